@@ -0,0 +1,310 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "argminmax.h"
+#include <algorithm>
+#include <arrow/compute/api.h>
+#include <arrow/util/bit_block_counter.h>
+#include <arrow/util/bitmap_generate.h>
+#include <functional>
+#include <limits>
+#include <tbb/blocked_range.h>
+#include "exec_context.h"
+#include "scheduler.h"
+#include "visit.h"
+
+
+namespace pd {
+
+    namespace {
+        /// running extremum of a column: Compare(a, b) is true when a beats b, ties keep the earlier row
+        template<class T, class Compare>
+        struct ArgExtremum {
+            static constexpr T worst = std::is_floating_point_v<T> ?
+                                       (std::is_same_v<Compare, std::less<>> ? std::numeric_limits<T>::infinity()
+                                                                              : -std::numeric_limits<T>::infinity()) :
+                                       (std::is_same_v<Compare, std::less<>> ? std::numeric_limits<T>::max()
+                                                                              : std::numeric_limits<T>::lowest());
+
+            bool skipNA;
+            T best{worst};
+            int64_t position{-1};
+            bool sawNaN{false};
+
+            explicit ArgExtremum(bool skipNA) : skipNA(skipNA) {}
+
+            ArgExtremum(ArgExtremum &other, tbb::split) : skipNA(other.skipNA) {}
+
+            void operator()(int64_t firstRow, ColumnView<T> const &column) {
+                if (sawNaN and not skipNA) {
+                    return;
+                }
+                auto const *values = column.values.data();
+                const auto length = static_cast<int64_t>(column.size());
+                if (not column.hasNulls()) {
+                    block(firstRow, values, length);
+                    return;
+                }
+
+                arrow::internal::BitBlockCounter counter(column.validity, column.bitOffset, length);
+                for (int64_t offset = 0; offset < length;) {
+                    auto run = counter.NextWord();
+                    if (run.AllSet()) {
+                        block(firstRow + offset, values + offset, run.length);
+                    } else if (not run.NoneSet()) {
+                        for (int64_t i = offset; i < offset + run.length; i++) {
+                            if (column.isValid(i)) {
+                                consider(firstRow + i, values[i]);
+                            }
+                        }
+                    }
+                    offset += run.length;
+                }
+            }
+
+            void join(ArgExtremum const &rhs) {
+                sawNaN |= rhs.sawNaN;
+                if (rhs.position >= 0 and (position < 0 or Compare{}(rhs.best, best))) {
+                    best = rhs.best;
+                    position = rhs.position;
+                }
+            }
+
+            [[nodiscard]] int64_t result() const {
+                return (sawNaN and not skipNA) ? -1 : position;
+            }
+
+        private:
+            void consider(int64_t row, T value) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (value != value) {
+                        sawNaN = true;
+                        return;
+                    }
+                }
+                if (position < 0 or Compare{}(value, best)) {
+                    best = value;
+                    position = row;
+                }
+            }
+
+            /// the extreme of a dense block is a branch free reduction the compiler vectorizes,
+            /// its first occurrence is only searched for when it beats the running best
+            void block(int64_t firstRow, T const *values, int64_t length) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    if (not skipNA) {
+                        bool nan = false;
+                        for (int64_t i = 0; i < length; i++) {
+                            nan |= values[i] != values[i];
+                        }
+                        if (nan) {
+                            sawNaN = true;
+                            return;
+                        }
+                    }
+                }
+
+                T extreme = worst;
+                for (int64_t i = 0; i < length; i++) {
+                    extreme = Compare{}(values[i], extreme) ? values[i] : extreme;
+                }
+                if (position >= 0 and not Compare{}(extreme, best)) {
+                    return;
+                }
+                // a NaN only block leaves extreme at the sentinel, which is then not found
+                auto it = std::find(values, values + length, extreme);
+                if (it != values + length) {
+                    best = extreme;
+                    position = firstRow + (it - values);
+                }
+            }
+        };
+
+        template<class T, class Compare>
+        int64_t scan(ArrayPtr const &array, bool skipNA) {
+            return visitColumns<T>(ArgExtremum<T, Compare>{skipNA}, {array}).result();
+        }
+
+        template<class Compare>
+        int64_t argExtremum(arrow::Array const &array, bool skipNA, std::string const &function) {
+            if (array.length() == 0 or array.null_count() == array.length() or
+                (not skipNA and array.null_count() > 0)) {
+                return -1;
+            }
+
+            auto values = arrow::MakeArray(array.data());
+            if (arrow::is_temporal(array.type_id())) {
+                values = ReturnOrThrowOnFailure(
+                        values->View(arrow::bit_width(array.type_id()) == 32 ? arrow::int32() : arrow::int64()));
+            }
+
+            switch (values->type_id()) {
+                case arrow::Type::INT8:
+                    return scan<int8_t, Compare>(values, skipNA);
+                case arrow::Type::INT16:
+                    return scan<int16_t, Compare>(values, skipNA);
+                case arrow::Type::INT32:
+                    return scan<int32_t, Compare>(values, skipNA);
+                case arrow::Type::INT64:
+                    return scan<int64_t, Compare>(values, skipNA);
+                case arrow::Type::UINT8:
+                    return scan<uint8_t, Compare>(values, skipNA);
+                case arrow::Type::UINT16:
+                    return scan<uint16_t, Compare>(values, skipNA);
+                case arrow::Type::UINT32:
+                    return scan<uint32_t, Compare>(values, skipNA);
+                case arrow::Type::UINT64:
+                    return scan<uint64_t, Compare>(values, skipNA);
+                case arrow::Type::FLOAT:
+                    return scan<float, Compare>(values, skipNA);
+                case arrow::Type::DOUBLE:
+                    return scan<double, Compare>(values, skipNA);
+                default:
+                    break;
+            }
+
+            auto extreme = ReturnOrThrowOnFailure(pd::CallFunction(function, {values})).scalar();
+            if (not extreme->is_valid) {
+                return -1;
+            }
+            arrow::compute::IndexOptions options{extreme};
+            return ReturnOrThrowOnFailure(pd::CallFunction("index", {values}, &options))
+                    .scalar_as<arrow::Int64Scalar>().value;
+        }
+
+        /// per row of values (all of type T) the position of the winning column, -1 when there is none
+        template<class T, class Compare>
+        void scanRows(std::vector<std::shared_ptr<arrow::ArrayData>> const &values, int64_t length, bool skipNA,
+                      int64_t *positions) {
+            // columns are walked one after the other over a block of rows, so every read is sequential
+            pd::parallel_for(
+                    tbb::blocked_range<int64_t>(0, length, 4096),
+                    pd::bindExecContext([&](tbb::blocked_range<int64_t> const &range) {
+                        const auto rows = static_cast<size_t>(range.size());
+                        auto *position = positions + range.begin();
+                        std::fill_n(position, rows, -1);
+                        std::vector<T> best(rows);
+                        std::vector<uint8_t> missing(skipNA ? 0 : rows);
+
+                        for (size_t c = 0; c < values.size(); c++) {
+                            auto const &data = *values[c];
+                            auto const *column = data.GetValues<T>(1) + range.begin();
+                            auto const *validity = data.null_count != 0 and data.buffers[0] ? data.buffers[0]->data() : nullptr;
+                            for (size_t i = 0; i < rows; i++) {
+                                const T x = column[i];
+                                if (x != x or (validity and not arrow::bit_util::GetBit(
+                                        validity, data.offset + range.begin() + static_cast<int64_t>(i)))) {
+                                    if (not skipNA) {
+                                        missing[i] = 1;
+                                    }
+                                    continue;
+                                }
+                                if (position[i] < 0 or Compare{}(x, best[i])) {
+                                    best[i] = x;
+                                    position[i] = static_cast<int64_t>(c);
+                                }
+                            }
+                        }
+                        for (size_t i = 0; i < missing.size(); i++) {
+                            if (missing[i]) {
+                                position[i] = -1;
+                            }
+                        }
+                    }));
+        }
+
+        template<class Compare>
+        std::shared_ptr<arrow::Int64Array> argExtremumRows(arrow::ArrayVector const &columns, bool skipNA) {
+            if (columns.empty()) {
+                throw std::runtime_error("row-wise argmin / argmax needs at least one column");
+            }
+
+            const int64_t length = columns[0]->length();
+            bool sameType = true, integers = true;
+            for (auto const &column: columns) {
+                if (column->length() != length) {
+                    throw std::runtime_error("row-wise argmin / argmax: columns have different lengths");
+                }
+                if (not arrow::is_numeric(column->type_id())) {
+                    throw std::runtime_error("row-wise argmin / argmax needs numeric columns, got " +
+                                             column->type()->ToString());
+                }
+                sameType = sameType and column->type_id() == columns[0]->type_id();
+                integers = integers and arrow::is_integer(column->type_id());
+            }
+
+            // one shared type is compared natively; mixed integers as int64 and anything else as
+            // double, both cast safely so a value the common type cannot hold exactly throws
+            auto common = sameType ? columns[0]->type() : integers ? arrow::int64() : arrow::float64();
+            if (common->id() == arrow::Type::HALF_FLOAT) {
+                common = arrow::float64();
+            }
+            std::vector<std::shared_ptr<arrow::ArrayData>> values;
+            values.reserve(columns.size());
+            for (auto const &column: columns) {
+                values.push_back(column->type()->Equals(*common)
+                                 ? column->data()
+                                 : ReturnOrThrowOnFailure(pd::Cast(column, common)).array());
+            }
+
+            auto buffer = ReturnOrThrowOnFailure(arrow::AllocateBuffer(length * sizeof(int64_t), pd::GetMemoryPool()));
+            auto *positions = reinterpret_cast<int64_t *>(buffer->mutable_data());
+            switch (common->id()) {
+                case arrow::Type::INT8:
+                    scanRows<int8_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::INT16:
+                    scanRows<int16_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::INT32:
+                    scanRows<int32_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::INT64:
+                    scanRows<int64_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::UINT8:
+                    scanRows<uint8_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::UINT16:
+                    scanRows<uint16_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::UINT32:
+                    scanRows<uint32_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::UINT64:
+                    scanRows<uint64_t, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::FLOAT:
+                    scanRows<float, Compare>(values, length, skipNA, positions);
+                    break;
+                case arrow::Type::DOUBLE:
+                    scanRows<double, Compare>(values, length, skipNA, positions);
+                    break;
+                default:
+                    throw std::runtime_error("row-wise argmin / argmax: unsupported column type " + common->ToString());
+            }
+
+            auto bitmap = ReturnOrThrowOnFailure(arrow::AllocateEmptyBitmap(length, pd::GetMemoryPool()));
+            int64_t row = 0;
+            arrow::internal::GenerateBitsUnrolled(bitmap->mutable_data(), 0, length,
+                                                  [&] { return positions[row++] >= 0; });
+            return std::make_shared<arrow::Int64Array>(length, std::move(buffer), std::move(bitmap), arrow::kUnknownNullCount);
+        }
+    }
+
+    int64_t argmin(arrow::Array const &array, bool skipNA) {
+        return argExtremum<std::less<>>(array, skipNA, "min");
+    }
+
+    int64_t argmax(arrow::Array const &array, bool skipNA) {
+        return argExtremum<std::greater<>>(array, skipNA, "max");
+    }
+
+    std::shared_ptr<arrow::Int64Array> argminRows(arrow::ArrayVector const &columns, bool skipNA) {
+        return argExtremumRows<std::less<>>(columns, skipNA);
+    }
+
+    std::shared_ptr<arrow::Int64Array> argmaxRows(arrow::ArrayVector const &columns, bool skipNA) {
+        return argExtremumRows<std::greater<>>(columns, skipNA);
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include "core.h"
+
+
+namespace pd {
+
+    /// Position of the first smallest / largest value in one typed pass, -1 when there is none.
+    /// skipNA ignores nulls and NaN, otherwise a column holding either has no extremum and gives -1.
+    /// Numeric and temporal columns are scanned natively (in parallel when long), other types go
+    /// through the min / max aggregate and a search for it.
+    int64_t argmin(arrow::Array const &array, bool skipNA = true);
+
+    int64_t argmax(arrow::Array const &array, bool skipNA = true);
+
+    /// Row-wise over equally long numeric columns: per row the position of the column holding its
+    /// smallest / largest value, ties to the leftmost column, null for rows without one.
+    /// Columns of one type are compared in that type, mixed integer columns as int64 and any other
+    /// mix as double; those casts are safe, so values the common type cannot represent exactly
+    /// (e.g. integers beyond 2^53 next to a float column) throw rather than compare wrongly.
+    std::shared_ptr<arrow::Int64Array> argminRows(arrow::ArrayVector const &columns, bool skipNA = true);
+
+    std::shared_ptr<arrow::Int64Array> argmaxRows(arrow::ArrayVector const &columns, bool skipNA = true);
+}
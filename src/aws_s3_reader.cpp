@@ -47,6 +47,26 @@ namespace arrow{
             throw std::runtime_error(fmt::format("Failed to create S3 file system:  {}.", status.ToString()));
         }
         m_s3fs = s3fs.MoveValueUnsafe();
+
+        if (const auto cacheDir = getenv("STRATIFYX_S3_CACHE_DIR")) {
+            const auto cacheMB = getenv("STRATIFYX_S3_CACHE_MB");
+            EnableCache(cacheDir, (cacheMB ? atoll(cacheMB) : 10240) << 20);
+        }
+        if (const auto ioThreads = getenv("STRATIFYX_S3_IO_THREADS")) {
+            const auto ioStatus = SetIOConcurrency(atoi(ioThreads));
+            if (!ioStatus.ok()) {
+                throw std::runtime_error(fmt::format("Invalid STRATIFYX_S3_IO_THREADS: {}.", ioStatus.ToString()));
+            }
+        }
+    }
+
+    void AWSS3Reader::EnableCache(std::filesystem::path const& directory, int64_t capacity) {
+        m_cache = std::make_shared<pd::FileCache>(directory, capacity);
+        SPDLOG_INFO("Caching S3 objects in {} up to {} bytes", directory.string(), capacity);
+    }
+
+    Status AWSS3Reader::SetIOConcurrency(int threads) {
+        return io::SetIOThreadPoolCapacity(threads);
     }
 
     AWSS3Reader::~AWSS3Reader() {
@@ -6,6 +6,7 @@
 #include <memory>
 #include <arrow/io/api.h>
 #include "arrow/filesystem/s3fs.h"
+#include "file_cache.h"
 
 
 namespace arrow {
@@ -18,16 +19,37 @@ namespace arrow {
             return instance;
         }
 
-        auto CreateReadableFile(std::string const& s3URI) const
+        /// served from the local disk cache when one is enabled
+        Result<std::shared_ptr<io::RandomAccessFile>> CreateReadableFile(std::string const& s3URI) const
         {
+            if (m_cache) {
+                return m_cache->open(*m_s3fs, s3URI);
+            }
             return m_s3fs->OpenInputFile(s3URI);
         }
 
+        /// keeps up to capacity bytes of fetched objects under directory, also enabled by
+        /// STRATIFYX_S3_CACHE_DIR and STRATIFYX_S3_CACHE_MB
+        void EnableCache(std::filesystem::path const& directory, int64_t capacity);
+
+        void DisableCache() { m_cache.reset(); }
+
+        std::shared_ptr<pd::FileCache> const& cache() const { return m_cache; }
+
+        /// bounds the concurrent range requests of pre-buffered reads, also set by STRATIFYX_S3_IO_THREADS
+        static Status SetIOConcurrency(int threads);
+
+        std::shared_ptr<fs::FileSystem> const& filesystem() const
+        {
+            return m_s3fs;
+        }
+
         ~AWSS3Reader();
 
     private:
         AWSS3Reader();
 
         std::shared_ptr<fs::FileSystem> m_s3fs;
+        std::shared_ptr<pd::FileCache> m_cache;
     };
     }
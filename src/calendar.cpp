@@ -0,0 +1,104 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "calendar.h"
+#include <algorithm>
+
+
+namespace pd {
+
+    BusinessCalendar::BusinessCalendar(std::vector<date> const &holidays, std::vector<greg_weekday> const &weekend) {
+        m_holidays.reserve(holidays.size());
+        std::ranges::transform(holidays, std::back_inserter(m_holidays), toDays);
+        std::ranges::sort(m_holidays);
+        for (auto day: weekend) {
+            m_weekend[day.as_number()] = true;
+        }
+        if (std::ranges::all_of(m_weekend, [](bool closed) { return closed; })) {
+            throw std::runtime_error("BusinessCalendar needs at least one trading weekday");
+        }
+    }
+
+    bool BusinessCalendar::isSession(int64_t day) const {
+        return not m_weekend[weekdayFromDays(day)] and not std::ranges::binary_search(m_holidays, day);
+    }
+
+    bool BusinessCalendar::isSession(date const &day) const {
+        return isSession(toDays(day));
+    }
+
+    static date fromDays(int64_t days) {
+        auto civil = civilFromDays(days);
+        return {static_cast<unsigned short>(civil.year), static_cast<unsigned short>(civil.month),
+                static_cast<unsigned short>(civil.day)};
+    }
+
+    date BusinessCalendar::rollForward(date const &day) const {
+        auto days = toDays(day);
+        while (not isSession(days)) {
+            days++;
+        }
+        return fromDays(days);
+    }
+
+    date BusinessCalendar::add(date const &day, int n) const {
+        auto days = toDays(rollForward(day));
+        const int step = n < 0 ? -1 : 1;
+        for (int remaining = std::abs(n); remaining > 0;) {
+            days += step;
+            remaining -= isSession(days);
+        }
+        return fromDays(days);
+    }
+
+    std::vector<int64_t> BusinessCalendar::sessionDays(int64_t first, int64_t last) const {
+        std::vector<int64_t> days;
+        days.reserve(std::max<int64_t>(0, last - first + 1));
+        auto holiday = std::ranges::lower_bound(m_holidays, first);
+        for (auto day = first; day <= last; day++) {
+            while (holiday != m_holidays.end() and *holiday < day) {
+                holiday++;
+            }
+            if (not m_weekend[weekdayFromDays(day)] and (holiday == m_holidays.end() or *holiday != day)) {
+                days.push_back(day);
+            }
+        }
+        return days;
+    }
+
+    std::shared_ptr<arrow::TimestampArray> BusinessCalendar::sessions(
+            date const &start,
+            date const &end,
+            std::string const &tz) const {
+        auto days = sessionDays(toDays(start), toDays(end));
+        return generateTimestamps(
+                static_cast<int64_t>(days.size()),
+                [&](int64_t i) { return days[i] * NANOS_PER_DAY; },
+                tz);
+    }
+
+    std::shared_ptr<arrow::TimestampArray> BusinessCalendar::sessionGrid(
+            date const &start,
+            date const &end,
+            time_duration const &open,
+            time_duration const &close,
+            time_duration const &freq,
+            std::string const &tz) const {
+        if (freq.is_negative() or freq.is_zero()) {
+            throw std::runtime_error("FREQ must be positive");
+        }
+        if (close <= open) {
+            throw std::runtime_error("sessionGrid: close has to be after open");
+        }
+
+        const int64_t step = freq.total_nanoseconds();
+        const int64_t openNs = open.total_nanoseconds();
+        const int64_t perSession = (close.total_nanoseconds() - openNs + step - 1) / step;
+
+        auto days = sessionDays(toDays(start), toDays(end));
+        return generateTimestamps(
+                static_cast<int64_t>(days.size()) * perSession,
+                [&](int64_t i) { return days[i / perSession] * NANOS_PER_DAY + openNs + (i % perSession) * step; },
+                tz);
+    }
+}
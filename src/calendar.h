@@ -0,0 +1,131 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <vector>
+#include "core.h"
+#include "exec_context.h"
+#include "scheduler.h"
+
+
+namespace pd {
+
+    constexpr int64_t NANOS_PER_DAY = 86'400'000'000'000;
+
+    struct CivilDate {
+        int64_t year;
+        unsigned month;
+        unsigned day;
+    };
+
+    /// days since 1970-01-01 of a proleptic gregorian date (Hinnant's days_from_civil)
+    constexpr int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+        y -= m <= 2;
+        const int64_t era = (y >= 0 ? y : y - 399) / 400;
+        const auto yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    constexpr CivilDate civilFromDays(int64_t z) {
+        z += 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const auto doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+        return {static_cast<int64_t>(yoe) + era * 400 + (m <= 2), m, d};
+    }
+
+    constexpr unsigned lastDayOfMonth(int64_t y, unsigned m) {
+        constexpr unsigned lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        const bool leap = y % 4 == 0 and (y % 100 != 0 or y % 400 == 0);
+        return m == 2 and leap ? 29 : lengths[m - 1];
+    }
+
+    /// 0 is Sunday, like boost's day_of_week
+    constexpr int weekdayFromDays(int64_t z) {
+        return static_cast<int>(((z + 4) % 7 + 7) % 7);
+    }
+
+    /// day number `months` after start. The day is clamped to the length of the month and
+    /// month ends stay month ends, which is how boost's month_iterator steps.
+    constexpr int64_t addMonths(CivilDate const &start, int64_t months) {
+        const int64_t index = start.year * 12 + (start.month - 1) + months;
+        const int64_t y = index >= 0 ? index / 12 : (index - 11) / 12;
+        const auto m = static_cast<unsigned>(index - y * 12 + 1);
+        const auto last = lastDayOfMonth(y, m);
+        const auto d = start.day == lastDayOfMonth(start.year, start.month) ? last : std::min(start.day, last);
+        return daysFromCivil(y, m, d);
+    }
+
+    inline int64_t toDays(date const &day) {
+        return daysFromCivil(day.year(), day.month(), day.day());
+    }
+
+    /// nanosecond timestamps valueAt(0) ... valueAt(length - 1) written straight into an arrow
+    /// buffer, filled in parallel in morsels when the range reaches the context's serial_threshold
+    template<class Fn>
+    std::shared_ptr<arrow::TimestampArray> generateTimestamps(int64_t length, Fn &&valueAt, std::string const &tz = "") {
+        auto ctx = pd::GetExecContext();
+        auto buffer = ReturnOrThrowOnFailure(arrow::AllocateBuffer(length * sizeof(int64_t), ctx.pool));
+        auto *values = reinterpret_cast<int64_t *>(buffer->mutable_data());
+
+        if (length >= std::max<int64_t>(ctx.serial_threshold, 1)) {
+            pd::parallel_for(tbb::blocked_range<int64_t>(0, length, std::max<int64_t>(ctx.morsel_size, 1)),
+                              pd::bindExecContext([&](tbb::blocked_range<int64_t> const &r) {
+                                  for (auto i = r.begin(); i != r.end(); i++) {
+                                      values[i] = valueAt(i);
+                                  }
+                              }));
+        } else {
+            for (int64_t i = 0; i < length; i++) {
+                values[i] = valueAt(i);
+            }
+        }
+        return std::make_shared<arrow::TimestampArray>(
+                arrow::timestamp(arrow::TimeUnit::NANO, tz), length, std::move(buffer));
+    }
+
+    /// Trading days: every day but the weekend days and the listed holidays
+    class BusinessCalendar {
+    public:
+        explicit BusinessCalendar(std::vector<date> const &holidays = {},
+                                  std::vector<greg_weekday> const &weekend = {Saturday, Sunday});
+
+        [[nodiscard]] bool isSession(date const &day) const;
+
+        /// the day itself when it is a session, otherwise the next session
+        [[nodiscard]] date rollForward(date const &day) const;
+
+        /// n sessions after (n < 0: before) day, counting from the session day rolls forward to
+        [[nodiscard]] date add(date const &day, int n) const;
+
+        /// midnight of every session in [start, end]
+        [[nodiscard]] std::shared_ptr<arrow::TimestampArray> sessions(
+                date const &start,
+                date const &end,
+                std::string const &tz = "") const;
+
+        /// bars of freq from open up to, not including, close on every session in [start, end]
+        [[nodiscard]] std::shared_ptr<arrow::TimestampArray> sessionGrid(
+                date const &start,
+                date const &end,
+                time_duration const &open,
+                time_duration const &close,
+                time_duration const &freq,
+                std::string const &tz = "") const;
+
+    private:
+        std::vector<int64_t> m_holidays;
+        std::array<bool, 7> m_weekend{};
+
+        [[nodiscard]] bool isSession(int64_t day) const;
+
+        [[nodiscard]] std::vector<int64_t> sessionDays(int64_t first, int64_t last) const;
+    };
+}
@@ -0,0 +1,118 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "categorical.h"
+#include <arrow/compute/api.h>
+#include <arrow/util/bitmap_ops.h>
+#include <tbb/combinable.h>
+#include "exec_context.h"
+#include "scheduler.h"
+
+
+namespace pd {
+
+    int64_t categoryCode(arrow::DictionaryArray const &array, std::shared_ptr<arrow::Scalar> const &label) {
+        auto const &dictionary = array.dictionary();
+        auto casted = label->type->Equals(dictionary->type()) ? label : ReturnOrThrowOnFailure(label->CastTo(dictionary->type()));
+        arrow::compute::IndexOptions options{casted};
+        return ReturnOrThrowOnFailure(pd::CallFunction("index", {dictionary}, &options)).scalar_as<arrow::Int64Scalar>().value;
+    }
+
+    std::optional<arrow::Datum> compareCodes(
+            std::string const &function,
+            ArrayPtr const &array,
+            std::shared_ptr<arrow::Scalar> const &label) {
+        if (array->type_id() != arrow::Type::DICTIONARY or not label->is_valid) {
+            return std::nullopt;
+        }
+        auto const &categorical = static_cast<arrow::DictionaryArray const &>(*array);
+        auto valueType = categorical.dictionary()->type();
+        if (not label->type->Equals(valueType) and not label->CastTo(valueType).ok()) {
+            return std::nullopt;
+        }
+
+        auto code = categoryCode(categorical, label);
+        if (code < 0) {
+            // no row holds a label outside the categories; -1 must not reach an unsigned index type,
+            // where it would wrap onto a real code
+            auto const &indices = *categorical.indices()->data();
+            auto constant = ReturnOrThrowOnFailure(arrow::MakeArrayFromScalar(
+                    arrow::BooleanScalar(function == "not_equal"), indices.length, pd::GetMemoryPool()));
+            std::shared_ptr<arrow::Buffer> validity;
+            if (indices.GetNullCount() != 0) {
+                validity = ReturnOrThrowOnFailure(arrow::internal::CopyBitmap(
+                        pd::GetMemoryPool(), indices.buffers[0]->data(), indices.offset, indices.length));
+            }
+            return arrow::Datum(arrow::ArrayData::Make(arrow::boolean(), indices.length,
+                                                       {std::move(validity), constant->data()->buffers[1]},
+                                                       indices.GetNullCount()));
+        }
+        auto codeScalar = ReturnOrThrowOnFailure(arrow::MakeScalar(categorical.indices()->type(), code));
+        return ReturnOrThrowOnFailure(pd::CallFunction(function, {categorical.indices(), codeScalar}));
+    }
+
+    std::optional<arrow::Datum> compareCodes(std::string const &function, ArrayPtr const &lhs, ArrayPtr const &rhs) {
+        if (lhs->type_id() != arrow::Type::DICTIONARY or not lhs->type()->Equals(rhs->type())) {
+            return std::nullopt;
+        }
+        auto const &x = static_cast<arrow::DictionaryArray const &>(*lhs);
+        auto const &y = static_cast<arrow::DictionaryArray const &>(*rhs);
+        if (x.dictionary() != y.dictionary() and not x.dictionary()->Equals(y.dictionary())) {
+            return std::nullopt;
+        }
+        return ReturnOrThrowOnFailure(pd::CallFunction(function, {x.indices(), y.indices()}));
+    }
+
+    std::shared_ptr<arrow::StructArray> countCodes(arrow::DictionaryArray const &array) {
+        const auto categories = array.dictionary()->length();
+        const auto length = array.length();
+        constexpr int64_t blockSize = 1 << 16;
+
+        // per thread histograms over the codes, the last slot counts the nulls
+        tbb::combinable<std::vector<int64_t>> histograms([&] { return std::vector<int64_t>(categories + 1); });
+        visitCodes(array, [&]<typename CType>(CType const *codes) {
+            pd::parallel_for(
+                    tbb::blocked_range<int64_t>(0, length, blockSize),
+                    pd::bindExecContext([&](tbb::blocked_range<int64_t> const &r) {
+                        auto &histogram = histograms.local();
+                        if (array.null_count() == 0) {
+                            for (auto i = r.begin(); i != r.end(); i++) {
+                                histogram[codes[i]]++;
+                            }
+                        } else {
+                            for (auto i = r.begin(); i != r.end(); i++) {
+                                histogram[array.IsValid(i) ? static_cast<int64_t>(codes[i]) : categories]++;
+                            }
+                        }
+                    }));
+        });
+
+        std::vector<int64_t> counts(categories + 1);
+        histograms.combine_each([&](std::vector<int64_t> const &histogram) {
+            for (int64_t i = 0; i <= categories; i++) {
+                counts[i] += histogram[i];
+            }
+        });
+
+        auto codeBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(array.indices()->type(), pd::GetMemoryPool()));
+        arrow::Int64Builder countBuilder(pd::GetMemoryPool());
+        for (int64_t code = 0; code <= categories; code++) {
+            if (counts[code] == 0) {
+                continue;
+            }
+            if (code == categories) {
+                ThrowOnFailure(codeBuilder->AppendNull());
+            } else {
+                ThrowOnFailure(codeBuilder->AppendScalar(
+                        *ReturnOrThrowOnFailure(arrow::MakeScalar(array.indices()->type(), code))));
+            }
+            ThrowOnFailure(countBuilder.Append(counts[code]));
+        }
+
+        auto values = std::make_shared<arrow::DictionaryArray>(
+                array.type(), ReturnOrThrowOnFailure(codeBuilder->Finish()), array.dictionary());
+        return ReturnOrThrowOnFailure(arrow::StructArray::Make(
+                arrow::ArrayVector{values, ReturnOrThrowOnFailure(countBuilder.Finish())},
+                std::vector<std::string>{"values", "counts"}));
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <optional>
+#include "core.h"
+
+
+namespace pd {
+
+    /// calls fn with a pointer to the codes of a dictionary array, typed after its index type
+    template<class Fn>
+    decltype(auto) visitCodes(arrow::DictionaryArray const &array, Fn &&fn) {
+        auto const &indices = *array.indices()->data();
+        switch (indices.type->id()) {
+            case arrow::Type::INT8:
+                return fn(indices.GetValues<int8_t>(1));
+            case arrow::Type::INT16:
+                return fn(indices.GetValues<int16_t>(1));
+            case arrow::Type::INT32:
+                return fn(indices.GetValues<int32_t>(1));
+            case arrow::Type::INT64:
+                return fn(indices.GetValues<int64_t>(1));
+            case arrow::Type::UINT8:
+                return fn(indices.GetValues<uint8_t>(1));
+            case arrow::Type::UINT16:
+                return fn(indices.GetValues<uint16_t>(1));
+            case arrow::Type::UINT32:
+                return fn(indices.GetValues<uint32_t>(1));
+            case arrow::Type::UINT64:
+                return fn(indices.GetValues<uint64_t>(1));
+            default:
+                throw std::runtime_error("unsupported dictionary index type " + indices.type->ToString());
+        }
+    }
+
+    /// position of label in the dictionary of a categorical, -1 when it is not one of its categories
+    int64_t categoryCode(arrow::DictionaryArray const &array, std::shared_ptr<arrow::Scalar> const &label);
+
+    /// equal / not_equal of a categorical against a label, done as one comparison of the codes.
+    /// nullopt when array is not a categorical or the label is not comparable with its categories.
+    std::optional<arrow::Datum> compareCodes(
+            std::string const &function,
+            ArrayPtr const &array,
+            std::shared_ptr<arrow::Scalar> const &label);
+
+    /// same for two categoricals, only taken when both share one dictionary
+    std::optional<arrow::Datum> compareCodes(std::string const &function, ArrayPtr const &lhs, ArrayPtr const &rhs);
+
+    /// occurrences of every category as {values, counts}, values stay dictionary encoded.
+    /// categories are listed in code order, unused ones are dropped and nulls come last.
+    std::shared_ptr<arrow::StructArray> countCodes(arrow::DictionaryArray const &array);
+}
@@ -0,0 +1,488 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "chunked_frame.h"
+#include <arrow/array/concatenate.h>
+#include <arrow/compute/api.h>
+#include <arrow/compute/row/grouper.h>
+#include "concat.h"
+#include "elementwise.h"
+#include "exec_context.h"
+#include "scheduler.h"
+#include "tracing.h"
+
+
+namespace pd {
+
+    namespace {
+        bool sameLayout(arrow::ChunkedArray const &a, arrow::ChunkedArray const &b) {
+            if (a.num_chunks() != b.num_chunks()) {
+                return false;
+            }
+            for (int i = 0; i < a.num_chunks(); i++) {
+                if (a.chunk(i)->length() != b.chunk(i)->length()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// chunks are evaluated in parallel when every chunked argument shares the layout of the first,
+        /// otherwise arrow walks the misaligned chunks itself
+        std::shared_ptr<arrow::ChunkedArray> elementwise(std::string const &function,
+                                                         std::vector<arrow::Datum> const &args,
+                                                         arrow::compute::FunctionOptions const *options) {
+            auto const &first = *args.front().chunked_array();
+            bool aligned = first.num_chunks() > 0;
+            for (auto const &arg: args) {
+                aligned = aligned and (not arg.is_chunked_array() or sameLayout(first, *arg.chunked_array()));
+            }
+            if (not aligned) {
+                return ReturnOrThrowOnFailure(pd::CallFunction(function, args, options)).chunked_array();
+            }
+
+            arrow::ArrayVector chunks(first.num_chunks());
+            pd::parallel_for(0, first.num_chunks(), pd::bindExecContext([&](int i) {
+                std::vector<arrow::Datum> chunkArgs;
+                chunkArgs.reserve(args.size());
+                for (auto const &arg: args) {
+                    chunkArgs.emplace_back(arg.is_chunked_array() ? arrow::Datum{arg.chunked_array()->chunk(i)} : arg);
+                }
+                chunks[i] = ReturnOrThrowOnFailure(pd::CallElementwise(function, chunkArgs, options)).make_array();
+            }));
+            return std::make_shared<arrow::ChunkedArray>(std::move(chunks));
+        }
+
+        ArrayPtr flatten(arrow::ChunkedArray const &chunked) {
+            if (chunked.num_chunks() == 1) {
+                return chunked.chunk(0);
+            }
+            if (chunked.num_chunks() == 0) {
+                return ReturnOrThrowOnFailure(arrow::MakeEmptyArray(chunked.type(), pd::GetMemoryPool()));
+            }
+            return ReturnOrThrowOnFailure(arrow::Concatenate(chunked.chunks(), pd::GetMemoryPool()));
+        }
+
+        std::shared_ptr<arrow::ChunkedArray> positionsOf(int64_t offset, int64_t length) {
+            return std::make_shared<arrow::ChunkedArray>(
+                    pd::range(static_cast<uint64_t>(offset), static_cast<uint64_t>(offset + length)));
+        }
+
+        /// index labels of rows [offset, offset + length), positions when there is no index
+        ArrayPtr indexSlice(std::shared_ptr<arrow::ChunkedArray> const &index, int64_t offset, int64_t length) {
+            if (not index) {
+                return pd::range(static_cast<uint64_t>(offset), static_cast<uint64_t>(offset + length));
+            }
+            return flatten(*index->Slice(offset, length));
+        }
+
+        std::shared_ptr<arrow::ChunkedArray> filterIndex(std::shared_ptr<arrow::ChunkedArray> const &index,
+                                                         int64_t length,
+                                                         std::shared_ptr<arrow::ChunkedArray> const &mask) {
+            return ReturnOrThrowOnFailure(pd::CallFunction("filter", {index ? index : positionsOf(0, length), mask}))
+                    .chunked_array();
+        }
+    }
+
+    //<editor-fold desc="ChunkedSeries">
+    ChunkedSeries::ChunkedSeries(std::shared_ptr<arrow::ChunkedArray> values,
+                                 std::shared_ptr<arrow::ChunkedArray> index,
+                                 std::string name)
+            : m_values(std::move(values)), m_index(std::move(index)), m_name(std::move(name)) {
+        if (m_index and m_index->length() != m_values->length()) {
+            throw std::invalid_argument("ChunkedSeries: index has " + std::to_string(m_index->length()) +
+                                        " labels for " + std::to_string(m_values->length()) + " values");
+        }
+    }
+
+    ChunkedSeries::ChunkedSeries(Series const &series)
+            : ChunkedSeries(std::make_shared<arrow::ChunkedArray>(series.array()),
+                            std::make_shared<arrow::ChunkedArray>(series.indexArray()),
+                            series.name()) {}
+
+    Series ChunkedSeries::chunk(int i) const {
+        int64_t offset = 0;
+        for (int c = 0; c < i; c++) {
+            offset += m_values->chunk(c)->length();
+        }
+        auto values = m_values->chunk(i);
+        return Series{values, indexSlice(m_index, offset, values->length()), m_name};
+    }
+
+    ChunkedSeries ChunkedSeries::slice(int64_t offset, int64_t length) const {
+        auto values = m_values->Slice(offset, length);
+        return ChunkedSeries{values, m_index ? m_index->Slice(offset, length) : positionsOf(offset, values->length()),
+                             m_name};
+    }
+
+    Series ChunkedSeries::combine() const {
+        PD_TRACE_SCOPE("ChunkedSeries::combine");
+        return Series{flatten(*m_values), indexSlice(m_index, 0, size()), m_name};
+    }
+
+    ChunkedSeries ChunkedSeries::call(std::string const &function, arrow::Datum const &other) const {
+        if (other.is_chunked_array() and other.chunked_array()->length() != size()) {
+            throw std::invalid_argument(function + ": lengths differ, " + std::to_string(size()) + " and " +
+                                        std::to_string(other.chunked_array()->length()));
+        }
+        return ChunkedSeries{elementwise(function, {m_values, other}, nullptr), m_index, m_name};
+    }
+
+    ChunkedSeries ChunkedSeries::call(std::string const &function,
+                                      arrow::compute::FunctionOptions const *options) const {
+        return ChunkedSeries{elementwise(function, {m_values}, options), m_index, m_name};
+    }
+
+    ChunkedSeries ChunkedSeries::filter(ChunkedSeries const &mask) const {
+        PD_TRACE_SCOPE("ChunkedSeries::filter");
+        auto values = ReturnOrThrowOnFailure(pd::CallFunction("filter", {m_values, mask.m_values})).chunked_array();
+        return ChunkedSeries{values, filterIndex(m_index, size(), mask.m_values), m_name};
+    }
+
+    Scalar ChunkedSeries::aggregate(std::string const &function,
+                                    arrow::compute::FunctionOptions const &options) const {
+        return Scalar{ReturnOrThrowOnFailure(pd::CallFunction(function, {m_values}, &options)).scalar()};
+    }
+
+    Scalar ChunkedSeries::sum(bool skip_null) const {
+        return aggregate("sum", arrow::compute::ScalarAggregateOptions{skip_null});
+    }
+
+    Scalar ChunkedSeries::mean(bool skip_null) const {
+        return aggregate("mean", arrow::compute::ScalarAggregateOptions{skip_null});
+    }
+
+    Scalar ChunkedSeries::min(bool skip_null) const {
+        return aggregate("min", arrow::compute::ScalarAggregateOptions{skip_null});
+    }
+
+    Scalar ChunkedSeries::max(bool skip_null) const {
+        return aggregate("max", arrow::compute::ScalarAggregateOptions{skip_null});
+    }
+
+    Scalar ChunkedSeries::std(int ddof, bool skip_null) const {
+        return aggregate("stddev", arrow::compute::VarianceOptions{ddof, skip_null});
+    }
+
+    Scalar ChunkedSeries::var(int ddof, bool skip_null) const {
+        return aggregate("variance", arrow::compute::VarianceOptions{ddof, skip_null});
+    }
+    //</editor-fold>
+
+    //<editor-fold desc="ChunkedFrame">
+    ChunkedFrame::ChunkedFrame(TablePtr table, std::shared_ptr<arrow::ChunkedArray> index)
+            : m_table(std::move(table)), m_index(std::move(index)) {
+        if (m_index and m_index->length() != m_table->num_rows()) {
+            throw std::invalid_argument("ChunkedFrame: index has " + std::to_string(m_index->length()) +
+                                        " labels for " + std::to_string(m_table->num_rows()) + " rows");
+        }
+    }
+
+    ChunkedFrame::ChunkedFrame(DataFrame const &df)
+            : ChunkedFrame(ReturnOrThrowOnFailure(arrow::Table::FromRecordBatches({df.array()})),
+                           std::make_shared<arrow::ChunkedArray>(df.indexArray())) {}
+
+    ChunkedFrame ChunkedFrame::fromFrames(std::vector<DataFrame> const &frames, JoinType join) {
+        PD_TRACE_SCOPE("ChunkedFrame::fromFrames");
+        auto table = Concatenator(frames, join).concatenateRowChunks();
+
+        arrow::ArrayVector indexes;
+        for (auto const &frame: frames) {
+            if (frame.array()) {
+                indexes.push_back(frame.indexArray());
+            }
+        }
+        return ChunkedFrame{table, ReturnOrThrowOnFailure(arrow::ChunkedArray::Make(indexes))};
+    }
+
+    ChunkedFrame ChunkedFrame::readParquet(std::filesystem::path const &path,
+                                           std::vector<std::string> const &dictionaryColumns) {
+        return ChunkedFrame{DataFrame::readParquetTable(path, dictionaryColumns)};
+    }
+
+    ChunkedFrame ChunkedFrame::readCSV(std::filesystem::path const &path) {
+        return ChunkedFrame{DataFrame::readCSVTable(path)};
+    }
+
+    ChunkedSeries ChunkedFrame::operator[](std::string const &column) const {
+        auto values = m_table->GetColumnByName(column);
+        if (not values) {
+            throw std::invalid_argument("ChunkedFrame: no column named " + column);
+        }
+        return ChunkedSeries{values, m_index, column};
+    }
+
+    ChunkedFrame ChunkedFrame::operator[](std::vector<std::string> const &columns) const {
+        std::vector<int> indices;
+        indices.reserve(columns.size());
+        for (auto const &column: columns) {
+            auto i = m_table->schema()->GetFieldIndex(column);
+            if (i < 0) {
+                throw std::invalid_argument("ChunkedFrame: no column named " + column);
+            }
+            indices.push_back(i);
+        }
+        return ChunkedFrame{ReturnOrThrowOnFailure(m_table->SelectColumns(indices)), m_index};
+    }
+
+    std::vector<DataFrame> ChunkedFrame::batches() const {
+        arrow::TableBatchReader reader(*m_table);
+        auto recordBatches = ReturnOrThrowOnFailure(reader.ToRecordBatches());
+
+        std::vector<DataFrame> frames;
+        frames.reserve(recordBatches.size());
+        int64_t offset = 0;
+        for (auto const &batch: recordBatches) {
+            frames.emplace_back(batch, indexSlice(m_index, offset, batch->num_rows()));
+            offset += batch->num_rows();
+        }
+        return frames;
+    }
+
+    ChunkedFrame ChunkedFrame::slice(int64_t offset, int64_t length) const {
+        auto table = m_table->Slice(offset, length);
+        return ChunkedFrame{table, m_index ? m_index->Slice(offset, length) : positionsOf(offset, table->num_rows())};
+    }
+
+    ChunkedFrame ChunkedFrame::filter(ChunkedSeries const &mask) const {
+        PD_TRACE_SCOPE("ChunkedFrame::filter");
+        auto table = ReturnOrThrowOnFailure(pd::CallFunction("filter", {m_table, mask.values()})).table();
+        return ChunkedFrame{table, filterIndex(m_index, num_rows(), mask.values())};
+    }
+
+    ChunkedFrame ChunkedFrame::append(ChunkedFrame const &other) const {
+        if (not m_table->schema()->Equals(*other.m_table->schema(), false)) {
+            throw std::invalid_argument("ChunkedFrame::append: schemas differ\n" + m_table->schema()->ToString() +
+                                        "\n" + other.m_table->schema()->ToString());
+        }
+        auto table = ReturnOrThrowOnFailure(arrow::ConcatenateTables({m_table, other.m_table}, arrow::ConcatenateTablesOptions::Defaults(), pd::GetMemoryPool()));
+        if (not m_index and not other.m_index) {
+            return ChunkedFrame{table};
+        }
+
+        auto lhs = m_index ? m_index : positionsOf(0, num_rows());
+        auto rhs = other.m_index ? other.m_index : positionsOf(0, other.num_rows());
+        auto chunks = lhs->chunks();
+        std::ranges::copy(rhs->chunks(), std::back_inserter(chunks));
+        return ChunkedFrame{table, ReturnOrThrowOnFailure(arrow::ChunkedArray::Make(chunks))};
+    }
+
+    Series ChunkedFrame::columnwise(std::string const &function,
+                                    arrow::compute::FunctionOptions const &options,
+                                    bool numericOnly) const {
+        std::vector<int> columns;
+        for (int i = 0; i < m_table->num_columns(); i++) {
+            if (not numericOnly or arrow::is_numeric(m_table->column(i)->type()->id())) {
+                columns.push_back(i);
+            }
+        }
+        if (columns.empty()) {
+            return pd::Series(nullptr, false);
+        }
+
+        arrow::ScalarVector result(columns.size());
+        std::vector<std::string> names(columns.size());
+        pd::parallel_for(size_t{0}, columns.size(), pd::bindExecContext([&](size_t i) {
+            result[i] = ReturnOrThrowOnFailure(pd::CallFunction(function, {m_table->column(columns[i])}, &options))
+                    .scalar();
+            names[i] = m_table->field(columns[i])->name();
+        }));
+
+        // integer and floating point columns reduce to different types
+        std::vector<std::shared_ptr<arrow::DataType>> types(result.size());
+        std::ranges::transform(result, types.begin(), [](auto const &scalar) { return scalar->type; });
+        auto type = promoteTypes(types);
+        for (auto &scalar: result) {
+            scalar = ReturnOrThrowOnFailure(scalar->CastTo(type));
+        }
+        return pd::Series{arrow::ScalarArray::Make(result), arrow::ArrayT<std::string>::Make(names)};
+    }
+
+    Series ChunkedFrame::sum(bool skip_null) const {
+        return columnwise("sum", arrow::compute::ScalarAggregateOptions{skip_null}, true);
+    }
+
+    Series ChunkedFrame::mean(bool skip_null) const {
+        return columnwise("mean", arrow::compute::ScalarAggregateOptions{skip_null}, true);
+    }
+
+    Series ChunkedFrame::min(bool skip_null) const {
+        return columnwise("min", arrow::compute::ScalarAggregateOptions{skip_null}, true);
+    }
+
+    Series ChunkedFrame::max(bool skip_null) const {
+        return columnwise("max", arrow::compute::ScalarAggregateOptions{skip_null}, true);
+    }
+
+    Series ChunkedFrame::count() const {
+        return columnwise("count", arrow::compute::CountOptions{}, false);
+    }
+
+    ChunkedGroupBy ChunkedFrame::group_by(std::string const &key) const {
+        return ChunkedGroupBy{*this, key};
+    }
+
+    DataFrame ChunkedFrame::combine() const {
+        PD_TRACE_SCOPE("ChunkedFrame::combine");
+        auto batch = ReturnOrThrowOnFailure(m_table->CombineChunksToBatch(pd::GetMemoryPool()));
+        return m_index ? DataFrame{batch, flatten(*m_index)} : DataFrame{batch};
+    }
+    //</editor-fold>
+
+    //<editor-fold desc="ChunkedGroupBy">
+    namespace {
+        template<class T>
+        ArrayPtr reduceGroups(ChunkedGroupBy::Reduction reduction,
+                              std::vector<std::shared_ptr<arrow::RecordBatch>> const &batches,
+                              std::vector<std::shared_ptr<arrow::UInt32Array>> const &groupIds,
+                              int column,
+                              int64_t numGroups) {
+            using Reduction = ChunkedGroupBy::Reduction;
+            using Accumulator = std::conditional_t<std::is_floating_point_v<T>, double,
+                    std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+            using ArrayType = typename arrow::CTypeTraits<T>::ArrayType;
+
+            std::vector<Accumulator> sums(numGroups, 0);
+            std::vector<T> extrema(numGroups, 0);
+            std::vector<int64_t> counts(numGroups, 0);
+            for (size_t b = 0; b < batches.size(); b++) {
+                auto const &values = static_cast<ArrayType const &>(*batches[b]->column(column));
+                auto const *ids = groupIds[b]->raw_values();
+                for (int64_t i = 0; i < values.length(); i++) {
+                    if (values.IsNull(i)) {
+                        continue;
+                    }
+                    const auto g = ids[i];
+                    const T value = values.Value(i);
+                    if (reduction == Reduction::Min) {
+                        extrema[g] = counts[g] == 0 ? value : std::min(extrema[g], value);
+                    } else if (reduction == Reduction::Max) {
+                        extrema[g] = counts[g] == 0 ? value : std::max(extrema[g], value);
+                    } else {
+                        sums[g] += value;
+                    }
+                    counts[g]++;
+                }
+            }
+
+            std::vector<bool> valid;
+            valid.reserve(numGroups);
+            for (auto n: counts) {
+                valid.push_back(n > 0);
+            }
+            switch (reduction) {
+                case Reduction::Count:
+                    return arrow::ArrayT<int64_t>::Make(counts);
+                case Reduction::Sum:
+                    return arrow::ArrayT<Accumulator>::Make(sums, valid);
+                case Reduction::Mean: {
+                    std::vector<double> means(numGroups);
+                    for (int64_t g = 0; g < numGroups; g++) {
+                        means[g] = counts[g] > 0 ? static_cast<double>(sums[g]) / static_cast<double>(counts[g]) : 0;
+                    }
+                    return arrow::ArrayT<double>::Make(means, valid);
+                }
+                default:
+                    return arrow::ArrayT<T>::Make(extrema, valid);
+            }
+        }
+
+        template<class Fn>
+        ArrayPtr visitNumeric(arrow::Type::type id, Fn &&fn) {
+            switch (id) {
+                case arrow::Type::INT8:
+                    return fn.template operator()<int8_t>();
+                case arrow::Type::INT16:
+                    return fn.template operator()<int16_t>();
+                case arrow::Type::INT32:
+                    return fn.template operator()<int32_t>();
+                case arrow::Type::INT64:
+                    return fn.template operator()<int64_t>();
+                case arrow::Type::UINT8:
+                    return fn.template operator()<uint8_t>();
+                case arrow::Type::UINT16:
+                    return fn.template operator()<uint16_t>();
+                case arrow::Type::UINT32:
+                    return fn.template operator()<uint32_t>();
+                case arrow::Type::UINT64:
+                    return fn.template operator()<uint64_t>();
+                case arrow::Type::FLOAT:
+                    return fn.template operator()<float>();
+                case arrow::Type::DOUBLE:
+                    return fn.template operator()<double>();
+                default:
+                    return nullptr;
+            }
+        }
+    }
+
+    ChunkedGroupBy::ChunkedGroupBy(ChunkedFrame const &frame, std::string key) : m_key(std::move(key)) {
+        PD_TRACE_SCOPE("ChunkedGroupBy::makeGroups");
+        auto keyIndex = frame.table()->schema()->GetFieldIndex(m_key);
+        if (keyIndex < 0) {
+            throw std::invalid_argument("ChunkedGroupBy: no column named " + m_key);
+        }
+
+        // batches split every column at the same rows, so group ids line up with the values
+        arrow::TableBatchReader reader(*frame.table());
+        m_batches = ReturnOrThrowOnFailure(reader.ToRecordBatches());
+
+        auto ctx = pd::GetExecContext().compute();
+        auto grouper = ReturnOrThrowOnFailure(
+                arrow::compute::Grouper::Make({frame.table()->field(keyIndex)->type()}, &ctx));
+        m_groupIds.reserve(m_batches.size());
+        for (auto const &batch: m_batches) {
+            auto keys = ReturnOrThrowOnFailure(arrow::compute::ExecBatch::Make({batch->column(keyIndex)}));
+            auto ids = ReturnOrThrowOnFailure(grouper->Consume(arrow::compute::ExecSpan(keys)));
+            m_groupIds.push_back(ids.array_as<arrow::UInt32Array>());
+        }
+        m_uniqueKeys = ReturnOrThrowOnFailure(grouper->GetUniques()).values[0].make_array();
+    }
+
+    DataFrame ChunkedGroupBy::reduce(Reduction reduction) const {
+        PD_TRACE_SCOPE("ChunkedGroupBy::reduce");
+        const int64_t numGroups = groupSize();
+        auto const &schema = m_batches.empty() ? arrow::schema({}) : m_batches.front()->schema();
+
+        std::vector<int> columns;
+        for (int i = 0; i < schema->num_fields(); i++) {
+            if (schema->field(i)->name() != m_key and arrow::is_numeric(schema->field(i)->type()->id())) {
+                columns.push_back(i);
+            }
+        }
+
+        arrow::ArrayVector results(columns.size());
+        pd::parallel_for(size_t{0}, columns.size(), pd::bindExecContext([&](size_t i) {
+            results[i] = visitNumeric(schema->field(columns[i])->type()->id(), [&]<class T>() {
+                return reduceGroups<T>(reduction, m_batches, m_groupIds, columns[i], numGroups);
+            });
+        }));
+
+        arrow::FieldVector fields(columns.size());
+        for (size_t i = 0; i < columns.size(); i++) {
+            fields[i] = arrow::field(schema->field(columns[i])->name(), results[i]->type());
+        }
+        return DataFrame{arrow::RecordBatch::Make(arrow::schema(fields), numGroups, results), m_uniqueKeys};
+    }
+
+    DataFrame ChunkedGroupBy::sum() const {
+        return reduce(Reduction::Sum);
+    }
+
+    DataFrame ChunkedGroupBy::mean() const {
+        return reduce(Reduction::Mean);
+    }
+
+    DataFrame ChunkedGroupBy::min() const {
+        return reduce(Reduction::Min);
+    }
+
+    DataFrame ChunkedGroupBy::max() const {
+        return reduce(Reduction::Max);
+    }
+
+    DataFrame ChunkedGroupBy::count() const {
+        return reduce(Reduction::Count);
+    }
+    //</editor-fold>
+}
@@ -0,0 +1,196 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <filesystem>
+#include "dataframe.h"
+#include "series.h"
+
+
+namespace pd {
+
+    /// Series over an arrow::ChunkedArray, for columns too large or too fragmented to copy into one buffer.
+    /// Elementwise operations, filtering and aggregations run chunk by chunk (chunks in parallel when both
+    /// operands share a layout); combine() is the only operation that copies into contiguous memory.
+    /// A null index stands for positions 0..size.
+    class ChunkedSeries {
+    public:
+        explicit ChunkedSeries(std::shared_ptr<arrow::ChunkedArray> values,
+                               std::shared_ptr<arrow::ChunkedArray> index = nullptr,
+                               std::string name = "");
+
+        explicit ChunkedSeries(Series const &series);
+
+        [[nodiscard]] std::shared_ptr<arrow::ChunkedArray> values() const { return m_values; }
+
+        [[nodiscard]] std::shared_ptr<arrow::ChunkedArray> index() const { return m_index; }
+
+        [[nodiscard]] std::string name() const { return m_name; }
+
+        [[nodiscard]] int64_t size() const { return m_values->length(); }
+
+        [[nodiscard]] int num_chunks() const { return m_values->num_chunks(); }
+
+        [[nodiscard]] std::shared_ptr<arrow::DataType> dtype() const { return m_values->type(); }
+
+        /// the i'th chunk as a Series, without copying its values
+        [[nodiscard]] Series chunk(int i) const;
+
+        [[nodiscard]] ChunkedSeries slice(int64_t offset, int64_t length) const;
+
+        [[nodiscard]] ChunkedSeries slice(int64_t offset) const { return slice(offset, size() - offset); }
+
+        [[nodiscard]] Series combine() const;
+
+        //<editor-fold desc="Elementwise">
+        ChunkedSeries operator+(ChunkedSeries const &other) const { return call("add", other.m_values); }
+        ChunkedSeries operator-(ChunkedSeries const &other) const { return call("subtract", other.m_values); }
+        ChunkedSeries operator*(ChunkedSeries const &other) const { return call("multiply", other.m_values); }
+        ChunkedSeries operator/(ChunkedSeries const &other) const { return call("divide", other.m_values); }
+        ChunkedSeries operator>(ChunkedSeries const &other) const { return call("greater", other.m_values); }
+        ChunkedSeries operator>=(ChunkedSeries const &other) const { return call("greater_equal", other.m_values); }
+        ChunkedSeries operator<(ChunkedSeries const &other) const { return call("less", other.m_values); }
+        ChunkedSeries operator<=(ChunkedSeries const &other) const { return call("less_equal", other.m_values); }
+        ChunkedSeries operator==(ChunkedSeries const &other) const { return call("equal", other.m_values); }
+        ChunkedSeries operator!=(ChunkedSeries const &other) const { return call("not_equal", other.m_values); }
+        ChunkedSeries operator&(ChunkedSeries const &other) const { return call("and_kleene", other.m_values); }
+        ChunkedSeries operator|(ChunkedSeries const &other) const { return call("or_kleene", other.m_values); }
+
+        ChunkedSeries operator+(Scalar const &other) const { return call("add", other.value()); }
+        ChunkedSeries operator-(Scalar const &other) const { return call("subtract", other.value()); }
+        ChunkedSeries operator*(Scalar const &other) const { return call("multiply", other.value()); }
+        ChunkedSeries operator/(Scalar const &other) const { return call("divide", other.value()); }
+        ChunkedSeries operator>(Scalar const &other) const { return call("greater", other.value()); }
+        ChunkedSeries operator>=(Scalar const &other) const { return call("greater_equal", other.value()); }
+        ChunkedSeries operator<(Scalar const &other) const { return call("less", other.value()); }
+        ChunkedSeries operator<=(Scalar const &other) const { return call("less_equal", other.value()); }
+        ChunkedSeries operator==(Scalar const &other) const { return call("equal", other.value()); }
+        ChunkedSeries operator!=(Scalar const &other) const { return call("not_equal", other.value()); }
+
+        /// any scalar arrow function of this series and other, e.g. "power" or "atan2"
+        [[nodiscard]] ChunkedSeries call(std::string const &function, arrow::Datum const &other) const;
+
+        [[nodiscard]] ChunkedSeries call(std::string const &function,
+                                         arrow::compute::FunctionOptions const *options = nullptr) const;
+        //</editor-fold>
+
+        /// rows where mask is true; nulls in the mask drop the row
+        [[nodiscard]] ChunkedSeries filter(ChunkedSeries const &mask) const;
+
+        //<editor-fold desc="Aggregations">
+        [[nodiscard]] Scalar sum(bool skip_null = true) const;
+        [[nodiscard]] Scalar mean(bool skip_null = true) const;
+        [[nodiscard]] Scalar min(bool skip_null = true) const;
+        [[nodiscard]] Scalar max(bool skip_null = true) const;
+        [[nodiscard]] Scalar std(int ddof = 1, bool skip_null = true) const;
+        [[nodiscard]] Scalar var(int ddof = 1, bool skip_null = true) const;
+        /// number of valid values
+        [[nodiscard]] int64_t count() const { return size() - m_values->null_count(); }
+        //</editor-fold>
+
+    private:
+        std::shared_ptr<arrow::ChunkedArray> m_values;
+        std::shared_ptr<arrow::ChunkedArray> m_index;
+        std::string m_name;
+
+        [[nodiscard]] Scalar aggregate(std::string const &function, arrow::compute::FunctionOptions const &options) const;
+    };
+
+    class ChunkedGroupBy;
+
+    /// DataFrame over an arrow::Table whose columns keep the chunks they were read or appended with.
+    /// Multi batch parquet and csv files, appends and row concatenation never copy into contiguous memory;
+    /// batches() hands the chunks to code written for DataFrame, combine() is the explicit contiguous copy.
+    class ChunkedFrame {
+    public:
+        explicit ChunkedFrame(TablePtr table, std::shared_ptr<arrow::ChunkedArray> index = nullptr);
+
+        explicit ChunkedFrame(DataFrame const &df);
+
+        /// the frames become the chunks, only columns of differing type are cast (see Concatenator)
+        static ChunkedFrame fromFrames(std::vector<DataFrame> const &frames, JoinType join = JoinType::Outer);
+
+        static ChunkedFrame readParquet(std::filesystem::path const &path,
+                                        std::vector<std::string> const &dictionaryColumns = {});
+
+        static ChunkedFrame readCSV(std::filesystem::path const &path);
+
+        [[nodiscard]] TablePtr table() const { return m_table; }
+
+        [[nodiscard]] std::shared_ptr<arrow::ChunkedArray> index() const { return m_index; }
+
+        [[nodiscard]] int64_t num_rows() const { return m_table->num_rows(); }
+
+        [[nodiscard]] int64_t num_columns() const { return m_table->num_columns(); }
+
+        [[nodiscard]] std::vector<std::string> columnNames() const { return m_table->ColumnNames(); }
+
+        [[nodiscard]] ChunkedSeries operator[](std::string const &column) const;
+
+        [[nodiscard]] ChunkedFrame operator[](std::vector<std::string> const &columns) const;
+
+        /// one frame per run of rows that no column splits, each a view into the chunks
+        [[nodiscard]] std::vector<DataFrame> batches() const;
+
+        [[nodiscard]] ChunkedFrame slice(int64_t offset, int64_t length) const;
+
+        [[nodiscard]] ChunkedFrame filter(ChunkedSeries const &mask) const;
+
+        /// the chunks of other are added after these ones, both frames need the same schema
+        [[nodiscard]] ChunkedFrame append(ChunkedFrame const &other) const;
+
+        [[nodiscard]] ChunkedFrame append(DataFrame const &other) const { return append(ChunkedFrame{other}); }
+
+        //<editor-fold desc="Aggregations">
+        /// one value per column, indexed by column name
+        [[nodiscard]] Series sum(bool skip_null = true) const;
+        [[nodiscard]] Series mean(bool skip_null = true) const;
+        [[nodiscard]] Series min(bool skip_null = true) const;
+        [[nodiscard]] Series max(bool skip_null = true) const;
+        [[nodiscard]] Series count() const;
+        //</editor-fold>
+
+        [[nodiscard]] ChunkedGroupBy group_by(std::string const &key) const;
+
+        [[nodiscard]] DataFrame combine() const;
+
+    private:
+        TablePtr m_table;
+        std::shared_ptr<arrow::ChunkedArray> m_index;
+
+        [[nodiscard]] std::shared_ptr<arrow::ChunkedArray> positions() const;
+
+        [[nodiscard]] Series columnwise(std::string const &function,
+                                        arrow::compute::FunctionOptions const &options,
+                                        bool numericOnly) const;
+    };
+
+    /// Hash grouping of a ChunkedFrame by one key column. Keys are encoded chunk by chunk with one
+    /// arrow Grouper, then every numeric column is reduced in parallel without gathering the groups.
+    /// Results are indexed by the distinct keys in order of first appearance.
+    class ChunkedGroupBy {
+    public:
+        enum class Reduction { Sum, Mean, Min, Max, Count };
+
+        ChunkedGroupBy(ChunkedFrame const &frame, std::string key);
+
+        [[nodiscard]] int64_t groupSize() const { return m_uniqueKeys->length(); }
+
+        [[nodiscard]] ArrayPtr unique() const { return m_uniqueKeys; }
+
+        [[nodiscard]] DataFrame sum() const;
+        [[nodiscard]] DataFrame mean() const;
+        [[nodiscard]] DataFrame min() const;
+        [[nodiscard]] DataFrame max() const;
+        [[nodiscard]] DataFrame count() const;
+
+    private:
+        std::string m_key;
+        std::vector<std::shared_ptr<arrow::RecordBatch>> m_batches;
+        std::vector<std::shared_ptr<arrow::UInt32Array>> m_groupIds;
+        ArrayPtr m_uniqueKeys;
+
+        [[nodiscard]] DataFrame reduce(Reduction reduction) const;
+    };
+}
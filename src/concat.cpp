@@ -3,9 +3,14 @@
 //
 #include <climits>
 #include "concat.h"
-#include <tbb/parallel_for.h>
+#include <arrow/array/concatenate.h>
+#include <arrow/util/bitmap_ops.h>
+#include <cstring>
+#include <unordered_set>
 #include "dataframe.h"
+#include "scheduler.h"
 #include "series.h"
+#include "tracing.h"
 
 
 namespace pd {
@@ -61,7 +66,7 @@ ArrayPtr Concatenator::makeConcatIndex(std::vector<pd::DataFrame> const& objs, A
         ArrayPtr newIndex = pd::range(0UL, totalSize);
         if (axis == AxisType::Columns)
         {
-            return arrow::compute::Cast(newIndex, arrow::utf8())->make_array();
+            return ReturnOrThrowOnFailure(pd::Cast(newIndex, arrow::utf8())).make_array();
         }
         return newIndex;
     }
@@ -70,7 +75,7 @@ ArrayPtr Concatenator::makeConcatIndex(std::vector<pd::DataFrame> const& objs, A
         arrow::ArrayVector indexes;
 
         std::ranges::transform(objs, std::back_inserter(indexes), selectIndex);
-        auto result = ReturnOrThrowOnFailure(arrow::Concatenate(indexes));
+        auto result = ReturnOrThrowOnFailure(arrow::Concatenate(indexes, pd::GetMemoryPool()));
         return result;
     }
 }
@@ -105,7 +110,11 @@ std::unordered_map<std::string, std::pair<std::vector<int>, std::shared_ptr<arro
             else
             {
                 result[fieldName].first.push_back(i);
-                result[fieldName].second = promoteTypes({ result[fieldName].second, field->type() });
+                // identical types, categoricals included, are concatenated as they are
+                if (not result[fieldName].second->Equals(field->type()))
+                {
+                    result[fieldName].second = promoteTypes({ result[fieldName].second, field->type() });
+                }
             }
         }
         i++;
@@ -113,50 +122,181 @@ std::unordered_map<std::string, std::pair<std::vector<int>, std::shared_ptr<arro
     return result;
 }
 
-pd::DataFrame Concatenator::concatenateRows() {
-
+std::vector<Concatenator::ColumnPieces> Concatenator::alignColumns() const
+{
     auto newDataTypes = resolveDuplicateFieldName(objs);
-    for (auto const &[field, value]: newDataTypes) {
-        if (value.first.size() > 1) {
-            auto const &new_type = value.second;
-            for (auto const &idx: value.first) {
-                auto recordBatch = objs.at(idx).array();
-                auto field_index = recordBatch->schema()->GetFieldIndex(field);
-                auto casted = arrow::compute::Cast(recordBatch->column(field_index), new_type)->make_array();
-                objs.at(idx) =
-                        DataFrame{pd::ReturnOrThrowOnFailure(
-                                recordBatch->SetColumn(field_index, arrow::field(field, new_type), casted)),
-                                  objs.at(idx).indexArray()};
+
+    std::vector<std::string> order;
+    std::unordered_set<std::string> seen;
+    for (auto const& obj : objs)
+    {
+        for (auto const& name : obj.array()->schema()->field_names())
+        {
+            if (seen.insert(name).second)
+            {
+                order.push_back(name);
             }
         }
     }
 
-    // Convert DataFrames to tables
-    auto unique_index = std::to_string(std::chrono::high_resolution_clock::now().time_since_epoch().count()) + "index";
-    std::vector<TablePtr> tables(objs.size());
+    std::vector<ColumnPieces> columns;
+    columns.reserve(order.size());
+    for (auto const& name : order)
+    {
+        auto const& [present, type] = newDataTypes.at(name);
+        if (intersect and present.size() != objs.size())
+        {
+            continue;
+        }
 
-    std::ranges::transform(
-            objs,
-            tables.begin(),
-            [&unique_index](auto const &obj) { return obj.toTable(unique_index); });
+        arrow::ArrayVector pieces(objs.size());
+        for (auto const& i : present)
+        {
+            auto column = objs[i].array()->GetColumnByName(name);
+            if (column and not column->type()->Equals(type))
+            {
+                auto options = arrow::compute::CastOptions::Safe(type);
+                column = ReturnOrThrowOnFailure(pd::CallFunction("cast", { column }, &options)).make_array();
+            }
+            pieces[i] = column;
+        }
+        columns.emplace_back(arrow::field(name, type), std::move(pieces));
+    }
+    return columns;
+}
 
-    // Define merge options for columns in case of name conflicts
-    arrow::Field::MergeOptions merge_options;
-    merge_options.promote_nullability = true; // Rename conflicting columns
+namespace {
+std::shared_ptr<arrow::Buffer> allocateRows(int64_t bytes)
+{
+    return ReturnOrThrowOnFailure(arrow::AllocateBuffer(bytes, pd::GetMemoryPool()));
+}
+
+void copyBits(ArrayPtr const& piece, int bufferIndex, int64_t length, uint8_t* dest, int64_t destOffset)
+{
+    if (not piece)
+    {
+        arrow::bit_util::SetBitsTo(dest, destOffset, length, false);
+    }
+    else if (bufferIndex == 0 and piece->null_count() == 0)
+    {
+        arrow::bit_util::SetBitsTo(dest, destOffset, length, true);
+    }
+    else
+    {
+        arrow::internal::CopyBitmap(
+            piece->data()->buffers[bufferIndex]->data(), piece->offset(), length, dest, destOffset);
+    }
+}
+} // namespace
+
+pd::DataFrame Concatenator::concatenateRows()
+{
+    PD_TRACE_SCOPE("concat::rows");
+
+    auto columns = alignColumns();
 
-    // Concatenate tables
-    arrow::ConcatenateTablesOptions options;
-    options.unify_schemas = true; // Automatically merge schemas of tables
-    options.field_merge_options = merge_options; // Use defined merge options for columns
+    std::vector<int64_t> rowOffset(objs.size() + 1, 0);
+    for (size_t i = 0; i < objs.size(); i++)
+    {
+        rowOffset[i + 1] = rowOffset[i] + objs[i].num_rows();
+    }
+    const int64_t length = rowOffset.back();
 
-    auto table = pd::ReturnOrThrowOnFailure(arrow::ConcatenateTables(tables, options));
+    // every output column is allocated once at its final length, then filled in place
+    arrow::FieldVector fields(columns.size());
+    arrow::ArrayDataVector outputs(columns.size());
+    std::vector<std::pair<size_t, size_t>> fixedWidthCopies;
+    for (size_t c = 0; c < columns.size(); c++)
+    {
+        auto const& [field, pieces] = columns[c];
+        fields[c] = field;
 
-    auto merged_rb = pd::ReturnOrThrowOnFailure(table->CombineChunksToBatch());
+        int64_t nullCount = 0;
+        for (size_t i = 0; i < objs.size(); i++)
+        {
+            nullCount += pieces[i] ? pieces[i]->null_count() : rowOffset[i + 1] - rowOffset[i];
+        }
 
-    auto index_column_i = merged_rb->schema()->GetFieldIndex(unique_index);
-    auto index = merged_rb->column(index_column_i);
+        if (const int width = fixedByteWidth(*field->type()))
+        {
+            auto validity = nullCount > 0 ? allocateRows(arrow::bit_util::BytesForBits(length)) : nullptr;
+            outputs[c] = arrow::ArrayData::Make(field->type(), length, { validity, allocateRows(length * width) }, nullCount);
+            for (size_t i = 0; i < objs.size(); i++)
+            {
+                fixedWidthCopies.emplace_back(c, i);
+            }
+        }
+        else if (field->type()->id() == arrow::Type::BOOL)
+        {
+            auto validity = nullCount > 0 ? allocateRows(arrow::bit_util::BytesForBits(length)) : nullptr;
+            outputs[c] = arrow::ArrayData::Make(
+                field->type(), length, { validity, allocateRows(arrow::bit_util::BytesForBits(length)) }, nullCount);
+        }
+    }
 
-    merged_rb = pd::ReturnOrThrowOnFailure(merged_rb->RemoveColumn(index_column_i));
+    // values of fixed width columns are copied per (column, input); bitmaps and variable width columns are handled
+    // per column since neighbouring inputs can share a byte of the output bitmap
+    pd::parallel_for(
+        size_t{ 0 },
+        fixedWidthCopies.size(),
+        pd::bindExecContext(
+            [&](size_t task)
+            {
+                auto [c, i] = fixedWidthCopies[task];
+                auto const& piece = columns[c].second[i];
+                const int width = fixedByteWidth(*columns[c].first->type());
+                const int64_t rows = rowOffset[i + 1] - rowOffset[i];
+                auto* dest = outputs[c]->buffers[1]->mutable_data() + rowOffset[i] * width;
+                if (piece)
+                {
+                    std::memcpy(dest, piece->data()->buffers[1]->data() + piece->offset() * width, rows * width);
+                }
+                else
+                {
+                    std::memset(dest, 0, rows * width);
+                }
+            }));
+
+    pd::parallel_for(
+        size_t{ 0 },
+        columns.size(),
+        pd::bindExecContext(
+            [&](size_t c)
+            {
+                auto const& [field, pieces] = columns[c];
+                if (not outputs[c])
+                {
+                    arrow::ArrayVector filled(pieces.size());
+                    for (size_t i = 0; i < pieces.size(); i++)
+                    {
+                        filled[i] = pieces[i] ? pieces[i] :
+                                                ReturnOrThrowOnFailure(arrow::MakeArrayOfNull(
+                                                    field->type(), rowOffset[i + 1] - rowOffset[i], pd::GetMemoryPool()));
+                    }
+                    outputs[c] = ReturnOrThrowOnFailure(arrow::Concatenate(filled, pd::GetMemoryPool()))->data();
+                    return;
+                }
+
+                auto& data = *outputs[c];
+                for (size_t i = 0; i < pieces.size(); i++)
+                {
+                    const int64_t rows = rowOffset[i + 1] - rowOffset[i];
+                    if (data.buffers[0])
+                    {
+                        copyBits(pieces[i], 0, rows, data.buffers[0]->mutable_data(), rowOffset[i]);
+                    }
+                    if (field->type()->id() == arrow::Type::BOOL and pieces[i])
+                    {
+                        copyBits(pieces[i], 1, rows, data.buffers[1]->mutable_data(), rowOffset[i]);
+                    }
+                    else if (field->type()->id() == arrow::Type::BOOL)
+                    {
+                        arrow::bit_util::SetBitsTo(data.buffers[1]->mutable_data(), rowOffset[i], rows, false);
+                    }
+                }
+            }));
+
+    auto merged_rb = arrow::RecordBatch::Make(arrow::schema(fields), length, outputs);
 
     //    if (sort)
     //    {
@@ -172,34 +312,50 @@ pd::DataFrame Concatenator::concatenateRows() {
     //                            ->array_as<arrow::StringArray>();
     //    }
 
-    if (intersect) {
-        auto column_names = merged_rb->schema()->field_names();
-        for (auto const &name: column_names) {
-            auto i = merged_rb->schema()->GetFieldIndex(name);
-            if (merged_rb->column(i)->null_count() > 0) {
-                merged_rb = merged_rb->RemoveColumn(i).MoveValueUnsafe();
-            }
-        }
+    if (ignore_index)
+    {
+        return pd::DataFrame{ merged_rb };
     }
+    return pd::DataFrame{ merged_rb, makeConcatIndex(objs, AxisType::Index, false) };
+}
 
-    if (ignore_index) {
-        return pd::DataFrame{merged_rb};
-    } else {
-        return pd::DataFrame{merged_rb, index};
+TablePtr Concatenator::concatenateRowChunks()
+{
+    PD_TRACE_SCOPE("concat::row_chunks");
+
+    auto columns = alignColumns();
+    arrow::FieldVector fields;
+    arrow::ChunkedArrayVector chunks;
+    fields.reserve(columns.size());
+    chunks.reserve(columns.size());
+    for (auto& [field, pieces] : columns)
+    {
+        for (size_t i = 0; i < pieces.size(); i++)
+        {
+            if (not pieces[i])
+            {
+                pieces[i] = ReturnOrThrowOnFailure(
+                    arrow::MakeArrayOfNull(field->type(), objs[i].num_rows(), pd::GetMemoryPool()));
+            }
+        }
+        fields.push_back(field);
+        chunks.push_back(std::make_shared<arrow::ChunkedArray>(std::move(pieces), field->type()));
     }
+    return arrow::Table::Make(arrow::schema(fields), chunks);
 }
 
 pd::DataFrame Concatenator::concatenateColumns()
 {
+    PD_TRACE_SCOPE("concat::columns");
     auto newIndexes = mergeIndexes(makeJoinIndexes(objs, AxisType::Columns), intersect);
     const size_t numRows = newIndexes->length();
 
     if (sort)
     {
-        auto sort_indices =
-            ReturnOrThrowOnFailure(arrow::compute::SortIndices(newIndexes, arrow::compute::SortOptions{}));
+        arrow::compute::SortOptions options{};
+        auto sort_indices = ReturnOrThrowOnFailure(pd::CallFunction("sort_indices", { newIndexes }, &options));
 
-        newIndexes = arrow::compute::Take(newIndexes, sort_indices)->make_array();
+        newIndexes = ReturnOrThrowOnFailure(pd::CallFunction("take", { newIndexes, sort_indices })).make_array();
     }
 
 
@@ -218,10 +374,10 @@ pd::DataFrame Concatenator::concatenateColumns()
     arrow::FieldVector fieldVector(newColumnLength);
     arrow::ArrayDataVector arrayVectors(newColumnLength);
 
-    tbb::parallel_for(
+    pd::parallel_for(
         0UL,
         objs.size(),
-        [&](size_t i)
+        pd::bindExecContext([&](size_t i)
         {
             auto& obj = objs[i];
             if (!obj.indexArray()->Equals(newIndexes))
@@ -230,7 +386,7 @@ pd::DataFrame Concatenator::concatenateColumns()
             }
             std::ranges::copy(obj.array()->schema()->fields(), fieldVector.begin() + index_offset[i]);
             std::ranges::copy(obj.array()->column_data(), arrayVectors.begin() + index_offset[i]);
-        });
+        }));
 
     if (ignore_index)
     {
@@ -243,31 +399,31 @@ pd::DataFrame Concatenator::concatenateColumns()
     return { arrow::schema(fieldVector), static_cast<int64_t>(numRows), arrayVectors, newIndexes };
 }
 
-pd::DataFrame concatColumnsUnsafe(std::vector<pd::DataFrame> const& objs) {
-  if (objs.empty()) {
-    return pd::DataFrame{};
-  }
-
-  auto df = objs.at(0).array();
-  auto N = df->num_columns();
-
-  for (size_t i = 1; i < objs.size(); i++) {
-    for (auto const &field : objs[i].array()->schema()->fields()) {
-      auto result = df->AddColumn(N++, field, objs[i][field->name()].m_array);
-      if (result.ok()) {
-        df = result.MoveValueUnsafe();
-      } else {
-        std::cerr << df->ToString() << "\nLength: " << df->num_rows()
-                  << "\nNewColumn: "
-                  << objs[i][field->name()].m_array->ToString()
-                  << "\nNew Column Length: "
-                  << objs[i][field->name()].m_array->length()
-                  << "\nField: " << field->name() << "\n";
-        throw std::runtime_error(result.status().ToString());
-      }
+pd::DataFrame concatColumnsUnsafe(std::vector<pd::DataFrame> const& objs)
+{
+    if (objs.empty())
+    {
+        return pd::DataFrame{};
+    }
+
+    // the schema is built once instead of once per added column
+    auto const& first = objs.at(0).array();
+    arrow::FieldVector fields;
+    arrow::ArrayVector columns;
+    for (auto const& obj : objs)
+    {
+        auto const& batch = obj.array();
+        if (batch->num_rows() != first->num_rows())
+        {
+            throw std::runtime_error(
+                "concatColumnsUnsafe: columns " + batch->schema()->ToString() + " have " +
+                std::to_string(batch->num_rows()) + " rows, expected " + std::to_string(first->num_rows()));
+        }
+        std::ranges::copy(batch->schema()->fields(), std::back_inserter(fields));
+        std::ranges::copy(batch->columns(), std::back_inserter(columns));
     }
-  }
-  return pd::DataFrame{df, objs.at(0).indexArray()};
+    return pd::DataFrame{ arrow::RecordBatch::Make(arrow::schema(fields), first->num_rows(), columns),
+                          objs.at(0).indexArray() };
 }
 
-} // namespace pd
\ No newline at end of file
+} // namespace pd
@@ -37,6 +37,10 @@ struct Concatenator
 
     pd::DataFrame concatenateRows();
 
+    /// rows of all inputs as chunked columns, one chunk per input. Nothing is copied except columns that need a
+    /// cast to the unified type or are missing from an input
+    TablePtr concatenateRowChunks();
+
     pd::DataFrame concatenateColumns();
 
     static ArrayPtr mergeIndexes(arrow::ArrayVector const& indexes, bool intersect);
@@ -47,6 +51,12 @@ struct Concatenator
     resolveDuplicateFieldName(std::vector<pd::DataFrame> const& objs);
 
 private:
+    using ColumnPieces = std::pair<std::shared_ptr<arrow::Field>, arrow::ArrayVector>;
+
+    /// unified schema in order of first appearance, with the column of every input cast to the unified type
+    /// (nullptr where an input lacks it)
+    std::vector<ColumnPieces> alignColumns() const;
+
     std::vector<pd::DataFrame> objs{};
     bool intersect{};
     bool ignore_index{};
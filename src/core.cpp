@@ -3,6 +3,7 @@
 //
 #include "core.h"
 #include <future>
+#include "calendar.h"
 #include "arrow/compute/exec.h"
 #include "dataframe.h"
 #include "group_by.h"
@@ -52,6 +53,10 @@ date DateOffset::add(date currentDate, const DateOffset& dateOffset)
             currentDate = date(currentDate.year(), Jan, 1);
             break;
 
+        case BusinessDay:
+            currentDate = BusinessCalendar{}.add(currentDate, dateOffset.multiplier);
+            break;
+
         default:
             currentDate += days(dateOffset.multiplier);
     }
@@ -68,6 +73,10 @@ std::optional<DateOffset> DateOffset::FromString(const std::string& code)
     {
         type = DateOffset::Day;
     }
+    else if (freq_unit == "B")
+    {
+        type = DateOffset::BusinessDay;
+    }
     else if (freq_unit == "WS")
     {
         type = DateOffset::WeekStart;
@@ -171,65 +180,112 @@ arrow::compute::CalendarUnit getCalendarUnit(char start_unit) {
     return unit;
 }
 
-template<class Iterator = day_iterator, typename FreqTime = int>
-std::shared_ptr<arrow::TimestampArray> date_range(
-    date const& start,
-    date const& end,
-    FreqTime freq = 1,
-    std::string const& tz = "")
+// element i of a calendar range is start + i steps: a fixed number of days, or of months
+// stepped like boost's month_iterator, or of sessions of the weekday calendar
+struct CalendarStep
 {
-    if (start >= end)
+    enum Kind
     {
-        throw std::runtime_error("start date has to be less than end date");
-    }
+        Days,
+        Months,
+        Sessions
+    } kind;
+    int64_t size;
+};
 
-    if (freq < 1)
+static int64_t stepLength(date const& start, date const& end, CalendarStep const& step)
+{
+    const int64_t first = toDays(start), last = toDays(end);
+    switch (step.kind)
     {
-        throw std::runtime_error("FREQ must be >= 1");
+        case CalendarStep::Days:
+            return (last - first) / step.size + 1;
+        case CalendarStep::Months:
+        {
+            const CivilDate civil{ start.year(), start.month(), start.day() };
+            const int64_t months = (int64_t(end.year()) - start.year()) * 12 + end.month() - start.month();
+            int64_t length = months / step.size + 1;
+            while (length > 0 and addMonths(civil, (length - 1) * step.size) > last)
+            {
+                length--;
+            }
+            return length;
+        }
+        case CalendarStep::Sessions:
+            break;
     }
+    throw std::runtime_error("session ranges are generated by BusinessCalendar");
+}
 
-    auto N = size_t(std::round(double(date_period(start, end).length().days()) / double(freq)));
-    std::vector<int64_t> timestamps;
-    timestamps.reserve(N);
-
-    for (auto it = Iterator(start, freq); it <= end; ++it)
+static std::shared_ptr<arrow::TimestampArray> calendarRange(
+    date const& start,
+    int64_t length,
+    CalendarStep const& step,
+    std::string const& tz)
+{
+    const int64_t first = toDays(start);
+    switch (step.kind)
     {
-        timestamps.push_back(fromDate(*it));
+        case CalendarStep::Days:
+            return generateTimestamps(
+                length, [=](int64_t i) { return (first + i * step.size) * NANOS_PER_DAY; }, tz);
+        case CalendarStep::Months:
+        {
+            const CivilDate civil{ start.year(), start.month(), start.day() };
+            return generateTimestamps(
+                length, [=](int64_t i) { return addMonths(civil, i * step.size) * NANOS_PER_DAY; }, tz);
+        }
+        case CalendarStep::Sessions:
+        {
+            // every step.size-th session of the weekday calendar
+            BusinessCalendar calendar;
+            std::vector<date> days(length);
+            auto day = calendar.rollForward(start);
+            for (auto& d : days)
+            {
+                d = day;
+                day = calendar.add(day, int(step.size));
+            }
+            return generateTimestamps(length, [&](int64_t i) { return toDays(days[i]) * NANOS_PER_DAY; }, tz);
+        }
     }
+    return { nullptr };
+}
 
-    return toDateTime(timestamps, arrow::TimeUnit::NANO, tz);
+static std::shared_ptr<arrow::TimestampArray> calendarRange(
+    date const& start,
+    date const& end,
+    CalendarStep const& step,
+    std::string const& tz)
+{
+    if (start >= end)
+    {
+        throw std::runtime_error("start date has to be less than end date");
+    }
+    if (step.kind == CalendarStep::Sessions)
+    {
+        BusinessCalendar calendar;
+        int64_t length = 0;
+        for (auto day = calendar.rollForward(start); day <= end; day = calendar.add(day, int(step.size)))
+        {
+            length++;
+        }
+        return calendarRange(start, length, step, tz);
+    }
+    return calendarRange(start, stepLength(start, end, step), step, tz);
 }
 
-template<class Iterator = day_iterator, typename FreqTime = int>
-std::shared_ptr<arrow::TimestampArray> date_range(
+static std::shared_ptr<arrow::TimestampArray> calendarRange(
     date const& start,
     int period,
-    FreqTime freq,
-    std::string const& /*unused*/)
+    CalendarStep const& step,
+    std::string const& tz)
 {
     if (period < 0)
     {
         throw std::runtime_error("period has to be positive");
     }
-    if (freq < 1)
-    {
-        throw std::runtime_error("FREQ must be >= 1");
-    }
-
-    Iterator it(start, freq);
-
-    std::vector<int64_t> timestamps(period);
-
-    std::generate_n(
-        timestamps.begin(),
-        period,
-        [&it]()
-        {
-            auto result = fromDate(*it);
-            ++it;
-            return result;
-        });
-    return toDateTime(timestamps);
+    return calendarRange(start, int64_t(period), step, tz);
 }
 
 std::shared_ptr<arrow::TimestampArray> switchFunction(
@@ -237,29 +293,34 @@ std::shared_ptr<arrow::TimestampArray> switchFunction(
     auto const& end_or_period,
     const DateOffset& freq,
     std::string const& tz) {
+    if (freq.multiplier < 1) {
+        throw std::runtime_error("FREQ must be >= 1");
+    }
     switch (freq.type) {
         case DateOffset::Day:
-            return date_range<day_iterator>(start, end_or_period, freq.multiplier, tz);
+            return calendarRange(start, end_or_period, {CalendarStep::Days, freq.multiplier}, tz);
+        case DateOffset::BusinessDay:
+            return calendarRange(start, end_or_period, {CalendarStep::Sessions, freq.multiplier}, tz);
         case DateOffset::MonthEnd:
             throw std::runtime_error("MonthEnd not supported use arrow month().groupby()");
         case DateOffset::MonthStart:
-            return date_range<month_iterator>(start, end_or_period, freq.multiplier, tz);
+            return calendarRange(start, end_or_period, {CalendarStep::Months, freq.multiplier}, tz);
         case DateOffset::QuarterStart: {
             if (start.month() / 3 != 0) {
                 throw std::runtime_error("A quarter freq requires month is on a quarter, +/- with DateOffset");
             }
-            return date_range<month_iterator>(start, end_or_period, freq.multiplier * 3, tz);
+            return calendarRange(start, end_or_period, {CalendarStep::Months, freq.multiplier * 3}, tz);
         }
         case DateOffset::QuarterEnd:
             throw std::runtime_error("QuarterEnd not supported use arrow quarter().groupby()");
         case DateOffset::WeekEnd:
             throw std::runtime_error("WeekEnd not supported use arrow weeks().groupby()");
         case DateOffset::WeekStart:
-            return date_range<week_iterator>(start, end_or_period, freq.multiplier, tz);
+            return calendarRange(start, end_or_period, {CalendarStep::Days, freq.multiplier * 7}, tz);
         case DateOffset::YearEnd:
             throw std::runtime_error("YearEnd not supported use arrow year().groupby()");
         case DateOffset::YearStart:
-            return date_range<year_iterator>(start, end_or_period, freq.multiplier, tz);
+            return calendarRange(start, end_or_period, {CalendarStep::Months, freq.multiplier * 12}, tz);
     }
     return {nullptr};
 }
@@ -321,13 +382,9 @@ std::shared_ptr<arrow::TimestampArray> date_range(
         throw std::runtime_error("FREQ must be positive");
     }
 
-    std::vector<int64_t> timestamps;
-    for (auto it = time_iterator(start, freq); it <= end; ++it)
-    {
-        timestamps.push_back(fromPTime(*it));
-    }
-
-    return toDateTime(timestamps, arrow::TimeUnit::NANO, tz);
+    const int64_t first = fromPTime(start), step = freq.total_nanoseconds();
+    const int64_t length = (fromPTime(end) - first) / step + 1;
+    return generateTimestamps(length, [=](int64_t i) { return first + i * step; }, tz);
 }
 
 std::shared_ptr<arrow::TimestampArray> date_range(
@@ -346,20 +403,8 @@ std::shared_ptr<arrow::TimestampArray> date_range(
         throw std::runtime_error("FREQ must be positive");
     }
 
-    time_iterator it(start, freq);
-    std::vector<int64_t> timestamps(period);
-
-    std::generate_n(
-        timestamps.begin(),
-        period,
-        [it]() mutable
-        {
-            auto result = fromPTime(*it);
-            ++it;
-            return result;
-        });
-
-    return toDateTime(timestamps, arrow::TimeUnit::NANO, tz);
+    const int64_t first = fromPTime(start), step = freq.total_nanoseconds();
+    return generateTimestamps(period, [=](int64_t i) { return first + i * step; }, tz);
 }
 
 std::shared_ptr<arrow::TimestampArray> date_range(
@@ -401,12 +446,12 @@ std::shared_ptr<arrow::TimestampArray> date_range(
 std::shared_ptr<arrow::Int64Array> range(int64_t start, int64_t end)
 {
     const int64_t length = (end - start);
-    arrow::Int64Builder builder;
+    arrow::Int64Builder builder(pd::GetMemoryPool());
 
     pd::ThrowOnFailure(builder.Reserve(length));
     for(int64_t i = 0; i < length; i++)
     {
-        builder.UnsafeAppend(i);
+        builder.UnsafeAppend(start + i);
     }
     return dynamic_pointer_cast<arrow::Int64Array>(builder.Finish().MoveValueUnsafe());
 }
@@ -414,12 +459,12 @@ std::shared_ptr<arrow::Int64Array> range(int64_t start, int64_t end)
 std::shared_ptr<arrow::UInt64Array> range(uint64_t start, uint64_t end)
 {
     const uint64_t length = (end - start);
-    arrow::UInt64Builder builder;
+    arrow::UInt64Builder builder(pd::GetMemoryPool());
 
     pd::ThrowOnFailure(builder.Reserve(length));
     for(uint64_t i = 0; i < length; i++)
     {
-        builder.UnsafeAppend(i);
+        builder.UnsafeAppend(start + i);
     }
     return dynamic_pointer_cast<arrow::UInt64Array>(builder.Finish().MoveValueUnsafe());
 }
@@ -433,7 +478,7 @@ std::shared_ptr<arrow::Array> combineIndexes(std::vector<Series::ArrayType> cons
         return range(0UL, std::accumulate(idx_len.begin(), idx_len.end(), 0UL));
     }
 
-    auto result = arrow::Concatenate(indexes);
+    auto result = arrow::Concatenate(indexes, pd::GetMemoryPool());
     if (result.ok())
         return result.MoveValueUnsafe();
 
@@ -483,6 +528,16 @@ std::shared_ptr<arrow::DataType> promoteTypes(const std::vector<std::shared_ptr<
 
     return common_type;
 }
+
+int fixedByteWidth(arrow::DataType const& type)
+{
+    if (type.id() == arrow::Type::BOOL or type.id() == arrow::Type::DICTIONARY)
+    {
+        return 0;
+    }
+    auto const* fixed = dynamic_cast<arrow::FixedWidthType const*>(&type);
+    return fixed and fixed->bit_width() % 8 == 0 ? fixed->bit_width() / 8 : 0;
+}
 } // namespace pd
 std::shared_ptr<arrow::Array> arrow::ScalarArray::Make(const std::vector<pd::Scalar>& x)
 {
@@ -490,7 +545,7 @@ std::shared_ptr<arrow::Array> arrow::ScalarArray::Make(const std::vector<pd::Sca
     {
         return { nullptr };
     }
-    auto builder = arrow::MakeBuilder(x.back().value()->type).MoveValueUnsafe();
+    auto builder = arrow::MakeBuilder(x.back().value()->type, pd::GetMemoryPool()).MoveValueUnsafe();
 
     pd::ThrowOnFailure(builder->Reserve(x.size()));
 
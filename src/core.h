@@ -7,6 +7,7 @@
 #include "boost/date_time/local_time/local_time.hpp"//include all types plus i/o
 #include "boost/date_time/posix_time/posix_time.hpp"
 #include "chrono"
+#include "exec_context.h"
 #include "random.h"
 #include "ranges"
 #include <arrow/api.h>
@@ -129,7 +130,8 @@ struct DateOffset {
         WeekEnd,
         MonthStart,
         YearEnd,
-        YearStart
+        YearStart,
+        BusinessDay
     } type;
 
     int multiplier{1};
@@ -266,7 +268,7 @@ inline std::shared_ptr<arrow::TimestampArray> toDateTime(
     arrow::TimeUnit::type unit = arrow::TimeUnit::NANO,
     std::string const& tz = "")
 {
-    arrow::TimestampBuilder builder{ arrow::timestamp(unit, tz), arrow::default_memory_pool() };
+    arrow::TimestampBuilder builder{ arrow::timestamp(unit, tz), pd::GetMemoryPool() };
     pd::ThrowOnFailure(builder.AppendValues(timestamps));
     const auto array = pd::ReturnOrThrowOnFailure(builder.Finish());
     return dynamic_pointer_cast<arrow::TimestampArray>(array);
@@ -317,7 +319,12 @@ inline std::shared_ptr<arrow::TimestampArray> date_range(
     std::string const& freq = "1D",
     std::string const& tz = "")
 {
-    return date_range(start, end, *DateOffset::FromString(freq), tz);
+    auto offset = DateOffset::FromString(freq);
+    if (not offset)
+    {
+        throw std::runtime_error("invalid date_range freq " + freq);
+    }
+    return date_range(start, end, *offset, tz);
 }
 
 inline std::shared_ptr<arrow::TimestampArray> date_range(
@@ -384,6 +391,10 @@ inline std::shared_ptr<arrow::TimestampScalar> fromDateTime(ptime const& dt)
 
 std::shared_ptr<arrow::DataType> promoteTypes(std::vector<std::shared_ptr<arrow::DataType>> const& types);
 
+/// byte width of types stored as one buffer of equal sized values that can be memcpy'd, 0 for booleans,
+/// dictionaries and variable width layouts
+int fixedByteWidth(arrow::DataType const& type);
+
 const std::shared_ptr<arrow::DataType> TimestampTypePtr =
     std::make_shared<arrow::TimestampType>(arrow::TimeUnit::NANO, "");
 
@@ -402,14 +413,14 @@ namespace arrow {
     template<typename T>
     struct ArrayT {
         static auto Make(std::vector<T> const &x, std::vector<bool> const &map) {
-            auto builder = std::make_shared<typename arrow::CTypeTraits<T>::BuilderType>();
+            auto builder = std::make_shared<typename arrow::CTypeTraits<T>::BuilderType>(pd::GetMemoryPool());
             pd::ThrowOnFailure(builder->AppendValues(x, map));
             return std::dynamic_pointer_cast<typename arrow::CTypeTraits<T>::ArrayType>(
                     builder->Finish().MoveValueUnsafe());
         }
 
         static auto Make(std::vector<T> const &x) {
-            auto builder = std::make_shared<typename arrow::CTypeTraits<T>::BuilderType>();
+            auto builder = std::make_shared<typename arrow::CTypeTraits<T>::BuilderType>(pd::GetMemoryPool());
             if constexpr (std::is_floating_point_v<T>)
             {
                 return Make(x, pd::makeValidFlags(x));
@@ -420,7 +431,7 @@ namespace arrow {
         }
 
         static auto Make(std::valarray<T> const &x) {
-            auto builder = std::make_shared<typename arrow::CTypeTraits<T>::BuilderType>();
+            auto builder = std::make_shared<typename arrow::CTypeTraits<T>::BuilderType>(pd::GetMemoryPool());
             if constexpr (std::is_floating_point_v<T>)
             {
                 std::vector<bool> flags{x.size(), true};
@@ -446,7 +457,7 @@ namespace arrow {
                     throw std::runtime_error("Empty ScalarArray requires a valid data_Type is passed");
                 }
             }
-            auto builder = arrow::MakeBuilder(x.back()->type).MoveValueUnsafe();
+            auto builder = arrow::MakeBuilder(x.back()->type, pd::GetMemoryPool()).MoveValueUnsafe();
             pd::ThrowOnFailure(builder->AppendScalars(x));
             return builder->Finish().MoveValueUnsafe();
         }
@@ -462,7 +473,7 @@ namespace arrow {
         }
 
         static auto Make(std::vector<date> const &x, std::vector<bool> const &map) {
-            TimestampBuilder builder(std::make_shared<arrow::TimestampType>(arrow::TimeUnit::NANO), default_memory_pool());
+            TimestampBuilder builder(std::make_shared<arrow::TimestampType>(arrow::TimeUnit::NANO), pd::GetMemoryPool());
 
             std::vector<int64_t> ts(x.size());
             std::ranges::transform(x, ts.begin(), [](auto const &t) { return pd::fromDate(t); });
@@ -481,7 +492,7 @@ namespace arrow {
         }
 
         static std::shared_ptr<arrow::TimestampArray> Make(std::vector<ptime> const &x, std::vector<bool> const &map) {
-            TimestampBuilder builder(std::make_shared<arrow::TimestampType>(arrow::TimeUnit::NANO), default_memory_pool());
+            TimestampBuilder builder(std::make_shared<arrow::TimestampType>(arrow::TimeUnit::NANO), pd::GetMemoryPool());
 
             std::vector<int64_t> ts(x.size());
             std::ranges::transform(x, ts.begin(), [](auto const &t) { return pd::fromPTime(t); });
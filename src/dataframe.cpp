@@ -7,6 +7,7 @@
 #include <arrow/compute/exec.h>
 #include <arrow/io/api.h>
 #include "arrow/csv/api.h"
+#include <cstring>
 #include <iostream>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
@@ -20,19 +21,24 @@
 #include "arrow/table.h"
 #include "arrow/type.h"
 #include "arrow/type_traits.h"
+#include "arrow/util/bitmap_ops.h"
 #include "arrow/util/key_value_metadata.h"
+#include "arrow/util/thread_pool.h"
 #include "arrow/util/vector.h"
+#include "argminmax.h"
+#include "categorical.h"
 #include "datetimelike.h"
+#include "elementwise.h"
 #include "filesystem"
 #include "pd_core_macros.h"
 #include "resample.h"
+#include "scheduler.h"
 #include "concat.h"
 #include <arrow/ipc/reader.h>
 #include <arrow/ipc/writer.h>
 #include "data_variant.h"
 #include "tabulate/table.hpp"
-//#include "json_utils.h"
-//#include "rapidjson/error/error.h"
+#include "tracing.h"
 
 
 #define Aggregation(name) \
@@ -43,12 +49,52 @@ pd::Series DataFrame::name(AxisType axis, bool skip_null) const { \
 
 namespace pd {
 
-    DataFrame::DataFrame(const std::shared_ptr<arrow::RecordBatch> &table, const std::shared_ptr<arrow::Array> &_index)
+    namespace {
+        /// local paths or s3://bucket/key
+        arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> openInputFile(std::filesystem::path const &path) {
+            const auto pathStr = path.string();
+            if (pathStr.starts_with("s3://")) {
+                return arrow::AWSS3Reader::Instance().CreateReadableFile(pathStr.substr(5));
+            }
+            return arrow::io::ReadableFile::Open(pathStr, pd::GetMemoryPool());
+        }
+
+        /// whole reads and writes run on their own pool: arrow's readers block on tasks they submit
+        /// to the IO and CPU pools, which would deadlock once those pools are filled with such reads
+        arrow::internal::Executor *frameIOExecutor() {
+            static auto pool = pd::ReturnOrThrowOnFailure(arrow::internal::ThreadPool::MakeEternal(4));
+            return pool.get();
+        }
+
+        /// fn on frameIOExecutor with the caller's context, exceptions returned as failed statuses
+        template<class Fn>
+        auto submitFrameIO(Fn &&fn) {
+            using R = std::invoke_result_t<Fn &>;
+            auto task = pd::bindExecContext([fn = std::forward<Fn>(fn)]() {
+                if constexpr (std::is_same_v<R, arrow::Status>) {
+                    try {
+                        return fn();
+                    } catch (std::exception const &e) {
+                        return arrow::Status::UnknownError(e.what());
+                    }
+                } else {
+                    try {
+                        return arrow::Result<R>(fn());
+                    } catch (std::exception const &e) {
+                        return arrow::Result<R>(arrow::Status::UnknownError(e.what()));
+                    }
+                }
+            });
+            return arrow::DeferNotOk(frameIOExecutor()->Submit(std::move(task)));
+        }
+    }
+
+    DataFrame::DataFrame(const std::shared_ptr<arrow::RecordBatch> &table, pd::Index const &_index)
             : NDFrame(table, _index) {}
 
     DataFrame::DataFrame(const ArrayTable &table, const std::shared_ptr<arrow::Array> &index)
             : NDFrame(GetTableRowSize(table), index) {
-        int nRows = m_index->length();
+        int nRows = m_index.length();
 
         arrow::FieldVector fieldVectors;
         fieldVectors.reserve(table.size());
@@ -76,14 +122,14 @@ namespace pd {
             for (auto const &[key, value]: table) {
                 builder << "[" << key << "]: " << value->length() << "\n";
             }
-            builder << "[index]: " << m_index->length() << "\n";
+            builder << "[index]: " << m_index.length() << "\n";
 
             throw std::runtime_error(builder.str());
         }
     }
 
     DataFrame DataFrame::Make(arrow::ArrayVector const &table) const {
-        auto merged = table.size() == 1 ? table.at(0) : pd::ReturnOrThrowOnFailure(arrow::Concatenate(table));
+        auto merged = table.size() == 1 ? table.at(0) : pd::ReturnOrThrowOnFailure(arrow::Concatenate(table, pd::GetMemoryPool()));
 
         arrow::ArrayVector batches(num_columns());
         if (merged->length() != num_columns()*num_rows()) {
@@ -129,7 +175,7 @@ namespace pd {
         }
 
         int num_rows = arrayVector.back()->length();
-        m_index = uint_range(num_rows);
+        m_index = RangeIndex::positions(num_rows);
         m_array = arrow::RecordBatch::Make(arrow::schema(fields), num_rows, arrayVector);
     }
 
@@ -143,26 +189,26 @@ namespace pd {
         if (axis == AxisType::Columns) {
             auto columns = m_array->columns();
             result.resize(num_rows());
-            tbb::parallel_for(
+            pd::parallel_for(
                     0L,
                     num_rows(),
-                    [&](int64_t i) {
+                    pd::bindExecContext([&](int64_t i) {
                         arrow::ScalarVector row;
                         row.reserve(num_columns());
 
                         for (const auto &column: columns) {
                             row.emplace_back(ReturnOrThrowOnFailure(column->GetScalar(i)));
                         }
-                        result[i] = arrow::compute::CallFunction(functionName,
-                                                                 {arrow::ScalarArray::Make(row)},
-                                                                 &option)->scalar();
-                    });
+                        result[i] = pd::CallFunction(functionName,
+                                                     {arrow::ScalarArray::Make(row)},
+                                                     &option)->scalar();
+                    }));
             newIndex = indexArray();
         } else {
             result.resize(num_columns());
-            tbb::parallel_for(0L, num_columns(), [&](int64_t i) {
-                result[i] = arrow::compute::CallFunction(functionName, {m_array->column(i)}, &option)->scalar();
-            });
+            pd::parallel_for(0L, num_columns(), pd::bindExecContext([&](int64_t i) {
+                result[i] = pd::CallFunction(functionName, {m_array->column(i)}, &option)->scalar();
+            }));
 
             newIndex = arrow::ArrayT<std::string>::Make(columnNames());
         }
@@ -241,9 +287,9 @@ namespace pd {
             input = other.GetChunkedArray();
         }
 
-        auto result = pd::ReturnOrThrowOnFailure(arrow::compute::CallFunction(func,
-                                                                              {self.GetChunkedArray(),
-                                                                               input})).chunks();
+        auto result = pd::ReturnOrThrowOnFailure(pd::CallElementwise(func,
+                                                                     {self.GetChunkedArray(),
+                                                                      input})).chunks();
 
         return self.Make(result);
     }
@@ -254,7 +300,7 @@ namespace pd {
     DataFrame DataFrame::operator op(Scalar const &s) const { return BinaryFunction(#name, *this, s); }
 
 #define UNARY_FUNCTION(op)     \
-DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow::compute::CallFunction(#op, {this->GetChunkedArray()})).chunks()); }
+DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(pd::CallElementwise(#op, {this->GetChunkedArray()})).chunks()); }
 
     UNARY_FUNCTION(abs)
     BINARY_OPERATOR_DF(+, add)
@@ -266,7 +312,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
     DataFrame DataFrame::pow(double v) const {
         return Make(pd::ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("power", {this->GetChunkedArray(), arrow::Datum{v}})).chunks());
+                pd::CallElementwise("power", {this->GetChunkedArray(), arrow::Datum{v}})).chunks());
     }
 
     UNARY_FUNCTION(sign)
@@ -279,7 +325,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     DataFrame DataFrame::operator[](Slice slice) const{
         slice.normalize(m_array->num_rows());
         int64_t length = slice.end - slice.start;
-        return DataFrame{m_array->Slice(slice.start, length), m_index->Slice(slice.start, length)};
+        return DataFrame{m_array->Slice(slice.start, length), m_index.slice(slice.start, length)};
     }
 
     Series DataFrame::operator[](const std::string &column) const {
@@ -322,8 +368,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
     DataFrame DataFrame::operator[](Scalar const& _index) const {
-        auto indexArrayIndex = ReturnOrThrowOnFailure(arrow::compute::Index(m_index, arrow::compute::IndexOptions{
-                _index.value()})).scalar_as<arrow::Int64Scalar>().value;
+        auto indexArrayIndex = m_index.position(_index.value());
         if (indexArrayIndex == -1) {
             auto error = fmt::format("Index out of bounds: {}", _index.value()->ToString());
             throw std::runtime_error(error);;
@@ -342,14 +387,14 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
                     auto series = this->m_array->GetColumnByName(column);
                     if (series) {
                         auto scalar = pd::ReturnOrThrowOnFailure(series->GetScalar(row));
-                        return std::pair{column, pd::ReturnOrThrowOnFailure(arrow::MakeArrayFromScalar(*scalar, 1))};
+                        return std::pair{column, pd::ReturnOrThrowOnFailure(arrow::MakeArrayFromScalar(*scalar, 1, pd::GetMemoryPool()))};
                     }
                     std::stringstream ss;
                     ss << "[" << column << "] returned null.";
                     throw std::runtime_error(ss.str());
                 });
         auto index = pd::ReturnOrThrowOnFailure(m_index->GetScalar(row));
-        return DataFrame{result, pd::ReturnOrThrowOnFailure(arrow::MakeArrayFromScalar(*index, 1))};
+        return DataFrame{result, pd::ReturnOrThrowOnFailure(arrow::MakeArrayFromScalar(*index, 1, pd::GetMemoryPool()))};
     }
     Scalar DataFrame::at(int64_t row, int64_t col) const {
         if (row < 0) {
@@ -382,26 +427,21 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
 
     DataFrame DataFrame::slice(DateTimeSlice slicer, const std::vector<std::string> &columns) const {
-        if (m_index->type_id() == arrow::Type::TIMESTAMP) {
-            int64_t start = 0, end = m_index->length() - 1;
+        if (m_index.type()->id() == arrow::Type::TIMESTAMP) {
+            int64_t start = 0, end = m_index.length() - 1;
 
             if (!slicer.start.is_not_a_date_time()) {
-                start = ReturnScalarOrThrowOnError(
-                        arrow::compute::Index(m_index,
-                                              arrow::compute::IndexOptions{
-                                                      fromDateTime(slicer.start)})).as<int64_t>();
+                start = m_index.position(fromDateTime(slicer.start));
             }
             if (!slicer.end.is_not_a_date_time()) {
-                end = ReturnScalarOrThrowOnError(
-                        arrow::compute::Index(m_index, arrow::compute::IndexOptions{
-                                fromDateTime(slicer.end)})).as<int64_t>();
+                end = m_index.position(fromDateTime(slicer.end));
             }
 
             return slice(Slice{start, end}, columns);
         } else {
             std::stringstream ss;
             ss << "Type Error: DateTime slicing is only allowed on TimeStamp DataType, but found index of type "
-               << m_index->type()->ToString() << "\n";
+               << m_index.type()->ToString() << "\n";
             throw std::runtime_error(ss.str());
         }
     }
@@ -427,7 +467,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
             fieldVector.emplace_back(schema->field(idx));
         }
         return DataFrame{arrow::RecordBatch::Make(arrow::schema(fieldVector), length, arrays),
-                         m_index->Slice(slice.start, length)};
+                         m_index.slice(slice.start, length)};
     }
     DataFrame DataFrame::slice(int offset, std::vector<std::string> const &columns) const {
         int64_t length = m_array->num_rows() - offset;
@@ -447,15 +487,15 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
             arrays.emplace_back(m_array->column(idx)->data()->Slice(offset, length));
             fieldVector.emplace_back(schema->field(idx));
         }
-        return DataFrame{arrow::RecordBatch::Make(arrow::schema(fieldVector), length, arrays), m_index->Slice(offset, length)};
+        return DataFrame{arrow::RecordBatch::Make(arrow::schema(fieldVector), length, arrays), m_index.slice(offset, length)};
     }
 
     DataFrame DataFrame::slice(int offset) const {
-        return DataFrame{m_array->Slice(offset), m_index->Slice(offset)};
+        return DataFrame{m_array->Slice(offset), m_index.slice(offset)};
     }
 
     DataFrame DataFrame::slice(int offset, int64_t length) const {
-        return DataFrame{m_array->Slice(offset, length), m_index->Slice(offset, length)};
+        return DataFrame{m_array->Slice(offset, length), m_index.slice(offset, length)};
     }
 
     DataFrame DataFrame::where(Series const & filter) const {
@@ -468,9 +508,9 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         }
         arrow::compute::FilterOptions opt{arrow::compute::FilterOptions::NullSelectionBehavior::EMIT_NULL};
         auto rb = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("filter", {m_array, filter.m_array}, &opt)).record_batch();
+                pd::CallFunction("filter", {m_array, filter.m_array}, &opt)).record_batch();
         auto idx = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("array_filter", {m_index, filter.m_array}, &opt)).make_array();
+                pd::CallFunction("array_filter", {m_index, filter.m_array}, &opt)).make_array();
         return DataFrame{rb, idx};
     }
 
@@ -484,53 +524,109 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         }
 
         auto rb = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("take", {m_array, x.m_array})).record_batch();
+                pd::CallFunction("take", {m_array, x.m_array})).record_batch();
         auto idx = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("array_take", {m_index, x.m_array})).make_array();
+                pd::CallFunction("array_take", {m_index, x.m_array})).make_array();
 
         return DataFrame{rb, idx};
     };
     //</editor-fold>
 
     //<editor-fold desc="Indexing Operations">
-    std::unordered_map<std::string, pd::Scalar> DataFrame::idxMin() const
+    template<bool Max>
+    static std::vector<int64_t> columnExtrema(arrow::RecordBatch const &batch, bool skip_na) {
+        std::vector<int64_t> positions(batch.num_columns());
+        pd::parallel_for(0, batch.num_columns(), pd::bindExecContext([&](int i) {
+            positions[i] = Max ? pd::argmax(*batch.column(i), skip_na) : pd::argmin(*batch.column(i), skip_na);
+        }));
+        return positions;
+    }
+
+    template<bool Max>
+    static Series extremaAlong(DataFrame const &df, AxisType axis, bool skip_na, bool labels) {
+        auto names = arrow::ArrayT<std::string>::Make(df.columnNames());
+        if (axis == AxisType::Columns) {
+            auto columns = df.array()->columns();
+            ArrayPtr positions = Max ? pd::argmaxRows(columns, skip_na) : pd::argminRows(columns, skip_na);
+            if (labels) {
+                positions = ReturnOrThrowOnFailure(pd::CallFunction("array_take", {names, positions})).make_array();
+            }
+            return {positions, df.labels()};
+        }
+
+        auto positions = columnExtrema<Max>(*df.array(), skip_na);
+        if (labels) {
+            arrow::ScalarVector result;
+            result.reserve(positions.size());
+            for (auto position: positions) {
+                result.push_back(df.labels().label(position));
+            }
+            return {arrow::ScalarArray::Make(result, df.labels().type()), names};
+        }
+        std::vector<bool> valid;
+        valid.reserve(positions.size());
+        for (auto position: positions) {
+            valid.push_back(position >= 0);
+        }
+        return {arrow::ArrayT<int64_t>::Make(positions, valid), names};
+    }
+
+    std::unordered_map<std::string, pd::Scalar> DataFrame::idxMin(bool skip_na) const
     {
+        auto positions = columnExtrema<false>(*m_array, skip_na);
         std::unordered_map<std::string, pd::Scalar> result;
-        for (auto const& column: columnNames()) {
-            result[column] = operator[](column).idxMin();
+        for (int i = 0; i < num_columns(); i++) {
+            result[m_array->column_name(i)] = pd::Scalar{m_index.label(positions[i])};
         }
         return result;
     }
 
-    std::unordered_map<std::string, pd::Scalar> DataFrame::idxMax() const{
+    std::unordered_map<std::string, pd::Scalar> DataFrame::idxMax(bool skip_na) const{
+        auto positions = columnExtrema<true>(*m_array, skip_na);
         std::unordered_map<std::string, pd::Scalar> result;
-        for (auto const& column: columnNames()) {
-            result[column] = operator[](column).idxMax();
+        for (int i = 0; i < num_columns(); i++) {
+            result[m_array->column_name(i)] = pd::Scalar{m_index.label(positions[i])};
         }
         return result;
     }
+
+    Series DataFrame::idxMin(AxisType axis, bool skip_na) const {
+        return extremaAlong<false>(*this, axis, skip_na, true);
+    }
+
+    Series DataFrame::idxMax(AxisType axis, bool skip_na) const {
+        return extremaAlong<true>(*this, axis, skip_na, true);
+    }
+
+    Series DataFrame::argmin(AxisType axis, bool skip_na) const {
+        return extremaAlong<false>(*this, axis, skip_na, false);
+    }
+
+    Series DataFrame::argmax(AxisType axis, bool skip_na) const {
+        return extremaAlong<true>(*this, axis, skip_na, false);
+    }
     //</editor-fold>
 
     //<editor-fold desc="Selection / Multiplexing">
     DataFrame DataFrame::where(pd::DataFrame const & cond, DataFrame const& other) const {
         return JoinArrays(ReturnOrThrowOnFailure(
-                arrow::compute::IfElse(cond.GetFlatArray(), GetFlatArray(), other.GetFlatArray())).make_array());
+                pd::CallFunction("if_else", {cond.GetFlatArray(), GetFlatArray(), other.GetFlatArray()})).make_array());
     }
 
     DataFrame DataFrame::where(DataFrame const &cond, Series const &other) const {
-        return JoinArrays(ReturnOrThrowOnFailure(arrow::compute::IfElse(cond.GetFlatArray(), GetFlatArray(),
-                                                                        Broadcast(other).GetFlatArray())).make_array());
+        return JoinArrays(ReturnOrThrowOnFailure(pd::CallFunction("if_else", {cond.GetFlatArray(), GetFlatArray(),
+                                                                              Broadcast(other).GetFlatArray()})).make_array());
     }
 
     DataFrame DataFrame::where(DataFrame const &cond, Scalar const &other) const {
         return JoinArrays(ReturnOrThrowOnFailure(
-                arrow::compute::IfElse(cond.GetFlatArray(), GetFlatArray(), other.value())).make_array());
+                pd::CallFunction("if_else", {cond.GetFlatArray(), GetFlatArray(), other.value()})).make_array());
     }
     //</editor-fold>
 
     pd::DataFrame DataFrame::Broadcast(pd::Series const &arrays) const
     {
-        if (!m_index->Equals(arrays.indexArray())) {
+        if (!m_index.equals(arrays.labels())) {
             auto error = fmt::format("Broadcasting arrays with different indices is not supported");
             throw std::runtime_error(error);
         }
@@ -643,46 +739,63 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         return rename(replace);
     }
 
-    DataFrame DataFrame::readParquet(std::filesystem::path const &path) {
-        const auto pathStr = path.string();
-        const auto isS3 = pathStr.starts_with("s3://");
-        auto &&infileStatus =
-                isS3 ? arrow::AWSS3Reader::Instance().CreateReadableFile(pathStr.substr(5))
-                     : arrow::io::ReadableFile::Open(path);
+    TablePtr DataFrame::readParquetTable(std::filesystem::path const &path, std::vector<std::string> const &dictionaryColumns) {
+        PD_TRACE_SCOPE("DataFrame::readParquetTable");
+        const auto isS3 = path.string().starts_with("s3://");
+        auto infileStatus = openInputFile(path);
         if (infileStatus.ok()) {
             auto infile = std::move(infileStatus).ValueUnsafe();
 
-            auto result = parquet::arrow::OpenFile(infile, arrow::default_memory_pool());
-            auto reader = pd::ReturnOrThrowOnFailure(std::move(result));
+            parquet::arrow::FileReaderBuilder builder;
+            pd::ThrowOnFailure(builder.Open(infile));
 
-            std::shared_ptr<arrow::Table> parquet_table;
-            PARQUET_THROW_NOT_OK(reader->ReadTable(&parquet_table));
-
-            arrow::TableBatchReader tableBatchReader(parquet_table);
-            auto recordBatchesResult = tableBatchReader.ToRecordBatches();
-
-            if (recordBatchesResult.ok()) {
-                auto rb = recordBatchesResult.MoveValueUnsafe();
-                if (rb.size() == 1) {
-                    return DataFrame{rb.at(0)};
-                } else if (rb.empty()) {
-                    throw std::runtime_error("Cannot Initialize DataFrame with empty parquet table");
-                } else {
-                    std::stringstream ss;
-                    ss << "DataFrame Only supports Parquet Table with single record batch\n"
-                          "Found "
-                       << rb.size() << " record batches\n";
-                    throw std::runtime_error(ss.str());
+            auto properties = parquet::default_arrow_reader_properties();
+            if (isS3) {
+                // footer and column chunks are fetched as a few coalesced ranges up front
+                // instead of one round trip per chunk
+                properties.set_pre_buffer(true);
+                properties.set_cache_options(arrow::io::CacheOptions::Defaults());
+            }
+            auto const *schema = builder.raw_reader()->metadata()->schema();
+            for (auto const &column: dictionaryColumns) {
+                auto index = schema->ColumnIndex(column);
+                if (index < 0) {
+                    throw std::runtime_error("readParquet: no column named " + column);
                 }
-            } else {
-                throw std::runtime_error(recordBatchesResult.status().ToString());
+                properties.set_read_dictionary(index, true);
             }
+            auto reader = pd::ReturnOrThrowOnFailure(
+                    builder.memory_pool(pd::GetMemoryPool())->properties(properties)->Build());
+
+            std::shared_ptr<arrow::Table> parquet_table;
+            PARQUET_THROW_NOT_OK(reader->ReadTable(&parquet_table));
+            return parquet_table;
         } else {
             throw std::runtime_error(infileStatus.status().ToString());
         }
     }
 
+    DataFrame DataFrame::readParquet(std::filesystem::path const &path, std::vector<std::string> const &dictionaryColumns) {
+        PD_TRACE_SCOPE("DataFrame::readParquet");
+        auto parquet_table = readParquetTable(path, dictionaryColumns);
+        if (parquet_table->num_rows() == 0) {
+            throw std::runtime_error("Cannot Initialize DataFrame with empty parquet table");
+        }
+        // multiple row groups are combined once; ChunkedFrame::readParquet keeps them as chunks
+        return DataFrame{pd::ReturnOrThrowOnFailure(parquet_table->CombineChunksToBatch(pd::GetMemoryPool()))};
+    }
+
+    arrow::Future<DataFrame> DataFrame::readParquetAsync(std::filesystem::path const &path,
+                                                         std::vector<std::string> const &dictionaryColumns) {
+        return submitFrameIO([path, dictionaryColumns] { return readParquet(path, dictionaryColumns); });
+    }
+
+    arrow::Future<> DataFrame::toParquetAsync(std::filesystem::path const &filepath, const std::string &indexField) const {
+        return submitFrameIO([self = *this, filepath, indexField] { return self.toParquet(filepath, indexField); });
+    }
+
     arrow::Status DataFrame::toParquet(std::filesystem::path const &filepath, const std::string &indexField) const {
+        PD_TRACE_SCOPE("DataFrame::toParquet");
         ARROW_ASSIGN_OR_RAISE(
                 std::shared_ptr<arrow::Table> table,
                 arrow::Table::FromRecordBatches(
@@ -695,10 +808,15 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         std::shared_ptr<arrow::io::FileOutputStream> outfile;
         ARROW_ASSIGN_OR_RAISE(outfile, arrow::io::FileOutputStream::Open(filepath));
 
-        return parquet::arrow::WriteTable(*table.get(), arrow::default_memory_pool(), outfile);
+        // the arrow schema is stored so categorical columns read back as dictionaries
+        auto arrowProps = parquet::ArrowWriterProperties::Builder().store_schema()->build();
+
+        return parquet::arrow::WriteTable(
+                *table.get(), pd::GetMemoryPool(), outfile, parquet::DEFAULT_MAX_ROW_GROUP_LENGTH, props, arrowProps);
     }
 
     arrow::Status DataFrame::toCSV(std::filesystem::path const &filepath, const std::string &indexField) const {
+        PD_TRACE_SCOPE("DataFrame::toCSV");
         // Create a file output stream
         ARROW_ASSIGN_OR_RAISE(auto fileOutputStream, arrow::io::FileOutputStream::Open(filepath));
         // Write the RecordBatch to CSV
@@ -706,22 +824,30 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         return arrow::csv::WriteCSV(*concatenated, arrow::csv::WriteOptions::Defaults(), fileOutputStream.get());
     }
 
-//    arrow::Result<rapidjson::Value> DataFrame::toJSON(rapidjson::Document::AllocatorType &allocator,
-//                                                      std::vector<std::string> columns,
-//                                                      std::optional<std::string> const &index,
-//                                                      bool toRecords) const {
-//        columns = columns.empty() ? this->columnNames() : columns;
-//
-//        auto array = m_array;
-//        if (index) {
-//            auto indexPtr = pd::ReturnOrThrowOnFailure(arrow::compute::Cast(m_index, arrow::int64())).make_array();
-//            array = array->AddColumn(array->num_columns(), arrow::field(*index, indexPtr->type()),
-//                                     indexPtr)
-//                    .MoveValueUnsafe();
-//        }
-//
-//        return ConvertToVector(array, toRecords, allocator);
-//    }
+    arrow::Result<std::shared_ptr<arrow::Buffer>> DataFrame::toJSON(JSONOrient orient,
+                                                                    std::vector<std::string> const &columns,
+                                                                    std::optional<std::string> const &index) const {
+        PD_TRACE_SCOPE("DataFrame::toJSON");
+        auto array = m_array;
+        if (not columns.empty()) {
+            std::vector<int> indices;
+            for (auto const &column: columns) {
+                auto position = m_array->schema()->GetFieldIndex(column);
+                if (position == -1) {
+                    return arrow::Status::KeyError("toJSON: no column named ", column);
+                }
+                indices.push_back(position);
+            }
+            ARROW_ASSIGN_OR_RAISE(array, m_array->SelectColumns(indices));
+        }
+        if (index) {
+            ARROW_ASSIGN_OR_RAISE(auto indexPtr, pd::Cast(m_index, arrow::int64()));
+            ARROW_ASSIGN_OR_RAISE(array, array->AddColumn(array->num_columns(),
+                                                          arrow::field(*index, arrow::int64()),
+                                                          indexPtr.make_array()));
+        }
+        return WriteJSON(*array, orient);
+    }
 
     arrow::Result<std::shared_ptr<arrow::Buffer>> DataFrame::toBinary(std::vector<std::string> columns,
                                                                       std::optional<std::string> const &index,
@@ -730,7 +856,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
         auto array = m_array;
         if (index) {
-            auto indexPtr = pd::ReturnOrThrowOnFailure(arrow::compute::Cast(m_index, arrow::int64())).make_array();
+            auto indexPtr = pd::ReturnOrThrowOnFailure(pd::Cast(m_index, arrow::int64())).make_array();
             array = array->AddColumn(array->num_columns(), arrow::field(*index, indexPtr->type()),
                                      indexPtr).MoveValueUnsafe();
         }
@@ -769,74 +895,52 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
             throw std::invalid_argument(
                     "PandasArrow Cannot ReadBinary from a Table or Array of RecordBatches yet. Always Assume Single RecordBatch.");
         }
+        return fromRecordBatch(batches[0], index);
+    }
 
+    DataFrame DataFrame::fromRecordBatch(std::shared_ptr<arrow::RecordBatch> batch, std::optional<std::string> const &index) {
         pd::ArrayPtr indexPtr{nullptr};
         if (index) {
-            auto indexPosition = batches[0]->schema()->GetFieldIndex(*index);
+            auto indexPosition = batch->schema()->GetFieldIndex(*index);
             if (indexPosition != -1) {
-                indexPtr = batches[0]->column(indexPosition);
+                indexPtr = batch->column(indexPosition);
                 if (indexPtr->type_id() == arrow::Type::INT64) {
                     indexPtr = pd::ReturnOrThrowOnFailure(
-                            arrow::compute::Cast(indexPtr, arrow::timestamp(arrow::TimeUnit::NANO))).make_array();
+                            pd::Cast(indexPtr, arrow::timestamp(arrow::TimeUnit::NANO))).make_array();
                 }
-                batches[0] = pd::ReturnOrThrowOnFailure(batches[0]->RemoveColumn(indexPosition));
+                batch = pd::ReturnOrThrowOnFailure(batch->RemoveColumn(indexPosition));
             } else {
-                SPDLOG_ERROR(R"(no field "{}" exist in JSON.)", index->c_str());
+                SPDLOG_ERROR(R"(no field "{}" exist in the batch.)", index->c_str());
             }
         }
 
         return DataFrame{
-                batches[0],
+                batch,
                 indexPtr};
     }
 
-//    DataFrame DataFrame::readJSON(const rapidjson::Document &doc, std::shared_ptr<arrow::Schema> const &schema,
-//                                  std::optional<std::string> const &index) {
-//
-//        std::shared_ptr<arrow::RecordBatch> batch =
-//                pd::ReturnOrThrowOnFailure(ConvertToRecordBatch(doc, schema));
-//
-//        pd::ArrayPtr indexPtr{nullptr};
-//        if (index) {
-//            auto indexPosition = batch->schema()->GetFieldIndex(*index);
-//            if (indexPosition != -1) {
-//                indexPtr = batch->column(indexPosition);
-//                if (indexPtr->type_id() == arrow::Type::INT64) {
-//                    indexPtr = pd::ReturnOrThrowOnFailure(
-//                            arrow::compute::Cast(indexPtr, arrow::timestamp(arrow::TimeUnit::NANO))).make_array();
-//                }
-//                batch = pd::ReturnOrThrowOnFailure(batch->RemoveColumn(indexPosition));
-//            } else {
-//                SPDLOG_ERROR(R"(no field "{}" exist in JSON.)", *index);
-//            }
-//        }
-//
-//        return DataFrame{
-//                batch,
-//                indexPtr};
-//    }
-//
-//    DataFrame DataFrame::readJSON(const std::string &jsonString, std::shared_ptr<arrow::Schema> const &schema,
-//                                  std::optional<std::string> const &index) {
-//        rapidjson::Document doc;
-//
-//        // Parse the JSON string
-//        rapidjson::ParseResult result = doc.Parse(jsonString.c_str());
-//
-//        // Check for parsing errors
-//        if (!result) {
-//            throw std::invalid_argument(
-//                    fmt::format("JSON parse error: {}, ({}).", rapidjson::GetParseErrorFunc()(result.Code()),
-//                                result.Offset()));
-//        }
-//
-//        return readJSON(doc, schema, index);
-//    }
+    DataFrame DataFrame::readJSON(std::filesystem::path const &path, JSONOrient orient,
+                                  std::shared_ptr<arrow::Schema> const &schema,
+                                  std::optional<std::string> const &index) {
+        PD_TRACE_SCOPE("DataFrame::readJSON");
+        std::shared_ptr<arrow::io::InputStream> input = pd::ReturnOrThrowOnFailure(openInputFile(path));
+        auto table = pd::ReturnOrThrowOnFailure(ReadJSONTable(input, orient, schema));
+        return fromRecordBatch(pd::ReturnOrThrowOnFailure(table->CombineChunksToBatch(pd::GetMemoryPool())), index);
+    }
 
-    DataFrame DataFrame::readCSV(std::filesystem::path const &path) {
-        arrow::io::IOContext io_context = arrow::io::default_io_context();
-        std::shared_ptr<arrow::io::InputStream> input =
-                pd::ReturnOrThrowOnFailure(arrow::io::ReadableFile::Open(path));
+    DataFrame DataFrame::readJSON(std::shared_ptr<arrow::Buffer> const &buffer, JSONOrient orient,
+                                  std::shared_ptr<arrow::Schema> const &schema,
+                                  std::optional<std::string> const &index) {
+        PD_TRACE_SCOPE("DataFrame::readJSON");
+        auto table = pd::ReturnOrThrowOnFailure(
+                ReadJSONTable(std::make_shared<arrow::io::BufferReader>(buffer), orient, schema));
+        return fromRecordBatch(pd::ReturnOrThrowOnFailure(table->CombineChunksToBatch(pd::GetMemoryPool())), index);
+    }
+
+    TablePtr DataFrame::readCSVTable(std::filesystem::path const &path) {
+        PD_TRACE_SCOPE("DataFrame::readCSVTable");
+        arrow::io::IOContext io_context = pd::GetExecContext().io();
+        std::shared_ptr<arrow::io::InputStream> input = pd::ReturnOrThrowOnFailure(openInputFile(path));
 
         auto read_options = arrow::csv::ReadOptions::Defaults();
         auto parse_options = arrow::csv::ParseOptions::Defaults();
@@ -844,15 +948,17 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
         std::shared_ptr<arrow::csv::TableReader> csv_reader = pd::ReturnOrThrowOnFailure(
                 arrow::csv::TableReader::Make(io_context, input, read_options, parse_options, convert_options));
-        std::shared_ptr<arrow::Table> table = pd::ReturnOrThrowOnFailure(csv_reader->Read());
-        arrow::TableBatchReader tableBatchReader(table);
+        return pd::ReturnOrThrowOnFailure(csv_reader->Read());
+    }
 
-        auto batches = pd::ReturnOrThrowOnFailure(tableBatchReader.ToRecordBatches());
-        if (batches.size() == 1) {
-            return DataFrame{batches.at(0)};
-        }
-        std::vector<pd::DataFrame> dataFrames{batches.begin(), batches.end()};
-        return pd::concat(dataFrames);
+    DataFrame DataFrame::readCSV(std::filesystem::path const &path) {
+        PD_TRACE_SCOPE("DataFrame::readCSV");
+        auto table = readCSVTable(path);
+        return DataFrame{pd::ReturnOrThrowOnFailure(table->CombineChunksToBatch(pd::GetMemoryPool()))};
+    }
+
+    arrow::Future<DataFrame> DataFrame::readCSVAsync(std::filesystem::path const &path) {
+        return submitFrameIO([path] { return readCSV(path); });
     }
 
     std::ostream &operator<<(std::ostream &os, DataFrame const &df) {
@@ -902,13 +1008,13 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
     DataFrame DateTimeLike::iso_calendar() const {
-        auto result = pd::ReturnOrThrowOnFailure(arrow::compute::ISOCalendar(m_array));
+        auto result = pd::ReturnOrThrowOnFailure(pd::CallFunction("iso_calendar", {m_array}));
         return {result.array_as<arrow::StructArray>(),
                 std::vector<std::string>{"iso_year", "iso_week", "iso_day_of_week"}};
     }
 
     DataFrame DateTimeLike::year_month_day() const {
-        auto result = pd::ReturnOrThrowOnFailure(arrow::compute::ISOCalendar(m_array));
+        auto result = pd::ReturnOrThrowOnFailure(pd::CallFunction("iso_calendar", {m_array}));
         return {result.array_as<arrow::StructArray>(), std::vector<std::string>{"year", "month", "day"}};
     }
 
@@ -924,7 +1030,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         std::vector<std::shared_ptr<arrow::ArrayData>> df_result;
         df_result.reserve(m_array->num_columns());
         for (const auto &col: m_array->columns()) {
-            auto result = arrow::compute::CallFunction(functionName, {col});
+            auto result = pd::CallFunction(functionName, {col});
             if (result.ok()) {
                 df_result.emplace_back(result.MoveValueUnsafe().array());
             } else {
@@ -935,105 +1041,147 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
 
-    using namespace std::string_literals;
-
-    DataFrame DataFrame::describe(bool include_all, bool percentiles) {
+    static DataFrame transformColumns(DataFrame const &df, std::function<Series(Series const &)> const &fn) {
+        auto batch = df.array();
+        auto index = df.indexArray();
+        const int64_t numColumns = batch->num_columns();
 
-        if (m_array == nullptr) {
-            return {};
-        }
+        arrow::ArrayVector columns(numColumns);
+        arrow::FieldVector fields(numColumns);
+        pd::parallel_for(0L, numColumns, pd::bindExecContext([&](int64_t i) {
+            auto name = batch->column_name(int(i));
+            columns[i] = fn(Series{batch->column(int(i)), index, name}).array();
+            fields[i] = arrow::field(name, columns[i]->type());
+        }));
+        return DataFrame{arrow::schema(fields), batch->num_rows(), columns, index};
+    }
 
-        const auto &valid_types = arrow::NumericTypes();
-        if (std::ranges::any_of(
-                m_array->schema()->fields(),
-                [&valid_types](std::shared_ptr<arrow::Field> const &field) {
-                    return std::find(valid_types.begin(), valid_types.end(), field->type()) == valid_types.end();
-                })) {
-            throw std::runtime_error("describe(): All Types must be numeric type");
-        }
+    DataFrame DataFrame::ewm(EWMAgg agg, double value, EWMAlphaType type, bool adjust, bool ignore_na,
+                             int min_periods, bool bias) const {
+        PD_TRACE_SCOPE("DataFrame::ewm");
+        return transformColumns(*this, [&](Series const &column) {
+            return column.ewm(agg, value, type, adjust, ignore_na, min_periods, bias);
+        });
+    }
 
-        std::vector<std::string> indexes;
-        if (include_all) {
-            indexes = this->columns();
-        } else {
-            for (auto const &field: this->array()->schema()->fields()) {
-                if (field->type()->id() != arrow::Type::NA) {
-                    indexes.push_back(field->name());
-                }
-            }
-        }
+    DataFrame DataFrame::ewm(time_duration const &halflife, bool adjust, bool ignore_na, int min_periods) const {
+        PD_TRACE_SCOPE("DataFrame::ewm");
+        return transformColumns(*this, [&](Series const &column) {
+            return column.ewm(halflife, adjust, ignore_na, min_periods);
+        });
+    }
 
-        auto columns = std::vector{"count"s, "mean"s, "std"s, "min"s, "nunique"s};
+    using namespace std::string_literals;
 
-        std::vector<double> percentiles_list;
+    DataFrame DataFrame::describe(bool include_all, bool percentiles) const {
+        DescribeOptions options{include_all};
         if (percentiles) {
-            columns.insert(columns.end(), {"25%"s, "50%"s, "75%"s});
-            percentiles_list = {0.25, 0.5, 0.75};
+            options.percentiles = {0.25, 0.5, 0.75};
         }
+        return describe(options);
+    }
 
-        columns.emplace_back("max");
-
-        auto N = indexes.size();
+    /// common type of the min / max column of describe()
+    static std::shared_ptr<arrow::DataType> describeValueType(arrow::FieldVector const &fields) {
+        std::vector<std::shared_ptr<arrow::DataType>> types;
+        for (auto const &field: fields) {
+            if (field->type()->id() != arrow::Type::NA) {
+                types.push_back(field->type());
+            }
+        }
+        if (types.empty()) {
+            return arrow::float64();
+        }
+        if (std::ranges::all_of(types, [&](auto const &type) { return type->Equals(types.front()); })) {
+            return types.front();
+        }
+        if (std::ranges::all_of(types, [](auto const &type) {
+            return arrow::is_integer(type->id()) or arrow::is_floating(type->id());
+        })) {
+            return arrow::float64();
+        }
+        return arrow::utf8();
+    }
 
-        std::vector<long> counts(N);
-        std::vector<double> mean(N);
-        std::vector<double> std(N);
-        arrow::ScalarVector min(N);
-        std::vector<long> nunique(N);
-        std::vector<arrow::ScalarVector> quantiles(percentiles_list.size(), arrow::ScalarVector{N});
-        arrow::ScalarVector max(N);
+    static std::shared_ptr<arrow::Scalar> describeValue(std::shared_ptr<arrow::Scalar> const &scalar,
+                                                        std::shared_ptr<arrow::DataType> const &type) {
+        if (scalar->type->Equals(type)) {
+            return scalar;
+        }
+        if (not scalar->is_valid) {
+            return arrow::MakeNullScalar(type);
+        }
+        if (type->id() == arrow::Type::STRING) {
+            return arrow::MakeScalar(scalar->ToString());
+        }
+        return ReturnOrThrowOnFailure(scalar->CastTo(type));
+    }
 
-        auto indexesArray = arrow::ArrayT<std::string>::Make(indexes);
-        for (size_t i = 0; i < indexes.size(); i++) {
-            auto index = indexes[i];
-            auto series = operator[](index);
+    DataFrame DataFrame::describe(DescribeOptions const &options) const {
+        PD_TRACE_SCOPE("DataFrame::describe");
 
-            counts[i] = series.count();
-            mean[i] = series.mean().as<double>();
-            std[i] = series.std().as<double>();
-            min[i] = series.min().value();
-            nunique[i] = series.nunique();
+        if (m_array == nullptr) {
+            return {};
+        }
 
-            for (size_t j = 0; j < percentiles_list.size(); j++) {
-                quantiles[j][i] = series.quantile(percentiles_list[j]).value();
+        arrow::FieldVector described;
+        std::vector<int> positions;
+        for (int i = 0; i < m_array->num_columns(); i++) {
+            auto const &field = m_array->schema()->field(i);
+            if (options.include_all or field->type()->id() != arrow::Type::NA) {
+                described.push_back(field);
+                positions.push_back(i);
             }
-
-            max[i] = series.max().value();
         }
 
-        arrow::ArrayVector data;
-        arrow::FieldVector fields;
-
-        auto common_type = min.back()->type;// todo
-
-        fields.insert(
-                fields.end(),
-                {
-                        arrow::field("count", arrow::int64()),
-                        arrow::field("mean", arrow::float64()),
-                        arrow::field("std", arrow::float64()),
-                        arrow::field("min", common_type),
-                        arrow::field("nunique", arrow::int64()),
-                });
+        const auto N = static_cast<int64_t>(described.size());
+        std::vector<ColumnSummary> summaries(N);
+        pd::parallel_for(0L, N, pd::bindExecContext([&](int64_t i) {
+            summaries[i] = pd::summarize(m_array->column(positions[i]), options);
+        }));
+
+        auto valueType = describeValueType(described);
+        auto percentileType = (arrow::is_temporal(valueType->id()) or valueType->id() == arrow::Type::STRING) ?
+                              valueType : arrow::float64();
+
+        std::vector<long> counts(N), nunique(N);
+        arrow::ScalarVector mean(N), std(N), min(N), max(N);
+        std::vector<arrow::ScalarVector> quantiles(options.percentiles.size(), arrow::ScalarVector(N));
+        std::vector<std::string> indexes(N);
+        for (int64_t i = 0; i < N; i++) {
+            auto const &summary = summaries[i];
+            indexes[i] = described[i]->name();
+            counts[i] = summary.count;
+            mean[i] = summary.mean;
+            std[i] = summary.std;
+            min[i] = describeValue(summary.min, valueType);
+            nunique[i] = summary.nunique;
+            for (size_t j = 0; j < options.percentiles.size(); j++) {
+                quantiles[j][i] = describeValue(summary.percentiles[j], percentileType);
+            }
+            max[i] = describeValue(summary.max, valueType);
+        }
 
-        data.insert(
-                data.end(),
-                {arrow::ArrayT<long>::Make(counts),
-                 arrow::ArrayT<double>::Make(mean),
-                 arrow::ArrayT<double>::Make(std),
-                 arrow::ScalarArray::Make(min),
-                 arrow::ArrayT<long>::Make(nunique)});
+        arrow::ArrayVector data{arrow::ArrayT<long>::Make(counts),
+                                arrow::ScalarArray::Make(mean, arrow::float64()),
+                                arrow::ScalarArray::Make(std, arrow::float64()),
+                                arrow::ScalarArray::Make(min, valueType),
+                                arrow::ArrayT<long>::Make(nunique)};
+        arrow::FieldVector fields{arrow::field("count", arrow::int64()),
+                                  arrow::field("mean", arrow::float64()),
+                                  arrow::field("std", arrow::float64()),
+                                  arrow::field("min", valueType),
+                                  arrow::field("nunique", arrow::int64())};
 
-        auto p = percentiles_list.begin();
-        for (auto const &q: quantiles) {
-            data.emplace_back(arrow::ScalarArray::Make(q));
-            fields.emplace_back(arrow::field(std::to_string(int((*p++) * 100)).append("%"), common_type));
+        for (size_t j = 0; j < options.percentiles.size(); j++) {
+            data.emplace_back(arrow::ScalarArray::Make(quantiles[j], percentileType));
+            fields.emplace_back(arrow::field(fmt::format("{:g}%", options.percentiles[j] * 100), percentileType));
         }
 
-        data.emplace_back(arrow::ScalarArray::Make(max));
-        fields.emplace_back(arrow::field("max", common_type));
+        data.emplace_back(arrow::ScalarArray::Make(max, valueType));
+        fields.emplace_back(arrow::field("max", valueType));
 
-        return {arrow::schema(fields), static_cast<int64_t>(indexes.size()), data, indexesArray};
+        return {arrow::schema(fields), N, data, arrow::ArrayT<std::string>::Make(indexes)};
     }
 
 
@@ -1046,7 +1194,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
     DataFrame DataFrame::head(int length) const {
-        return DataFrame{m_array->Slice(0, length), m_index->Slice(0, length)};
+        return DataFrame{m_array->Slice(0, length), m_index.slice(0, length)};
     }
 
     DataFrame DataFrame::tail(int length) const {
@@ -1054,7 +1202,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         if (nRows > 0) {
             auto startIndex = std::max<int64_t>(0l, nRows - length);
             return DataFrame{m_array->Slice(startIndex, length),
-                    m_index->Slice(startIndex, length)};
+                    m_index.slice(startIndex, length)};
         }
         return *this;
     }
@@ -1063,7 +1211,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         Series index(m_index, nullptr);
 
         auto sorted = index.sort(ascending);
-        auto result = arrow::compute::CallFunction("take", {m_array, sorted.indexArray()});
+        auto result = pd::CallFunction("take", {m_array, sorted.indexArray()});
         if (result.ok()) {
             return DataFrame{result.MoveValueUnsafe().record_batch(), ignore_index ? nullptr : sorted.array()};
         }
@@ -1071,29 +1219,22 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
     Series DataFrame::argsort(std::vector<std::string> const &fields, bool ascending) const {
-        arrow::compute::SortOptions opt;
-        opt.sort_keys.reserve(fields.size());
-
-        std::ranges::transform(
-                fields,
-                std::back_inserter(opt.sort_keys),
-                [ascending](std::string const &name) {
-                    return arrow::compute::SortKey(
-                            name,
-                            ascending ? arrow::compute::SortOrder::Ascending : arrow::compute::SortOrder::Descending);
-                });
-
-        auto result = arrow::compute::CallFunction("sort_indices", {m_array}, &opt);
-        if (result.ok()) {
-            return {result.MoveValueUnsafe().make_array(), false};
+        std::vector<SortKey> keys;
+        keys.reserve(fields.size());
+        for (auto const &name: fields) {
+            keys.push_back(SortKey{name, ascending});
         }
-        throw std::runtime_error(result.status().ToString());
+        return {pd::sort_indices(*m_array, keys), false};
     }
 
     DataFrame Series::value_counts() const {
-        auto result = arrow::compute::ValueCounts(m_array);
+        if (m_array->type_id() == arrow::Type::DICTIONARY) {
+            return {pd::countCodes(static_cast<arrow::DictionaryArray const &>(*m_array)),
+                    std::vector<std::string>{"values", "counts"}};
+        }
+        auto result = pd::CallFunction("value_counts", {m_array});
         if (result.ok()) {
-            return {result.MoveValueUnsafe(), std::vector<std::string>{"values", "counts"}};
+            return {result.MoveValueUnsafe().array_as<arrow::StructArray>(), std::vector<std::string>{"values", "counts"}};
         } else {
             throw std::runtime_error(result.status().ToString());
         }
@@ -1104,7 +1245,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         if (index == -1) {
             return DataFrame{pd::ReturnOrThrowOnFailure(m_array->AddColumn(num_columns(), fieldName, ptr)), m_index};
         } else {
-            auto field = m_array->schema()->GetFieldByName(fieldName);
+            auto field = m_array->schema()->GetFieldByName(fieldName)->WithType(ptr->type());
             return DataFrame{pd::ReturnOrThrowOnFailure(m_array->SetColumn(index, field, ptr)), m_index};
         }
     }
@@ -1114,7 +1255,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         if (index == -1) {
             m_array = pd::ReturnOrThrowOnFailure(m_array->AddColumn(num_columns(), fieldName, ptr));
         } else {
-            auto field = m_array->schema()->GetFieldByName(fieldName);
+            auto field = m_array->schema()->GetFieldByName(fieldName)->WithType(ptr->type());
             m_array = pd::ReturnOrThrowOnFailure(m_array->SetColumn(index, field, ptr));
         }
     }
@@ -1124,7 +1265,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
     pd::DataFrame DataFrame::reset_index(std::string const &columnName, bool drop) const {
-        pd::ArrayPtr newIndex = pd::range(0UL, static_cast<uint64_t>(m_index->length()));
+        pd::Index newIndex = RangeIndex::positions(m_index.length());
         std::shared_ptr<arrow::RecordBatch> new_rb{nullptr};
         if (drop) {
             new_rb = m_array;
@@ -1136,82 +1277,115 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         return pd::DataFrame{new_rb, newIndex};
     }
 
-    pd::DataFrame DataFrame::reindex(std::shared_ptr<arrow::Array> const &newIndex,
-                                     const std::optional<Scalar> &fillValue) const noexcept {
-        auto N = m_array->num_columns();
-        std::vector<pd::ArrayPtr> reindexedSeries(N);
+    /// rows of batch at the positions of newIndex in index, fillValue (or null) for the labels it does not have
+    static pd::DataFrame reindexRows(std::shared_ptr<arrow::RecordBatch> const &batch,
+                                     pd::Index const &index,
+                                     std::shared_ptr<arrow::Array> const &newIndex,
+                                     const std::optional<Scalar> &fillValue,
+                                     bool parallel) {
+        if (newIndex->type()->id() != index.type()->id()) {
+            throw std::runtime_error("reindex: type(NewIndex) " + newIndex->type()->ToString() +
+                                     " != type(CurrentIndex) " + index.type()->ToString());
+        }
 
-        std::unordered_map<int64_t, int64_t> indexer;
-        auto idx_int =
-                pd::ReturnOrThrowOnFailure(
-                        arrow::compute::Cast(m_index, {arrow::int64()})).array_as<arrow::Int64Array>();
+        auto positions = index.labelIndex().get_indexer(*newIndex);
+        auto taken = ReturnOrThrowOnFailure(pd::CallFunction("take", {batch, positions})).record_batch();
+        if (not fillValue or positions->null_count() == 0) {
+            return pd::DataFrame{taken, newIndex};
+        }
 
-        for (int i = 0; i < m_index->length(); i++) {
-            indexer[idx_int->Value(i)] = i;
+        auto found = ReturnOrThrowOnFailure(pd::CallFunction("is_valid", {positions}));
+        auto columns = taken->columns();
+        auto fill = [&](int64_t i) {
+            auto value = ReturnOrThrowOnFailure(fillValue->value()->CastTo(columns[i]->type()));
+            columns[i] = ReturnOrThrowOnFailure(pd::CallFunction("if_else", {found, columns[i], value})).make_array();
+        };
+        if (parallel) {
+            pd::parallel_for(int64_t{0}, static_cast<int64_t>(columns.size()), pd::bindExecContext(fill));
+        } else {
+            for (size_t i = 0; i < columns.size(); i++) {
+                fill(static_cast<int64_t>(i));
+            }
         }
+        return {batch->schema(), newIndex->length(), columns, newIndex};
+    }
 
-        std::ranges::transform(
-                std::views::iota(0L, N),
-                reindexedSeries.begin(),
-                [&](std::int64_t i) {
-                    return Series(m_array->column(i), m_index).reindex(newIndex, indexer, fillValue).m_array;
-                });
-        return {m_array->schema(), newIndex->length(), reindexedSeries, newIndex};
+    pd::DataFrame DataFrame::reindex(std::shared_ptr<arrow::Array> const &newIndex,
+                                     const std::optional<Scalar> &fillValue) const noexcept {
+        PD_TRACE_SCOPE("DataFrame::reindex");
+        return reindexRows(m_array, m_index, newIndex, fillValue, false);
     }
 
     pd::DataFrame DataFrame::reindexAsync(std::shared_ptr<arrow::Array> const &newIndex,
                                           const std::optional<Scalar> &fillValue) const noexcept {
-        auto N = m_array->num_columns();
-
-        std::vector<pd::ArrayPtr> reindexedSeries(N);
+        PD_TRACE_SCOPE("DataFrame::reindexAsync");
+        return reindexRows(m_array, m_index, newIndex, fillValue, true);
+    }
 
-        auto idx_int =
-                pd::ReturnOrThrowOnFailure(
-                        arrow::compute::Cast(m_index, {arrow::int64()})).array_as<arrow::Int64Array>();
+    DataFrame DataFrame::sort_values(std::vector<std::string> const &by,
+                                     bool ascending,
+                                     arrow::compute::NullPlacement na_position,
+                                     bool ignore_index) const {
+        return sort_values(by, std::vector<bool>(by.size(), ascending),
+                           std::vector<arrow::compute::NullPlacement>(by.size(), na_position), ignore_index);
+    }
 
-        std::unordered_map<int64_t, int64_t> indexer;
-        for (int i = 0; i < m_index->length(); i++) {
-            indexer[idx_int->Value(i)] = i;
+    DataFrame DataFrame::sort_values(std::vector<std::string> const &by,
+                                     std::vector<bool> const &ascending,
+                                     std::vector<arrow::compute::NullPlacement> const &na_position,
+                                     bool ignore_index) const {
+        PD_TRACE_SCOPE("DataFrame::sort_values");
+        if (ascending.size() != by.size() || (!na_position.empty() && na_position.size() != by.size())) {
+            throw std::runtime_error("sort_values: ascending and na_position must match the length of by");
         }
 
-        tbb::parallel_for(
-                0,
-                N,
-                [&](size_t i) {
-                    reindexedSeries[i] = Series(m_array->column(i), m_index).reindex(newIndex, indexer,
-                                                                                     fillValue).m_array;
-                });
+        std::vector<SortKey> keys(by.size());
+        for (size_t i = 0; i < by.size(); i++) {
+            keys[i] = SortKey{by[i], ascending[i],
+                              na_position.empty() ? arrow::compute::NullPlacement::AtEnd : na_position[i]};
+        }
+        return takeRows(pd::sort_indices(*m_array, keys), ignore_index);
+    }
 
-        return {m_array->schema(), newIndex->length(), reindexedSeries, newIndex};
+    DataFrame DataFrame::nlargest(int64_t n, std::vector<std::string> const &columns) const {
+        std::vector<SortKey> keys;
+        for (auto const &column: columns) {
+            keys.push_back(SortKey{column, false});
+        }
+        return takeRows(pd::select_k(*m_array, keys, n), false);
     }
 
-    DataFrame DataFrame::sort_values(const std::vector<std::string> &by, bool ascending) {
+    DataFrame DataFrame::nsmallest(int64_t n, std::vector<std::string> const &columns) const {
+        std::vector<SortKey> keys;
+        for (auto const &column: columns) {
+            keys.push_back(SortKey{column, true});
+        }
+        return takeRows(pd::select_k(*m_array, keys, n), false);
+    }
 
-        auto array = m_array;
-        auto fields = m_array->schema()->field_names();
+    DataFrame DataFrame::takeRows(std::shared_ptr<arrow::UInt64Array> const &indices, bool ignore_index) const {
+        const int64_t numColumns = num_columns();
+        arrow::ArrayVector columns(numColumns);
+        pd::Index index;
 
-        for (auto const &field: by) {
-            auto col = m_array->GetColumnByName(field);
-            uint64_t i{};
-            if (auto it = std::find(fields.begin(), fields.end(), field); it != fields.end()) {
-                i = std::distance(std::begin(fields), it);
+        // the index is gathered as one more task next to the columns
+        pd::parallel_for(0L, numColumns + 1, pd::bindExecContext([&](int64_t i) {
+            if (i == numColumns) {
+                index = ignore_index ? pd::Index{RangeIndex::positions(indices->length())} :
+                        pd::Index{ReturnOrThrowOnFailure(pd::CallFunction("array_take", {m_index, indices})).make_array()};
             } else {
-                throw std::runtime_error(field + " not in schema");
+                columns[i] = ReturnOrThrowOnFailure(
+                        pd::CallFunction("array_take", {m_array->column(int(i)), indices})).make_array();
             }
-
-            array = ReturnOrThrowOnFailure(
-                    array->SetColumn(i, arrow::field(field, col->type()),
-                                     Series(col, m_index).sort(ascending).array()));
-        }
-
-        return pd::DataFrame{array};
+        }));
+        return DataFrame{m_array->schema(), indices->length(), columns, index};
     }
 
     Series DataFrame::coalesce() {
         std::vector<arrow::Datum> args(m_array->num_columns());
         std::copy(m_array->columns().begin(), m_array->columns().end(), args.begin());
 
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("coalesce", args));
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("coalesce", args));
     }
 
     Series DataFrame::coalesce(std::vector<std::string> const &columns) {
@@ -1221,7 +1395,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
                 columns.end(),
                 args.begin(),
                 [this](std::string const &key) { return m_array->GetColumnByName(key); });
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("coalesce", args));
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("coalesce", args));
     }
 
     GroupBy DataFrame::group_by(const std::string &key) const {
@@ -1244,7 +1418,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     DataFrame DataFrame::drop_na() const {
         auto N = num_columns();
         auto datum = ReturnOrThrowOnFailure(
-                arrow::compute::DropNull(m_array->AddColumn(num_columns(), "___index___", m_index).MoveValueUnsafe()));
+                pd::CallFunction("drop_null", {m_array->AddColumn(num_columns(), "___index___", m_index).MoveValueUnsafe()}));
         auto new_rb = datum.record_batch();
         auto new_index = new_rb->column(N);
         new_rb = ReturnOrThrowOnFailure(new_rb->RemoveColumn(N));
@@ -1272,18 +1446,17 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         arrow::compute::RoundTemporalOptions temporalOption(freq_value, getCalendarUnit(freq_unit[0]), weekStartsMonday,
                                                             false, startEpoch);
         auto binned = pd::ReturnOrThrowOnFailure(
-                closed_label_right ? arrow::compute::CeilTemporal(m_index, temporalOption)
-                                   : arrow::compute::FloorTemporal(m_index, temporalOption))
+                pd::CallFunction(closed_label_right ? "ceil_temporal" : "floor_temporal", {m_index}, &temporalOption))
                 .make_array();
 
         if (freq_unit.ends_with("E") || freq_unit == "M" || freq_unit == "W" || freq_unit == "Y" || freq_unit == "Q") {
             auto oneDay = arrow::MakeScalar(arrow::date32(), 1L).MoveValueUnsafe();
             binned =
                     pd::ReturnOrThrowOnFailure(
-                            arrow::compute::Cast(pd::ReturnOrThrowOnFailure(arrow::compute::Subtract(binned, oneDay)),
-                                                 arrow::int64())).make_array();
+                            pd::Cast(pd::ReturnOrThrowOnFailure(pd::CallFunction("subtract", {binned, oneDay})),
+                                     arrow::int64())).make_array();
             binned = pd::ReturnOrThrowOnFailure(
-                    arrow::compute::Cast(binned, arrow::timestamp(arrow::TimeUnit::NANO))).make_array();
+                    pd::Cast(binned, arrow::timestamp(arrow::TimeUnit::NANO))).make_array();
         }
         return {
                 DataFrame{m_array, binned}};
@@ -1301,11 +1474,91 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
     FOR_ALL_COLUMN(is_infinite)
 
+    // square tiles small enough that a tile of the source and one of the destination stay in L1
+    constexpr int64_t TRANSPOSE_TILE = 64;
+
+    /// out[i][j] = columns[j][i] for fixed width types, tiled so reads and writes both stay in cache.
+    /// Output columns are produced in stripes of one tile, in parallel.
+    static arrow::ArrayVector transposeFixedWidth(arrow::ArrayVector const &columns,
+                                                  std::shared_ptr<arrow::DataType> const &type,
+                                                  int64_t numRows) {
+        const auto numColumns = static_cast<int64_t>(columns.size());
+        const auto byteWidth = static_cast<arrow::FixedWidthType const &>(*type).bit_width() / 8;
+        const bool hasNulls = std::ranges::any_of(columns, [](auto const &column) { return column->null_count() > 0; });
+
+        std::vector<uint8_t const *> source(numColumns);
+        std::vector<uint8_t const *> sourceValidity(numColumns, nullptr);
+        for (int64_t j = 0; j < numColumns; j++) {
+            auto const &data = *columns[j]->data();
+            source[j] = data.buffers[1]->data() + data.offset * byteWidth;
+            if (data.MayHaveNulls()) {
+                sourceValidity[j] = data.buffers[0]->data();
+            }
+        }
+
+        std::vector<std::shared_ptr<arrow::Buffer>> values(numRows), validity(numRows);
+        const auto numStripes = (numRows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+        pd::parallel_for(int64_t{0}, numStripes, pd::bindExecContext([&](int64_t stripe) {
+            const int64_t rowBegin = stripe * TRANSPOSE_TILE;
+            const int64_t rowEnd = std::min(numRows, rowBegin + TRANSPOSE_TILE);
+
+            for (int64_t i = rowBegin; i < rowEnd; i++) {
+                values[i] = ReturnOrThrowOnFailure(arrow::AllocateBuffer(numColumns * byteWidth, pd::GetMemoryPool()));
+                if (hasNulls) {
+                    validity[i] = ReturnOrThrowOnFailure(
+                            arrow::AllocateBitmap(numColumns, pd::GetMemoryPool()));
+                    std::memset(validity[i]->mutable_data(), 0xff, validity[i]->size());
+                }
+            }
+
+            for (int64_t columnBegin = 0; columnBegin < numColumns; columnBegin += TRANSPOSE_TILE) {
+                const int64_t columnEnd = std::min(numColumns, columnBegin + TRANSPOSE_TILE);
+                for (int64_t i = rowBegin; i < rowEnd; i++) {
+                    auto *out = values[i]->mutable_data();
+                    for (int64_t j = columnBegin; j < columnEnd; j++) {
+                        std::memcpy(out + j * byteWidth, source[j] + i * byteWidth, byteWidth);
+                    }
+                    if (hasNulls) {
+                        auto *outValidity = validity[i]->mutable_data();
+                        for (int64_t j = columnBegin; j < columnEnd; j++) {
+                            if (sourceValidity[j] and
+                                !arrow::bit_util::GetBit(sourceValidity[j], columns[j]->offset() + i)) {
+                                arrow::bit_util::ClearBit(outValidity, j);
+                            }
+                        }
+                    }
+                }
+            }
+        }));
+
+        arrow::ArrayVector result(numRows);
+        for (int64_t i = 0; i < numRows; i++) {
+            result[i] = arrow::MakeArray(arrow::ArrayData::Make(
+                    type, numColumns, {validity[i], values[i]}, hasNulls ? arrow::kUnknownNullCount : 0));
+        }
+        return result;
+    }
+
+    DataFrame DataFrame::categorize(std::vector<std::string> const &columns) const {
+        auto result = m_array;
+        for (auto const &column: columns) {
+            auto index = result->schema()->GetFieldIndex(column);
+            if (index < 0) {
+                throw std::runtime_error("categorize: no column named " + column);
+            }
+            auto encoded = Series{result->column(index), m_index, column}.categorize().array();
+            result = ReturnOrThrowOnFailure(
+                    result->SetColumn(index, arrow::field(column, encoded->type()), encoded));
+        }
+        return DataFrame{result, m_index};
+    }
+
     DataFrame DataFrame::transpose() const {
+        PD_TRACE_SCOPE("DataFrame::transpose");
         auto newIndex = arrow::ArrayT<std::string>::Make(m_array->schema()->field_names());
-        arrow::FieldVector newFields(m_index->length());
+        arrow::FieldVector newFields(m_index.length());
 
-        auto newColumnSize = newFields.size();
+        auto newColumnSize = static_cast<int64_t>(newFields.size());
         auto newRowSize = newIndex->length();
 
         auto fields = m_array->schema()->fields();
@@ -1317,29 +1570,38 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
         auto commonType = promoteTypes(data_types);
 
-        auto builder = ReturnOrThrowOnFailure(arrow::MakeBuilder(commonType));
-
-        arrow::ArrayVector arrays(newColumnSize);
-
-        std::ranges::transform(
-                std::views::iota(0UL, newColumnSize),
-                arrays.begin(),
-                [&](size_t i) {
-                    auto field = ReturnOrThrowOnFailure(m_index->GetScalar(i));
-                    arrow::ScalarVector scalars(newRowSize);
-
-                    for (int64_t j = 0; j < newRowSize; j++) {
-                        scalars[j] =
-                                ReturnOrThrowOnFailure(
-                                        m_array->column(j)->GetScalar(i).MoveValueUnsafe()->CastTo(commonType));
-                    }
+        // every column is cast once, cells are then moved without going through scalars
+        arrow::ArrayVector columns(newRowSize);
+        pd::parallel_for(0L, newRowSize, pd::bindExecContext([&](int64_t j) {
+            auto column = m_array->column(int(j));
+            if (column->type()->Equals(commonType)) {
+                columns[j] = column;
+            } else {
+                auto options = arrow::compute::CastOptions::Safe(commonType);
+                columns[j] = ReturnOrThrowOnFailure(pd::CallFunction("cast", {column}, &options)).make_array();
+            }
+        }));
 
-                    newFields[i] = arrow::field(field->ToString(), commonType);
+        for (int64_t i = 0; i < newColumnSize; i++) {
+            newFields[i] = arrow::field(ReturnOrThrowOnFailure(m_index->GetScalar(i))->ToString(), commonType);
+        }
 
-                    ThrowOnFailure(builder->AppendScalars(scalars));
-                    auto data = ReturnOrThrowOnFailure(builder->Finish());
-                    return data;
-                });
+        arrow::ArrayVector arrays;
+        const auto typeId = commonType->id();
+        if ((arrow::is_primitive(typeId) and typeId != arrow::Type::BOOL and typeId != arrow::Type::NA) or
+            arrow::is_fixed_size_binary(typeId)) {
+            arrays = transposeFixedWidth(columns, commonType, newColumnSize);
+        } else {
+            arrays.resize(newColumnSize);
+            pd::parallel_for(0L, newColumnSize, pd::bindExecContext([&](int64_t i) {
+                auto builder = ReturnOrThrowOnFailure(arrow::MakeBuilder(commonType, pd::GetMemoryPool()));
+                ThrowOnFailure(builder->Reserve(newRowSize));
+                for (auto const &column: columns) {
+                    ThrowOnFailure(builder->AppendArraySlice(arrow::ArraySpan(*column->data()), i, 1));
+                }
+                arrays[i] = ReturnOrThrowOnFailure(builder->Finish());
+            }));
+        }
 
         return {arrow::schema(newFields), newRowSize, arrays, newIndex};
     }
@@ -1360,10 +1622,10 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         arrow::ArrayDataVector resultForEachColumn(numGroups);
         auto columnNames = schema->field_names();
 
-        tbb::parallel_for(
+        pd::parallel_for(
                 0L,
                 numColumns,
-                [&](::int64_t columnIdx) {
+                pd::bindExecContext([&](::int64_t columnIdx) {
                     arrow::ScalarVector result(numGroups);
                     std::string const &columnName = columnNames[columnIdx];
                     std::ranges::transform(
@@ -1381,7 +1643,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
                                 return fn(seriesFromGroupArray);
                             });
                     resultForEachColumn[columnIdx] = ReturnOrThrowOnFailure(buildData(result));
-                });
+                }));
 
         return pd::DataFrame(schema, numGroups, resultForEachColumn, uniqueKeys);
     }
@@ -1391,17 +1653,17 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         arrow::ScalarVector result(numGroups);
         std::shared_ptr<arrow::Schema> schema = df.m_array->schema();
 
-        tbb::parallel_for(
+        pd::parallel_for(
                 0L,
                 numGroups,
-                [&](::int64_t groupIdx) {
+                pd::bindExecContext([&](::int64_t groupIdx) {
                     ScalarPtr key = GetKeyByIndex(groupIdx);
                     ArrayPtr index = indexGroups[key];
                     arrow::ArrayVector group = groups[key];
                     int64_t numRows = index->length();
                     auto dataFrameGroup = pd::DataFrame(schema, numRows, group, index);
                     result[groupIdx] = fn(dataFrameGroup);
-                });
+                }));
 
         ARROW_ASSIGN_OR_RAISE(auto finalArray, buildArray(result));
         return pd::Series(finalArray, uniqueKeys);
@@ -1505,7 +1767,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
                                     .append(std::to_string(subGroup.num_rows())));
                 });
 
-        ARROW_ASSIGN_OR_RAISE(auto finalArray, arrow::Concatenate(result));
+        ARROW_ASSIGN_OR_RAISE(auto finalArray, arrow::Concatenate(result, pd::GetMemoryPool()));
         return pd::Series(finalArray, df.indexArray());
     }
 
@@ -1537,15 +1799,16 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
 
     arrow::Status GroupBy::processEach(
-            std::unique_ptr<arrow::compute::Grouper> const &grouper,
+            int64_t numGroups,
             std::shared_ptr<arrow::ListArray> const &groupings,
             std::shared_ptr<arrow::Array> const &column) {
         using namespace arrow;
         using namespace arrow::compute;
 
-        ARROW_ASSIGN_OR_RAISE(auto grouped_argument, Grouper::ApplyGroupings(*groupings, *column));
+        auto ctx = pd::GetExecContext().compute();
+        ARROW_ASSIGN_OR_RAISE(auto grouped_argument, Grouper::ApplyGroupings(*groupings, *column, &ctx));
 
-        for (int64_t i_group = 0; i_group < grouper->num_groups(); ++i_group) {
+        for (int64_t i_group = 0; i_group < numGroups; ++i_group) {
             ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Scalar> keyScalar, uniqueKeys->GetScalar(i_group));
 
             groups[keyScalar].emplace_back(grouped_argument->value_slice(i_group));
@@ -1554,14 +1817,15 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
     arrow::Status GroupBy::processIndex(
-            std::unique_ptr<arrow::compute::Grouper> const &grouper,
+            int64_t numGroups,
             std::shared_ptr<arrow::ListArray> const &groupings) {
         using namespace arrow;
         using namespace arrow::compute;
 
-        ARROW_ASSIGN_OR_RAISE(auto grouped_argument, Grouper::ApplyGroupings(*groupings, *df.indexArray()));
+        auto ctx = pd::GetExecContext().compute();
+        ARROW_ASSIGN_OR_RAISE(auto grouped_argument, Grouper::ApplyGroupings(*groupings, *df.indexArray(), &ctx));
 
-        for (int64_t i_group = 0; i_group < grouper->num_groups(); ++i_group) {
+        for (int64_t i_group = 0; i_group < numGroups; ++i_group) {
             ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Scalar> keyScalar, uniqueKeys->GetScalar(i_group));
             indexGroups[keyScalar] = grouped_argument->value_slice(i_group);
         }
@@ -1569,6 +1833,7 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
     }
 
     arrow::Status GroupBy::makeGroups(std::string const &keyInStringFormat) {
+        PD_TRACE_SCOPE("GroupBy::makeGroups");
         using namespace arrow;
         using namespace arrow::compute;
         if (!df.m_array) {
@@ -1577,28 +1842,80 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
 
         auto schema = df.array()->schema();
         auto key_array = keyInStringFormat == "__resampler_idx__" ? df.indexArray() : df[keyInStringFormat].array();
-        ARROW_ASSIGN_OR_RAISE(auto key_batch, ExecBatch::Make(std::vector<Datum>{key_array}));
+        auto ctx = pd::GetExecContext().compute();
 
-        ARROW_ASSIGN_OR_RAISE(auto grouper, Grouper::Make(key_batch.GetTypes()));
+        int64_t numGroups;
+        if (key_array->type_id() == arrow::Type::DICTIONARY) {
+            ARROW_ASSIGN_OR_RAISE(numGroups, makeDictionaryGroups(static_cast<DictionaryArray const &>(*key_array)));
+        } else {
+            ARROW_ASSIGN_OR_RAISE(auto key_batch, ExecBatch::Make(std::vector<Datum>{key_array}));
 
-        ARROW_ASSIGN_OR_RAISE(Datum id_batch, grouper->Consume(ExecSpan(key_batch)));
+            ARROW_ASSIGN_OR_RAISE(auto grouper, Grouper::Make(key_batch.GetTypes(), &ctx));
 
-        ARROW_ASSIGN_OR_RAISE(
-                auto groupings,
-                Grouper::MakeGroupings(*id_batch.array_as<UInt32Array>(), grouper->num_groups()));
+            ARROW_ASSIGN_OR_RAISE(Datum id_batch, grouper->Consume(ExecSpan(key_batch)));
+
+            ARROW_ASSIGN_OR_RAISE(auto uniques, grouper->GetUniques());
+            uniqueKeys = uniques.values[0].make_array();
+            groupIds = id_batch.array_as<UInt32Array>();
+            numGroups = grouper->num_groups();
+        }
 
-        ARROW_ASSIGN_OR_RAISE(auto uniques, grouper->GetUniques());
-        uniqueKeys = uniques.values[0].make_array();
+        ARROW_ASSIGN_OR_RAISE(auto groupings, Grouper::MakeGroupings(*groupIds, numGroups, &ctx));
+        this->groupings = groupings;
+        ARROW_ASSIGN_OR_RAISE(auto rows, pd::Cast(groupings->values(), arrow::int64()));
+        groupRows = rows.array_as<Int64Array>();
 
-        RETURN_NOT_OK(processIndex(grouper, groupings));
+        RETURN_NOT_OK(processIndex(numGroups, groupings));
 
         for (auto const &col: df.m_array->columns()) {
-            RETURN_NOT_OK(processEach(grouper, groupings, col));
+            RETURN_NOT_OK(processEach(numGroups, groupings, col));
         }
 
         return arrow::Status::OK();
     }
 
+    arrow::Result<int64_t> GroupBy::makeDictionaryGroups(arrow::DictionaryArray const &keys) {
+        const auto dictionarySize = keys.dictionary()->length();
+        const auto length = keys.length();
+
+        // code -> group id, the extra slot is the null key
+        std::vector<int32_t> remap(dictionarySize + 1, -1);
+        std::vector<int64_t> firstCodes;
+
+        ARROW_ASSIGN_OR_RAISE(auto idBuffer, arrow::AllocateBuffer(length * sizeof(uint32_t), pd::GetMemoryPool()));
+        auto *ids = reinterpret_cast<uint32_t *>(idBuffer->mutable_data());
+
+        pd::visitCodes(keys, [&]<typename CType>(CType const *codes) {
+            for (int64_t i = 0; i < length; i++) {
+                const int64_t code = keys.IsValid(i) ? static_cast<int64_t>(codes[i]) : dictionarySize;
+                auto &id = remap[code];
+                if (id < 0) {
+                    id = static_cast<int32_t>(firstCodes.size());
+                    firstCodes.push_back(code);
+                }
+                ids[i] = static_cast<uint32_t>(id);
+            }
+        });
+
+        groupIds = std::make_shared<arrow::UInt32Array>(length, std::move(idBuffer));
+
+        // labels of the groups, the null key decodes to a null label
+        arrow::Int64Builder codeBuilder(pd::GetMemoryPool());
+        RETURN_NOT_OK(codeBuilder.Reserve(static_cast<int64_t>(firstCodes.size())));
+        for (auto code: firstCodes) {
+            if (code == dictionarySize) {
+                codeBuilder.UnsafeAppendNull();
+            } else {
+                codeBuilder.UnsafeAppend(code);
+            }
+        }
+        ARROW_ASSIGN_OR_RAISE(auto uniqueCodes, codeBuilder.Finish());
+        ARROW_ASSIGN_OR_RAISE(auto labels, pd::CallFunction("take", {keys.dictionary(), uniqueCodes}));
+        uniqueKeys = labels.make_array();
+
+        return static_cast<int64_t>(firstCodes.size());
+    }
+
     arrow::Result<pd::DataFrame> GroupBy::min_max(std::vector<std::string> const &args) {
         auto schema = df.m_array->schema();
         auto N = groups.size();
@@ -1618,24 +1935,24 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
             int index = schema->GetFieldIndex(arg);
 
             arrow::ScalarVector min(keysLength), max(keysLength);
-            tbb::parallel_for(
+            pd::parallel_for(
                     0L,
                     keysLength,
-                    [&](size_t j) {
+                    pd::bindExecContext([&](size_t j) {
                         auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                         auto &group = groups.at(key);
 
                         auto d =
                                 ReturnOrThrowOnFailure(
-                                        arrow::compute::MinMax(group[index])).scalar_as<arrow::StructScalar>().value;
+                                        pd::CallFunction("min_max", {group[index]})).scalar_as<arrow::StructScalar>().value;
                         min[j] = d[0];
                         max[j] = d[1];
-                    });
+                    }));
 
             std::shared_ptr<arrow::ArrayBuilder> minBuilder, maxBuilder;
             if (not min.empty()) {
-                minBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(min.back()->type));
-                maxBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(max.back()->type));
+                minBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(min.back()->type, pd::GetMemoryPool()));
+                maxBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(max.back()->type, pd::GetMemoryPool()));
 
                 RETURN_NOT_OK(minBuilder->AppendScalars(min));
                 RETURN_NOT_OK(maxBuilder->AppendScalars(max));
@@ -1661,26 +1978,26 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         int index = schema->GetFieldIndex(arg);
 
         arrow::ScalarVector min(L), max(L);
-        tbb::parallel_for(
+        pd::parallel_for(
                 0l,
                 L,
-                [&](size_t j) {
+                pd::bindExecContext([&](size_t j) {
                     auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                     auto &group = groups.at(key);
 
                     auto d =
                             ReturnOrThrowOnFailure(
-                                    arrow::compute::MinMax(group[index])).scalar_as<arrow::StructScalar>().value;
+                                    pd::CallFunction("min_max", {group[index]})).scalar_as<arrow::StructScalar>().value;
                     min[j] = d[0];
                     max[j] = d[1];
-                });
+                }));
 
         std::shared_ptr<arrow::DataType> dtype;
         std::shared_ptr<arrow::ArrayBuilder> minBuilder, maxBuilder;
         if (not min.empty()) {
             dtype = min.back()->type;
-            minBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(dtype));
-            maxBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(dtype));
+            minBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(dtype, pd::GetMemoryPool()));
+            maxBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(dtype, pd::GetMemoryPool()));
 
             RETURN_NOT_OK(minBuilder->AppendScalars(min));
             RETURN_NOT_OK(maxBuilder->AppendScalars(max));
@@ -1702,27 +2019,27 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         auto fv = fieldVectors(args, schema);
         arrow::ArrayDataVector arr(args.size());
 
-        tbb::parallel_for(
+        pd::parallel_for(
                 tbb::blocked_range<size_t>(0, args.size()),
-                [&](const tbb::blocked_range<size_t> &r) {
+                pd::bindExecContext([&](const tbb::blocked_range<size_t> &r) {
                     for (size_t i = r.begin(); i != r.end(); ++i) {
                         const auto &arg = args[i];
                         long L = uniqueKeys->length();
                         int index = schema->GetFieldIndex(arg);
 
                         arrow::ScalarVector result(L);
-                        tbb::parallel_for(
+                        pd::parallel_for(
                                 0L,
                                 L,
-                                [&](size_t j) {
+                                pd::bindExecContext([&](size_t j) {
                                     auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                                     auto &group = groups.at(key);
                                     result[j] = ReturnOrThrowOnFailure(group[index]->GetScalar(0));
-                                });
+                                }));
 
                         arr[i] = ReturnOrThrowOnFailure(buildData(result));
                     }
-                });
+                }));
 
         return pd::DataFrame(arrow::schema(fv), long(N), arr, uniqueKeys);
     }
@@ -1755,28 +2072,28 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         auto fv = fieldVectors(args, schema);
         arrow::ArrayDataVector arr(args.size());
 
-        tbb::parallel_for(
+        pd::parallel_for(
                 0ul,
                 args.size(),
-                [&](size_t i) {
+                pd::bindExecContext([&](size_t i) {
                     const auto &arg = args[i];
                     long L = uniqueKeys->length();
                     int index = schema->GetFieldIndex(arg);
 
                     arrow::ScalarVector result(L);
-                    tbb::parallel_for(
+                    pd::parallel_for(
                             0L,
                             L,
-                            [&](size_t j) {
+                            pd::bindExecContext([&](size_t j) {
                                 auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                                 auto &group = groups.at(key);
                                 auto groupLength = group[index]->length();
                                 auto lastIndex = groupLength - 1;
                                 result[j] = ReturnOrThrowOnFailure(group[index]->GetScalar(lastIndex));
-                            });
+                            }));
 
                     arr[i] = ReturnOrThrowOnFailure(buildData(result));
-                });
+                }));
 
         return pd::DataFrame(arrow::schema(fv), long(N), arr);
     }
@@ -1812,29 +2129,29 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         auto fv = fieldVectors(args, schema);
         arrow::ArrayDataVector arr(args.size());
 
-        tbb::parallel_for(
+        pd::parallel_for(
                 tbb::blocked_range<size_t>(0, args.size()),
-                [&](const tbb::blocked_range<size_t> &r) {
+                pd::bindExecContext([&](const tbb::blocked_range<size_t> &r) {
                     for (size_t i = r.begin(); i != r.end(); ++i) {
                         const auto &arg = args[i];
                         long L = uniqueKeys->length();
                         int index = schema->GetFieldIndex(arg);
 
                         arrow::ScalarVector result(L);
-                        tbb::parallel_for(
-                                tbb::blocked_range<size_t>(0, uniqueKeys->length()),
-                                [&](const tbb::blocked_range<size_t> &r) {
+                        pd::parallel_for(
+                                tbb::blocked_range<size_t>(0, uniqueKeys->length(), pd::grainSize(uniqueKeys->length())),
+                                pd::bindExecContext([&](const tbb::blocked_range<size_t> &r) {
                                     for (size_t j = r.begin(); j != r.end(); ++j) {
                                         auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                                         auto &group = groups.at(key);
 
-                                        arrow::Datum d = ReturnOrThrowOnFailure(arrow::compute::Mode(group[index]));
+                                        arrow::Datum d = ReturnOrThrowOnFailure(pd::CallFunction("mode", {group[index]}));
                                         result[j] = d.scalar();
                                     }
-                                });
+                                }));
                         arr[i] = pd::ReturnOrThrowOnFailure(buildData(result));
                     }
-                });
+                }));
 
         return pd::DataFrame(arrow::schema(fv), long(N), arr);
     }
@@ -1848,17 +2165,17 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         int index = schema->GetFieldIndex(arg);
 
         arrow::ScalarVector result(L);
-        tbb::parallel_for(
-                tbb::blocked_range<size_t>(0, L),
-                [&](const tbb::blocked_range<size_t> &r) {
+        pd::parallel_for(
+                tbb::blocked_range<size_t>(0, L, pd::grainSize(L)),
+                pd::bindExecContext([&](const tbb::blocked_range<size_t> &r) {
                     for (size_t j = r.begin(); j != r.end(); ++j) {
                         auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                         auto &group = groups.at(key);
 
-                        arrow::Datum d = ReturnOrThrowOnFailure(arrow::compute::Mode(group[index]));
+                        arrow::Datum d = ReturnOrThrowOnFailure(pd::CallFunction("mode", {group[index]}));
                         result[j] = d.scalar();
                     }
-                });
+                }));
 
         ARROW_ASSIGN_OR_RAISE(auto data, buildArray(result));
         return pd::Series(data, uniqueKeys);
@@ -1872,30 +2189,30 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         arrow::ArrayDataVector arr(args.size());
 
         auto options = convertToArrowFunctionOptions<arrow::compute::QuantileOptions>(q);
-        tbb::parallel_for(
+        pd::parallel_for(
                 tbb::blocked_range<size_t>(0, args.size()),
-                [&](const tbb::blocked_range<size_t> &r) {
+                pd::bindExecContext([&](const tbb::blocked_range<size_t> &r) {
                     for (size_t i = r.begin(); i != r.end(); ++i) {
                         const auto &arg = args[i];
                         long L = uniqueKeys->length();
                         int index = schema->GetFieldIndex(arg);
 
                         arrow::ScalarVector result(L);
-                        tbb::parallel_for(
-                                tbb::blocked_range<size_t>(0, uniqueKeys->length()),
-                                [&](const tbb::blocked_range<size_t> &r) {
+                        pd::parallel_for(
+                                tbb::blocked_range<size_t>(0, uniqueKeys->length(), pd::grainSize(uniqueKeys->length())),
+                                pd::bindExecContext([&](const tbb::blocked_range<size_t> &r) {
                                     for (size_t j = r.begin(); j != r.end(); ++j) {
                                         auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                                         auto &group = groups.at(key);
 
                                         arrow::Datum d = ReturnOrThrowOnFailure(
-                                                arrow::compute::Quantile(group[index], options[i]));
+                                                pd::CallFunction("quantile", {group[index]}, &options[i]));
                                         result[j] = d.scalar();
                                     }
-                                });
+                                }));
                         arr[i] = ReturnOrThrowOnFailure(buildData(result));
                     }
-                });
+                }));
 
         return pd::DataFrame(arrow::schema(fv), long(N), arr);
     }
@@ -1914,19 +2231,339 @@ DataFrame DataFrame:: op() const { return Make(pd::ReturnOrThrowOnFailure(arrow:
         arrow::compute::QuantileOptions option(q);
 
         arrow::ScalarVector result(L);
-        tbb::parallel_for(
-                tbb::blocked_range<size_t>(0, L),
-                [&](const tbb::blocked_range<size_t> &r) {
+        pd::parallel_for(
+                tbb::blocked_range<size_t>(0, L, pd::grainSize(L)),
+                pd::bindExecContext([&](const tbb::blocked_range<size_t> &r) {
                     for (size_t j = r.begin(); j != r.end(); ++j) {
                         auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe();
                         auto &group = groups.at(key);
 
-                        arrow::Datum d = ReturnOrThrowOnFailure(arrow::compute::Quantile(group[index], option));
+                        arrow::Datum d = ReturnOrThrowOnFailure(pd::CallFunction("quantile", {group[index]}, &option));
                         result[j] = d.scalar();
                     }
-                });
+                }));
 
         ARROW_ASSIGN_OR_RAISE(auto data, buildArray(result));
         return pd::Series(data, uniqueKeys);
     }
+
+    //<editor-fold desc="GroupBy Window Functions">
+    arrow::Result<pd::DataFrame> GroupBy::transformColumns(
+            std::vector<std::string> const &args,
+            std::function<arrow::Result<ArrayPtr>(ArrayPtr const &, int)> const &fn) {
+        auto schema = df.m_array->schema();
+        arrow::ArrayVector columns(args.size());
+        arrow::FieldVector fields(args.size());
+        for (size_t i = 0; i < args.size(); i++) {
+            int index = schema->GetFieldIndex(args[i]);
+            if (index == -1) {
+                return arrow::Status::KeyError("Invalid column: ", args[i]);
+            }
+            ARROW_ASSIGN_OR_RAISE(columns[i], fn(df.m_array->column(index), index));
+            fields[i] = arrow::field(args[i], columns[i]->type());
+        }
+        return pd::DataFrame(arrow::schema(fields), df.num_rows(), columns, df.indexArray());
+    }
+
+    arrow::Result<ArrayPtr> GroupBy::broadcastAggregate(ArrayPtr const &, int index, std::string const &agg) {
+        const int64_t L = uniqueKeys->length();
+        arrow::ScalarVector result(L);
+        pd::parallel_for(
+                tbb::blocked_range<int64_t>(0, L, pd::grainSize(L)),
+                pd::bindExecContext([&](const tbb::blocked_range<int64_t> &r) {
+                    for (int64_t j = r.begin(); j != r.end(); ++j) {
+                        auto key = uniqueKeys->GetScalar(j).MoveValueUnsafe();
+                        auto &group = groups.at(key);
+                        result[j] = ReturnOrThrowOnFailure(pd::CallFunction(agg, {group[index]})).scalar();
+                    }
+                }));
+
+        ARROW_ASSIGN_OR_RAISE(auto aggregates, buildArray(result));
+        ARROW_ASSIGN_OR_RAISE(auto broadcast, pd::CallFunction("array_take", {aggregates, groupIds}));
+        return broadcast.make_array();
+    }
+
+    /// integers and bools widen to int64, or to double when `floating` is set
+    static arrow::Result<ArrayPtr> castToNumeric(ArrayPtr const &column, bool floating) {
+        const auto id = column->type_id();
+        if (!arrow::is_integer(id) && !arrow::is_floating(id) && id != arrow::Type::BOOL) {
+            return arrow::Status::TypeError("expected a numeric column, got ", column->type()->ToString());
+        }
+        auto options = arrow::compute::CastOptions::Safe(
+                floating || arrow::is_floating(id) ? arrow::float64() : arrow::int64());
+        ARROW_ASSIGN_OR_RAISE(auto casted, pd::CallFunction("cast", {column}, &options));
+        return casted.make_array();
+    }
+
+    static arrow::Result<std::shared_ptr<arrow::Buffer>> copyValidity(arrow::ArrayData const &data) {
+        if (data.GetNullCount() == 0 || !data.buffers[0]) {
+            return nullptr;
+        }
+        return arrow::internal::CopyBitmap(pd::GetMemoryPool(), data.buffers[0]->data(), data.offset, data.length);
+    }
+
+    template<class T>
+    static arrow::Result<ArrayPtr> makeNumericArray(std::vector<T> const &values,
+                                                    std::shared_ptr<arrow::Buffer> validity,
+                                                    int64_t nullCount) {
+        const auto n = static_cast<int64_t>(values.size());
+        ARROW_ASSIGN_OR_RAISE(auto buffer, arrow::AllocateBuffer(n * static_cast<int64_t>(sizeof(T)),
+                                                                 pd::GetMemoryPool()));
+        if (n > 0) {
+            std::memcpy(buffer->mutable_data(), values.data(), values.size() * sizeof(T));
+        }
+        return arrow::MakeArray(arrow::ArrayData::Make(arrow::CTypeTraits<T>::type_singleton(), n,
+                                                       {std::move(validity), std::move(buffer)}, nullCount));
+    }
+
+    /// NaN slots become nulls, so isna / dropna / null_count see rows without a result as missing
+    static arrow::Result<ArrayPtr> makeMaskedArray(std::vector<double> const &values) {
+        arrow::DoubleBuilder builder(pd::GetMemoryPool());
+        ARROW_RETURN_NOT_OK(builder.AppendValues(values, makeValidFlags(values)));
+        return builder.Finish();
+    }
+
+    arrow::Result<ArrayPtr> GroupBy::cumulative(ArrayPtr const &column, CumulativeOp op) const {
+        ARROW_ASSIGN_OR_RAISE(auto numeric, castToNumeric(column, false));
+        const auto &data = *numeric->data();
+        const int64_t n = data.length;
+        const auto *ids = groupIds->raw_values();
+
+        auto run = [&]<class T>(T const *values) -> arrow::Result<ArrayPtr> {
+            std::vector<T> acc(uniqueKeys->length());
+            std::vector<uint8_t> started(uniqueKeys->length(), 0);
+            std::vector<T> out(n);
+            // nulls are skipped and stay null, like Series::cumsum with skip_nulls
+            for (int64_t i = 0; i < n; i++) {
+                if (!data.IsValid(i)) {
+                    continue;
+                }
+                const auto g = ids[i];
+                const T x = values[i];
+                if (!started[g]) {
+                    acc[g] = x;
+                    started[g] = 1;
+                } else {
+                    switch (op) {
+                        case CumulativeOp::Sum:
+                            acc[g] += x;
+                            break;
+                        case CumulativeOp::Prod:
+                            acc[g] *= x;
+                            break;
+                        case CumulativeOp::Max:
+                            acc[g] = std::max(acc[g], x);
+                            break;
+                        case CumulativeOp::Min:
+                            acc[g] = std::min(acc[g], x);
+                            break;
+                    }
+                }
+                out[i] = acc[g];
+            }
+            ARROW_ASSIGN_OR_RAISE(auto validity, copyValidity(data));
+            return makeNumericArray(out, std::move(validity), data.GetNullCount());
+        };
+
+        if (numeric->type_id() == arrow::Type::DOUBLE) {
+            return run(data.GetValues<double>(1));
+        }
+        return run(data.GetValues<int64_t>(1));
+    }
+
+    arrow::Result<ArrayPtr> GroupBy::shiftColumn(ArrayPtr const &column, int64_t periods) const {
+        const int64_t n = column->length();
+        const int64_t L = uniqueKeys->length();
+        const auto *rows = groupRows->raw_values();
+
+        std::vector<int64_t> source(n, 0);
+        std::vector<uint8_t> valid(n, 0);
+        pd::parallel_for(
+                tbb::blocked_range<int64_t>(0, L, pd::grainSize(L)),
+                pd::bindExecContext([&](const tbb::blocked_range<int64_t> &r) {
+                    for (int64_t g = r.begin(); g != r.end(); ++g) {
+                        const int64_t offset = groupings->value_offset(g);
+                        const int64_t length = groupings->value_length(g);
+                        for (int64_t j = 0; j < length; j++) {
+                            const int64_t from = j - periods;
+                            if (from >= 0 && from < length) {
+                                source[rows[offset + j]] = rows[offset + from];
+                                valid[rows[offset + j]] = 1;
+                            }
+                        }
+                    }
+                }));
+
+        arrow::Int64Builder builder(pd::GetMemoryPool());
+        ARROW_RETURN_NOT_OK(builder.AppendValues(source.data(), n, valid.data()));
+        ARROW_ASSIGN_OR_RAISE(auto indices, builder.Finish());
+        ARROW_ASSIGN_OR_RAISE(auto shifted, pd::CallFunction("array_take", {column, indices}));
+        return shifted.make_array();
+    }
+
+    arrow::Result<ArrayPtr> GroupBy::diffColumn(ArrayPtr const &column, int64_t periods, bool pct) const {
+        ARROW_ASSIGN_OR_RAISE(auto numeric, castToNumeric(column, true));
+        const auto &data = *numeric->data();
+        const auto *values = data.GetValues<double>(1);
+        const auto *rows = groupRows->raw_values();
+
+        std::vector<double> out(data.length, std::numeric_limits<double>::quiet_NaN());
+        pd::parallel_for(
+                tbb::blocked_range<int64_t>(0, uniqueKeys->length(), pd::grainSize(uniqueKeys->length())),
+                pd::bindExecContext([&](const tbb::blocked_range<int64_t> &r) {
+                    for (int64_t g = r.begin(); g != r.end(); ++g) {
+                        const int64_t offset = groupings->value_offset(g);
+                        const int64_t length = groupings->value_length(g);
+                        for (int64_t j = 0; j < length; j++) {
+                            const int64_t from = j - periods;
+                            const int64_t row = rows[offset + j];
+                            if (from < 0 || from >= length) {
+                                continue;
+                            }
+                            const int64_t prev = rows[offset + from];
+                            if (data.IsValid(row) && data.IsValid(prev)) {
+                                out[row] = pct ? values[row] / values[prev] - 1 : values[row] - values[prev];
+                            }
+                        }
+                    }
+                }));
+        return makeMaskedArray(out);
+    }
+
+    arrow::Result<ArrayPtr> GroupBy::rankColumn(ArrayPtr const &column, bool ascending) const {
+        ARROW_ASSIGN_OR_RAISE(auto numeric, castToNumeric(column, true));
+        const auto &data = *numeric->data();
+        const auto *values = data.GetValues<double>(1);
+        const auto *rows = groupRows->raw_values();
+
+        std::vector<double> out(data.length, std::numeric_limits<double>::quiet_NaN());
+        pd::parallel_for(
+                tbb::blocked_range<int64_t>(0, uniqueKeys->length(), pd::grainSize(uniqueKeys->length())),
+                pd::bindExecContext([&](const tbb::blocked_range<int64_t> &r) {
+                    std::vector<int64_t> order;
+                    for (int64_t g = r.begin(); g != r.end(); ++g) {
+                        const int64_t offset = groupings->value_offset(g);
+                        const int64_t length = groupings->value_length(g);
+
+                        order.clear();
+                        for (int64_t j = 0; j < length; j++) {
+                            const int64_t row = rows[offset + j];
+                            if (data.IsValid(row) && !std::isnan(values[row])) {
+                                order.push_back(row);
+                            }
+                        }
+                        std::ranges::stable_sort(order, [&](int64_t a, int64_t b) {
+                            return ascending ? values[a] < values[b] : values[a] > values[b];
+                        });
+
+                        // ties share the average of the ranks they span
+                        for (size_t begin = 0; begin < order.size();) {
+                            size_t end = begin + 1;
+                            while (end < order.size() && values[order[end]] == values[order[begin]]) {
+                                end++;
+                            }
+                            const double rank = static_cast<double>(begin + 1 + end) / 2;
+                            for (size_t k = begin; k < end; k++) {
+                                out[order[k]] = rank;
+                            }
+                            begin = end;
+                        }
+                    }
+                }));
+        return makeMaskedArray(out);
+    }
+
+    arrow::Result<ArrayPtr> GroupBy::ffillColumn(ArrayPtr const &column) const {
+        const int64_t n = column->length();
+        const auto *ids = groupIds->raw_values();
+
+        std::vector<int64_t> last(uniqueKeys->length(), -1);
+        std::vector<int64_t> source(n, 0);
+        std::vector<uint8_t> valid(n, 0);
+        for (int64_t i = 0; i < n; i++) {
+            const auto g = ids[i];
+            if (column->IsValid(i)) {
+                last[g] = i;
+            }
+            if (last[g] >= 0) {
+                source[i] = last[g];
+                valid[i] = 1;
+            }
+        }
+
+        arrow::Int64Builder builder(pd::GetMemoryPool());
+        ARROW_RETURN_NOT_OK(builder.AppendValues(source.data(), n, valid.data()));
+        ARROW_ASSIGN_OR_RAISE(auto indices, builder.Finish());
+        ARROW_ASSIGN_OR_RAISE(auto filled, pd::CallFunction("array_take", {column, indices}));
+        return filled.make_array();
+    }
+
+    arrow::Result<pd::DataFrame> GroupBy::transform(std::string const &agg, std::vector<std::string> const &args) {
+        return transformColumns(args, [&](ArrayPtr const &column, int index) {
+            return broadcastAggregate(column, index, agg);
+        });
+    }
+
+    arrow::Result<pd::DataFrame> GroupBy::shift(std::vector<std::string> const &args, int64_t periods) {
+        return transformColumns(args, [&](ArrayPtr const &column, int) { return shiftColumn(column, periods); });
+    }
+
+    arrow::Result<pd::DataFrame> GroupBy::diff(std::vector<std::string> const &args, int64_t periods) {
+        return transformColumns(args, [&](ArrayPtr const &column, int) {
+            return diffColumn(column, periods, false);
+        });
+    }
+
+    arrow::Result<pd::DataFrame> GroupBy::pct_change(std::vector<std::string> const &args, int64_t periods) {
+        return transformColumns(args, [&](ArrayPtr const &column, int) {
+            return diffColumn(column, periods, true);
+        });
+    }
+
+    arrow::Result<pd::DataFrame> GroupBy::rank(std::vector<std::string> const &args, bool ascending) {
+        return transformColumns(args, [&](ArrayPtr const &column, int) { return rankColumn(column, ascending); });
+    }
+
+    arrow::Result<pd::DataFrame> GroupBy::ffill(std::vector<std::string> const &args) {
+        return transformColumns(args, [&](ArrayPtr const &column, int) { return ffillColumn(column); });
+    }
+
+    arrow::Result<pd::Series> GroupBy::transform(std::string const &agg, std::string const &arg) {
+        ARROW_ASSIGN_OR_RAISE(auto result, transform(agg, std::vector{arg}));
+        return result[arg];
+    }
+
+    arrow::Result<pd::Series> GroupBy::shift(std::string const &arg, int64_t periods) {
+        ARROW_ASSIGN_OR_RAISE(auto result, shift(std::vector{arg}, periods));
+        return result[arg];
+    }
+
+    arrow::Result<pd::Series> GroupBy::diff(std::string const &arg, int64_t periods) {
+        ARROW_ASSIGN_OR_RAISE(auto result, diff(std::vector{arg}, periods));
+        return result[arg];
+    }
+
+    arrow::Result<pd::Series> GroupBy::pct_change(std::string const &arg, int64_t periods) {
+        ARROW_ASSIGN_OR_RAISE(auto result, pct_change(std::vector{arg}, periods));
+        return result[arg];
+    }
+
+    arrow::Result<pd::Series> GroupBy::rank(std::string const &arg, bool ascending) {
+        ARROW_ASSIGN_OR_RAISE(auto result, rank(std::vector{arg}, ascending));
+        return result[arg];
+    }
+
+    arrow::Result<pd::Series> GroupBy::ffill(std::string const &arg) {
+        ARROW_ASSIGN_OR_RAISE(auto result, ffill(std::vector{arg}));
+        return result[arg];
+    }
+
+    GROUPBY_CUMULATIVE(cumsum, CumulativeOp::Sum)
+
+    GROUPBY_CUMULATIVE(cumprod, CumulativeOp::Prod)
+
+    GROUPBY_CUMULATIVE(cummax, CumulativeOp::Max)
+
+    GROUPBY_CUMULATIVE(cummin, CumulativeOp::Min)
+    //</editor-fold>
 } // namespace pd
@@ -3,7 +3,11 @@
 //
 #pragma once
 #include "filesystem"
+#include "describe.h"
+#include <arrow/util/future.h>
+#include "json_io.h"
 #include "series.h"
+#include "sort.h"
 #include "set"
 
 
@@ -82,13 +86,13 @@ namespace pd {
         }
 
         explicit DataFrame(std::shared_ptr<arrow::RecordBatch> const &table,
-                           std::shared_ptr<arrow::Array> const &_index = nullptr);
+                           pd::Index const &_index = nullptr);
 
         DataFrame(
                 std::shared_ptr<arrow::Schema> const &schemas,
                 int64_t num_rows,
                 std::vector<std::shared_ptr<arrow::ArrayData>> const &table,
-                std::shared_ptr<arrow::Array> const &_index = nullptr)
+                pd::Index const &_index = nullptr)
                 : NDFrame<arrow::RecordBatch>(arrow::RecordBatch::Make(schemas, num_rows, table), _index) {
         }
 
@@ -96,7 +100,7 @@ namespace pd {
                 std::shared_ptr<arrow::Schema> const &schemas,
                 int64_t num_rows,
                 std::vector<std::shared_ptr<arrow::Array>> const &table,
-                std::shared_ptr<arrow::Array> const &_index = nullptr)
+                pd::Index const &_index = nullptr)
                 : NDFrame<arrow::RecordBatch>(arrow::RecordBatch::Make(schemas, num_rows, table), _index) {
         }
 
@@ -136,6 +140,8 @@ namespace pd {
         //<editor-fold desc="Aggregation Functions">
         using NDFrame<arrow::RecordBatch>::all;
         using NDFrame<arrow::RecordBatch>::any;
+        using NDFrame<arrow::RecordBatch>::argmax;
+        using NDFrame<arrow::RecordBatch>::argmin;
         using NDFrame<arrow::RecordBatch>::median;
         using NDFrame<arrow::RecordBatch>::count;
         using NDFrame<arrow::RecordBatch>::count_na;
@@ -253,8 +259,18 @@ namespace pd {
         //</editor-fold>
 
         //<editor-fold desc="Indexing Operations">
-        std::unordered_map<std::string, pd::Scalar> idxMin() const;
-        std::unordered_map<std::string, pd::Scalar> idxMax() const;
+        /// label of the first smallest / largest value of every column, the columns are scanned in parallel
+        std::unordered_map<std::string, pd::Scalar> idxMin(bool skip_na = true) const;
+        std::unordered_map<std::string, pd::Scalar> idxMax(bool skip_na = true) const;
+
+        /// AxisType::Index: the label per column, indexed by column name.
+        /// AxisType::Columns: the name of the column holding each row's extremum, e.g. which asset is max.
+        [[nodiscard]] pd::Series idxMin(AxisType axis, bool skip_na = true) const;
+        [[nodiscard]] pd::Series idxMax(AxisType axis, bool skip_na = true) const;
+
+        /// same as idxMin / idxMax with positions, nulls where there is no value
+        [[nodiscard]] pd::Series argmin(AxisType axis, bool skip_na = true) const;
+        [[nodiscard]] pd::Series argmax(AxisType axis, bool skip_na = true) const;
         //</editor-fold>
 
         //<editor-fold desc="Iterator Functions">
@@ -286,7 +302,7 @@ namespace pd {
         }
 
         std::shared_ptr<arrow::Array> GetFlatArray() const {
-            return pd::ReturnOrThrowOnFailure(arrow::Concatenate(m_array->columns()));
+            return pd::ReturnOrThrowOnFailure(arrow::Concatenate(m_array->columns(), pd::GetMemoryPool()));
         }
 
         pd::DataFrame JoinArrays(std::shared_ptr<arrow::Array> const &arrays) const;
@@ -336,6 +352,9 @@ namespace pd {
 
         DataFrame transpose() const;
 
+        /// dictionary encodes the given columns, the rest are shared as they are
+        [[nodiscard]] DataFrame categorize(std::vector<std::string> const &columns) const;
+
         DataFrame &rename(std::unordered_map<std::string, std::string> const &columns);
 
         bool contains(std::string const &column) const;
@@ -363,29 +382,82 @@ namespace pd {
 
         friend std::ostream &operator<<(std::ostream &a, DataFrame const &b);
 
-        DataFrame describe(bool include_all = true, bool percentiles = false);
-
-        static DataFrame readParquet(std::filesystem::path const &path);
+        /// one row of statistics per column, percentiles adds the 25% / 50% / 75% quantiles
+        DataFrame describe(bool include_all = true, bool percentiles = false) const;
+
+        /// columns are summarised in parallel with a single fused pass each (see pd::summarize).
+        /// string and temporal columns get type-appropriate statistics; min, max and percentiles
+        /// keep the column type when all columns share it, become double for mixed numeric
+        /// columns and strings otherwise
+        DataFrame describe(DescribeOptions const &options) const;
+
+        /// every column is smoothed independently and in parallel, see Series::ewm
+        [[nodiscard]] DataFrame ewm(
+                EWMAgg agg,
+                double value,
+                EWMAlphaType type,
+                bool adjust = true,
+                bool ignore_na = false,
+                int min_periods = 0,
+                bool bias = false) const;
+
+        /// Series::ewm with a time halflife on every column, adjust=false throws
+        [[nodiscard]] DataFrame ewm(
+                time_duration const &halflife,
+                bool adjust = true,
+                bool ignore_na = false,
+                int min_periods = 0) const;
+
+        /// columns named in dictionaryColumns are read as categoricals straight from the
+        /// parquet dictionary pages; columns written as categoricals come back as such
+        static DataFrame readParquet(std::filesystem::path const &path,
+                                     std::vector<std::string> const &dictionaryColumns = {});
 
         static DataFrame readCSV(std::filesystem::path const &path);
 
+        /// the files as read, with the chunks the readers produced; see ChunkedFrame to keep them
+        static TablePtr readParquetTable(std::filesystem::path const &path,
+                                         std::vector<std::string> const &dictionaryColumns = {});
+
+        static TablePtr readCSVTable(std::filesystem::path const &path);
+
+        /// readParquet / readCSV run on a background pool. The caller continues while the file is read
+        /// and decoded; failures are returned through the future.
+        static arrow::Future<DataFrame> readParquetAsync(std::filesystem::path const &path,
+                                                         std::vector<std::string> const &dictionaryColumns = {});
+
+        static arrow::Future<DataFrame> readCSVAsync(std::filesystem::path const &path);
+
         static DataFrame
         readBinary(const std::basic_string_view<uint8_t> &blob, std::optional<std::string> const &index = std::nullopt);
 
-//        static DataFrame readJSON(const rapidjson::Document &doc, std::shared_ptr<arrow::Schema> const &schema,
-//                                  std::optional<std::string> const &index = std::nullopt);
-//
-//        static DataFrame readJSON(const std::string &doc, std::shared_ptr<arrow::Schema> const &schema,
-//                                  std::optional<std::string> const &index = std::nullopt);
+        /// JSON parsed block parallel by arrow (see ReadJSONTable); schema types the named fields and
+        /// drops the others. An int64 index column becomes a nanosecond timestamp index, as in readBinary.
+        static DataFrame readJSON(std::filesystem::path const &path,
+                                  JSONOrient orient = JSONOrient::Records,
+                                  std::shared_ptr<arrow::Schema> const &schema = nullptr,
+                                  std::optional<std::string> const &index = std::nullopt);
+
+        static DataFrame readJSON(std::shared_ptr<arrow::Buffer> const &buffer,
+                                  JSONOrient orient = JSONOrient::Records,
+                                  std::shared_ptr<arrow::Schema> const &schema = nullptr,
+                                  std::optional<std::string> const &index = std::nullopt);
+
+        /// batch with its index column, if present, moved to the index
+        static DataFrame fromRecordBatch(std::shared_ptr<arrow::RecordBatch> batch,
+                                         std::optional<std::string> const &index = std::nullopt);
 
         arrow::Status toParquet(std::filesystem::path const &filepath, const std::string &indexField = "index") const;
 
+        /// toParquet of this frame on a background pool
+        arrow::Future<> toParquetAsync(std::filesystem::path const &filepath, const std::string &indexField = "index") const;
+
         arrow::Status toCSV(std::filesystem::path const &filepath, const std::string &indexField = "index") const;
-//
-//        arrow::Result<rapidjson::Value> toJSON(rapidjson::Document::AllocatorType &allocator,
-//                                               std::vector<std::string> columns = {},
-//                                               std::optional<std::string> const &index = {},
-//                                               bool toRecords = true) const;
+
+        /// columns (all by default) serialized by WriteJSON; index names a column the index is written to
+        arrow::Result<std::shared_ptr<arrow::Buffer>>
+        toJSON(JSONOrient orient = JSONOrient::Records, std::vector<std::string> const &columns = {},
+               std::optional<std::string> const &index = {}) const;
 
         arrow::Result<std::shared_ptr<arrow::Buffer>>
         toBinary(std::vector<std::string> columns = {}, std::optional<std::string> const &index = {},
@@ -406,10 +478,10 @@ namespace pd {
                                    const std::optional<Scalar> &fillValue = std::nullopt) const noexcept;
 
         Scalar at(std::shared_ptr<arrow::Scalar> const &row, std::string const &col) const {
-            return at(
-                    arrow::compute::Index(m_index,
-                                          arrow::compute::IndexOptions(row))->scalar_as<arrow::Int64Scalar>().value,
-                    col);
+            arrow::compute::IndexOptions options(row);
+            return at(pd::ReturnOrThrowOnFailure(pd::CallFunction("index", {m_index}, &options))
+                              .scalar_as<arrow::Int64Scalar>().value,
+                      col);
         }
 
         template<typename T>
@@ -451,7 +523,7 @@ namespace pd {
         DataFrame setColumns(std::vector<std::string> const &column_names);
 
         bool equals_(NDFrame<arrow::RecordBatch> const &other) const override {
-            return m_array->Equals(*other.m_array) && m_index->Equals(other.indexArray());
+            return m_array->Equals(*other.m_array) && m_index.equals(other.labels());
         }
 
         template<typename T>
@@ -557,9 +629,27 @@ namespace pd {
 
         [[nodiscard]] DataFrame sort_index(bool ascending = true, bool ignore_index = false);
 
+        /// one stable lexicographic permutation over all `by` keys, gathered into every column and the index
+        [[nodiscard]] DataFrame sort_values(
+                std::vector<std::string> const &by,
+                bool ascending = true,
+                arrow::compute::NullPlacement na_position = arrow::compute::NullPlacement::AtEnd,
+                bool ignore_index = false) const;
+
+        /// per key ascending / na_position, an empty na_position keeps nulls at the end
         [[nodiscard]] DataFrame sort_values(
                 std::vector<std::string> const &by,
-                bool ascending = true);
+                std::vector<bool> const &ascending,
+                std::vector<arrow::compute::NullPlacement> const &na_position = {},
+                bool ignore_index = false) const;
+
+        /// the `n` rows with the largest `columns` values in descending order, without a full sort
+        [[nodiscard]] DataFrame nlargest(int64_t n, std::vector<std::string> const &columns) const;
+
+        [[nodiscard]] DataFrame nsmallest(int64_t n, std::vector<std::string> const &columns) const;
+
+        /// gathers every column and the index at `indices` in parallel
+        [[nodiscard]] DataFrame takeRows(std::shared_ptr<arrow::UInt64Array> const &indices, bool ignore_index) const;
 
         [[nodiscard]] class GroupBy group_by(std::string const &) const;
         [[nodiscard]] GroupBy group_by(const ArrayPtr& key) const;
@@ -661,7 +751,7 @@ namespace pd {
                 typename ColumnType=double,
                 typename ...NameType>
         V hmVisit(V &&visitor, NameType &&... names) const {
-            if ((m_index->type()->id() != arrow::Type::INT64 && m_index->type()->id() != arrow::Type::TIMESTAMP)) {
+            if ((m_index.type()->id() != arrow::Type::INT64 && m_index.type()->id() != arrow::Type::TIMESTAMP)) {
                 throw std::runtime_error("invalid index for hwdf Visitor only int64 are allowed.");
             }
 
@@ -693,6 +783,22 @@ namespace pd {
             return std::forward<V>(visitor);
         }
 
+        /// streams the named columns, which may differ in type and hold nulls, to
+        /// visitor(firstRow, ColumnView<ColumnTypes>...) chunk by chunk, see pd::visitColumns
+        template<typename... ColumnTypes, typename V>
+        V visit(V visitor,
+                std::array<std::string, sizeof...(ColumnTypes)> const &names,
+                VisitOptions const &options = {}) const {
+            std::array<ArrayPtr, sizeof...(ColumnTypes)> columns;
+            for (size_t i = 0; i < names.size(); i++) {
+                columns[i] = m_array->GetColumnByName(names[i]);
+                if (!columns[i]) {
+                    throw std::runtime_error(fmt::format("Column '{}' does not exist.", names[i]));
+                }
+            }
+            return visitColumns<ColumnTypes...>(std::move(visitor), columns, options);
+        }
+
         template<typename ReturnT, typename FunctionSignature>
         Series rolling(FunctionSignature &&fn, int64_t window) const {
             return rollingT<false, ReturnT, Series, DataFrame>(std::forward<FunctionSignature>(fn), window, m_array, m_index);
@@ -715,7 +821,7 @@ namespace pd {
             std::vector<ColumnTypes> &&... columnData)
             : NDFrame<arrow::RecordBatch>(std::get<0>(std::forward_as_tuple(columnData...)).size(), _index) {
 
-        if (m_index->length() == 0) {
+        if (m_index.length() == 0) {
             throw std::runtime_error("Cannot Create DataFrame with empty columns");
         }
 
@@ -742,7 +848,7 @@ namespace pd {
             : NDFrame<arrow::RecordBatch>(std::get<0>(std::forward_as_tuple(columnData...)).second.size(), _index) {
         static_assert(sizeof...(columnData) > 0, "Cannot Create DataFrame with empty columns");
 
-        int64_t nRows = m_index->length();
+        int64_t nRows = m_index.length();
 
         arrow::ArrayVector arrays(N);
         arrow::FieldVector fields(N);
@@ -781,7 +887,7 @@ namespace pd {
             throw std::runtime_error("Cannot Create DataFrame with empty columns");
         }
 
-        int64_t nRows = m_index->length();
+        int64_t nRows = m_index.length();
 
         auto [fields, arrays] = makeFieldArrayPair(table);
 
@@ -812,7 +918,7 @@ namespace pd {
                 columns.begin(),
                 arrays.begin(),
                 [&fields](std::vector<T> const &column, std::string const &name) {
-                    typename arrow::CTypeTraits<T>::BuilderType builder;
+                    typename arrow::CTypeTraits<T>::BuilderType builder(pd::GetMemoryPool());
                     arrow::Status status;
                     if constexpr (std::is_floating_point_v<T>) {
                         status = builder.AppendValues(column, makeValidFlags(column));
@@ -849,7 +955,7 @@ namespace pd {
                 table.end(),
                 arrays.begin(),
                 [&fields](std::pair<std::string, V> const &columnItem) {
-                    typename arrow::CTypeTraits<T>::BuilderType builder;
+                    typename arrow::CTypeTraits<T>::BuilderType builder(pd::GetMemoryPool());
 
                     auto [name, column] = columnItem;
 
@@ -888,7 +994,7 @@ namespace pd {
             using T = std::tuple_element_t<I, TupleT>;
             using Type = arrow::CTypeTraits<T>;
 
-            typename Type::BuilderType builder;
+            typename Type::BuilderType builder(pd::GetMemoryPool());
             auto column = std::get<I>(columnData);
 
             if constexpr (std::is_floating_point_v<T>) {
@@ -932,7 +1038,7 @@ namespace pd {
             using T = std::tuple_element_t<I, TupleT>;
             using Type = arrow::CTypeTraits<T>;
 
-            typename Type::BuilderType builder;
+            typename Type::BuilderType builder(pd::GetMemoryPool());
             auto [name, column] = std::get<I>(columnData);
 
             arrow::Status status;
@@ -0,0 +1,173 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "dataset.h"
+#include <arrow/compute/api.h>
+#include <arrow/dataset/plan.h>
+#include <arrow/filesystem/localfs.h>
+#include <filesystem>
+#include <mutex>
+#include "aws_s3_reader.h"
+#include "tracing.h"
+
+
+namespace pd {
+
+    namespace cp = arrow::compute;
+    namespace ds = arrow::dataset;
+
+    static DataFrame toFrame(std::shared_ptr<arrow::RecordBatch> const &batch, std::string const &index) {
+        auto i = batch->schema()->GetFieldIndex(index);
+        if (i < 0) {
+            return DataFrame{batch};
+        }
+        auto labels = batch->column(i);
+        return DataFrame{ReturnOrThrowOnFailure(batch->RemoveColumn(i)), labels};
+    }
+
+    DatasetStream::DatasetStream(std::shared_ptr<arrow::RecordBatchReader> reader, std::string index)
+            : m_reader(std::move(reader)), m_index(std::move(index)) {
+    }
+
+    std::optional<DataFrame> DatasetStream::next() {
+        std::shared_ptr<arrow::RecordBatch> batch;
+        ThrowOnFailure(m_reader->ReadNext(&batch));
+        if (not batch) {
+            return std::nullopt;
+        }
+        return toFrame(batch, m_index);
+    }
+
+    Dataset::Dataset(std::shared_ptr<ds::Dataset> dataset, DatasetOptions options)
+            : m_dataset(std::move(dataset)), m_options(std::move(options)), m_filter(cp::literal(true)) {
+    }
+
+    Dataset Dataset::open(std::string const &uri, DatasetOptions const &options) {
+        if (uri.starts_with("s3://")) {
+            return open(arrow::AWSS3Reader::Instance().filesystem(), uri.substr(5), options);
+        }
+        return open(std::make_shared<arrow::fs::LocalFileSystem>(), std::filesystem::absolute(uri).string(), options);
+    }
+
+    Dataset Dataset::open(
+            std::shared_ptr<arrow::fs::FileSystem> const &filesystem,
+            std::string const &root,
+            DatasetOptions const &options) {
+        PD_TRACE_SCOPE("Dataset::open");
+        // registers the scan node the scanner plans are built from
+        static std::once_flag initialized;
+        std::call_once(initialized, ds::internal::Initialize);
+
+        arrow::fs::FileSelector selector;
+        selector.base_dir = root;
+        selector.recursive = true;
+
+        ds::HivePartitioningFactoryOptions partitioning;
+        partitioning.schema = options.partitionSchema;
+
+        ds::FileSystemFactoryOptions factoryOptions;
+        factoryOptions.partitioning = ds::HivePartitioning::MakeFactory(partitioning);
+        factoryOptions.partition_base_dir = root;
+
+        auto factory = ReturnOrThrowOnFailure(ds::FileSystemDatasetFactory::Make(
+                filesystem, selector, std::make_shared<ds::ParquetFileFormat>(), factoryOptions));
+        return Dataset{ReturnOrThrowOnFailure(factory->Finish()), options};
+    }
+
+    std::shared_ptr<arrow::Scalar> Dataset::castTo(
+            std::string const &column,
+            std::shared_ptr<arrow::Scalar> const &value) const {
+        auto field = m_dataset->schema()->GetFieldByName(column);
+        if (not field) {
+            throw std::runtime_error("Dataset has no column named " + column);
+        }
+        return value->type->Equals(field->type()) ? value : ReturnOrThrowOnFailure(value->CastTo(field->type()));
+    }
+
+    Dataset Dataset::filter(cp::Expression const &expression) const {
+        auto result = *this;
+        result.m_filter = cp::and_(m_filter, expression);
+        return result;
+    }
+
+    Dataset Dataset::between(ptime const &start, ptime const &end) const {
+        auto lower = castTo(m_options.index, std::make_shared<arrow::TimestampScalar>(pd::fromPTime(start), arrow::timestamp(arrow::TimeUnit::NANO)));
+        auto upper = castTo(m_options.index, std::make_shared<arrow::TimestampScalar>(pd::fromPTime(end), arrow::timestamp(arrow::TimeUnit::NANO)));
+        auto range = cp::and_(cp::greater_equal(cp::field_ref(m_options.index), cp::literal(lower)),
+                              cp::less(cp::field_ref(m_options.index), cp::literal(upper)));
+
+        // ISO dates order like the days they name, so the date partitions prune as strings
+        if (m_dataset->schema()->GetFieldByName(m_options.datePartition)) {
+            auto lastDay = end.time_of_day().ticks() == 0 ? end.date() - days(1) : end.date();
+            auto first = castTo(m_options.datePartition, arrow::MakeScalar(to_iso_extended_string(start.date())));
+            auto last = castTo(m_options.datePartition, arrow::MakeScalar(to_iso_extended_string(lastDay)));
+            range = cp::and_({range,
+                              cp::greater_equal(cp::field_ref(m_options.datePartition), cp::literal(first)),
+                              cp::less_equal(cp::field_ref(m_options.datePartition), cp::literal(last))});
+        }
+        return filter(range);
+    }
+
+    Dataset Dataset::where(std::string const &column, Scalar const &value) const {
+        return filter(cp::equal(cp::field_ref(column), cp::literal(castTo(column, value.value()))));
+    }
+
+    Dataset Dataset::isin(std::string const &column, std::vector<Scalar> const &values) const {
+        arrow::ScalarVector casted(values.size());
+        std::ranges::transform(values, casted.begin(), [&](Scalar const &value) { return castTo(column, value.value()); });
+
+        auto builder = ReturnOrThrowOnFailure(
+                arrow::MakeBuilder(m_dataset->schema()->GetFieldByName(column)->type(), pd::GetMemoryPool()));
+        ThrowOnFailure(builder->AppendScalars(casted));
+        cp::SetLookupOptions options{ReturnOrThrowOnFailure(builder->Finish())};
+        return filter(cp::call("is_in", {cp::field_ref(column)}, options));
+    }
+
+    Dataset Dataset::select(std::vector<std::string> const &columns) const {
+        auto result = *this;
+        result.m_columns = columns;
+        if (m_dataset->schema()->GetFieldByName(m_options.index) and
+            std::ranges::find(columns, m_options.index) == columns.end()) {
+            result.m_columns.push_back(m_options.index);
+        }
+        return result;
+    }
+
+    std::shared_ptr<arrow::Schema> Dataset::schema() const {
+        return m_dataset->schema();
+    }
+
+    std::vector<std::string> Dataset::files() const {
+        auto predicate = ReturnOrThrowOnFailure(m_filter.Bind(*m_dataset->schema()));
+        auto fragments = ReturnOrThrowOnFailure(ReturnOrThrowOnFailure(m_dataset->GetFragments(predicate)).ToVector());
+        std::vector<std::string> paths(fragments.size());
+        std::ranges::transform(fragments, paths.begin(), [](auto const &fragment) {
+            return std::static_pointer_cast<ds::FileFragment>(fragment)->source().path();
+        });
+        return paths;
+    }
+
+    std::shared_ptr<ds::Scanner> Dataset::scanner() const {
+        ds::ScannerBuilder builder(m_dataset);
+        ThrowOnFailure(builder.Filter(m_filter));
+        if (not m_columns.empty()) {
+            ThrowOnFailure(builder.Project(m_columns));
+        }
+        ThrowOnFailure(builder.UseThreads(true));
+        ThrowOnFailure(builder.BatchSize(m_options.batchSize));
+        ThrowOnFailure(builder.BatchReadahead(m_options.batchReadahead));
+        ThrowOnFailure(builder.FragmentReadahead(m_options.fragmentReadahead));
+        ThrowOnFailure(builder.Pool(pd::GetMemoryPool()));
+        return ReturnOrThrowOnFailure(builder.Finish());
+    }
+
+    DataFrame Dataset::read() const {
+        PD_TRACE_SCOPE("Dataset::read");
+        auto table = ReturnOrThrowOnFailure(scanner()->ToTable());
+        return toFrame(ReturnOrThrowOnFailure(table->CombineChunksToBatch(pd::GetMemoryPool())), m_options.index);
+    }
+
+    DatasetStream Dataset::stream() const {
+        return {ReturnOrThrowOnFailure(scanner()->ToRecordBatchReader()), m_options.index};
+    }
+}
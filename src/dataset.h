@@ -0,0 +1,89 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/compute/expression.h>
+#include <arrow/dataset/api.h>
+#include <optional>
+#include "dataframe.h"
+
+
+namespace pd {
+
+    struct DatasetOptions {
+        /// type of the hive partition keys (key=value directories), inferred from the paths when null
+        std::shared_ptr<arrow::Schema> partitionSchema{nullptr};
+        /// column holding the frame index, as written by DataFrame::toParquet
+        std::string index{"index"};
+        /// partition key holding the YYYY-MM-DD date of its rows, between() prunes whole
+        /// directories on it when the dataset is partitioned that way
+        std::string datePartition{"date"};
+        /// memory is bounded by fragmentReadahead files of batchReadahead batches each
+        int64_t batchSize{1 << 17};
+        int32_t batchReadahead{4};
+        int32_t fragmentReadahead{4};
+    };
+
+    /// Stream of frames over the batches of a scan, in file order
+    class DatasetStream {
+    public:
+        DatasetStream(std::shared_ptr<arrow::RecordBatchReader> reader, std::string index);
+
+        /// nullopt once the scan is exhausted
+        std::optional<DataFrame> next();
+
+    private:
+        std::shared_ptr<arrow::RecordBatchReader> m_reader;
+        std::string m_index;
+    };
+
+    /// Parquet files under a local directory or an s3:// prefix read as one frame.
+    /// Filters are pushed into the scan: partitions whose keys cannot match are never
+    /// opened and row groups are skipped on their statistics. Filtering returns a new
+    /// Dataset sharing the discovered files.
+    class Dataset {
+    public:
+        static Dataset open(std::string const &uri, DatasetOptions const &options = {});
+
+        static Dataset open(
+                std::shared_ptr<arrow::fs::FileSystem> const &filesystem,
+                std::string const &root,
+                DatasetOptions const &options = {});
+
+        /// rows whose index lies in [start, end)
+        [[nodiscard]] Dataset between(ptime const &start, ptime const &end) const;
+
+        [[nodiscard]] Dataset where(std::string const &column, Scalar const &value) const;
+
+        [[nodiscard]] Dataset isin(std::string const &column, std::vector<Scalar> const &values) const;
+
+        [[nodiscard]] Dataset filter(arrow::compute::Expression const &expression) const;
+
+        /// the index column is always read
+        [[nodiscard]] Dataset select(std::vector<std::string> const &columns) const;
+
+        [[nodiscard]] std::shared_ptr<arrow::Schema> schema() const;
+
+        /// files left after partition pruning
+        [[nodiscard]] std::vector<std::string> files() const;
+
+        [[nodiscard]] DataFrame read() const;
+
+        [[nodiscard]] DatasetStream stream() const;
+
+    private:
+        Dataset(std::shared_ptr<arrow::dataset::Dataset> dataset, DatasetOptions options);
+
+        std::shared_ptr<arrow::dataset::Dataset> m_dataset;
+        DatasetOptions m_options;
+        arrow::compute::Expression m_filter;
+        std::vector<std::string> m_columns;
+
+        [[nodiscard]] std::shared_ptr<arrow::dataset::Scanner> scanner() const;
+
+        [[nodiscard]] std::shared_ptr<arrow::Scalar> castTo(
+                std::string const &column,
+                std::shared_ptr<arrow::Scalar> const &value) const;
+    };
+}
@@ -0,0 +1,339 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "describe.h"
+#include <arrow/compute/api.h>
+#include <arrow/util/hashing.h>
+#include <bit>
+#include <cmath>
+#include <optional>
+#include <string_view>
+#include "exec_context.h"
+#include "scheduler.h"
+#include "sketch.h"
+
+
+namespace pd {
+
+    namespace {
+        constexpr int64_t MIN_BLOCK_SIZE = 1 << 16;
+        // bounds the number of partial states (and sketches) alive at once
+        constexpr int64_t MAX_BLOCKS = 256;
+
+        struct Moments {
+            int64_t count{0};
+            double mean{0};
+            double m2{0};
+
+            void add(double x) {
+                count++;
+                const double delta = x - mean;
+                mean += delta / static_cast<double>(count);
+                m2 += delta * (x - mean);
+            }
+
+            /// Chan et al. pairwise update
+            void merge(Moments const &other) {
+                if (other.count == 0) {
+                    return;
+                }
+                if (count == 0) {
+                    *this = other;
+                    return;
+                }
+                const auto n = static_cast<double>(count + other.count);
+                const double delta = other.mean - mean;
+                mean += delta * static_cast<double>(other.count) / n;
+                m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / n;
+                count += other.count;
+            }
+        };
+
+        struct Sketches {
+            std::optional<HyperLogLog> hll;
+            std::optional<TDigest> digest;
+
+            Sketches(bool cardinality, bool quantiles) {
+                if (cardinality) {
+                    hll.emplace();
+                }
+                if (quantiles) {
+                    digest.emplace();
+                }
+            }
+
+            void merge(Sketches const &other) {
+                if (hll) {
+                    hll->merge(*other.hll);
+                }
+                if (digest) {
+                    digest->merge(*other.digest);
+                }
+            }
+        };
+
+        template<class CType>
+        uint64_t hashValue(CType value) {
+            if constexpr (std::is_floating_point_v<CType>) {
+                return mixHash(std::bit_cast<uint64_t>(value == 0 ? 0.0 : static_cast<double>(value)));
+            } else {
+                return mixHash(static_cast<uint64_t>(value));
+            }
+        }
+
+        template<class CType>
+        struct NumericState {
+            Moments moments;
+            std::optional<CType> min, max;
+            int64_t nan{0};
+            Sketches sketches;
+
+            NumericState(bool cardinality, bool quantiles) : sketches(cardinality, quantiles) {}
+
+            void add(CType value) {
+                if constexpr (std::is_floating_point_v<CType>) {
+                    if (std::isnan(value)) {
+                        nan++;
+                        return;
+                    }
+                }
+                moments.add(static_cast<double>(value));
+                min = min ? std::min(*min, value) : value;
+                max = max ? std::max(*max, value) : value;
+                if (sketches.hll) {
+                    sketches.hll->add(hashValue(value));
+                }
+                if (sketches.digest) {
+                    sketches.digest->add(static_cast<double>(value));
+                }
+            }
+
+            void merge(NumericState const &other) {
+                moments.merge(other.moments);
+                if (other.min) {
+                    min = min ? std::min(*min, *other.min) : other.min;
+                    max = max ? std::max(*max, *other.max) : other.max;
+                }
+                nan += other.nan;
+                sketches.merge(other.sketches);
+            }
+        };
+
+        struct StringState {
+            int64_t count{0};
+            std::optional<std::string_view> min, max;
+            Sketches sketches;
+
+            StringState(bool cardinality, bool) : sketches(cardinality, false) {}
+
+            void add(std::string_view value) {
+                count++;
+                min = min ? std::min(*min, value) : value;
+                max = max ? std::max(*max, value) : value;
+                if (sketches.hll) {
+                    sketches.hll->add(arrow::internal::ComputeStringHash<0>(value.data(),
+                                                                            static_cast<int64_t>(value.size())));
+                }
+            }
+
+            void merge(StringState const &other) {
+                count += other.count;
+                if (other.min) {
+                    min = min ? std::min(*min, *other.min) : other.min;
+                    max = max ? std::max(*max, *other.max) : other.max;
+                }
+                sketches.merge(other.sketches);
+            }
+        };
+
+        /// splits the column into row blocks, accumulates every block in parallel and merges
+        /// the partial states in block order so results do not depend on the scheduling
+        template<class State, class ArrayType>
+        State fusedPass(ArrayType const &array, bool cardinality, bool quantiles) {
+            const int64_t length = array.length();
+            const int64_t blockSize = std::max(MIN_BLOCK_SIZE, (length + MAX_BLOCKS - 1) / MAX_BLOCKS);
+            const int64_t numBlocks = std::max<int64_t>(1, (length + blockSize - 1) / blockSize);
+
+            std::vector<State> partials(numBlocks, State(cardinality, quantiles));
+            pd::parallel_for(int64_t{0}, numBlocks, pd::bindExecContext([&](int64_t block) {
+                auto &state = partials[block];
+                const int64_t end = std::min(length, (block + 1) * blockSize);
+                for (int64_t i = block * blockSize; i < end; i++) {
+                    if (array.IsValid(i)) {
+                        state.add(array.GetView(i));
+                    }
+                }
+            }));
+
+            for (int64_t block = 1; block < numBlocks; block++) {
+                partials[0].merge(partials[block]);
+            }
+            return std::move(partials[0]);
+        }
+
+        int64_t exactDistinct(ArrayPtr const &column) {
+            arrow::compute::CountOptions options{arrow::compute::CountOptions::ONLY_VALID};
+            return ReturnOrThrowOnFailure(pd::CallFunction("count_distinct", {column}, &options))
+                    .scalar_as<arrow::Int64Scalar>().value;
+        }
+
+        std::vector<double> exactQuantiles(ArrayPtr const &column, std::vector<double> const &q) {
+            arrow::compute::QuantileOptions options{q, arrow::compute::QuantileOptions::LINEAR};
+            auto result = ReturnOrThrowOnFailure(pd::CallFunction("quantile", {column}, &options)).make_array();
+            auto const &doubles = static_cast<arrow::DoubleArray const &>(*result);
+
+            std::vector<double> out(q.size(), std::numeric_limits<double>::quiet_NaN());
+            for (int64_t i = 0; i < std::min<int64_t>(doubles.length(), static_cast<int64_t>(q.size())); i++) {
+                if (doubles.IsValid(i)) {
+                    out[i] = doubles.Value(i);
+                }
+            }
+            return out;
+        }
+
+        template<class ArrowType>
+        ColumnSummary summarizeNumeric(ArrayPtr const &column,
+                                       ArrayPtr const &physical,
+                                       DescribeOptions const &options,
+                                       bool sketch) {
+            using CType = typename ArrowType::c_type;
+            using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+
+            const bool quantiles = !options.percentiles.empty();
+            auto state = fusedPass<NumericState<CType>>(
+                    static_cast<ArrayType const &>(*physical), sketch, sketch and quantiles);
+
+            auto const &type = column->type();
+            const bool temporal = arrow::is_temporal(type->id());
+
+            ColumnSummary summary;
+            summary.count = state.moments.count;
+            summary.mean = arrow::MakeNullScalar(arrow::float64());
+            summary.std = arrow::MakeNullScalar(arrow::float64());
+            if (not temporal) {
+                if (state.moments.count > 0) {
+                    summary.mean = arrow::MakeScalar(state.moments.mean);
+                }
+                if (state.moments.count > 1) {
+                    summary.std = arrow::MakeScalar(
+                            std::sqrt(state.moments.m2 / static_cast<double>(state.moments.count - 1)));
+                }
+            }
+            summary.min = state.min ? ReturnOrThrowOnFailure(arrow::MakeScalar(type, *state.min)) :
+                          arrow::MakeNullScalar(type);
+            summary.max = state.max ? ReturnOrThrowOnFailure(arrow::MakeScalar(type, *state.max)) :
+                          arrow::MakeNullScalar(type);
+            summary.nunique = sketch ? state.sketches.hll->estimate() :
+                              exactDistinct(physical) - (state.nan > 0 ? 1 : 0);
+
+            if (quantiles) {
+                std::vector<double> values;
+                if (sketch) {
+                    for (auto q: options.percentiles) {
+                        values.push_back(state.sketches.digest->quantile(q));
+                    }
+                } else {
+                    values = exactQuantiles(physical, options.percentiles);
+                }
+
+                for (auto v: values) {
+                    if (std::isnan(v) or state.moments.count == 0) {
+                        summary.percentiles.push_back(arrow::MakeNullScalar(temporal ? type : arrow::float64()));
+                    } else if (temporal) {
+                        summary.percentiles.push_back(
+                                ReturnOrThrowOnFailure(arrow::MakeScalar(type, static_cast<CType>(std::llround(v)))));
+                    } else {
+                        summary.percentiles.push_back(arrow::MakeScalar(v));
+                    }
+                }
+            }
+            return summary;
+        }
+
+        template<class ArrowType>
+        ColumnSummary summarizeString(ArrayPtr const &column, DescribeOptions const &options, bool sketch) {
+            using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+            auto state = fusedPass<StringState>(static_cast<ArrayType const &>(*column), sketch, false);
+
+            auto const &type = column->type();
+            ColumnSummary summary;
+            summary.count = state.count;
+            summary.mean = arrow::MakeNullScalar(arrow::float64());
+            summary.std = arrow::MakeNullScalar(arrow::float64());
+            summary.min = state.min ? ReturnOrThrowOnFailure(arrow::MakeScalar(type, std::string(*state.min))) :
+                          arrow::MakeNullScalar(type);
+            summary.max = state.max ? ReturnOrThrowOnFailure(arrow::MakeScalar(type, std::string(*state.max))) :
+                          arrow::MakeNullScalar(type);
+            summary.nunique = sketch ? state.sketches.hll->estimate() : exactDistinct(column);
+            summary.percentiles.assign(options.percentiles.size(), arrow::MakeNullScalar(arrow::float64()));
+            return summary;
+        }
+
+        /// bool, decimal, dictionary ... : arrow kernels, only count / nunique / min / max
+        ColumnSummary summarizeGeneric(ArrayPtr const &column, DescribeOptions const &options) {
+            auto const &type = column->type();
+            ColumnSummary summary;
+            summary.count = column->length() - column->null_count();
+            summary.mean = arrow::MakeNullScalar(arrow::float64());
+            summary.std = arrow::MakeNullScalar(arrow::float64());
+            summary.min = arrow::MakeNullScalar(type);
+            summary.max = arrow::MakeNullScalar(type);
+            summary.percentiles.assign(options.percentiles.size(), arrow::MakeNullScalar(arrow::float64()));
+
+            if (type->id() == arrow::Type::NA) {
+                return summary;
+            }
+            summary.nunique = exactDistinct(column);
+
+            auto minMax = pd::CallFunction("min_max", {column});
+            if (minMax.ok()) {
+                auto const &result = minMax->scalar_as<arrow::StructScalar>();
+                summary.min = result.value[0];
+                summary.max = result.value[1];
+            }
+            return summary;
+        }
+    }
+
+    ColumnSummary summarize(ArrayPtr const &column, DescribeOptions const &options) {
+        const bool sketch = !options.exact and column->length() > options.sketch_threshold;
+
+        auto const &type = column->type();
+        ArrayPtr physical = column;
+        auto id = type->id();
+        if (arrow::is_temporal(id) or id == arrow::Type::DURATION) {
+            auto bitWidth = static_cast<arrow::FixedWidthType const &>(*type).bit_width();
+            physical = ReturnOrThrowOnFailure(column->View(bitWidth == 32 ? arrow::int32() : arrow::int64()));
+            id = physical->type_id();
+        }
+
+        switch (id) {
+            case arrow::Type::INT8:
+                return summarizeNumeric<arrow::Int8Type>(column, physical, options, sketch);
+            case arrow::Type::INT16:
+                return summarizeNumeric<arrow::Int16Type>(column, physical, options, sketch);
+            case arrow::Type::INT32:
+                return summarizeNumeric<arrow::Int32Type>(column, physical, options, sketch);
+            case arrow::Type::INT64:
+                return summarizeNumeric<arrow::Int64Type>(column, physical, options, sketch);
+            case arrow::Type::UINT8:
+                return summarizeNumeric<arrow::UInt8Type>(column, physical, options, sketch);
+            case arrow::Type::UINT16:
+                return summarizeNumeric<arrow::UInt16Type>(column, physical, options, sketch);
+            case arrow::Type::UINT32:
+                return summarizeNumeric<arrow::UInt32Type>(column, physical, options, sketch);
+            case arrow::Type::UINT64:
+                return summarizeNumeric<arrow::UInt64Type>(column, physical, options, sketch);
+            case arrow::Type::FLOAT:
+                return summarizeNumeric<arrow::FloatType>(column, physical, options, sketch);
+            case arrow::Type::DOUBLE:
+                return summarizeNumeric<arrow::DoubleType>(column, physical, options, sketch);
+            case arrow::Type::STRING:
+                return summarizeString<arrow::StringType>(column, options, sketch);
+            case arrow::Type::LARGE_STRING:
+                return summarizeString<arrow::LargeStringType>(column, options, sketch);
+            default:
+                return summarizeGeneric(column, options);
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <vector>
+#include "core.h"
+
+
+namespace pd {
+
+    struct DescribeOptions {
+        /// false drops columns of the null type
+        bool include_all{true};
+        std::vector<double> percentiles{};
+        /// exact nunique and percentiles on every column, otherwise columns longer than
+        /// sketch_threshold are summarised with HyperLogLog and t-digest sketches
+        bool exact{false};
+        int64_t sketch_threshold{1 << 16};
+    };
+
+    /// Statistics of one column gathered in a single fused pass.
+    /// mean / std are only set for numeric columns; min, max and the percentiles keep the
+    /// column type for temporal columns and percentiles are null for string like columns.
+    struct ColumnSummary {
+        int64_t count{0};
+        std::shared_ptr<arrow::Scalar> mean, std, min, max;
+        int64_t nunique{0};
+        arrow::ScalarVector percentiles;
+    };
+
+    /// count, mean, M2, min, max and the sketches are accumulated together over row blocks
+    /// in parallel, so each column is read once however many statistics are requested
+    ColumnSummary summarize(ArrayPtr const &column, DescribeOptions const &options);
+}
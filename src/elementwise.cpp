@@ -0,0 +1,242 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "elementwise.h"
+#include <arrow/array/concatenate.h>
+#include <arrow/compute/registry.h>
+#include <arrow/util/bitmap_ops.h>
+#include <cstring>
+#include <limits>
+#include "core.h"
+#include "exec_context.h"
+#include "scheduler.h"
+#include "tracing.h"
+
+
+namespace pd {
+
+    namespace {
+        void copyBits(uint8_t const *source, int64_t sourceOffset, bool allSet, int64_t length, uint8_t *dest,
+                      int64_t destOffset) {
+            if (allSet) {
+                arrow::bit_util::SetBitsTo(dest, destOffset, length, true);
+            } else {
+                arrow::internal::CopyBitmap(source, sourceOffset, length, dest, destOffset);
+            }
+        }
+
+        template<class ArrayType, class Offset>
+        void copyBinary(arrow::Array const &piece, Offset dataStart, int64_t rowStart, bool last,
+                        Offset *offsets, uint8_t *data) {
+            auto const &values = static_cast<ArrayType const &>(piece);
+            auto const *source = values.raw_value_offsets();
+            const int64_t length = values.length();
+            const Offset base = source[0];
+            for (int64_t i = 0; i < length; i++) {
+                offsets[rowStart + i] = source[i] - base + dataStart;
+            }
+            if (last) {
+                offsets[rowStart + length] = source[length] - base + dataStart;
+            }
+            std::memcpy(data + dataStart, values.value_data()->data() + base, source[length] - base);
+        }
+
+        template<class ArrayType, class Offset>
+        arrow::Result<std::shared_ptr<arrow::Buffer>> stitchBinary(arrow::ArrayVector const &pieces,
+                                                                   std::vector<int64_t> const &rowStart,
+                                                                   std::shared_ptr<arrow::Buffer> &offsets) {
+            std::vector<int64_t> dataStart(pieces.size() + 1, 0);
+            for (size_t i = 0; i < pieces.size(); i++) {
+                auto const &values = static_cast<ArrayType const &>(*pieces[i]);
+                dataStart[i + 1] = dataStart[i] + values.value_offset(values.length()) - values.value_offset(0);
+            }
+            if (dataStart.back() > std::numeric_limits<Offset>::max()) {
+                return arrow::Status::CapacityError("stitched binary data does not fit its offsets");
+            }
+
+            ARROW_ASSIGN_OR_RAISE(offsets, arrow::AllocateBuffer((rowStart.back() + 1) * sizeof(Offset), pd::GetMemoryPool()));
+            ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Buffer> data, arrow::AllocateBuffer(dataStart.back(), pd::GetMemoryPool()));
+            auto *offsetData = reinterpret_cast<Offset *>(offsets->mutable_data());
+            offsetData[0] = 0;
+            pd::parallel_for(size_t{0}, pieces.size(), pd::bindExecContext([&](size_t i) {
+                copyBinary<ArrayType, Offset>(*pieces[i], static_cast<Offset>(dataStart[i]), rowStart[i],
+                                              i + 1 == pieces.size(), offsetData, data->mutable_data());
+            }));
+            return data;
+        }
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Array>> Stitch(arrow::ArrayVector const &pieces) {
+        if (pieces.empty()) {
+            return arrow::Status::Invalid("Stitch needs at least one piece");
+        }
+        if (pieces.size() == 1) {
+            return pieces.front();
+        }
+
+        auto const &type = pieces.front()->type();
+        const auto id = type->id();
+        const int width = fixedByteWidth(*type);
+        const bool boolean = id == arrow::Type::BOOL;
+        const bool binary = id == arrow::Type::STRING or id == arrow::Type::BINARY;
+        const bool largeBinary = id == arrow::Type::LARGE_STRING or id == arrow::Type::LARGE_BINARY;
+        const bool sameType = std::ranges::all_of(pieces, [&](auto const &piece) { return piece->type()->Equals(*type); });
+        if (not sameType or not(width > 0 or boolean or binary or largeBinary)) {
+            return arrow::Concatenate(pieces, pd::GetMemoryPool());
+        }
+
+        PD_TRACE_SCOPE("Stitch");
+        std::vector<int64_t> rowStart(pieces.size() + 1, 0);
+        int64_t nullCount = 0;
+        bool wholeBytes = true;
+        for (size_t i = 0; i < pieces.size(); i++) {
+            rowStart[i + 1] = rowStart[i] + pieces[i]->length();
+            nullCount += pieces[i]->null_count();
+            wholeBytes = wholeBytes and (i + 1 == pieces.size() or pieces[i]->length() % 8 == 0);
+        }
+        const int64_t length = rowStart.back();
+
+        std::shared_ptr<arrow::Buffer> validity, values, data;
+        if (nullCount > 0) {
+            ARROW_ASSIGN_OR_RAISE(validity, arrow::AllocateBuffer(arrow::bit_util::BytesForBits(length), pd::GetMemoryPool()));
+        }
+        if (binary) {
+            ARROW_ASSIGN_OR_RAISE(data, (stitchBinary<arrow::BinaryArray, int32_t>(pieces, rowStart, values)));
+        } else if (largeBinary) {
+            ARROW_ASSIGN_OR_RAISE(data, (stitchBinary<arrow::LargeBinaryArray, int64_t>(pieces, rowStart, values)));
+        } else {
+            ARROW_ASSIGN_OR_RAISE(values, arrow::AllocateBuffer(boolean ? arrow::bit_util::BytesForBits(length) : length * width,
+                                                                pd::GetMemoryPool()));
+        }
+
+        // neighbouring pieces share a byte of each bitmap unless the earlier one ends on a byte boundary
+        auto copyBitmaps = [&](size_t i) {
+            auto const &piece = *pieces[i];
+            if (validity) {
+                copyBits(piece.null_bitmap_data(), piece.offset(), piece.null_count() == 0, piece.length(),
+                         validity->mutable_data(), rowStart[i]);
+            }
+            if (boolean) {
+                copyBits(piece.data()->buffers[1]->data(), piece.offset(), false, piece.length(),
+                         values->mutable_data(), rowStart[i]);
+            }
+        };
+        pd::parallel_for(size_t{0}, pieces.size(), pd::bindExecContext([&](size_t i) {
+            if (width > 0) {
+                auto const &piece = *pieces[i];
+                std::memcpy(values->mutable_data() + rowStart[i] * width,
+                            piece.data()->buffers[1]->data() + piece.offset() * width,
+                            piece.length() * width);
+            }
+            if (wholeBytes) {
+                copyBitmaps(i);
+            }
+        }));
+        if (not wholeBytes) {
+            for (size_t i = 0; i < pieces.size(); i++) {
+                copyBitmaps(i);
+            }
+        }
+
+        arrow::BufferVector buffers{validity, values};
+        if (data) {
+            buffers.push_back(data);
+        }
+        return arrow::MakeArray(arrow::ArrayData::Make(type, length, std::move(buffers), nullCount));
+    }
+
+    arrow::Result<arrow::Datum> CallElementwise(
+            std::string const &name,
+            std::vector<arrow::Datum> const &args,
+            arrow::compute::FunctionOptions const *options) {
+        auto const ctx = GetExecContext();
+
+        int64_t length = -1;
+        std::shared_ptr<arrow::ChunkedArray> layout;
+        for (auto const &arg: args) {
+            if (arg.is_array()) {
+                if (length >= 0 and arg.length() != length) {
+                    return pd::CallFunction(name, args, options);
+                }
+                length = arg.length();
+            } else if (arg.is_chunked_array()) {
+                layout = arg.chunked_array();
+            } else if (not arg.is_scalar()) {
+                return pd::CallFunction(name, args, options);
+            }
+        }
+
+        // arrays mixed with chunked arrays are left to arrow
+        const int64_t rows = layout ? layout->length() : length;
+        if (not ctx.use_threads or (layout and length >= 0) or rows < std::max<int64_t>(ctx.serial_threshold, 1)) {
+            return pd::CallFunction(name, args, options);
+        }
+        ARROW_ASSIGN_OR_RAISE(auto function, arrow::compute::GetFunctionRegistry()->GetFunction(name));
+        if (function->kind() != arrow::compute::Function::SCALAR) {
+            return pd::CallFunction(name, args, options);
+        }
+
+        if (layout) {
+            auto sameLayout = [&](arrow::ChunkedArray const &other) {
+                if (other.num_chunks() != layout->num_chunks()) {
+                    return false;
+                }
+                for (int c = 0; c < other.num_chunks(); c++) {
+                    if (other.chunk(c)->length() != layout->chunk(c)->length()) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            for (auto const &arg: args) {
+                if (arg.is_chunked_array() and not sameLayout(*arg.chunked_array())) {
+                    return pd::CallFunction(name, args, options);
+                }
+            }
+            arrow::ArrayVector chunks(layout->num_chunks());
+            std::vector<arrow::Status> statuses(layout->num_chunks());
+            pd::parallel_for(0, layout->num_chunks(), pd::bindExecContext([&](int c) {
+                std::vector<arrow::Datum> chunkArgs;
+                chunkArgs.reserve(args.size());
+                for (auto const &arg: args) {
+                    chunkArgs.emplace_back(arg.is_chunked_array() ? arrow::Datum{arg.chunked_array()->chunk(c)} : arg);
+                }
+                auto result = CallElementwise(name, chunkArgs, options);
+                statuses[c] = result.status();
+                if (result.ok()) {
+                    chunks[c] = result->make_array();
+                }
+            }));
+            for (auto const &status: statuses) {
+                ARROW_RETURN_NOT_OK(status);
+            }
+            return std::make_shared<arrow::ChunkedArray>(std::move(chunks));
+        }
+
+        // a few morsels per worker keeps per call kernel setup (e.g. is_in's hash set) from dominating
+        const int64_t workers = pd::get_parallelism();
+        const int64_t morselSize = (std::max<int64_t>(ctx.morsel_size, length / (4 * workers)) + 7) & ~int64_t{7};
+        const int64_t numMorsels = (length + morselSize - 1) / morselSize;
+
+        arrow::ArrayVector pieces(numMorsels);
+        std::vector<arrow::Status> statuses(numMorsels);
+        pd::parallel_for(int64_t{0}, numMorsels, pd::bindExecContext([&](int64_t m) {
+            const int64_t offset = m * morselSize;
+            std::vector<arrow::Datum> morselArgs;
+            morselArgs.reserve(args.size());
+            for (auto const &arg: args) {
+                morselArgs.emplace_back(arg.is_array() ? arrow::Datum{arg.make_array()->Slice(offset, morselSize)} : arg);
+            }
+            auto result = pd::CallFunction(name, morselArgs, options);
+            statuses[m] = result.status();
+            if (result.ok()) {
+                pieces[m] = result->make_array();
+            }
+        }));
+        for (auto const &status: statuses) {
+            ARROW_RETURN_NOT_OK(status);
+        }
+        ARROW_ASSIGN_OR_RAISE(auto stitched, Stitch(pieces));
+        return arrow::Datum{stitched};
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/compute/api.h>
+#include <string>
+#include <vector>
+
+
+namespace pd {
+
+    /// pd::CallFunction for scalar (elementwise) arrow functions, run in parallel over long inputs.
+    /// Array arguments are sliced into morsels of at least ExecContext::morsel_size rows, each morsel is
+    /// evaluated on a TBB worker and the results are stitched back into one array. Chunked arguments
+    /// with a common layout are evaluated chunk by chunk. Inputs shorter than
+    /// ExecContext::serial_threshold, contexts without use_threads and functions that are not
+    /// elementwise go straight to CallFunction.
+    arrow::Result<arrow::Datum> CallElementwise(
+            std::string const &name,
+            std::vector<arrow::Datum> const &args,
+            arrow::compute::FunctionOptions const *options = nullptr);
+
+    /// pieces of the same type concatenated into one array. Fixed width, boolean and (large) binary
+    /// pieces are copied into a single preallocated array in parallel, one task per piece; bitmaps
+    /// are written in parallel only when every piece but the last covers whole bytes. Other types
+    /// go through arrow::Concatenate. A single piece is returned as is.
+    arrow::Result<std::shared_ptr<arrow::Array>> Stitch(arrow::ArrayVector const &pieces);
+}
@@ -0,0 +1,190 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include "core.h"
+
+
+namespace pd {
+
+    inline double ewmCenterOfMass(double value, EWMAlphaType type) {
+        switch (type) {
+            case EWMAlphaType::CenterOfMass:
+                if (value >= 0) {
+                    return value;
+                }
+                throw std::runtime_error("EWM with COM require Value >= 0");
+            case EWMAlphaType::Span:
+                if (value >= 1) {
+                    return (value - 1) / 2;
+                }
+                throw std::runtime_error("EWM with Span require Value >= 1");
+            case EWMAlphaType::HalfLife:
+                if (value > 0) {
+                    double decay = 1 - std::exp(std::log(0.5) / value);
+                    return 1 / decay - 1;
+                }
+                throw std::runtime_error("EWM with HalfLife require Value > 0");
+            case EWMAlphaType::Alpha:
+                if (value > 0 and value <= 1) {
+                    return (1 - value) / value;
+                }
+                throw std::runtime_error("EWM with Alpha require 0 < value <= 1");
+        }
+        throw std::runtime_error("invalid EWMAlphaType");
+    }
+
+    /// Incremental exponentially weighted mean / variance.
+    /// Each update is O(1) and reproduces the value Series::ewm would return for the
+    /// last row of the full history, so live signals never need to recompute it.
+    /// NaN observations are treated as missing values, like nulls in Series::ewm.
+    class EWMState {
+    public:
+        EWMState(double value,
+                 EWMAlphaType type,
+                 bool adjust = true,
+                 bool ignore_na = false,
+                 int min_periods = 0,
+                 bool bias = false)
+                : m_com(ewmCenterOfMass(value, type)),
+                  m_adjust(adjust),
+                  m_ignoreNA(ignore_na),
+                  m_minPeriods(std::max(min_periods, 1)),
+                  m_bias(bias) {
+        }
+
+        /// halflife measured on the time axis, every observation must come with its timestamp.
+        /// Like pandas adjust must stay true, the recursive form is not defined for irregular times.
+        explicit EWMState(time_duration const &halflife,
+                          bool adjust = true,
+                          bool ignore_na = false,
+                          int min_periods = 0,
+                          bool bias = false)
+                : m_com(1.0),
+                  m_halfLifeNs(halflife.total_nanoseconds()),
+                  m_adjust(adjust),
+                  m_ignoreNA(ignore_na),
+                  m_minPeriods(std::max(min_periods, 1)),
+                  m_bias(bias) {
+            if (m_halfLifeNs <= 0) {
+                throw std::runtime_error("EWM with HalfLife require a positive duration");
+            }
+            if (not adjust) {
+                throw std::invalid_argument("EWM with a time halflife does not support adjust=false");
+            }
+        }
+
+        void update(double x) {
+            if (m_halfLifeNs) {
+                throw std::runtime_error("EWMState with a time halflife requires a timestamp");
+            }
+            step(x, 1.0);
+        }
+
+        void update(double x, int64_t timestampNs) {
+            if (!m_halfLifeNs) {
+                step(x, 1.0);
+                return;
+            }
+            double delta = m_lastTimestamp ? static_cast<double>(timestampNs - *m_lastTimestamp) /
+                                             static_cast<double>(m_halfLifeNs) : 1.0;
+            m_lastTimestamp = timestampNs;
+            step(x, delta);
+        }
+
+        void update(double x, ptime const &timestamp) {
+            update(x, fromPTime(timestamp));
+        }
+
+        [[nodiscard]] double mean() const {
+            return (m_mean and m_nobs >= m_minPeriods) ? *m_mean : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        [[nodiscard]] double var() const {
+            if (!m_mean or m_nobs < m_minPeriods) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (m_bias) {
+                return m_cov;
+            }
+            const double numerator = m_sumWt * m_sumWt;
+            const double denominator = numerator - m_sumWt2;
+            return denominator > 0 ? (numerator / denominator) * m_cov : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        [[nodiscard]] double std() const {
+            auto v = var();
+            return v < 0 ? 0 : std::sqrt(v);
+        }
+
+        [[nodiscard]] int64_t nobs() const { return m_nobs; }
+
+        void reset() {
+            m_mean.reset();
+            m_lastTimestamp.reset();
+            m_cov = 0;
+            m_sumWt = m_sumWt2 = m_oldWt = 1;
+            m_nobs = 0;
+        }
+
+    private:
+        double m_com;
+        int64_t m_halfLifeNs{0};
+        bool m_adjust;
+        bool m_ignoreNA;
+        int m_minPeriods;
+        bool m_bias;
+
+        std::optional<double> m_mean;
+        std::optional<int64_t> m_lastTimestamp;
+        double m_cov{0};
+        double m_sumWt{1}, m_sumWt2{1}, m_oldWt{1};
+        int64_t m_nobs{0};
+
+        void step(double x, double delta) {
+            const bool is_observation = !std::isnan(x);
+            m_nobs += is_observation;
+
+            if (!m_mean) {
+                if (is_observation) {
+                    m_mean = x;
+                }
+                return;
+            }
+            if (!is_observation and m_ignoreNA) {
+                return;
+            }
+
+            const double old_wt_factor = std::pow(1. - 1. / (1. + m_com), delta);
+            const double new_wt = m_adjust ? 1. : 1. / (1. + m_com);
+
+            m_sumWt *= old_wt_factor;
+            m_sumWt2 *= old_wt_factor * old_wt_factor;
+            m_oldWt *= old_wt_factor;
+            if (!is_observation) {
+                return;
+            }
+
+            // same update order as Series::ewm / ewmcov so results match bit for bit
+            const double old_mean = *m_mean;
+            if (old_mean != x) {
+                m_mean = (m_oldWt * old_mean + new_wt * x) / (m_oldWt + new_wt);
+            }
+            m_cov = (m_oldWt * (m_cov + (old_mean - *m_mean) * (old_mean - *m_mean)) +
+                     new_wt * (x - *m_mean) * (x - *m_mean)) / (m_oldWt + new_wt);
+            m_sumWt += new_wt;
+            m_sumWt2 += new_wt * new_wt;
+            m_oldWt += new_wt;
+
+            if (not m_adjust) {
+                m_sumWt /= m_oldWt;
+                m_sumWt2 /= (m_oldWt * m_oldWt);
+                m_oldWt = 1.;
+            }
+        }
+    };
+}
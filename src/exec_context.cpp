@@ -0,0 +1,222 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "exec_context.h"
+#include "tracing.h"
+#include <arrow/compute/api.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+
+namespace pd {
+
+    namespace {
+        std::shared_mutex defaultContextMutex;
+        ExecContext defaultContext;
+
+        thread_local ExecContext const *currentContext = nullptr;
+
+        struct AllocationTrackerRegistry {
+            std::mutex mutex;
+            // pools are never destroyed: buffers allocated through them may outlive any scope
+            std::map<std::string, std::unique_ptr<TrackingMemoryPool>> pools;
+
+            static AllocationTrackerRegistry &Instance() {
+                static AllocationTrackerRegistry instance;
+                return instance;
+            }
+        };
+    }
+
+    arrow::compute::ExecContext ExecContext::compute() const {
+        arrow::compute::ExecContext ctx(pool, executor);
+        ctx.set_use_threads(use_threads);
+        return ctx;
+    }
+
+    arrow::io::IOContext ExecContext::io() const {
+        return executor ? arrow::io::IOContext(pool, executor) : arrow::io::IOContext(pool);
+    }
+
+    ExecContext GetExecContext() {
+        if (currentContext) {
+            return *currentContext;
+        }
+        return GetDefaultExecContext();
+    }
+
+    arrow::MemoryPool *GetMemoryPool() {
+        return GetExecContext().pool;
+    }
+
+    ExecContext GetDefaultExecContext() {
+        std::shared_lock lock(defaultContextMutex);
+        return defaultContext;
+    }
+
+    void SetDefaultExecContext(ExecContext const &ctx) {
+        std::unique_lock lock(defaultContextMutex);
+        defaultContext = ctx;
+    }
+
+    ScopedExecContext::ScopedExecContext(ExecContext const &ctx) : m_ctx(ctx), m_previous(currentContext) {
+        currentContext = &m_ctx;
+    }
+
+    ScopedExecContext::ScopedExecContext(arrow::MemoryPool *pool) : m_ctx(GetExecContext()), m_previous(currentContext) {
+        m_ctx.pool = pool;
+        currentContext = &m_ctx;
+    }
+
+    ScopedExecContext::~ScopedExecContext() {
+        currentContext = m_previous;
+    }
+
+    arrow::Result<arrow::Datum> CallFunction(
+            std::string const &name,
+            std::vector<arrow::Datum> const &args,
+            arrow::compute::FunctionOptions const *options) {
+        auto ctx = GetExecContext().compute();
+        if (!tracing::enabled()) {
+            return arrow::compute::CallFunction(name, args, options, &ctx);
+        }
+
+        tracing::Span span(name, args);
+        auto result = arrow::compute::CallFunction(name, args, options, &ctx);
+        if (result.ok()) {
+            span.setOutput(*result);
+        }
+        return result;
+    }
+
+    arrow::Result<arrow::Datum> Cast(
+            arrow::Datum const &value,
+            std::shared_ptr<arrow::DataType> const &type,
+            bool safe) {
+        auto options = safe ? arrow::compute::CastOptions::Safe(type) : arrow::compute::CastOptions::Unsafe(type);
+        return pd::CallFunction("cast", {value}, &options);
+    }
+
+    //<editor-fold desc="Memory Pools">
+    arrow::Result<arrow::MemoryPool *> MakeMemoryPool(std::string const &backend) {
+        arrow::MemoryPool *pool = nullptr;
+        if (backend == "default") {
+            pool = arrow::default_memory_pool();
+        } else if (backend == "system") {
+            pool = arrow::system_memory_pool();
+        } else if (backend == "jemalloc") {
+            ARROW_RETURN_NOT_OK(arrow::jemalloc_memory_pool(&pool));
+        } else if (backend == "mimalloc") {
+            ARROW_RETURN_NOT_OK(arrow::mimalloc_memory_pool(&pool));
+        } else {
+            return arrow::Status::Invalid("Unknown memory pool backend: ", backend);
+        }
+        return pool;
+    }
+
+    TrackingMemoryPool::TrackingMemoryPool(arrow::MemoryPool *parent, int64_t limit)
+            : m_parent(parent), m_limit(limit) {
+    }
+
+    arrow::Status TrackingMemoryPool::reserve(int64_t size) {
+        auto current = m_bytesAllocated.fetch_add(size) + size;
+        if (m_limit > 0 && size > 0 && current > m_limit) {
+            m_bytesAllocated.fetch_sub(size);
+            return arrow::Status::OutOfMemory("allocation of ", size, " bytes exceeds memory limit of ", m_limit,
+                                              " bytes (", current - size, " bytes in use)");
+        }
+        updateMaxMemory(current);
+        return arrow::Status::OK();
+    }
+
+    void TrackingMemoryPool::updateMaxMemory(int64_t current) {
+        auto peak = m_maxMemory.load();
+        while (current > peak && !m_maxMemory.compare_exchange_weak(peak, current)) {
+        }
+    }
+
+    arrow::Status TrackingMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t **out) {
+        ARROW_RETURN_NOT_OK(reserve(size));
+        auto status = m_parent->Allocate(size, alignment, out);
+        if (!status.ok()) {
+            m_bytesAllocated.fetch_sub(size);
+            return status;
+        }
+        m_totalBytesAllocated.fetch_add(size);
+        m_numAllocations.fetch_add(1);
+        return status;
+    }
+
+    arrow::Status TrackingMemoryPool::Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t **ptr) {
+        const int64_t delta = new_size - old_size;
+        if (delta > 0) {
+            ARROW_RETURN_NOT_OK(reserve(delta));
+        }
+        auto status = m_parent->Reallocate(old_size, new_size, alignment, ptr);
+        if (!status.ok()) {
+            if (delta > 0) {
+                m_bytesAllocated.fetch_sub(delta);
+            }
+            return status;
+        }
+        if (delta < 0) {
+            m_bytesAllocated.fetch_add(delta);
+        } else {
+            m_totalBytesAllocated.fetch_add(delta);
+        }
+        m_numAllocations.fetch_add(1);
+        return status;
+    }
+
+    void TrackingMemoryPool::Free(uint8_t *buffer, int64_t size, int64_t alignment) {
+        m_parent->Free(buffer, size, alignment);
+        m_bytesAllocated.fetch_sub(size);
+    }
+
+    AllocationStats TrackingMemoryPool::stats(std::string const &name) const {
+        return AllocationStats{name, bytes_allocated(), max_memory(), total_bytes_allocated(), num_allocations()};
+    }
+
+    static TrackingMemoryPool *namedTrackingPool(std::string const &name) {
+        auto &registry = AllocationTrackerRegistry::Instance();
+        std::scoped_lock lock(registry.mutex);
+        auto &pool = registry.pools[name];
+        if (!pool) {
+            pool = std::make_unique<TrackingMemoryPool>(GetMemoryPool());
+        }
+        return pool.get();
+    }
+
+    ScopedAllocationTracker::ScopedAllocationTracker(std::string name)
+            : m_name(std::move(name)),
+              m_pool(namedTrackingPool(m_name)),
+              m_start(m_pool->stats(m_name)),
+              m_scope(m_pool) {
+    }
+
+    AllocationStats ScopedAllocationTracker::stats() const {
+        auto current = m_pool->stats(m_name);
+        return AllocationStats{m_name,
+                               current.bytes_allocated - m_start.bytes_allocated,
+                               current.max_memory,
+                               current.total_bytes_allocated - m_start.total_bytes_allocated,
+                               current.num_allocations - m_start.num_allocations};
+    }
+
+    std::vector<AllocationStats> AllocationReport() {
+        auto &registry = AllocationTrackerRegistry::Instance();
+        std::vector<AllocationStats> report;
+        {
+            std::scoped_lock lock(registry.mutex);
+            report.reserve(registry.pools.size());
+            for (auto const &[name, pool]: registry.pools) {
+                report.emplace_back(pool->stats(name));
+            }
+        }
+        std::ranges::sort(report, std::greater{}, &AllocationStats::total_bytes_allocated);
+        return report;
+    }
+    //</editor-fold>
+}
@@ -0,0 +1,155 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/compute/exec.h>
+#include <arrow/io/interfaces.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+
+namespace pd {
+
+    /// Execution state shared by every Series/DataFrame/GroupBy operation.
+    /// The active context is thread-local and falls back to a process wide default;
+    /// install one for a region of code with ScopedExecContext.
+    struct ExecContext {
+        arrow::MemoryPool *pool{arrow::default_memory_pool()};
+        /// executor handed to arrow compute/io, nullptr selects arrow's global pools
+        arrow::internal::Executor *executor{nullptr};
+        bool use_threads{true};
+        /// elementwise functions over at least serial_threshold rows are split into morsels of
+        /// morsel_size rows or more (see pd::CallElementwise)
+        int64_t morsel_size{1 << 16};
+        int64_t serial_threshold{1 << 18};
+
+        [[nodiscard]] arrow::compute::ExecContext compute() const;
+
+        [[nodiscard]] arrow::io::IOContext io() const;
+    };
+
+    ExecContext GetExecContext();
+
+    arrow::MemoryPool *GetMemoryPool();
+
+    /// the context used by threads that have no ScopedExecContext installed
+    ExecContext GetDefaultExecContext();
+
+    /// replaces the context used by threads that have no ScopedExecContext installed
+    void SetDefaultExecContext(ExecContext const &ctx);
+
+    class ScopedExecContext {
+    public:
+        explicit ScopedExecContext(ExecContext const &ctx);
+
+        explicit ScopedExecContext(arrow::MemoryPool *pool);
+
+        ScopedExecContext(ScopedExecContext const &) = delete;
+
+        ScopedExecContext &operator=(ScopedExecContext const &) = delete;
+
+        ~ScopedExecContext();
+
+    private:
+        ExecContext m_ctx;
+        ExecContext const *m_previous;
+    };
+
+    /// Wraps a parallel body so that worker threads run with the caller's context.
+    template<class Fn>
+    auto bindExecContext(Fn &&fn) {
+        return [ctx = GetExecContext(), fn = std::forward<Fn>(fn)](auto &&... args) -> decltype(auto) {
+            ScopedExecContext scope(ctx);
+            return fn(std::forward<decltype(args)>(args)...);
+        };
+    }
+
+    /// arrow::compute::CallFunction bound to the active context
+    arrow::Result<arrow::Datum> CallFunction(
+            std::string const &name,
+            std::vector<arrow::Datum> const &args,
+            arrow::compute::FunctionOptions const *options = nullptr);
+
+    /// arrow::compute::Cast bound to the active context
+    arrow::Result<arrow::Datum> Cast(
+            arrow::Datum const &value,
+            std::shared_ptr<arrow::DataType> const &type,
+            bool safe = true);
+
+    //<editor-fold desc="Memory Pools">
+    /// arrow::MemoryPool by backend name: "system", "jemalloc", "mimalloc" or "default"
+    arrow::Result<arrow::MemoryPool *> MakeMemoryPool(std::string const &backend);
+
+    struct AllocationStats {
+        std::string name;
+        int64_t bytes_allocated{0};
+        int64_t max_memory{0};
+        int64_t total_bytes_allocated{0};
+        int64_t num_allocations{0};
+    };
+
+    /// Forwards to a parent pool while counting allocations. A non-zero limit makes
+    /// allocations that would exceed it fail with Status::OutOfMemory.
+    /// Like any arrow::MemoryPool it must outlive the buffers it allocated.
+    class TrackingMemoryPool : public arrow::MemoryPool {
+    public:
+        explicit TrackingMemoryPool(arrow::MemoryPool *parent = arrow::default_memory_pool(), int64_t limit = 0);
+
+        using arrow::MemoryPool::Allocate;
+        using arrow::MemoryPool::Free;
+        using arrow::MemoryPool::Reallocate;
+
+        arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t **out) override;
+
+        arrow::Status Reallocate(int64_t old_size, int64_t new_size, int64_t alignment, uint8_t **ptr) override;
+
+        void Free(uint8_t *buffer, int64_t size, int64_t alignment) override;
+
+        void ReleaseUnused() override { m_parent->ReleaseUnused(); }
+
+        int64_t bytes_allocated() const override { return m_bytesAllocated.load(); }
+
+        int64_t max_memory() const override { return m_maxMemory.load(); }
+
+        int64_t total_bytes_allocated() const override { return m_totalBytesAllocated.load(); }
+
+        int64_t num_allocations() const override { return m_numAllocations.load(); }
+
+        std::string backend_name() const override { return m_parent->backend_name(); }
+
+        [[nodiscard]] int64_t limit() const { return m_limit; }
+
+        [[nodiscard]] AllocationStats stats(std::string const &name = "") const;
+
+    private:
+        arrow::MemoryPool *m_parent;
+        int64_t m_limit;
+        std::atomic<int64_t> m_bytesAllocated{0}, m_maxMemory{0}, m_totalBytesAllocated{0}, m_numAllocations{0};
+
+        arrow::Status reserve(int64_t size);
+
+        void updateMaxMemory(int64_t current);
+    };
+
+    /// Accounts every allocation made on this thread (and in library parallel regions
+    /// it spawns) to a named, process-lifetime TrackingMemoryPool.
+    /// stats() reports the allocations made while the scope was alive.
+    class ScopedAllocationTracker {
+    public:
+        explicit ScopedAllocationTracker(std::string name);
+
+        [[nodiscard]] AllocationStats stats() const;
+
+    private:
+        std::string m_name;
+        TrackingMemoryPool *m_pool;
+        AllocationStats m_start;
+        ScopedExecContext m_scope;
+    };
+
+    /// cumulative stats of every named tracker, largest total_bytes_allocated first
+    std::vector<AllocationStats> AllocationReport();
+    //</editor-fold>
+}
@@ -0,0 +1,170 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "file_cache.h"
+#include <algorithm>
+#include <random>
+#include <unistd.h>
+#include <vector>
+#include "exec_context.h"
+#include "fmt/format.h"
+#include "tracing.h"
+
+
+namespace pd {
+
+    static constexpr int64_t kCopyChunk = 8 << 20;
+
+    // FNV-1a, stable across runs unlike std::hash
+    static uint64_t fingerprint(std::string const &text) {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (unsigned char c: text) {
+            hash = (hash ^ c) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    // distinct per download, also across processes sharing the directory
+    static std::string partialSuffix() {
+        thread_local std::mt19937_64 engine{(uint64_t{std::random_device{}()} << 32) | std::random_device{}()};
+        return fmt::format(".{}.{:016x}.part", ::getpid(), engine());
+    }
+
+    FileCache::FileCache(std::filesystem::path directory,
+                         int64_t capacity,
+                         std::chrono::steady_clock::duration revalidateAfter)
+            : m_directory(std::move(directory)), m_capacity(capacity), m_revalidateAfter(revalidateAfter) {
+        std::filesystem::create_directories(m_directory);
+    }
+
+    arrow::Result<std::string> FileCache::key(
+            arrow::fs::FileSystem &filesystem,
+            std::string const &path,
+            arrow::io::RandomAccessFile &source) const {
+        std::string version;
+        ARROW_ASSIGN_OR_RAISE(auto metadata, source.ReadMetadata());
+        if (metadata and metadata->Contains("ETag")) {
+            ARROW_ASSIGN_OR_RAISE(version, metadata->Get("ETag"));
+        } else {
+            ARROW_ASSIGN_OR_RAISE(auto info, filesystem.GetFileInfo(path));
+            version = fmt::format("{}:{}", info.size(), info.mtime().time_since_epoch().count());
+        }
+        return fmt::format("{:016x}{:016x}", fingerprint(path), fingerprint(path + '\n' + version));
+    }
+
+    arrow::Status FileCache::download(arrow::io::RandomAccessFile &source, std::filesystem::path const &entry) const {
+        // written under a private name and renamed, readers never see a partial entry
+        auto partial = entry;
+        partial += partialSuffix();
+
+        ARROW_ASSIGN_OR_RAISE(auto size, source.GetSize());
+        ARROW_ASSIGN_OR_RAISE(auto sink, arrow::io::FileOutputStream::Open(partial.string()));
+        for (int64_t offset = 0; offset < size; offset += kCopyChunk) {
+            ARROW_ASSIGN_OR_RAISE(auto chunk, source.ReadAt(offset, std::min(kCopyChunk, size - offset)));
+            RETURN_NOT_OK(sink->Write(chunk));
+        }
+        RETURN_NOT_OK(sink->Close());
+
+        std::error_code error;
+        std::filesystem::rename(partial, entry, error);
+        if (error) {
+            std::filesystem::remove(partial, error);
+            return arrow::Status::IOError("FileCache: cannot publish ", entry.string());
+        }
+        return arrow::Status::OK();
+    }
+
+    arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> FileCache::open(
+            arrow::fs::FileSystem &filesystem,
+            std::string const &path) {
+        PD_TRACE_SCOPE("FileCache::open");
+        const auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard lock(m_mutex);
+            auto validated = m_validated.find(path);
+            if (validated != m_validated.end() and now - validated->second.at < m_revalidateAfter) {
+                if (auto cached = openEntry(m_directory / validated->second.name)) {
+                    m_hits++;
+                    return cached;
+                }
+            }
+        }
+
+        ARROW_ASSIGN_OR_RAISE(auto source, filesystem.OpenInputFile(path));
+        ARROW_ASSIGN_OR_RAISE(auto name, key(filesystem, path, *source));
+        auto entry = m_directory / name;
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (auto cached = openEntry(entry)) {
+                m_validated[path] = {name, now};
+                m_hits++;
+                return cached;
+            }
+        }
+
+        m_misses++;
+        ARROW_ASSIGN_OR_RAISE(auto size, source->GetSize());
+        if (size > m_capacity) {
+            return source;
+        }
+
+        RETURN_NOT_OK(download(*source, entry));
+        std::lock_guard lock(m_mutex);
+        evict(entry);
+        m_validated[path] = {name, now};
+        return arrow::io::ReadableFile::Open(entry.string(), pd::GetMemoryPool());
+    }
+
+    std::shared_ptr<arrow::io::RandomAccessFile> FileCache::openEntry(std::filesystem::path const &entry) const {
+        std::error_code error;
+        if (not std::filesystem::exists(entry, error)) {
+            return nullptr;
+        }
+        // the modification time orders the entries for eviction
+        std::filesystem::last_write_time(entry, std::filesystem::file_time_type::clock::now(), error);
+        auto cached = arrow::io::ReadableFile::Open(entry.string(), pd::GetMemoryPool());
+        return cached.ok() ? *cached : nullptr;
+    }
+
+    int64_t FileCache::size() const {
+        std::lock_guard lock(m_mutex);
+        int64_t total = 0;
+        for (auto const &file: std::filesystem::directory_iterator(m_directory)) {
+            if (file.is_regular_file() and file.path().extension() != ".part") {
+                total += static_cast<int64_t>(file.file_size());
+            }
+        }
+        return total;
+    }
+
+    void FileCache::evict(std::filesystem::path const &keep) {
+        struct Entry {
+            std::filesystem::path path;
+            std::filesystem::file_time_type used;
+            int64_t size;
+        };
+
+        std::vector<Entry> entries;
+        int64_t total = 0;
+        for (auto const &file: std::filesystem::directory_iterator(m_directory)) {
+            if (not file.is_regular_file() or file.path().extension() == ".part") {
+                continue;
+            }
+            entries.push_back({file.path(), file.last_write_time(), static_cast<int64_t>(file.file_size())});
+            total += entries.back().size;
+        }
+
+        std::ranges::sort(entries, {}, &Entry::used);
+        std::error_code error;
+        for (auto const &entry: entries) {
+            if (total <= m_capacity) {
+                break;
+            }
+            // open readers keep unlinked files alive
+            if (entry.path != keep and std::filesystem::remove(entry.path, error)) {
+                total -= entry.size;
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/filesystem/filesystem.h>
+#include <arrow/io/api.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+namespace pd {
+
+    /// Read-through cache of remote files on local disk.
+    /// Entries are keyed by path and ETag (size and mtime when the filesystem reports no ETag),
+    /// so a rewritten object is fetched again. Least recently opened entries are evicted once
+    /// the cache grows past its capacity in bytes; files larger than that are never cached.
+    /// A path whose version was checked less than `revalidateAfter` ago is served from disk without
+    /// contacting the filesystem at all (no open, no HEAD); 0 checks the version on every open.
+    class FileCache {
+    public:
+        FileCache(std::filesystem::path directory,
+                  int64_t capacity,
+                  std::chrono::steady_clock::duration revalidateAfter = std::chrono::seconds{60});
+
+        arrow::Result<std::shared_ptr<arrow::io::RandomAccessFile>> open(
+                arrow::fs::FileSystem &filesystem,
+                std::string const &path);
+
+        /// bytes held on disk
+        [[nodiscard]] int64_t size() const;
+
+        [[nodiscard]] int64_t hits() const { return m_hits; }
+
+        [[nodiscard]] int64_t misses() const { return m_misses; }
+
+        [[nodiscard]] std::filesystem::path const &directory() const { return m_directory; }
+
+    private:
+        struct Validated {
+            std::string name;
+            std::chrono::steady_clock::time_point at;
+        };
+
+        std::filesystem::path m_directory;
+        int64_t m_capacity;
+        std::chrono::steady_clock::duration m_revalidateAfter;
+        mutable std::mutex m_mutex;
+        std::atomic<int64_t> m_hits{0}, m_misses{0};
+        /// entry name of each path whose version was checked, guarded by m_mutex
+        std::unordered_map<std::string, Validated> m_validated;
+
+        arrow::Result<std::string> key(
+                arrow::fs::FileSystem &filesystem,
+                std::string const &path,
+                arrow::io::RandomAccessFile &source) const;
+
+        arrow::Status download(arrow::io::RandomAccessFile &source, std::filesystem::path const &entry) const;
+
+        /// the cached entry marked as recently used, nullptr when it is not on disk
+        std::shared_ptr<arrow::io::RandomAccessFile> openEntry(std::filesystem::path const &entry) const;
+
+        void evict(std::filesystem::path const &keep);
+    };
+}
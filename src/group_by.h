@@ -138,6 +138,41 @@ struct GroupBy
     arrow::Result<pd::DataFrame> tdigest(std::vector<std::string> const& args);
     arrow::Result<pd::Series> tdigest(std::string const& arg);
 
+    /// aggregates every group with the arrow function `agg` and broadcasts the result back
+    /// to the original rows, so the output is aligned with the grouped DataFrame
+    arrow::Result<pd::DataFrame> transform(std::string const& agg, std::vector<std::string> const& args);
+    arrow::Result<pd::Series> transform(std::string const& agg, std::string const& arg);
+
+    // group-wise window functions, the output keeps the original row order and index.
+    // cumulative functions run in one pass over the group ids, the others in parallel over groups.
+    arrow::Result<pd::DataFrame> cumsum(std::vector<std::string> const& args);
+    arrow::Result<pd::Series> cumsum(std::string const& arg);
+
+    arrow::Result<pd::DataFrame> cumprod(std::vector<std::string> const& args);
+    arrow::Result<pd::Series> cumprod(std::string const& arg);
+
+    arrow::Result<pd::DataFrame> cummax(std::vector<std::string> const& args);
+    arrow::Result<pd::Series> cummax(std::string const& arg);
+
+    arrow::Result<pd::DataFrame> cummin(std::vector<std::string> const& args);
+    arrow::Result<pd::Series> cummin(std::string const& arg);
+
+    arrow::Result<pd::DataFrame> shift(std::vector<std::string> const& args, int64_t periods = 1);
+    arrow::Result<pd::Series> shift(std::string const& arg, int64_t periods = 1);
+
+    arrow::Result<pd::DataFrame> diff(std::vector<std::string> const& args, int64_t periods = 1);
+    arrow::Result<pd::Series> diff(std::string const& arg, int64_t periods = 1);
+
+    arrow::Result<pd::DataFrame> pct_change(std::vector<std::string> const& args, int64_t periods = 1);
+    arrow::Result<pd::Series> pct_change(std::string const& arg, int64_t periods = 1);
+
+    /// average rank of ties, starting at 1, NaN for nulls
+    arrow::Result<pd::DataFrame> rank(std::vector<std::string> const& args, bool ascending = true);
+    arrow::Result<pd::Series> rank(std::string const& arg, bool ascending = true);
+
+    arrow::Result<pd::DataFrame> ffill(std::vector<std::string> const& args);
+    arrow::Result<pd::Series> ffill(std::string const& arg);
+
     template<class IndexType>
     std::vector<std::pair<IndexType, pd::DataFrame>>
     orderedGroups() const
@@ -173,6 +208,29 @@ private:
     std::unordered_map<std::shared_ptr<arrow::Scalar>, std::shared_ptr<arrow::Array>, pd::HashScalar, pd::HashScalar>
         indexGroups;
     std::shared_ptr<arrow::Array> uniqueKeys;
+    /// group id of every row, ids index into uniqueKeys
+    std::shared_ptr<arrow::UInt32Array> groupIds;
+    /// rows of group g in their original order are groupRows[groupings->value_offset(g), value_offset(g + 1))
+    std::shared_ptr<arrow::ListArray> groupings;
+    std::shared_ptr<arrow::Int64Array> groupRows;
+
+    enum class CumulativeOp
+    {
+        Sum,
+        Prod,
+        Max,
+        Min
+    };
+
+    arrow::Result<pd::DataFrame> transformColumns(std::vector<std::string> const& args,
+                                                  std::function<arrow::Result<ArrayPtr>(ArrayPtr const&, int)> const& fn);
+
+    arrow::Result<ArrayPtr> broadcastAggregate(ArrayPtr const& column, int index, std::string const& agg);
+    arrow::Result<ArrayPtr> cumulative(ArrayPtr const& column, CumulativeOp op) const;
+    arrow::Result<ArrayPtr> shiftColumn(ArrayPtr const& column, int64_t periods) const;
+    arrow::Result<ArrayPtr> diffColumn(ArrayPtr const& column, int64_t periods, bool pct) const;
+    arrow::Result<ArrayPtr> rankColumn(ArrayPtr const& column, bool ascending) const;
+    arrow::Result<ArrayPtr> ffillColumn(ArrayPtr const& column) const;
 
     template<typename OptionT, typename... Args>
     static OptionT convertToArrowFunctionOption(Args const&... args)
@@ -193,7 +251,7 @@ private:
         std::shared_ptr<arrow::ArrayBuilder> builder;
         if (not arg.empty())
         {
-            builder = arrow::MakeBuilder(arg.back()->type).MoveValueUnsafe();
+            builder = arrow::MakeBuilder(arg.back()->type, pd::GetMemoryPool()).MoveValueUnsafe();
             ARROW_RETURN_NOT_OK(builder->AppendScalars(arg));
         }
 
@@ -207,7 +265,7 @@ private:
         std::shared_ptr<arrow::ArrayBuilder> builder;
         if (not arg.empty())
         {
-            builder = arrow::MakeBuilder(arg.back()->type).MoveValueUnsafe();
+            builder = arrow::MakeBuilder(arg.back()->type, pd::GetMemoryPool()).MoveValueUnsafe();
             RETURN_NOT_OK(builder->AppendScalars(arg));
         }
 
@@ -218,14 +276,13 @@ private:
 
     static inline auto defaultOpt = std::shared_ptr<arrow::compute::FunctionOptions>();
 
-    /// takes in a grouper (an object that groups rows in a DataFrame based
-    /// on certain criteria), a groupings array (which specifies the groups
-    /// that the rows are grouped into), and a column array (which contains
-    /// the data of a specific column in the DataFrame). It uses the grouper
-    /// to group the rows in the column array based on the groupings, and
-    /// stores the grouped data in the groups attribute.
+    /// takes in the number of groups, a groupings array (which specifies the
+    /// groups that the rows are grouped into), and a column array (which contains
+    /// the data of a specific column in the DataFrame). It groups the rows in
+    /// the column array based on the groupings, and stores the grouped data in
+    /// the groups attribute.
     arrow::Status processEach(
-        std::unique_ptr<arrow::compute::Grouper> const& grouper,
+        int64_t numGroups,
         std::shared_ptr<arrow::ListArray> const& groupings,
         std::shared_ptr<arrow::Array> const& column);
 
@@ -233,11 +290,15 @@ private:
     /// but it is used to group the rows in the index column of the DataFrame,
     /// rather than a specific column.
     arrow::Status processIndex(
-        std::unique_ptr<arrow::compute::Grouper> const& grouper,
+        int64_t numGroups,
         std::shared_ptr<arrow::ListArray> const& groupings);
 
     arrow::Status makeGroups(std::string const& keyInStringFormat);
 
+    /// group ids of a categorical key straight from its codes, numbered in order of
+    /// first appearance like the hash grouper; uniqueKeys holds the decoded labels
+    arrow::Result<int64_t> makeDictionaryGroups(arrow::DictionaryArray const& keys);
+
     arrow::FieldVector fieldVectors(std::vector<std::string> const& args, std::shared_ptr<arrow::Schema> const& schema)
     {
         arrow::FieldVector fv(args.size());
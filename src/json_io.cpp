@@ -0,0 +1,400 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "json_io.h"
+#include <arrow/io/file.h>
+#include <arrow/json/api.h>
+#include <arrow/util/base64.h>
+#include <charconv>
+#include <cmath>
+#include "core.h"
+#include "dataframe.h"
+#include "scheduler.h"
+
+
+namespace pd {
+
+    namespace {
+        constexpr int64_t BLOCK_ROWS = 1 << 14;
+
+        /// the JSON text of rows [begin, end) of one column; value i ends at ends[i - begin]
+        struct Rendered {
+            std::string text;
+            std::vector<int64_t> ends;
+
+            [[nodiscard]] std::string_view value(int64_t i) const {
+                const int64_t start = i == 0 ? 0 : ends[i - 1];
+                return {text.data() + start, static_cast<size_t>(ends[i] - start)};
+            }
+        };
+
+        void appendEscaped(std::string &out, std::string_view value) {
+            static constexpr char HEX[] = "0123456789abcdef";
+            out.push_back('"');
+            for (char c: value) {
+                switch (c) {
+                    case '"':
+                        out.append("\\\"");
+                        break;
+                    case '\\':
+                        out.append("\\\\");
+                        break;
+                    case '\n':
+                        out.append("\\n");
+                        break;
+                    case '\r':
+                        out.append("\\r");
+                        break;
+                    case '\t':
+                        out.append("\\t");
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            out.append("\\u00");
+                            out.push_back(HEX[c >> 4]);
+                            out.push_back(HEX[c & 0xF]);
+                        } else {
+                            out.push_back(c);
+                        }
+                }
+            }
+            out.push_back('"');
+        }
+
+        template<class T>
+        void appendNumber(std::string &out, T value) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (not std::isfinite(value)) {
+                    out.append("null");
+                    return;
+                }
+            }
+            char buffer[32];
+            auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+            out.append(buffer, end);
+            if constexpr (std::is_floating_point_v<T>) {
+                // 2.0 stays a float when read back
+                if (std::string_view(buffer, end - buffer).find_first_of(".e") == std::string_view::npos) {
+                    out.append(".0");
+                }
+            }
+        }
+
+        /// the column as one of the types render handles: temporal values are viewed as their integers,
+        /// dictionaries decoded and anything else without a JSON form cast to utf8
+        arrow::Result<ArrayPtr> normalize(ArrayPtr const &array) {
+            switch (array->type_id()) {
+                case arrow::Type::NA:
+                case arrow::Type::BOOL:
+                case arrow::Type::INT8:
+                case arrow::Type::INT16:
+                case arrow::Type::INT32:
+                case arrow::Type::INT64:
+                case arrow::Type::UINT8:
+                case arrow::Type::UINT16:
+                case arrow::Type::UINT32:
+                case arrow::Type::UINT64:
+                case arrow::Type::FLOAT:
+                case arrow::Type::DOUBLE:
+                case arrow::Type::STRING:
+                case arrow::Type::LARGE_STRING:
+                case arrow::Type::BINARY:
+                case arrow::Type::LARGE_BINARY:
+                    return array;
+                case arrow::Type::DATE32:
+                case arrow::Type::TIME32:
+                    return array->View(arrow::int32());
+                case arrow::Type::DATE64:
+                case arrow::Type::TIME64:
+                case arrow::Type::TIMESTAMP:
+                case arrow::Type::DURATION:
+                    return array->View(arrow::int64());
+                case arrow::Type::HALF_FLOAT: {
+                    auto options = arrow::compute::CastOptions::Safe(arrow::float32());
+                    ARROW_ASSIGN_OR_RAISE(auto cast, pd::CallFunction("cast", {array}, &options));
+                    return cast.make_array();
+                }
+                case arrow::Type::DICTIONARY: {
+                    auto const &dictionary = static_cast<arrow::DictionaryType const &>(*array->type());
+                    auto options = arrow::compute::CastOptions::Safe(dictionary.value_type());
+                    ARROW_ASSIGN_OR_RAISE(auto decoded, pd::CallFunction("cast", {array}, &options));
+                    return normalize(decoded.make_array());
+                }
+                default: {
+                    auto options = arrow::compute::CastOptions::Safe(arrow::utf8());
+                    ARROW_ASSIGN_OR_RAISE(auto cast, pd::CallFunction("cast", {array}, &options));
+                    return cast.make_array();
+                }
+            }
+        }
+
+        template<class ArrayType, class Append>
+        void renderValues(arrow::Array const &array, int64_t begin, int64_t end, Rendered &out, Append &&append) {
+            auto const &typed = static_cast<ArrayType const &>(array);
+            for (int64_t i = begin; i < end; i++) {
+                if (typed.IsNull(i)) {
+                    out.text.append("null");
+                } else {
+                    append(out.text, typed.GetView(i));
+                }
+                out.ends.push_back(static_cast<int64_t>(out.text.size()));
+            }
+        }
+
+        Rendered render(arrow::Array const &array, int64_t begin, int64_t end) {
+            Rendered out;
+            out.ends.reserve(end - begin);
+            out.text.reserve((end - begin) * 8);
+
+            const auto number = [](std::string &text, auto value) { appendNumber(text, value); };
+            const auto string = [](std::string &text, std::string_view value) { appendEscaped(text, value); };
+            // bytes are not text, a JSON string of them would not be valid UTF-8
+            const auto bytes = [](std::string &text, std::string_view value) {
+                text.push_back('"');
+                text.append(arrow::util::base64_encode(value));
+                text.push_back('"');
+            };
+            switch (array.type_id()) {
+                case arrow::Type::NA:
+                    for (int64_t i = begin; i < end; i++) {
+                        out.text.append("null");
+                        out.ends.push_back(static_cast<int64_t>(out.text.size()));
+                    }
+                    break;
+                case arrow::Type::BOOL:
+                    renderValues<arrow::BooleanArray>(array, begin, end, out, [](std::string &text, bool value) {
+                        text.append(value ? "true" : "false");
+                    });
+                    break;
+                case arrow::Type::INT8:
+                    renderValues<arrow::Int8Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::INT16:
+                    renderValues<arrow::Int16Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::INT32:
+                    renderValues<arrow::Int32Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::INT64:
+                    renderValues<arrow::Int64Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::UINT8:
+                    renderValues<arrow::UInt8Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::UINT16:
+                    renderValues<arrow::UInt16Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::UINT32:
+                    renderValues<arrow::UInt32Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::UINT64:
+                    renderValues<arrow::UInt64Array>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::FLOAT:
+                    renderValues<arrow::FloatArray>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::DOUBLE:
+                    renderValues<arrow::DoubleArray>(array, begin, end, out, number);
+                    break;
+                case arrow::Type::STRING:
+                    renderValues<arrow::StringArray>(array, begin, end, out, string);
+                    break;
+                case arrow::Type::LARGE_STRING:
+                    renderValues<arrow::LargeStringArray>(array, begin, end, out, string);
+                    break;
+                case arrow::Type::BINARY:
+                    renderValues<arrow::BinaryArray>(array, begin, end, out, bytes);
+                    break;
+                case arrow::Type::LARGE_BINARY:
+                    renderValues<arrow::LargeBinaryArray>(array, begin, end, out, bytes);
+                    break;
+                default:
+                    throw std::logic_error("WriteJSON: " + array.type()->ToString() + " was not normalized");
+            }
+            return out;
+        }
+
+        /// the rows of a {"column": [values]} document, one per value of the single row read
+        arrow::Result<std::shared_ptr<arrow::Table>> flattenColumns(arrow::Table const &table) {
+            std::vector<std::shared_ptr<arrow::Field>> fields;
+            std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+            for (int i = 0; i < table.num_columns(); i++) {
+                auto const &field = table.schema()->field(i);
+                if (field->type()->id() != arrow::Type::LIST) {
+                    return arrow::Status::Invalid("readJSON: columns orient expects an array for \"", field->name(),
+                                                  "\", found ", field->type()->ToString());
+                }
+                ARROW_ASSIGN_OR_RAISE(auto values, pd::CallFunction("list_flatten", {table.column(i)}));
+                columns.push_back(values.chunked_array());
+                fields.push_back(arrow::field(field->name(), columns.back()->type()));
+                if (columns.back()->length() != columns.front()->length()) {
+                    return arrow::Status::Invalid("readJSON: column \"", field->name(), "\" has ",
+                                                  columns.back()->length(), " values, expected ",
+                                                  columns.front()->length());
+                }
+            }
+            return arrow::Table::Make(arrow::schema(fields), columns);
+        }
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Table>> ReadJSONTable(std::shared_ptr<arrow::io::InputStream> const &input,
+                                                               JSONOrient orient,
+                                                               std::shared_ptr<arrow::Schema> const &schema) {
+        auto readOptions = arrow::json::ReadOptions::Defaults();
+        readOptions.use_threads = pd::GetExecContext().use_threads;
+
+        auto parseOptions = arrow::json::ParseOptions::Defaults();
+        if (schema) {
+            parseOptions.unexpected_field_behavior = arrow::json::UnexpectedFieldBehavior::Ignore;
+            parseOptions.explicit_schema = schema;
+        }
+        if (orient == JSONOrient::Columns) {
+            // the whole document is one row of lists, usually pretty printed
+            parseOptions.newlines_in_values = true;
+            if (schema) {
+                std::vector<std::shared_ptr<arrow::Field>> lists;
+                for (auto const &field: schema->fields()) {
+                    lists.push_back(field->WithType(arrow::list(field->type())));
+                }
+                parseOptions.explicit_schema = arrow::schema(lists);
+            }
+        }
+
+        ARROW_ASSIGN_OR_RAISE(auto reader,
+                              arrow::json::TableReader::Make(pd::GetMemoryPool(), input, readOptions, parseOptions));
+        ARROW_ASSIGN_OR_RAISE(auto table, reader->Read());
+        return orient == JSONOrient::Columns ? flattenColumns(*table) : table;
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Buffer>> WriteJSON(arrow::RecordBatch const &batch, JSONOrient orient) {
+        const int numColumns = batch.num_columns();
+        const int64_t numRows = batch.num_rows();
+
+        std::vector<std::string> keys(numColumns);
+        std::vector<ArrayPtr> columns(numColumns);
+        for (int c = 0; c < numColumns; c++) {
+            appendEscaped(keys[c], batch.schema()->field(c)->name());
+            keys[c].push_back(':');
+            ARROW_ASSIGN_OR_RAISE(columns[c], normalize(batch.column(c)));
+        }
+
+        // every (column, block of rows) is rendered on its own
+        const int64_t blockRows = std::max<int64_t>(BLOCK_ROWS, pd::grainSize(numRows));
+        const int64_t numBlocks = numRows == 0 ? 0 : (numRows + blockRows - 1) / blockRows;
+        std::vector<Rendered> blocks(numColumns * numBlocks);
+        pd::parallel_for(int64_t{0}, static_cast<int64_t>(blocks.size()), pd::bindExecContext([&](int64_t task) {
+            const auto c = task / numBlocks;
+            const auto begin = (task % numBlocks) * blockRows;
+            blocks[task] = render(*columns[c], begin, std::min(begin + blockRows, numRows));
+        }));
+        const auto value = [&](int c, int64_t row) {
+            return blocks[c * numBlocks + row / blockRows].value(row % blockRows);
+        };
+        const auto blockBytes = [&](Rendered const &block) { return static_cast<int64_t>(block.text.size()); };
+
+        std::shared_ptr<arrow::Buffer> out;
+        if (orient == JSONOrient::Records) {
+            // {"a":1,"b":2}\n per row: the offset of every row first, then rows are copied in parallel
+            int64_t keyBytes = 3 + std::max(numColumns - 1, 0);
+            for (auto const &key: keys) {
+                keyBytes += static_cast<int64_t>(key.size());
+            }
+            std::vector<int64_t> offsets(numRows + 1, 0);
+            for (int64_t row = 0; row < numRows; row++) {
+                int64_t size = keyBytes;
+                for (int c = 0; c < numColumns; c++) {
+                    size += static_cast<int64_t>(value(c, row).size());
+                }
+                offsets[row + 1] = offsets[row] + size;
+            }
+
+            ARROW_ASSIGN_OR_RAISE(out, arrow::AllocateBuffer(offsets.back(), pd::GetMemoryPool()));
+            auto *data = reinterpret_cast<char *>(out->mutable_data());
+            pd::parallel_for(tbb::blocked_range<int64_t>(0, numRows, pd::grainSize(numRows, 1024)),
+                             pd::bindExecContext([&](tbb::blocked_range<int64_t> const &r) {
+                                 for (int64_t row = r.begin(); row != r.end(); row++) {
+                                     char *cursor = data + offsets[row];
+                                     *cursor++ = '{';
+                                     for (int c = 0; c < numColumns; c++) {
+                                         if (c > 0) {
+                                             *cursor++ = ',';
+                                         }
+                                         cursor = std::ranges::copy(keys[c], cursor).out;
+                                         cursor = std::ranges::copy(value(c, row), cursor).out;
+                                     }
+                                     *cursor++ = '}';
+                                     *cursor = '\n';
+                                 }
+                             }));
+        } else {
+            // {"a":[1,2],"b":[3,4]}\n: values of a column are separated by the commas between blocks' values
+            std::vector<int64_t> offsets(numColumns + 1, 1);
+            for (int c = 0; c < numColumns; c++) {
+                int64_t size = static_cast<int64_t>(keys[c].size()) + 2 + std::max<int64_t>(numRows - 1, 0) + (c > 0);
+                for (int64_t b = 0; b < numBlocks; b++) {
+                    size += blockBytes(blocks[c * numBlocks + b]);
+                }
+                offsets[c + 1] = offsets[c] + size;
+            }
+
+            ARROW_ASSIGN_OR_RAISE(out, arrow::AllocateBuffer(offsets.back() + 2, pd::GetMemoryPool()));
+            auto *data = reinterpret_cast<char *>(out->mutable_data());
+            data[0] = '{';
+            data[offsets.back()] = '}';
+            data[offsets.back() + 1] = '\n';
+            pd::parallel_for(0, numColumns, pd::bindExecContext([&](int c) {
+                char *cursor = data + offsets[c];
+                if (c > 0) {
+                    *cursor++ = ',';
+                }
+                cursor = std::ranges::copy(keys[c], cursor).out;
+                *cursor++ = '[';
+                for (int64_t row = 0; row < numRows; row++) {
+                    if (row > 0) {
+                        *cursor++ = ',';
+                    }
+                    cursor = std::ranges::copy(value(c, row), cursor).out;
+                }
+                *cursor = ']';
+            }));
+        }
+        return out;
+    }
+
+    JSONBatchReader::JSONBatchReader(std::filesystem::path const &path,
+                                     std::shared_ptr<arrow::Schema> const &schema,
+                                     std::optional<std::string> index,
+                                     int32_t blockSize) : m_index(std::move(index)) {
+        auto ctx = pd::GetExecContext();
+        auto readOptions = arrow::json::ReadOptions::Defaults();
+        readOptions.use_threads = ctx.use_threads;
+        readOptions.block_size = blockSize;
+
+        auto parseOptions = arrow::json::ParseOptions::Defaults();
+        if (schema) {
+            parseOptions.unexpected_field_behavior = arrow::json::UnexpectedFieldBehavior::Ignore;
+            parseOptions.explicit_schema = schema;
+        }
+
+        auto input = pd::ReturnOrThrowOnFailure(arrow::io::ReadableFile::Open(path, ctx.pool));
+        m_reader = pd::ReturnOrThrowOnFailure(
+                arrow::json::StreamingReader::Make(input, readOptions, parseOptions, ctx.io(), ctx.executor));
+    }
+
+    std::optional<DataFrame> JSONBatchReader::next() {
+        std::shared_ptr<arrow::RecordBatch> batch;
+        pd::ThrowOnFailure(m_reader->ReadNext(&batch));
+        if (not batch) {
+            return std::nullopt;
+        }
+        return DataFrame::fromRecordBatch(batch, m_index);
+    }
+
+    std::shared_ptr<arrow::Schema> JSONBatchReader::schema() const {
+        return m_reader->schema();
+    }
+
+    int64_t JSONBatchReader::bytes_processed() const {
+        return m_reader->bytes_processed();
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/io/interfaces.h>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+
+namespace arrow::json {
+    class StreamingReader;
+}
+
+namespace pd {
+
+    class DataFrame;
+
+    /// Records: newline delimited objects, one row per line {"a":1,"b":"x"}.
+    /// Columns: one object with an array per column {"a":[1,2],"b":["x","y"]}.
+    enum class JSONOrient {
+        Records,
+        Columns
+    };
+
+    /// input parsed by arrow's block parallel JSON reader (on arrow's CPU pool when the active
+    /// ExecContext uses threads). Types are inferred unless a schema is given, in which case
+    /// fields outside it are ignored.
+    arrow::Result<std::shared_ptr<arrow::Table>> ReadJSONTable(std::shared_ptr<arrow::io::InputStream> const &input,
+                                                               JSONOrient orient = JSONOrient::Records,
+                                                               std::shared_ptr<arrow::Schema> const &schema = nullptr);
+
+    /// batch serialized without a DOM: every column is rendered in parallel, then rows or columns are
+    /// copied in parallel into one buffer allocated at its final size. Temporal values are written as
+    /// their integers (e.g. epoch nanoseconds), NaN and infinities as null, binary values as base64
+    /// strings, dictionaries decoded and other nested or decimal types as their string cast.
+    arrow::Result<std::shared_ptr<arrow::Buffer>> WriteJSON(arrow::RecordBatch const &batch,
+                                                            JSONOrient orient = JSONOrient::Records);
+
+    /// Newline delimited JSON read a block at a time with arrow's streaming reader, for logs that do not
+    /// fit in memory. The schema is fixed by the first block unless one is given.
+    class JSONBatchReader {
+    public:
+        explicit JSONBatchReader(std::filesystem::path const &path,
+                                 std::shared_ptr<arrow::Schema> const &schema = nullptr,
+                                 std::optional<std::string> index = std::nullopt,
+                                 int32_t blockSize = 1 << 20);
+
+        /// the rows of the next block, nullopt once the input is exhausted
+        std::optional<DataFrame> next();
+
+        [[nodiscard]] std::shared_ptr<arrow::Schema> schema() const;
+
+        /// bytes of input converted so far
+        [[nodiscard]] int64_t bytes_processed() const;
+
+    private:
+        std::shared_ptr<arrow::json::StreamingReader> m_reader;
+        std::optional<std::string> m_index;
+    };
+}
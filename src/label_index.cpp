@@ -0,0 +1,268 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "label_index.h"
+#include <arrow/compute/api.h>
+#include <arrow/util/bitmap_generate.h>
+#include <bit>
+#include <cstring>
+#include <tbb/blocked_range.h>
+#include "core.h"
+#include "exec_context.h"
+#include "scheduler.h"
+#include "sketch.h"
+
+
+namespace pd {
+
+    namespace {
+        std::shared_ptr<arrow::Array> castTo(std::shared_ptr<arrow::Array> const &array,
+                                             std::shared_ptr<arrow::DataType> const &type) {
+            auto options = arrow::compute::CastOptions::Safe(type);
+            return ReturnOrThrowOnFailure(pd::CallFunction("cast", {array}, &options)).make_array();
+        }
+
+        uint64_t hashOf(std::string_view key) {
+            return std::hash<std::string_view>{}(key);
+        }
+
+        std::shared_ptr<arrow::BooleanArray> makeMask(int64_t length, auto &&predicate) {
+            auto bitmap = ReturnOrThrowOnFailure(arrow::AllocateEmptyBitmap(length, pd::GetMemoryPool()));
+            int64_t i = 0;
+            arrow::internal::GenerateBitsUnrolled(bitmap->mutable_data(), 0, length, [&] { return predicate(i++); });
+            return std::make_shared<arrow::BooleanArray>(length, std::move(bitmap));
+        }
+    }
+
+    std::pair<LabelIndex::Kind, std::shared_ptr<arrow::Array>>
+    LabelIndex::keysOf(std::shared_ptr<arrow::Array> const &labels) {
+        auto const &type = labels->type();
+        switch (type->id()) {
+            case arrow::Type::DICTIONARY:
+                return keysOf(castTo(labels, static_cast<arrow::DictionaryType const &>(*type).value_type()));
+            case arrow::Type::STRING:
+            case arrow::Type::BINARY:
+                return {Kind::Binary, ReturnOrThrowOnFailure(labels->View(arrow::binary()))};
+            case arrow::Type::LARGE_STRING:
+            case arrow::Type::LARGE_BINARY:
+                return {Kind::Binary, castTo(ReturnOrThrowOnFailure(labels->View(arrow::large_binary())), arrow::binary())};
+            case arrow::Type::HALF_FLOAT:
+            case arrow::Type::FLOAT:
+                return {Kind::Integer, ReturnOrThrowOnFailure(castTo(labels, arrow::float64())->View(arrow::int64()))};
+            case arrow::Type::BOOL:
+                return {Kind::Integer, castTo(labels, arrow::int64())};
+            default:
+                break;
+        }
+
+        const bool integerLike = arrow::is_integer(type->id()) or arrow::is_temporal(type->id()) or
+                                 type->id() == arrow::Type::DURATION or type->id() == arrow::Type::DOUBLE;
+        if (not integerLike) {
+            return {Kind::Other, labels};
+        }
+        switch (arrow::bit_width(type->id())) {
+            case 64:
+                return {Kind::Integer, ReturnOrThrowOnFailure(labels->View(arrow::int64()))};
+            case 32:
+                return {Kind::Integer, castTo(ReturnOrThrowOnFailure(labels->View(arrow::int32())), arrow::int64())};
+            case 16:
+                return {Kind::Integer, castTo(ReturnOrThrowOnFailure(labels->View(arrow::int16())), arrow::int64())};
+            case 8:
+                return {Kind::Integer, castTo(ReturnOrThrowOnFailure(labels->View(arrow::int8())), arrow::int64())};
+            default:
+                return {Kind::Other, labels};
+        }
+    }
+
+    LabelIndex::LabelIndex(std::shared_ptr<arrow::Array> labels) : m_labels(std::move(labels)) {
+        if (not m_labels or m_labels->length() == 0) {
+            return;
+        }
+
+        std::tie(m_kind, m_keys) = keysOf(m_labels);
+        const int64_t length = m_keys->length();
+        if (m_kind == Kind::Other) {
+            for (int64_t i = 0; i < length; i++) {
+                if (m_labels->IsValid(i)) {
+                    m_duplicates |= not m_scalars.try_emplace(ReturnOrThrowOnFailure(m_labels->GetScalar(i)), i).second;
+                }
+            }
+            m_distinct = m_scalars.size();
+            return;
+        }
+
+        // at most half full, so probe sequences stay short
+        m_slots.assign(std::bit_ceil(static_cast<uint64_t>(std::max<int64_t>(16, 2 * length))), Slot{0, -1});
+        m_mask = m_slots.size() - 1;
+
+        if (m_kind == Kind::Integer) {
+            auto const *keys = m_keys->data()->GetValues<int64_t>(1);
+            for (int64_t i = 0; i < length; i++) {
+                if (m_keys->IsNull(i)) {
+                    continue;
+                }
+                const auto key = static_cast<uint64_t>(keys[i]);
+                for (auto s = mixHash(key) & m_mask;; s = (s + 1) & m_mask) {
+                    auto &slot = m_slots[s];
+                    if (slot.position < 0) {
+                        slot = {key, i};
+                        m_distinct++;
+                        break;
+                    }
+                    if (slot.tag == key) {
+                        m_duplicates = true;
+                        break;
+                    }
+                }
+            }
+        } else {
+            auto const &keys = static_cast<arrow::BinaryArray const &>(*m_keys);
+            for (int64_t i = 0; i < length; i++) {
+                if (keys.IsNull(i)) {
+                    continue;
+                }
+                auto key = keys.GetView(i);
+                const auto hash = hashOf(key);
+                for (auto s = hash & m_mask;; s = (s + 1) & m_mask) {
+                    auto &slot = m_slots[s];
+                    if (slot.position < 0) {
+                        slot = {hash, i};
+                        m_distinct++;
+                        break;
+                    }
+                    if (slot.tag == hash and keys.GetView(slot.position) == key) {
+                        m_duplicates = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    int64_t LabelIndex::probe(uint64_t key) const {
+        for (auto s = mixHash(key) & m_mask;; s = (s + 1) & m_mask) {
+            auto const &slot = m_slots[s];
+            if (slot.position < 0 or slot.tag == key) {
+                return slot.position;
+            }
+        }
+    }
+
+    int64_t LabelIndex::probe(std::string_view key, uint64_t hash) const {
+        auto const &labels = static_cast<arrow::BinaryArray const &>(*m_keys);
+        for (auto s = hash & m_mask;; s = (s + 1) & m_mask) {
+            auto const &slot = m_slots[s];
+            if (slot.position < 0 or (slot.tag == hash and labels.GetView(slot.position) == key)) {
+                return slot.position;
+            }
+        }
+    }
+
+    void LabelIndex::positions(arrow::Array const &keys, int64_t *out) const {
+        pd::parallel_for(
+                tbb::blocked_range<int64_t>(0, keys.length(), 1 << 14),
+                pd::bindExecContext([&](tbb::blocked_range<int64_t> const &range) {
+                    if (m_kind == Kind::Integer) {
+                        auto const *values = keys.data()->GetValues<int64_t>(1);
+                        for (int64_t i = range.begin(); i < range.end(); i++) {
+                            out[i] = keys.IsNull(i) ? -1 : probe(static_cast<uint64_t>(values[i]));
+                        }
+                    } else {
+                        auto const &views = static_cast<arrow::BinaryArray const &>(keys);
+                        for (int64_t i = range.begin(); i < range.end(); i++) {
+                            if (views.IsNull(i)) {
+                                out[i] = -1;
+                            } else {
+                                auto key = views.GetView(i);
+                                out[i] = probe(key, hashOf(key));
+                            }
+                        }
+                    }
+                }));
+    }
+
+    int64_t LabelIndex::find(arrow::Scalar const &label) const {
+        if (not label.is_valid or m_kind == Kind::Empty) {
+            return -1;
+        }
+        if (m_kind == Kind::Other) {
+            auto it = m_scalars.find(label.GetSharedPtr());
+            return it == m_scalars.end() ? -1 : it->second;
+        }
+
+        // labels of the index type are probed directly, anything else goes through the same cast as arrays
+        if (label.type->Equals(*m_labels->type())) {
+            if (m_kind == Kind::Binary and arrow::is_base_binary_like(label.type->id())) {
+                auto key = static_cast<arrow::BaseBinaryScalar const &>(label).view();
+                return probe(key, hashOf(key));
+            }
+            if (m_kind == Kind::Integer and arrow::is_primitive(label.type->id()) and arrow::bit_width(label.type->id()) == 64) {
+                uint64_t key;
+                std::memcpy(&key, static_cast<arrow::internal::PrimitiveScalarBase const &>(label).view().data(), sizeof(key));
+                return probe(key);
+            }
+        }
+        auto array = ReturnOrThrowOnFailure(arrow::MakeArrayFromScalar(label, 1, pd::GetMemoryPool()));
+        auto positions = get_indexer(*array);
+        return positions->IsValid(0) ? positions->Value(0) : -1;
+    }
+
+    int64_t LabelIndex::at(std::shared_ptr<arrow::Scalar> const &label) const {
+        auto position = find(*label);
+        if (position < 0) {
+            throw std::out_of_range("label " + label->ToString() + " is not in the index");
+        }
+        return position;
+    }
+
+    std::shared_ptr<arrow::Int64Array> LabelIndex::get_indexer(arrow::Array const &labels) const {
+        const int64_t length = labels.length();
+        auto buffer = ReturnOrThrowOnFailure(arrow::AllocateBuffer(length * sizeof(int64_t), pd::GetMemoryPool()));
+        auto *out = reinterpret_cast<int64_t *>(buffer->mutable_data());
+        std::fill_n(out, length, -1);
+
+        if (m_kind == Kind::Other) {
+            for (int64_t i = 0; i < length; i++) {
+                if (labels.IsValid(i)) {
+                    auto it = m_scalars.find(ReturnOrThrowOnFailure(labels.GetScalar(i)));
+                    out[i] = it == m_scalars.end() ? -1 : it->second;
+                }
+            }
+        } else if (m_kind != Kind::Empty) {
+            auto array = arrow::MakeArray(labels.data());
+            if (not labels.type()->Equals(*m_labels->type())) {
+                auto options = arrow::compute::CastOptions::Safe(m_labels->type());
+                auto casted = pd::CallFunction("cast", {array}, &options);
+                array = casted.ok() ? casted->make_array() : nullptr;
+            }
+            if (array) {
+                positions(*keysOf(array).second, out);
+            }
+        }
+
+        auto validity = makeMask(length, [out](int64_t i) { return out[i] >= 0; });
+        return std::make_shared<arrow::Int64Array>(length, std::move(buffer), validity->values(), arrow::kUnknownNullCount);
+    }
+
+    std::shared_ptr<arrow::BooleanArray> LabelIndex::duplicated() const {
+        if (not m_labels) {
+            return makeMask(0, [](int64_t) { return false; });
+        }
+        const int64_t length = m_labels->length();
+        if (not m_duplicates) {
+            return makeMask(length, [](int64_t) { return false; });
+        }
+
+        std::vector<int64_t> first(length, -1);
+        if (m_kind == Kind::Other) {
+            for (int64_t i = 0; i < length; i++) {
+                if (m_labels->IsValid(i)) {
+                    first[i] = m_scalars.at(ReturnOrThrowOnFailure(m_labels->GetScalar(i)));
+                }
+            }
+        } else {
+            positions(*m_keys, first.data());
+        }
+        return makeMask(length, [&](int64_t i) { return first[i] >= 0 and first[i] != i; });
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace pd {
+
+    struct HashScalar {
+
+        bool operator()(std::shared_ptr<arrow::Scalar> const &a, std::shared_ptr<arrow::Scalar> const &b) const {
+            return a->Equals(*b->CastTo(a->type).MoveValueUnsafe());
+        }
+
+        bool equal(std::shared_ptr<arrow::Scalar> const &a, std::shared_ptr<arrow::Scalar> const &b) const {
+            return a->Equals(*b->CastTo(a->type).MoveValueUnsafe());
+        }
+
+        size_t operator()(std::shared_ptr<arrow::Scalar> const &scalar) const {
+            return scalar->hash();
+        }
+
+        size_t hash(std::shared_ptr<arrow::Scalar> const &scalar) const {
+            return scalar->hash();
+        }
+    };
+
+    /// Hash table from the labels of an index to their first position.
+    /// Integer, temporal and floating point labels are keyed by a 64 bit value, strings and binaries by a
+    /// string_view into the arrow data buffer, both in one flat open addressing table without per row
+    /// allocations. Other label types fall back to a map of scalars. Null labels are never found.
+    class LabelIndex {
+    public:
+        LabelIndex() = default;
+
+        explicit LabelIndex(std::shared_ptr<arrow::Array> labels);
+
+        /// first position of label, -1 when it is not in the index
+        [[nodiscard]] int64_t find(arrow::Scalar const &label) const;
+
+        /// position of every label in the index, null where it is missing; ready for arrow's take
+        [[nodiscard]] std::shared_ptr<arrow::Int64Array> get_indexer(arrow::Array const &labels) const;
+
+        [[nodiscard]] bool has_duplicates() const {
+            return m_duplicates;
+        }
+
+        /// true for each label already seen at an earlier position
+        [[nodiscard]] std::shared_ptr<arrow::BooleanArray> duplicated() const;
+
+        /// number of distinct labels
+        [[nodiscard]] size_t size() const {
+            return m_distinct;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return m_distinct == 0;
+        }
+
+        [[nodiscard]] bool contains(std::shared_ptr<arrow::Scalar> const &label) const {
+            return find(*label) >= 0;
+        }
+
+        /// position of label, throws std::out_of_range when it is missing
+        [[nodiscard]] int64_t at(std::shared_ptr<arrow::Scalar> const &label) const;
+
+    private:
+        enum class Kind { Empty, Integer, Binary, Other };
+
+        struct Slot {
+            /// the key itself for Integer, its hash for Binary
+            uint64_t tag;
+            int64_t position;
+        };
+
+        Kind m_kind{Kind::Empty};
+        std::shared_ptr<arrow::Array> m_labels;
+        std::shared_ptr<arrow::Array> m_keys;
+        std::vector<Slot> m_slots;
+        uint64_t m_mask{0};
+        size_t m_distinct{0};
+        bool m_duplicates{false};
+        std::unordered_map<std::shared_ptr<arrow::Scalar>, int64_t, HashScalar, HashScalar> m_scalars;
+
+        static std::pair<Kind, std::shared_ptr<arrow::Array>> keysOf(std::shared_ptr<arrow::Array> const &labels);
+
+        void positions(arrow::Array const &keys, int64_t *out) const;
+
+        [[nodiscard]] int64_t probe(uint64_t key) const;
+
+        [[nodiscard]] int64_t probe(std::string_view key, uint64_t hash) const;
+    };
+}
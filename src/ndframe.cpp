@@ -2,6 +2,7 @@
 // Created by adesola on 1/10/25.
 //
 #include "ndframe.h"
+#include "argminmax.h"
 #include "dataframe.h"
 #include "series.h"
 
@@ -10,7 +11,7 @@
     template<class ArrayTypeImpl>                                                       \
     OutT NDFrame<ArrayTypeImpl>::name() const \
     { \
-        auto result = arrow::compute::CallFunction(#name, { GetInternalArray() }); \
+        auto result = pd::CallFunction(#name, { GetInternalArray() }); \
         if (result.ok()) \
         { \
             return OutT(ReturnFilter); \
@@ -27,7 +28,7 @@
 template<class ArrayTypeImpl>                          \
 pd::Scalar NDFrame<ArrayTypeImpl>::name(bool skip_null) const { \
     arrow::compute::ScalarAggregateOptions opt{ skip_null }; \
-    return ReturnScalarOrThrowOnError(arrow::compute::CallFunction(#name, { GetInternalArray() }, &opt)); \
+    return ReturnScalarOrThrowOnError(pd::CallFunction(#name, { GetInternalArray() }, &opt)); \
 }
 
 #define AggregationT(name, T) \
@@ -35,7 +36,7 @@ pd::Scalar NDFrame<ArrayTypeImpl>::name(bool skip_null) const { \
     T NDFrame<ArrayTypeImpl>::name(bool skip_null) const \
     { \
         arrow::compute::ScalarAggregateOptions opt{ skip_null }; \
-        return ReturnScalarOrThrowOnError(arrow::compute::CallFunction(#name, { GetInternalArray() }, &opt)). template as<T>(); \
+        return ReturnScalarOrThrowOnError(pd::CallFunction(#name, { GetInternalArray() }, &opt)). template as<T>(); \
     }
 
 #define AggregationWithCustomOption(name, f_name, ReturnT, option) \
@@ -43,7 +44,7 @@ pd::Scalar NDFrame<ArrayTypeImpl>::name(bool skip_null) const { \
     ReturnT NDFrame<ArrayTypeImpl>::name() const \
     { \
         auto opt = option; \
-        auto result = arrow::compute::CallFunction(#f_name, { GetInternalArray() }, &opt); \
+        auto result = pd::CallFunction(#f_name, { GetInternalArray() }, &opt); \
         if (result.ok()) \
         { \
             return result->template scalar_as<typename arrow::CTypeTraits<ReturnT>::ScalarType>().value; \
@@ -56,42 +57,42 @@ pd::Scalar NDFrame<ArrayTypeImpl>::name(bool skip_null) const { \
 
 namespace pd {
     template<class ArrayTypeImpl>
-    NDFrame<ArrayTypeImpl>::NDFrame(std::shared_ptr<arrow::Array> const &_index) : m_array(nullptr), m_index(_index) {
+    NDFrame<ArrayTypeImpl>::NDFrame(pd::Index const &_index) : m_array(nullptr), m_index(_index) {
     }
 
     template<class ArrayTypeImpl>
-    NDFrame<ArrayTypeImpl>::NDFrame(int64_t num_rows) : m_array(nullptr), m_index(uint_range(num_rows)) {
+    NDFrame<ArrayTypeImpl>::NDFrame(int64_t num_rows) : m_array(nullptr), m_index(RangeIndex::positions(num_rows)) {
     }
 
     template<class ArrayTypeImpl>
-    NDFrame<ArrayTypeImpl>::NDFrame(int64_t num_rows, std::shared_ptr<arrow::Array> const &_index) : m_array(nullptr) {
+    NDFrame<ArrayTypeImpl>::NDFrame(int64_t num_rows, pd::Index const &_index) : m_array(nullptr) {
         if (_index) {
             m_index = _index;
         } else {
-            m_index = uint_range(num_rows);
+            m_index = RangeIndex::positions(num_rows);
         }
 
-        if (num_rows != m_index->length()) {
+        if (num_rows != m_index.length()) {
             throw std::runtime_error(
                     fmt::format("NDFrame: Number of rows({}) does not match array length({})", num_rows,
-                                m_index->length()));
+                                m_index.length()));
         }
     }
 
     template<class ArrayTypeImpl>
     NDFrame<ArrayTypeImpl>::NDFrame(ArrayType const &array, int64_t num_rows) : m_array(array),
-                                                                                m_index(uint_range(num_rows)) {
+                                                                                m_index(RangeIndex::positions(num_rows)) {
     }
 
     template<class ArrayTypeImpl>
-    NDFrame<ArrayTypeImpl>::NDFrame(ArrayType const &array, std::shared_ptr<arrow::Array> const &_index, bool skipIndex)
+    NDFrame<ArrayTypeImpl>::NDFrame(ArrayType const &array, pd::Index const &_index, bool skipIndex)
             : m_array(array), m_index(_index) {
         if (not m_index and not skipIndex) {
             if (m_array) {
                 if constexpr (std::same_as<ArrayType, std::shared_ptr<arrow::RecordBatch>>) {
-                    m_index = uint_range(array->num_rows());
+                    m_index = RangeIndex::positions(array->num_rows());
                 } else {
-                    m_index = uint_range(array->length());
+                    m_index = RangeIndex::positions(array->length());
                 }
             }
         }
@@ -100,7 +101,7 @@ namespace pd {
     std::shared_ptr<arrow::Array> uint_range(int64_t n_rows) {
         std::vector<uint64_t> index(n_rows);
         std::iota(index.begin(), index.end(), 0);
-        arrow::UInt64Builder builder;
+        arrow::UInt64Builder builder(pd::GetMemoryPool());
 
         ThrowOnFailure(builder.AppendValues(index));
         return ReturnOrThrowOnFailure(builder.Finish());
@@ -131,14 +132,10 @@ namespace pd {
     template<class ArrayTypeImpl>
     int64_t NDFrame<ArrayTypeImpl>::index(Scalar const &search) const {
         if (isIndex) {
-            try {
-                return indexer.at(search.scalar);
-            }
-            catch (std::out_of_range const &) {
-                return -1;
-            }
+            return indexer.labelIndex().find(*search.scalar);
         } else {
-            auto result = arrow::compute::Index(GetInternalArray(), arrow::compute::IndexOptions{search.value()});
+            arrow::compute::IndexOptions options{search.value()};
+            auto result = pd::CallFunction("index", {GetInternalArray()}, &options);
             if (result.ok()) {
                 return result->template scalar_as<arrow::Int64Scalar>().value;
             } else {
@@ -147,11 +144,29 @@ namespace pd {
         }
     }
 
+    template<class ArrayTypeImpl>
+    int64_t NDFrame<ArrayTypeImpl>::argmax(bool skip_na) const {
+        if constexpr (std::same_as<ArrayTypeImpl, arrow::Array>) {
+            return pd::argmax(*m_array, skip_na);
+        } else {
+            return index(max());
+        }
+    }
+
+    template<class ArrayTypeImpl>
+    int64_t NDFrame<ArrayTypeImpl>::argmin(bool skip_na) const {
+        if constexpr (std::same_as<ArrayTypeImpl, arrow::Array>) {
+            return pd::argmin(*m_array, skip_na);
+        } else {
+            return index(min());
+        }
+    }
+
     template<class ArrayTypeImpl>
     std::array<Scalar, 2> NDFrame<ArrayTypeImpl>::first_last(bool skip_null) const {
         arrow::compute::ScalarAggregateOptions opt{skip_null};
         auto result =
-                pd::ReturnOrThrowOnFailure(arrow::compute::CallFunction("first_last", {GetInternalArray()}, &opt));
+                pd::ReturnOrThrowOnFailure(pd::CallFunction("first_last", {GetInternalArray()}, &opt));
 
         auto firstLast = result.template scalar_as<arrow::StructScalar>().value;
         return {pd::Scalar(std::move(firstLast[0])), pd::Scalar(std::move(firstLast[1]))};
@@ -167,18 +182,16 @@ namespace pd {
 
     template<class ArrayTypeImpl>
     MinMax NDFrame<ArrayTypeImpl>::min_max(bool skip_null) const {
-        auto result =
-                ReturnOrThrowOnFailure(
-                        arrow::compute::MinMax(GetInternalArray(), arrow::compute::ScalarAggregateOptions{skip_null}));
+        arrow::compute::ScalarAggregateOptions options{skip_null};
+        auto result = ReturnOrThrowOnFailure(pd::CallFunction("min_max", {GetInternalArray()}, &options));
         auto minmax = result.template scalar_as<arrow::StructScalar>().value;
         return MinMax{pd::Scalar(std::move(minmax[0])), pd::Scalar(std::move(minmax[1]))};
     }
 
     template<class ArrayTypeImpl>
     std::vector<Mode> NDFrame<ArrayTypeImpl>::mode(int64_t n, bool skip_null, uint32_t minCount) const {
-        arrow::Datum result =
-                ReturnOrThrowOnFailure(
-                        arrow::compute::Mode(GetInternalArray(), arrow::compute::ModeOptions{n, skip_null, minCount}));
+        arrow::compute::ModeOptions options{n, skip_null, minCount};
+        arrow::Datum result = ReturnOrThrowOnFailure(pd::CallFunction("mode", {GetInternalArray()}, &options));
         auto arr = result.array_as<arrow::StructArray>();
 
         auto count = arr->length();
@@ -203,7 +216,7 @@ namespace pd {
                                             arrow::compute::QuantileOptions::Interpolation interpolation,
                                             bool skip_nulls, uint32_t min_count) const {
         arrow::compute::QuantileOptions opt{q, interpolation, skip_nulls, min_count};
-        auto result = arrow::compute::Quantile(GetInternalArray(), opt);
+        auto result = pd::CallFunction("quantile", {GetInternalArray()}, &opt);
         if (result.ok()) {
             return Scalar(pd::ReturnOrThrowOnFailure(result->make_array()->GetScalar(0)));
         } else {
@@ -213,8 +226,8 @@ namespace pd {
 
     template<class ArrayTypeImpl>
     Scalar NDFrame<ArrayTypeImpl>::std(int ddof, bool skip_na) const {
-        return ReturnScalarOrThrowOnError(
-                arrow::compute::Stddev(GetInternalArray(), arrow::compute::VarianceOptions{ddof, skip_na}));
+        arrow::compute::VarianceOptions options{ddof, skip_na};
+        return ReturnScalarOrThrowOnError(pd::CallFunction("stddev", {GetInternalArray()}, &options));
     }
 
     Aggregation(sum)
@@ -224,20 +237,20 @@ namespace pd {
                                            uint32_t buffer_size, bool skip_nulls,
                                            uint32_t min_count) const {
         arrow::compute::TDigestOptions opt{q, delta, buffer_size, skip_nulls, min_count};
-        auto result = ReturnOrThrowOnFailure(arrow::compute::TDigest({GetInternalArray()}, opt)).make_array();
+        auto result = ReturnOrThrowOnFailure(pd::CallFunction("tdigest", {GetInternalArray()}, &opt)).make_array();
         return Scalar{ReturnOrThrowOnFailure(result->GetScalar(0))};
     }
 
     template<class ArrayTypeImpl>
     Scalar NDFrame<ArrayTypeImpl>::var(int ddof, bool skip_na) const {
-        return ReturnScalarOrThrowOnError(
-                arrow::compute::Variance(GetInternalArray(), arrow::compute::VarianceOptions{ddof, skip_na}));
+        arrow::compute::VarianceOptions options{ddof, skip_na};
+        return ReturnScalarOrThrowOnError(pd::CallFunction("variance", {GetInternalArray()}, &options));
     }
 
     template<class ArrayTypeImpl>
     Scalar NDFrame<ArrayTypeImpl>::agg(std::string const &name, bool skip_null) const {
         arrow::compute::ScalarAggregateOptions opt{skip_null};
-        return pd::ReturnScalarOrThrowOnError(arrow::compute::CallFunction(name, {GetInternalArray()}, &opt));
+        return pd::ReturnScalarOrThrowOnError(pd::CallFunction(name, {GetInternalArray()}, &opt));
     }
     //</editor-fold>
 
@@ -253,7 +266,7 @@ namespace pd {
             if (!slicer.start.is_not_a_date_time()) {
                 auto startT = fromDateTime(slicer.start);
                 result = ReturnOrThrowOnFailure(
-                                 arrow::compute::CallFunction("greater_equal", {index, startT}))
+                                 pd::CallFunction("greater_equal", {index, startT}))
                                  .make_array();
             }
             if (!slicer.end.is_not_a_date_time()) {
@@ -261,13 +274,13 @@ namespace pd {
                 auto endT = fromDateTime(slicer.end);
 
                 if (result) {
-                    result = ReturnOrThrowOnFailure(arrow::compute::CallFunction("and", {ReturnOrThrowOnFailure(
-                                                                                                 arrow::compute::CallFunction(kernel, {index, endT}))
+                    result = ReturnOrThrowOnFailure(pd::CallFunction("and", {ReturnOrThrowOnFailure(
+                                                                                                 pd::CallFunction(kernel, {index, endT}))
                                                                                                  .make_array(),
                                                                                          result}))
                                      .make_array();
                 } else {
-                    result = ReturnOrThrowOnFailure(arrow::compute::CallFunction(kernel, {index, endT})).make_array();
+                    result = ReturnOrThrowOnFailure(pd::CallFunction(kernel, {index, endT})).make_array();
                 }
             }
 
@@ -308,17 +321,15 @@ namespace pd {
         if (index->type_id() == arrow::Type::STRING) {
             int64_t start = 0, end = index->length();
             if (slicer.start) {
-                start = ReturnScalarOrThrowOnError(arrow::compute::Index(
-                        index,
-                        arrow::compute::IndexOptions{arrow::MakeScalar(slicer.start.value())})).template as<int64_t>();
+                arrow::compute::IndexOptions options{arrow::MakeScalar(slicer.start.value())};
+                start = ReturnScalarOrThrowOnError(pd::CallFunction("index", {index}, &options)).template as<int64_t>();
                 if (start == -1) {
                     throw std::runtime_error("invalid start index");
                 }
             }
             if (slicer.end) {
-                end = ReturnScalarOrThrowOnError(
-                        arrow::compute::Index(index,
-                                              arrow::compute::IndexOptions{arrow::MakeScalar(slicer.end.value())})).template as<int64_t>();
+                arrow::compute::IndexOptions options{arrow::MakeScalar(slicer.end.value())};
+                end = ReturnScalarOrThrowOnError(pd::CallFunction("index", {index}, &options)).template as<int64_t>();
                 if (end == -1) {
                     throw std::runtime_error("invalid end index");
                 }
@@ -350,7 +361,7 @@ namespace pd {
     }
 
     template<class ArrayTypeImpl>
-    NDFrame<ArrayTypeImpl>::ChildType NDFrame<ArrayTypeImpl>::setIndex(std::shared_ptr<arrow::Array> const &index) const {
+    NDFrame<ArrayTypeImpl>::ChildType NDFrame<ArrayTypeImpl>::setIndex(pd::Index const &index) const {
         return ChildType{
             m_array, index
         };
@@ -359,15 +370,14 @@ namespace pd {
 
     template<class ArrayTypeImpl>
     pd::ArrayPtr NDFrame<ArrayTypeImpl>::normalizeIndex() const {
-        if (m_index->type_id() != arrow::Type::TIMESTAMP) {
+        if (m_index.type()->id() != arrow::Type::TIMESTAMP) {
             auto error = fmt::format("Index must be of type TIMESTAMP, but found index of type {}",
-                                     m_index->type()->ToString());
+                                     m_index.type()->ToString());
             throw std::runtime_error(error);
         }
 
-        return pd::ReturnOrThrowOnFailure(arrow::compute::FloorTemporal(m_index,
-                                                                        arrow::compute::RoundTemporalOptions{1,
-                                                                                                             arrow::compute::CalendarUnit::DAY})).make_array();
+        arrow::compute::RoundTemporalOptions options{1, arrow::compute::CalendarUnit::DAY};
+        return pd::ReturnOrThrowOnFailure(pd::CallFunction("floor_temporal", {m_index}, &options)).make_array();
 
     }
 
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <fmt/format.h>
 
+#include "range_index.h"
 #include "scalar.h"
 #include "sstream"
 #include "span"
@@ -17,27 +18,6 @@
 
 namespace pd {
 
-    struct HashScalar {
-
-        bool operator()(std::shared_ptr<arrow::Scalar> const &a, std::shared_ptr<arrow::Scalar> const &b) const {
-            return a->Equals(*b->CastTo(a->type).MoveValueUnsafe());
-        }
-
-        bool equal(std::shared_ptr<arrow::Scalar> const &a, std::shared_ptr<arrow::Scalar> const &b) const {
-            return a->Equals(*b->CastTo(a->type).MoveValueUnsafe());
-        }
-
-        size_t operator()(std::shared_ptr<arrow::Scalar> const &scalar) const {
-            return scalar->hash();
-        }
-
-        size_t hash(std::shared_ptr<arrow::Scalar> const &scalar) const {
-            return scalar->hash();
-        }
-    };
-
-    using Indexer = std::unordered_map<std::shared_ptr<arrow::Scalar>, int64_t, HashScalar, HashScalar>;
-
 /// Thrown when an invalid cast is attempted on the array data.
     struct RawArrayCastException : std::exception {
         std::shared_ptr<arrow::DataType> requested_type, array_type;
@@ -71,7 +51,7 @@ namespace pd {
                ArrayType const &array,
                std::shared_ptr<arrow::Array> const &index) {
         auto size = index->length();
-        typename arrow::CTypeTraits<ReturnT>::BuilderType builder;
+        typename arrow::CTypeTraits<ReturnT>::BuilderType builder(pd::GetMemoryPool());
         ThrowOnFailure(builder.Reserve(size));
 
         if (window > size) {
@@ -108,15 +88,15 @@ namespace pd {
         virtual ~NDFrame() = default;
 
         //<editor-fold desc="Constructor">
-        NDFrame(ArrayType const &array, std::shared_ptr<arrow::Array> const &_index, bool skipIndex = false);
+        NDFrame(ArrayType const &array, pd::Index const &_index, bool skipIndex = false);
 
         NDFrame(ArrayType const &array, int64_t num_rows);
 
-        explicit NDFrame(std::shared_ptr<arrow::Array> const &_index = nullptr);
+        explicit NDFrame(pd::Index const &_index = nullptr);
 
         explicit NDFrame(int64_t num_rows);
 
-        NDFrame(int64_t num_rows, std::shared_ptr<arrow::Array> const &_index);
+        NDFrame(int64_t num_rows, pd::Index const &_index);
 
         virtual bool equals_(BaseT const &a) const {
             return m_array->Equals(*a.m_array);
@@ -128,10 +108,20 @@ namespace pd {
 
         [[nodiscard]] Series index() const;
 
-        std::shared_ptr<arrow::Array> indexArray() const noexcept {
+        std::shared_ptr<arrow::Array> indexArray() const {
+            return m_index;
+        }
+
+        /// the row labels without materializing a RangeIndex
+        [[nodiscard]] pd::Index const &labels() const noexcept {
             return m_index;
         }
 
+        /// set when the labels are a RangeIndex, which is never stored as an array
+        [[nodiscard]] std::optional<RangeIndex> rangeIndex() const {
+            return m_index.range();
+        }
+
         template<typename T>
         static bool CanCastToInt64FromTimestamp(pd::ArrayPtr const& array) {
             return (arrow::CTypeTraits<T>::type_singleton()->id() == arrow::Type::INT64 && array->type()->id() == arrow::Type::TIMESTAMP);
@@ -273,13 +263,10 @@ namespace pd {
 
         [[nodiscard]] Scalar agg(std::string const &func, bool skip_null = true) const;
 
-        [[nodiscard]] int64_t argmax() const {
-            return index(max());
-        }
+        /// position of the first largest / smallest value, -1 when there is none (see pd::argmax)
+        [[nodiscard]] int64_t argmax(bool skip_na = true) const;
 
-        [[nodiscard]] int64_t argmin() const {
-            return index(min());
-        }
+        [[nodiscard]] int64_t argmin(bool skip_na = true) const;
         //</editor-fold>
 
         //<editor-fold desc="Indexing Functions">
@@ -297,7 +284,7 @@ namespace pd {
 
         virtual ChildType take(Series const &) const = 0;
 
-        ChildType setIndex(std::shared_ptr<arrow::Array> const &index) const;
+        ChildType setIndex(pd::Index const &index) const;
         //</editor-fold>
 
         //<editor-fold desc="Indexing Operations">
@@ -311,17 +298,16 @@ namespace pd {
 
     protected:
         std::vector<uint8_t> byteValidStr;
-        std::shared_ptr<arrow::Array> m_index;
-        Indexer indexer;
+        pd::Index m_index;
+        /// the values of a Series that is an index, hashed on first lookup
+        pd::Index indexer;
         bool isIndex{false};
 
         void setIndexer() {
             if constexpr (std::same_as<ArrayTypeImpl, arrow::Array>) {
                 if (m_array != nullptr) {
                     isIndex = true;
-                    for (int i = 0; i < m_array->length(); i++) {
-                        indexer[m_array->GetScalar(i).MoveValueUnsafe()] = i;
-                    }
+                    indexer = pd::Index{m_array};
                 }
             }
         }
@@ -3,12 +3,28 @@
 // Created by dewe on 12/29/22.
 //
 
+#include "argminmax.h"
+#include "calendar.h"
+#include "categorical.h"
+#include "chunked_frame.h"
 #include "concat.h"
 #include "core.h"
+#include "dataset.h"
 #include "datetimelike.h"
+#include "describe.h"
+#include "elementwise.h"
+#include "ewm.h"
 #include "group_by.h"
+#include "json_io.h"
+#include "label_index.h"
+#include "prefetch.h"
+#include "range_index.h"
 #include "resample.h"
+#include "scheduler.h"
+#include "sort.h"
 #include "stringlike.h"
+#include "tracing.h"
+#include "streaming_frame.h"
 
 
 namespace pd {
@@ -1,5 +1,5 @@
 #pragma once
-#include "tbb/parallel_for.h"
+#include "scheduler.h"
 
 
 #define GROUPBY_NUMERIC_AGG(func, T) \
@@ -18,22 +18,22 @@
             int index = schema->GetFieldIndex(arg); \
 \
             std::vector<T> result(L); \
-            tbb::parallel_for( \
-                tbb::blocked_range<size_t>(0, uniqueKeys->length()), \
-                [&](const tbb::blocked_range<size_t>& /*unused*/) \
+            pd::parallel_for( \
+                tbb::blocked_range<size_t>(0, L, pd::grainSize(int64_t(L))), \
+                pd::bindExecContext([&](const tbb::blocked_range<size_t>& r) \
                 { \
-                    for (size_t j = 0; j < L; j++) \
+                    for (size_t j = r.begin(); j != r.end(); j++) \
                     { \
                         auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe(); \
                         auto& group = groups.at(key); \
 \
                         arrow::Datum d = \
-                            arrow::compute::CallFunction(#func, { group[index] }, defaultOpt.get()).MoveValueUnsafe(); \
+                            pd::CallFunction(#func, { group[index] }, defaultOpt.get()).MoveValueUnsafe(); \
                         result[j] = d.scalar_as<arrow::CTypeTraits<T>::ScalarType>().value; \
                     } \
-                }); \
+                })); \
 \
-            auto builder = arrow::CTypeTraits<T>::BuilderType(); \
+            auto builder = arrow::CTypeTraits<T>::BuilderType(pd::GetMemoryPool()); \
             ThrowOnFailure(builder.AppendValues(result)); \
 \
             std::shared_ptr<arrow::ArrayData> data; \
@@ -53,9 +53,9 @@
         int index = schema->GetFieldIndex(arg); \
 \
         std::vector<T> result(L); \
-        tbb::parallel_for( \
-            tbb::blocked_range<size_t>(0, L), \
-            [&](const tbb::blocked_range<size_t>& r) \
+        pd::parallel_for( \
+            tbb::blocked_range<size_t>(0, L, pd::grainSize(L)), \
+            pd::bindExecContext([&](const tbb::blocked_range<size_t>& r) \
             { \
                 for (size_t j = r.begin(); j != r.end(); ++j) \
                 { \
@@ -63,12 +63,12 @@
                     auto& group = groups.at(key); \
 \
                     arrow::Datum d = \
-                        arrow::compute::CallFunction(#func, { group[index] }, defaultOpt.get()).MoveValueUnsafe(); \
+                        pd::CallFunction(#func, { group[index] }, defaultOpt.get()).MoveValueUnsafe(); \
                     result[j] = d.scalar_as<arrow::CTypeTraits<T>::ScalarType>().value; \
                 } \
-            }); \
+            })); \
 \
-        auto builder = arrow::CTypeTraits<T>::BuilderType(); \
+        auto builder = arrow::CTypeTraits<T>::BuilderType(pd::GetMemoryPool()); \
         ThrowOnFailure(builder.AppendValues(result)); \
 \
         std::shared_ptr<arrow::Array> data; \
@@ -91,19 +91,19 @@
             int index = schema->GetFieldIndex(arg); \
 \
             arrow::ScalarVector result(L); \
-            tbb::parallel_for( \
-                tbb::blocked_range<size_t>(0, L), \
-                [&](const tbb::blocked_range<size_t>& r) \
+            pd::parallel_for( \
+                tbb::blocked_range<size_t>(0, L, pd::grainSize(L)), \
+                pd::bindExecContext([&](const tbb::blocked_range<size_t>& r) \
                 { \
                     for (size_t j = r.begin(); j != r.end(); ++j) \
                     { \
                         auto key = uniqueKeys->GetScalar(long(j)).MoveValueUnsafe(); \
                         auto& group = groups.at(key); \
                         arrow::Datum d = pd::ReturnOrThrowOnFailure( \
-                            arrow::compute::CallFunction(#func, { group[index] }, defaultOpt.get())); \
+                            pd::CallFunction(#func, { group[index] }, defaultOpt.get())); \
                         result[j] = d.scalar(); \
                     } \
-                }); \
+                })); \
 \
             ARROW_ASSIGN_OR_RAISE(arr[i], buildData(result)); \
         } \
@@ -119,9 +119,9 @@
         int index = schema->GetFieldIndex(arg); \
 \
         arrow::ScalarVector result(L); \
-        tbb::parallel_for( \
-            tbb::blocked_range<size_t>(0, L), \
-            [&](const tbb::blocked_range<size_t>& r) \
+        pd::parallel_for( \
+            tbb::blocked_range<size_t>(0, L, pd::grainSize(L)), \
+            pd::bindExecContext([&](const tbb::blocked_range<size_t>& r) \
             { \
                 for (size_t j = r.begin(); j != r.end(); ++j) \
                 { \
@@ -129,15 +129,15 @@
                     auto& group = groups.at(key); \
 \
                     arrow::Datum d = \
-                        arrow::compute::CallFunction(#func, { group[index] }, defaultOpt.get()).MoveValueUnsafe(); \
+                        pd::CallFunction(#func, { group[index] }, defaultOpt.get()).MoveValueUnsafe(); \
                     result[j] = d.scalar(); \
                 } \
-            }); \
+            })); \
 \
         std::shared_ptr<arrow::ArrayBuilder> builder; \
         if (not result.empty()) \
         { \
-            builder = arrow::MakeBuilder(result.back()->type).MoveValueUnsafe(); \
+            builder = arrow::MakeBuilder(result.back()->type, pd::GetMemoryPool()).MoveValueUnsafe(); \
             RETURN_NOT_OK(builder->AppendScalars(result)); \
         } \
         std::shared_ptr<arrow::Array> data; \
@@ -147,15 +147,28 @@
     }
 
 
+#define GROUPBY_CUMULATIVE(func, op) \
+    arrow::Result<pd::DataFrame> GroupBy::func(std::vector<std::string> const& args) \
+    { \
+        return transformColumns(args, [&](ArrayPtr const& column, int) { return cumulative(column, op); }); \
+    } \
+\
+    arrow::Result<pd::Series> GroupBy::func(std::string const& arg) \
+    { \
+        ARROW_ASSIGN_OR_RAISE(auto result, func(std::vector{ arg })); \
+        return result[arg]; \
+    }
+
+
 #define FOR_ALL_COLUMN(SERIES_FUNCTION_NAME) \
     DataFrame DataFrame::SERIES_FUNCTION_NAME() const \
     { \
         auto N = num_columns(); \
         arrow::ArrayDataVector new_columns(N); \
-        tbb::parallel_for( \
+        pd::parallel_for( \
             0L, \
             N, \
-            [&](::int64_t i) \
-            { new_columns[i] = Series(this->m_array->column(i), m_index).SERIES_FUNCTION_NAME().m_array->data(); }); \
+            pd::bindExecContext([&](::int64_t i) \
+            { new_columns[i] = Series(this->m_array->column(i), m_index).SERIES_FUNCTION_NAME().m_array->data(); })); \
         return DataFrame(m_array->schema(), num_rows(), new_columns, m_index); \
     }
@@ -0,0 +1,73 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "prefetch.h"
+#include <arrow/util/byte_size.h>
+
+
+namespace pd {
+
+    Prefetcher::Prefetcher(std::vector<std::string> paths, PrefetchOptions options)
+            : m_paths(std::move(paths)), m_options(std::move(options)) {
+        fill();
+    }
+
+    std::optional<DataFrame> Prefetcher::next() {
+        if (m_pending.empty()) {
+            return std::nullopt;
+        }
+        auto front = std::move(m_pending.front());
+        m_pending.pop_front();
+        // the reads after it start before waiting on it
+        fill();
+
+        auto decoded = pd::ReturnOrThrowOnFailure(front.MoveResult());
+        m_largest = std::max(m_largest, decoded.bytes);
+        // with its size known the budget may allow more reads
+        fill();
+        return std::move(decoded.frame);
+    }
+
+    int64_t Prefetcher::bytesAhead() const {
+        int64_t bytes = 0;
+        for (auto const &pending: m_pending) {
+            if (pending.is_finished() and pending.result().ok()) {
+                bytes += pending.result()->bytes;
+            }
+        }
+        return bytes;
+    }
+
+    void Prefetcher::fill() {
+        const auto depth = static_cast<size_t>(std::max(m_options.depth, 1));
+        while (m_next < m_paths.size() and m_pending.size() < depth) {
+            if (m_options.memoryBudget > 0 and not m_pending.empty()) {
+                // frames still being read are assumed to be as large as the largest one seen,
+                // nothing is read ahead until one size is known
+                int64_t held = 0;
+                for (auto const &pending: m_pending) {
+                    if (pending.is_finished() and pending.result().ok()) {
+                        m_largest = std::max(m_largest, pending.result()->bytes);
+                        held += pending.result()->bytes;
+                    } else {
+                        held += m_largest;
+                    }
+                }
+                if (m_largest == 0 or held + m_largest > m_options.memoryBudget) {
+                    break;
+                }
+            }
+
+            auto const &path = m_paths[m_next++];
+            auto frame = path.ends_with(".csv") ? DataFrame::readCSVAsync(path)
+                                                : DataFrame::readParquetAsync(path, m_options.dictionaryColumns);
+            m_pending.push_back(frame.Then([](DataFrame const &df) {
+                auto bytes = arrow::util::TotalBufferSize(*df.array());
+                if (auto index = df.indexArray()) {
+                    bytes += arrow::util::TotalBufferSize(*index);
+                }
+                return Decoded{df, bytes};
+            }));
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/util/future.h>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+#include "dataframe.h"
+
+
+namespace pd {
+
+    struct PrefetchOptions {
+        /// files read and decoded ahead of the one being consumed
+        int32_t depth{2};
+        /// bytes of decoded frames held ahead, 0 for no limit. The next file is always read,
+        /// further ones only while the largest frame seen so far still fits.
+        int64_t memoryBudget{0};
+        /// passed to readParquet
+        std::vector<std::string> dictionaryColumns{};
+    };
+
+    /// Frames of an ordered list of files, read in the background while the caller works on
+    /// the current one. Paths ending in .csv are read with readCSV, the others with readParquet,
+    /// so s3:// parquet files are supported as well as local ones.
+    class Prefetcher {
+    public:
+        explicit Prefetcher(std::vector<std::string> paths, PrefetchOptions options = {});
+
+        /// the frame of the next path, waiting for it if it is still being read; nullopt after the last
+        std::optional<DataFrame> next();
+
+        /// files being read or decoded and not consumed yet
+        [[nodiscard]] size_t ahead() const { return m_pending.size(); }
+
+        /// bytes of the decoded frames not consumed yet
+        [[nodiscard]] int64_t bytesAhead() const;
+
+        [[nodiscard]] size_t remaining() const { return m_paths.size() - m_next + m_pending.size(); }
+
+    private:
+        struct Decoded {
+            DataFrame frame;
+            int64_t bytes;
+        };
+
+        std::vector<std::string> m_paths;
+        PrefetchOptions m_options;
+        size_t m_next{0};
+        std::deque<arrow::Future<Decoded>> m_pending;
+        int64_t m_largest{0};
+
+        void fill();
+    };
+}
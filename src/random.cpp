@@ -0,0 +1,290 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "random.h"
+#include <cmath>
+#include <random>
+#include <unordered_set>
+#include <tbb/parallel_sort.h>
+#include "core.h"
+#include "dataframe.h"
+#include "series.h"
+
+
+namespace pd::random {
+
+    namespace {
+        constexpr int64_t GRAIN = 1 << 14;
+        /// samples of at most population / SPARSE_SAMPLE rows are drawn in O(size) memory
+        constexpr int64_t SPARSE_SAMPLE = 16;
+
+        uint64_t splitmix64(uint64_t x) {
+            x += 0x9E3779B97F4A7C15;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+            return x ^ (x >> 31);
+        }
+
+        uint64_t bits64(uint32_t hi, uint32_t lo) {
+            return (uint64_t{hi} << 32) | lo;
+        }
+
+        /// [0, 1) from the top 53 bits
+        double unit(uint64_t bits) {
+            return static_cast<double>(bits >> 11) * 0x1.0p-53;
+        }
+
+        /// Marsaglia & Tsang's ziggurat tables for 256 layers of the standard normal, scaled to 52 bit draws
+        struct Ziggurat {
+            static constexpr double R = 3.6541528853610088;
+            static constexpr double AREA = 0.00492867323399;
+
+            std::array<uint64_t, 256> k{};
+            std::array<double, 256> w{};
+            std::array<double, 256> f{};
+
+            Ziggurat() {
+                constexpr double scale = 0x1.0p52;
+                double dn = R;
+                double tn = dn;
+                const double q = AREA / std::exp(-0.5 * dn * dn);
+
+                k[0] = static_cast<uint64_t>((dn / q) * scale);
+                k[1] = 0;
+                w[0] = q / scale;
+                w[255] = dn / scale;
+                f[0] = 1.0;
+                f[255] = std::exp(-0.5 * dn * dn);
+                for (int i = 254; i >= 1; i--) {
+                    dn = std::sqrt(-2.0 * std::log(AREA / dn + std::exp(-0.5 * dn * dn)));
+                    k[i + 1] = static_cast<uint64_t>((dn / tn) * scale);
+                    tn = dn;
+                    f[i] = std::exp(-0.5 * dn * dn);
+                    w[i] = dn / scale;
+                }
+            }
+
+            static Ziggurat const &Instance() {
+                static const Ziggurat instance;
+                return instance;
+            }
+        };
+
+        /// out[i] = valueAt(first + i) for i in [0, size), in parallel for long fills
+        template<class T, class ValueAt>
+        void generate(T *out, int64_t size, uint64_t first, ValueAt &&valueAt) {
+            pd::parallel_for(tbb::blocked_range<int64_t>(0, size, pd::grainSize(size, GRAIN)),
+                             pd::bindExecContext([&](tbb::blocked_range<int64_t> const &r) {
+                                 for (int64_t i = r.begin(); i != r.end(); i++) {
+                                     out[i] = valueAt(first + i);
+                                 }
+                             }));
+        }
+
+        template<class ArrayType, class T, class Fill>
+        std::shared_ptr<ArrayType> makeArray(int64_t size, Fill &&fill) {
+            auto buffer = ReturnOrThrowOnFailure(arrow::AllocateBuffer(size * int64_t{sizeof(T)}, pd::GetMemoryPool()));
+            fill(reinterpret_cast<T *>(buffer->mutable_data()));
+            return std::make_shared<ArrayType>(size, std::move(buffer));
+        }
+
+        void checkSize(int64_t size) {
+            if (size < 0) {
+                throw std::invalid_argument("RandomState: size must not be negative");
+            }
+        }
+    }
+
+    RandomState::RandomState(std::optional<uint64_t> const &seed)
+            : RandomState(seed ? *seed : bits64(std::random_device()(), std::random_device()()), 0) {
+    }
+
+    RandomState::RandomState(uint64_t seed, uint64_t stream, uint64_t position)
+            : m_seed(seed), m_stream(stream), m_position(position) {
+    }
+
+    RandomState RandomState::substream(uint64_t id) const {
+        return RandomState{m_seed, splitmix64(m_stream ^ splitmix64(id + 1)), 0};
+    }
+
+    Philox4x32::Counter RandomState::block(uint64_t position, uint32_t attempt) const {
+        // positions take the low 56 bits of the first two words, retries of a draw the top 8
+        const Philox4x32::Counter counter{static_cast<uint32_t>(position),
+                                          static_cast<uint32_t>((position >> 32) & 0xFFFFFF) | ((attempt & 0xFF) << 24),
+                                          static_cast<uint32_t>(m_stream),
+                                          static_cast<uint32_t>(m_stream >> 32)};
+        return Philox4x32::apply(counter, {static_cast<uint32_t>(m_seed), static_cast<uint32_t>(m_seed >> 32)});
+    }
+
+    uint64_t RandomState::advance(int64_t size) const {
+        checkSize(size);
+        const uint64_t first = m_position;
+        m_position += static_cast<uint64_t>(size);
+        return first;
+    }
+
+    //<editor-fold desc="Buffers">
+    void RandomState::fillUniform(double *out, int64_t size, double low, double high) const {
+        const double width = high - low;
+        generate(out, size, advance(size), [&](uint64_t position) {
+            auto b = block(position);
+            return low + unit(bits64(b[0], b[1])) * width;
+        });
+    }
+
+    void RandomState::fillNormal(double *out, int64_t size, double mean, double std) const {
+        auto const &zig = Ziggurat::Instance();
+        generate(out, size, advance(size), [&](uint64_t position) {
+            for (uint32_t attempt = 0;; attempt++) {
+                auto b = block(position, attempt);
+                uint64_t r = bits64(b[0], b[1]);
+                const auto layer = static_cast<int>(r & 0xFF);
+                r >>= 8;
+                const bool negative = r & 1;
+                const uint64_t magnitude = (r >> 1) & 0x000FFFFFFFFFFFFF;
+                double x = static_cast<double>(magnitude) * zig.w[layer];
+                if (negative) {
+                    x = -x;
+                }
+                if (magnitude < zig.k[layer]) {
+                    return mean + std * x;
+                }
+                if (layer == 0) {
+                    // the tail beyond R, sampled until accepted
+                    for (;;) {
+                        auto tail = block(position, ++attempt);
+                        const double xx = -std::log1p(-unit(bits64(tail[0], tail[1]))) / Ziggurat::R;
+                        const double yy = -std::log1p(-unit(bits64(tail[2], tail[3])));
+                        if (yy + yy > xx * xx) {
+                            return mean + std * (negative ? -(Ziggurat::R + xx) : Ziggurat::R + xx);
+                        }
+                    }
+                }
+                if ((zig.f[layer - 1] - zig.f[layer]) * unit(bits64(b[2], b[3])) + zig.f[layer] < std::exp(-0.5 * x * x)) {
+                    return mean + std * x;
+                }
+            }
+        });
+    }
+
+    void RandomState::fillIntegers(int64_t *out, int64_t size, int64_t low, int64_t high) const {
+        if (high <= low) {
+            throw std::invalid_argument("RandomState: integers need low < high");
+        }
+        const auto range = static_cast<uint64_t>(high) - static_cast<uint64_t>(low);
+        generate(out, size, advance(size), [&](uint64_t position) {
+            auto b = block(position);
+            const auto scaled = static_cast<uint64_t>((static_cast<unsigned __int128>(bits64(b[0], b[1])) * range) >> 64);
+            return static_cast<int64_t>(static_cast<uint64_t>(low) + scaled);
+        });
+    }
+
+    std::shared_ptr<arrow::DoubleArray> RandomState::uniform(int64_t size, double low, double high) const {
+        return makeArray<arrow::DoubleArray, double>(size, [&](double *out) { fillUniform(out, size, low, high); });
+    }
+
+    std::shared_ptr<arrow::DoubleArray> RandomState::normal(int64_t size, double mean, double std) const {
+        return makeArray<arrow::DoubleArray, double>(size, [&](double *out) { fillNormal(out, size, mean, std); });
+    }
+
+    std::shared_ptr<arrow::Int64Array> RandomState::integers(int64_t size, int64_t low, int64_t high) const {
+        return makeArray<arrow::Int64Array, int64_t>(size, [&](int64_t *out) { fillIntegers(out, size, low, high); });
+    }
+
+    std::shared_ptr<arrow::Int64Array> RandomState::permutation(int64_t size) const {
+        return sampleIndices(size, size, false);
+    }
+
+    std::shared_ptr<arrow::Int64Array> RandomState::sampleSparse(int64_t population, int64_t size, uint64_t first) const {
+        // Floyd's algorithm picks the set with one draw per row, a Fisher-Yates pass over it with the
+        // other half of the same blocks puts it in random order
+        auto draw = [](uint64_t bits, uint64_t bound) {
+            return static_cast<int64_t>((static_cast<unsigned __int128>(bits) * bound) >> 64);
+        };
+        std::unordered_set<int64_t> chosen;
+        chosen.reserve(size);
+        return makeArray<arrow::Int64Array, int64_t>(size, [&](int64_t *out) {
+            for (int64_t i = 0; i < size; i++) {
+                const int64_t j = population - size + i;
+                auto b = block(first + i);
+                const int64_t t = draw(bits64(b[0], b[1]), static_cast<uint64_t>(j) + 1);
+                // j itself was never drawn before, it stands in when t is taken
+                out[i] = chosen.insert(t).second ? t : j;
+                chosen.insert(out[i]);
+            }
+            for (int64_t i = size - 1; i > 0; i--) {
+                auto b = block(first + i);
+                std::swap(out[i], out[draw(bits64(b[2], b[3]), static_cast<uint64_t>(i) + 1)]);
+            }
+        });
+    }
+
+    std::shared_ptr<arrow::Int64Array> RandomState::sampleIndices(int64_t population, int64_t size, bool replace) const {
+        checkSize(size);
+        if (replace) {
+            if (population <= 0 and size > 0) {
+                throw std::invalid_argument("RandomState: cannot sample from an empty population");
+            }
+            return size == 0 ? integers(0, 0, 1) : integers(size, 0, population);
+        }
+        if (size > population) {
+            throw std::invalid_argument("RandomState: cannot sample more rows than the population without replacement");
+        }
+
+        // both methods consume population draws so that later draws do not depend on which one ran
+        const uint64_t first = advance(population);
+        if (size <= population / SPARSE_SAMPLE) {
+            return sampleSparse(population, size, first);
+        }
+
+        // every position gets a random key, the size smallest keys win: ties are broken by position so
+        // the result is the same whatever order the keys are compared in
+        std::vector<std::pair<uint64_t, int64_t>> keys(population);
+        generate(keys.data(), population, first, [&](uint64_t position) {
+            auto b = block(position);
+            return std::pair{bits64(b[0], b[1]), static_cast<int64_t>(position - first)};
+        });
+        if (size < population) {
+            std::ranges::nth_element(keys, keys.begin() + size);
+            keys.resize(size);
+        }
+        if (pd::GetExecContext().use_threads) {
+            pd::inArena([&] { tbb::parallel_sort(keys.begin(), keys.end()); });
+        } else {
+            std::ranges::sort(keys);
+        }
+
+        return makeArray<arrow::Int64Array, int64_t>(size, [&](int64_t *out) {
+            for (int64_t i = 0; i < size; i++) {
+                out[i] = keys[i].second;
+            }
+        });
+    }
+    //</editor-fold>
+
+    //<editor-fold desc="Series and DataFrame">
+    pd::Series RandomState::sample(pd::Series const &data, int64_t size, bool replace) const {
+        return data.take(pd::Series{sampleIndices(data.size(), size, replace), false});
+    }
+
+    pd::DataFrame RandomState::sample(pd::DataFrame const &data, int64_t size, bool replace) const {
+        return data.take(pd::Series{sampleIndices(data.num_rows(), size, replace), false});
+    }
+
+    pd::Series RandomState::permutation(pd::Series const &data) const {
+        return data.take(pd::Series{permutation(data.size()), false});
+    }
+
+    pd::DataFrame RandomState::permutation(pd::DataFrame const &data) const {
+        return data.take(pd::Series{permutation(data.num_rows()), false});
+    }
+
+    pd::Series RandomState::resample(pd::Series const &data, int64_t replicate) const {
+        return substream(replicate).sample(data, data.size(), true);
+    }
+
+    pd::DataFrame RandomState::resample(pd::DataFrame const &data, int64_t replicate) const {
+        return substream(replicate).sample(data, data.num_rows(), true);
+    }
+    //</editor-fold>
+}
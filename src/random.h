@@ -3,33 +3,133 @@
 // Created by dewe on 1/9/23.
 //
 #include <algorithm>
-#include <random>
-#include "optional"
-#include "ranges"
-#include "vector"
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <vector>
 #include <arrow/api.h>
+#include "exec_context.h"
+#include "scheduler.h"
+
+namespace pd {
+class Series;
+class DataFrame;
+}
 
 namespace pd::random {
 
 using vector_double = std::vector<double>;
 using vector_int = std::vector<int64_t>;
 
+/// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"): ten rounds of a keyed
+/// bijection over a 128 bit counter. Every counter gives an independent block of four 32 bit words, so
+/// any draw can be computed on its own without stepping through the ones before it.
+struct Philox4x32
+{
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static Counter apply(Counter counter, Key key) noexcept
+    {
+        for (int round = 0; round < 10; round++)
+        {
+            if (round > 0)
+            {
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            const uint64_t p0 = uint64_t{ 0xD2511F53 } * counter[0];
+            const uint64_t p1 = uint64_t{ 0xCD9E8D57 } * counter[2];
+            counter = { static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                        static_cast<uint32_t>(p1),
+                        static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                        static_cast<uint32_t>(p0) };
+        }
+        return counter;
+    }
+};
+
+/// Counter based random numbers: draw i of a stream is Philox of (seed, stream, position + i), so results do
+/// not depend on how many threads generate them or in which order. Every fill advances position by the
+/// number of values written; jump skips draws and substream gives independent streams of the same seed.
+/// Bulk generation runs in parallel straight into the output buffer (see pd::parallel_for).
 class RandomState
 {
 public:
-    explicit RandomState(std::optional<uint64_t> const& seed) : gen(seed ? *seed : std::random_device()())
+    explicit RandomState(std::optional<uint64_t> const& seed);
+
+    RandomState(uint64_t seed, uint64_t stream, uint64_t position = 0);
+
+    [[nodiscard]] uint64_t seed() const { return m_seed; }
+
+    [[nodiscard]] uint64_t stream() const { return m_stream; }
+
+    [[nodiscard]] uint64_t position() const { return m_position; }
+
+    /// skips the next draws, e.g. to give each job its own slice of one stream
+    void jump(uint64_t draws) const { m_position += draws; }
+
+    /// an independent stream of the same seed, starting at position 0; equal ids give equal streams
+    [[nodiscard]] RandomState substream(uint64_t id) const;
+
+    //<editor-fold desc="Buffers">
+    /// uniform doubles in [low, high)
+    void fillUniform(double* out, int64_t size, double low = 0, double high = 1) const;
+
+    /// normal doubles by 256 layer Ziggurat, retries of a draw stay on that draw's counter
+    void fillNormal(double* out, int64_t size, double mean = 0, double std = 1) const;
+
+    /// integers in [low, high) by multiply-shift of 64 random bits, biased by at most (high - low) / 2^64
+    void fillIntegers(int64_t* out, int64_t size, int64_t low, int64_t high) const;
+
+    [[nodiscard]] std::shared_ptr<arrow::DoubleArray> uniform(int64_t size, double low = 0, double high = 1) const;
+
+    [[nodiscard]] std::shared_ptr<arrow::DoubleArray> normal(int64_t size, double mean = 0, double std = 1) const;
+
+    [[nodiscard]] std::shared_ptr<arrow::Int64Array> integers(int64_t size, int64_t low, int64_t high) const;
+
+    /// 0 .. size - 1 in random order
+    [[nodiscard]] std::shared_ptr<arrow::Int64Array> permutation(int64_t size) const;
+
+    /// size positions out of 0 .. population - 1 in random order, distinct unless replace.
+    /// Without replacement small samples take O(size) memory, larger ones and permutations O(population).
+    [[nodiscard]] std::shared_ptr<arrow::Int64Array> sampleIndices(int64_t population, int64_t size, bool replace = false) const;
+    //</editor-fold>
+
+    //<editor-fold desc="Series and DataFrame">
+    /// size rows taken at random, index included
+    [[nodiscard]] pd::Series sample(pd::Series const& data, int64_t size, bool replace = false) const;
+
+    [[nodiscard]] pd::DataFrame sample(pd::DataFrame const& data, int64_t size, bool replace = false) const;
+
+    [[nodiscard]] pd::Series permutation(pd::Series const& data) const;
+
+    [[nodiscard]] pd::DataFrame permutation(pd::DataFrame const& data) const;
+
+    /// bootstrap replicate of data: as many rows as data, drawn with replacement from substream(replicate)
+    [[nodiscard]] pd::Series resample(pd::Series const& data, int64_t replicate) const;
+
+    [[nodiscard]] pd::DataFrame resample(pd::DataFrame const& data, int64_t replicate) const;
+
+    /// statistic of every bootstrap replicate, replicates evaluated in parallel. The result of a
+    /// replicate depends only on this state's seed and stream, not on thread count or scheduling.
+    template<class Frame, class Statistic>
+    auto bootstrap(Frame const& data, int64_t replicates, Statistic&& statistic) const
     {
+        std::vector<std::invoke_result_t<Statistic&, Frame>> results(replicates);
+        pd::parallel_for(
+            int64_t{ 0 },
+            replicates,
+            pd::bindExecContext([&](int64_t replicate) { results[replicate] = statistic(resample(data, replicate)); }));
+        return results;
     }
+    //</editor-fold>
 
     inline void rand(vector_double& result, double min = 0, double max = 1) const
     {
-        std::ranges::generate(
-            result,
-            [min, max, this]()
-            {
-                std::uniform_real_distribution dist(min, max);
-                return dist(gen);
-            });
+        fillUniform(result.data(), static_cast<int64_t>(result.size()), min, max);
     }
 
     inline vector_double rand(int size, double min = 0, double max = 1) const
@@ -42,39 +142,29 @@ public:
     template<typename T>
     inline std::vector<T> choice(std::vector<T> const& k, int size) const
     {
+        vector_int positions(size);
+        fillIntegers(positions.data(), size, 0, static_cast<int64_t>(k.size()));
+
         std::vector<T> out;
         out.reserve(size);
-
-        std::uniform_int_distribution dist(0UL, k.size() - 1);
-        std::generate_n(std::back_inserter(out), size, [&]() { return k[dist(gen)]; });
+        std::ranges::transform(positions, std::back_inserter(out), [&](int64_t i) { return k[i]; });
         return out;
     }
 
     inline vector_double rand(vector_double const& min, vector_double const& max) const
     {
         vector_double result(min.size());
-        std::transform(
-            min.begin(),
-            min.end(),
-            max.begin(),
-            std::begin(result),
-            [&](double lb, double ub)
-            {
-                std::uniform_real_distribution<double> rand(lb, ub);
-                return rand(gen);
-            });
+        rand(result);
+        for (size_t i = 0; i < result.size(); i++)
+        {
+            result[i] = min[i] + result[i] * (max[i] - min[i]);
+        }
         return result;
     }
 
     inline void randn(vector_double& result, double mean = 0, double std = 1) const
     {
-        std::ranges::generate(
-            result,
-            [mean, std, this]()
-            {
-                std::normal_distribution dist(mean, std);
-                return dist(gen);
-            });
+        fillNormal(result.data(), static_cast<int64_t>(result.size()), mean, std);
     }
 
     inline vector_double randn(int size, double mean = 0, double std = 1) const
@@ -84,15 +174,10 @@ public:
         return result;
     }
 
+    /// integers in [min, max], both ends included
     inline void randint(vector_int& result, int min = 0, int max = 1) const
     {
-        std::ranges::generate(
-            result,
-            [min, max, this]()
-            {
-                std::uniform_int_distribution dist(min, max);
-                return dist(gen);
-            });
+        fillIntegers(result.data(), static_cast<int64_t>(result.size()), min, int64_t{ max } + 1);
     }
 
     inline vector_int randint(int size, int min = 0, int max = 1) const
@@ -105,12 +190,23 @@ public:
     template<class T>
     static std::shared_ptr<arrow::Array> toArray(std::vector<T> const& v)
     {
-        typename arrow::CTypeTraits<T>::BuilderType b;
+        typename arrow::CTypeTraits<T>::BuilderType b(pd::GetMemoryPool());
         b.AppendValues(v);
         return b.Finish().ValueOrDie();
     }
 
 private:
-    mutable std::mt19937_64 gen;
+    uint64_t m_seed;
+    uint64_t m_stream;
+    mutable uint64_t m_position;
+
+    /// the block of draw position; a draw rejected attempt times reads its next block
+    [[nodiscard]] Philox4x32::Counter block(uint64_t position, uint32_t attempt = 0) const;
+
+    /// position at which the next fill of size values starts
+    uint64_t advance(int64_t size) const;
+
+    /// sampleIndices without replacement for a size much smaller than the population
+    [[nodiscard]] std::shared_ptr<arrow::Int64Array> sampleSparse(int64_t population, int64_t size, uint64_t first) const;
 };
-} // namespace pd::random
\ No newline at end of file
+} // namespace pd::random
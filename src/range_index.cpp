@@ -0,0 +1,86 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "range_index.h"
+#include "core.h"
+#include "exec_context.h"
+
+
+namespace pd {
+
+    RangeIndex RangeIndex::positions(int64_t length) {
+        return {0, 1, length, arrow::uint64()};
+    }
+
+    RangeIndex RangeIndex::datetime(ptime const &start, time_duration const &freq, int64_t length, std::string const &tz) {
+        if (freq.total_nanoseconds() <= 0) {
+            throw std::runtime_error("RangeIndex::datetime requires a positive frequency");
+        }
+        return {pd::fromPTime(start), freq.total_nanoseconds(), length, arrow::timestamp(arrow::TimeUnit::NANO, tz)};
+    }
+
+    std::optional<int64_t> RangeIndex::position(arrow::Scalar const &label) const {
+        if (not label.is_valid) {
+            return std::nullopt;
+        }
+        auto casted = label.CastTo(type);
+        if (not casted.ok()) {
+            return std::nullopt;
+        }
+
+        auto const &scalar = **casted;
+        switch (type->id()) {
+            case arrow::Type::UINT64: {
+                auto value = static_cast<arrow::UInt64Scalar const &>(scalar).value;
+                if (value > static_cast<uint64_t>(INT64_MAX)) {
+                    return std::nullopt;
+                }
+                return position(static_cast<int64_t>(value));
+            }
+            case arrow::Type::INT64:
+                return position(static_cast<arrow::Int64Scalar const &>(scalar).value);
+            case arrow::Type::TIMESTAMP:
+                return position(static_cast<arrow::TimestampScalar const &>(scalar).value);
+            default:
+                throw std::runtime_error("RangeIndex only stands for uint64, int64 or timestamp labels");
+        }
+    }
+
+    int64_t Index::position(std::shared_ptr<arrow::Scalar> const &label) const {
+        if (m_lazy) {
+            return m_lazy->range.position(*label).value_or(-1);
+        }
+        if (not m_array) {
+            return -1;
+        }
+        return labelIndex().find(*label);
+    }
+
+    LabelIndex const &Index::labelIndex() const {
+        static const LabelIndex empty;
+        if (not m_hashed) {
+            return empty;
+        }
+        std::call_once(m_hashed->once, [this] { m_hashed->table = std::make_shared<LabelIndex>(array()); });
+        return *m_hashed->table;
+    }
+
+    std::shared_ptr<arrow::Scalar> Index::label(int64_t position) const {
+        if (position < 0) {
+            return arrow::MakeNullScalar(type());
+        }
+        if (m_lazy) {
+            return ReturnOrThrowOnFailure(arrow::MakeScalar(m_lazy->range.type, m_lazy->range.at(position)));
+        }
+        return ReturnOrThrowOnFailure(m_array->GetScalar(position));
+    }
+
+    std::shared_ptr<arrow::Array> RangeIndex::materialize() const {
+        auto buffer = ReturnOrThrowOnFailure(arrow::AllocateBuffer(length * sizeof(int64_t), pd::GetMemoryPool()));
+        auto *values = reinterpret_cast<int64_t *>(buffer->mutable_data());
+        for (int64_t i = 0; i < length; i++) {
+            values[i] = at(i);
+        }
+        return arrow::MakeArray(arrow::ArrayData::Make(type, length, {nullptr, std::move(buffer)}, 0));
+    }
+}
@@ -0,0 +1,173 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/datum.h>
+#include <mutex>
+#include <optional>
+#include "boost/date_time/posix_time/posix_time.hpp"
+#include "label_index.h"
+
+
+namespace pd {
+
+    /// Labels start + i * step for i in [0, length) that are never stored.
+    /// type is the arrow type the labels stand for: uint64 / int64 positions, or a
+    /// timestamp (regularly sampled DatetimeIndex) where start and step are in its unit.
+    struct RangeIndex {
+        int64_t start{0};
+        int64_t step{1};
+        int64_t length{0};
+        std::shared_ptr<arrow::DataType> type{arrow::uint64()};
+
+        /// the default 0, 1, ..., n - 1 index
+        static RangeIndex positions(int64_t length);
+
+        /// regular DatetimeIndex of nanosecond timestamps
+        static RangeIndex datetime(boost::posix_time::ptime const &start,
+                                   boost::posix_time::time_duration const &freq,
+                                   int64_t length,
+                                   std::string const &tz = "");
+
+        [[nodiscard]] int64_t at(int64_t position) const {
+            return start + position * step;
+        }
+
+        /// position of `label`, or nullopt when it is not on the grid
+        [[nodiscard]] std::optional<int64_t> position(int64_t label) const {
+            const int64_t offset = label - start;
+            if (step == 0 or offset % step != 0) {
+                return std::nullopt;
+            }
+            const int64_t position = offset / step;
+            return (position >= 0 and position < length) ? std::optional{position} : std::nullopt;
+        }
+
+        [[nodiscard]] std::optional<int64_t> position(arrow::Scalar const &label) const;
+
+        /// follows arrow's Slice and clamps to the end
+        [[nodiscard]] RangeIndex slice(int64_t offset, int64_t sliceLength = INT64_MAX) const {
+            offset = std::clamp<int64_t>(offset, 0, length);
+            return {at(offset), step, std::min(sliceLength, length - offset), type};
+        }
+
+        [[nodiscard]] std::shared_ptr<arrow::Array> materialize() const;
+
+        bool operator==(RangeIndex const &other) const {
+            return length == other.length and type->Equals(other.type) and
+                   (length == 0 or (start == other.start and (length == 1 or step == other.step)));
+        }
+    };
+
+    /// Row labels of a frame: either an arrow array or a RangeIndex.
+    /// A RangeIndex is only materialized (once, shared by every copy) when the array is asked
+    /// for, so code that only needs the length, a slice, a lookup or an equality check stays O(1).
+    class Index {
+    public:
+        Index() = default;
+
+        Index(std::nullptr_t) {}
+
+        template<class ArrayT>
+        requires std::derived_from<ArrayT, arrow::Array>
+        Index(std::shared_ptr<ArrayT> array) : m_array(std::move(array)) {
+            if (m_array) {
+                m_hashed = std::make_shared<Hashed>();
+            }
+        }
+
+        Index(RangeIndex const &range) : m_lazy(std::make_shared<Lazy>(range)), m_hashed(std::make_shared<Hashed>()) {}
+
+        [[nodiscard]] std::optional<RangeIndex> range() const {
+            return m_lazy ? std::optional{m_lazy->range} : std::nullopt;
+        }
+
+        [[nodiscard]] bool isMaterialized() const {
+            return m_array != nullptr or (m_lazy and m_lazy->array);
+        }
+
+        [[nodiscard]] std::shared_ptr<arrow::Array> const &array() const {
+            if (m_lazy) {
+                std::call_once(m_lazy->once, [this] { m_lazy->array = m_lazy->range.materialize(); });
+                return m_lazy->array;
+            }
+            return m_array;
+        }
+
+        operator std::shared_ptr<arrow::Array> const &() const {
+            return array();
+        }
+
+        operator arrow::Datum() const {
+            return array();
+        }
+
+        arrow::Array *operator->() const {
+            return array().get();
+        }
+
+        arrow::Array &operator*() const {
+            return *array();
+        }
+
+        explicit operator bool() const {
+            return m_lazy or m_array;
+        }
+
+        bool operator==(std::nullptr_t) const {
+            return not *this;
+        }
+
+        [[nodiscard]] int64_t length() const {
+            return m_lazy ? m_lazy->range.length : m_array->length();
+        }
+
+        [[nodiscard]] std::shared_ptr<arrow::DataType> type() const {
+            return m_lazy ? m_lazy->range.type : m_array->type();
+        }
+
+        [[nodiscard]] Index slice(int64_t offset, int64_t length = INT64_MAX) const {
+            if (m_lazy) {
+                return m_lazy->range.slice(offset, length);
+            }
+            return length == INT64_MAX ? Index{m_array->Slice(offset)} : Index{m_array->Slice(offset, length)};
+        }
+
+        /// typed hash table of the labels, built on first use and shared by every copy of this Index
+        [[nodiscard]] LabelIndex const &labelIndex() const;
+
+        /// label at `position`, a null of the index type for -1
+        [[nodiscard]] std::shared_ptr<arrow::Scalar> label(int64_t position) const;
+
+        /// position of the first row labelled `label`, -1 when there is none.
+        /// O(1) for a RangeIndex, a probe of labelIndex() otherwise.
+        [[nodiscard]] int64_t position(std::shared_ptr<arrow::Scalar> const &label) const;
+
+        /// O(1) for two ranges, element-wise otherwise
+        [[nodiscard]] bool equals(Index const &other) const {
+            if (m_lazy and other.m_lazy) {
+                return m_lazy->range == other.m_lazy->range;
+            }
+            return array()->Equals(*other.array());
+        }
+
+    private:
+        struct Lazy {
+            explicit Lazy(RangeIndex range) : range(std::move(range)) {}
+
+            RangeIndex range;
+            std::once_flag once;
+            std::shared_ptr<arrow::Array> array;
+        };
+
+        struct Hashed {
+            std::once_flag once;
+            std::shared_ptr<LabelIndex> table;
+        };
+
+        std::shared_ptr<arrow::Array> m_array;
+        std::shared_ptr<Lazy> m_lazy;
+        std::shared_ptr<Hashed> m_hashed;
+    };
+}
@@ -14,7 +14,7 @@ std::vector<int64_t> generate_bins_dt64(std::shared_ptr<arrow::TimestampArray> v
 {
 //    int64_t nat_count = 0;
     if (values->null_count() > 0) {
-        auto datum = pd::ReturnOrThrowOnFailure(arrow::compute::DropNull(values));
+        auto datum = pd::ReturnOrThrowOnFailure(pd::CallFunction("drop_null", {values}));
         values = datum.array_as<arrow::TimestampArray>();
 //        nat_count = values->null_count();
     }
@@ -180,14 +180,14 @@ std::pair<ptime, ptime> adjustDatesAnchored(
     std::shared_ptr<arrow::Int64Array> adjustBinEdges(std::shared_ptr<arrow::TimestampArray>& binner,
                                                       int64_t max_timestamp) {
 
-        auto binEdges = pd::ReturnOrThrowOnFailure(arrow::compute::Add(binner,
-                                                                       std::make_shared<arrow::DurationScalar>(
-                                                                               60 * 60 * 24/*1D*/,
-                                                                               arrow::TimeUnit::SECOND)));
-        binEdges = pd::ReturnOrThrowOnFailure(arrow::compute::Subtract(binEdges,
-                                                                       std::make_shared<arrow::DurationScalar>(1,
-                                                                                                               arrow::TimeUnit::NANO)));
-        binEdges = pd::ReturnOrThrowOnFailure(arrow::compute::Cast(binEdges, arrow::int64()));
+        auto binEdges = pd::ReturnOrThrowOnFailure(pd::CallFunction("add", {binner,
+                                                                             std::make_shared<arrow::DurationScalar>(
+                                                                                     60 * 60 * 24/*1D*/,
+                                                                                     arrow::TimeUnit::SECOND)}));
+        binEdges = pd::ReturnOrThrowOnFailure(pd::CallFunction("subtract", {binEdges,
+                                                                             std::make_shared<arrow::DurationScalar>(1,
+                                                                                                                     arrow::TimeUnit::NANO)}));
+        binEdges = pd::ReturnOrThrowOnFailure(pd::Cast(binEdges, arrow::int64()));
 
         auto binEdgesArray = binEdges.array_as<arrow::Int64Array>();
         const int64_t length = binEdgesArray->length();
@@ -220,7 +220,7 @@ GroupInfo makeGroupInfo(
         return { {}, timestamps_ax };
     }
 
-    const auto datum = pd::ReturnOrThrowOnFailure(arrow::compute::MinMax(timestamps_ax));
+    const auto datum = pd::ReturnOrThrowOnFailure(pd::CallFunction("min_max", {timestamps_ax}));
     const auto& datum_struct = datum.scalar_as<arrow::StructScalar>();
     auto [min, max] = MinMax{ Scalar{datum_struct.value[0]}, Scalar{datum_struct.value[1]} };
 
@@ -243,7 +243,7 @@ GroupInfo makeGroupInfo(
             tz);
         binner = date_range(first, last, duration, tz);
         labels = binner;
-        binEdges = pd::ReturnOrThrowOnFailure(arrow::compute::Cast(binner, arrow::int64())).array_as<arrow::Int64Array>();
+        binEdges = pd::ReturnOrThrowOnFailure(pd::Cast(binner, arrow::int64())).array_as<arrow::Int64Array>();
     }
     else {
         date first = minValue.date();
@@ -260,7 +260,7 @@ GroupInfo makeGroupInfo(
             binEdges = adjustBinEdges(binner, pd::fromPTime(maxValue));
         } else {
             binEdges = pd::ReturnOrThrowOnFailure(
-                    arrow::compute::Cast(binner, arrow::int64())).array_as<arrow::Int64Array>();
+                    pd::Cast(binner, arrow::int64())).array_as<arrow::Int64Array>();
         }
     }
 
@@ -282,7 +282,8 @@ GroupInfo makeGroupInfo(
     if (ax->null_count() > 0)
     {
         labels = dynamic_pointer_cast<arrow::TimestampArray>(
-            arrow::Concatenate({ arrow::MakeArrayOfNull(labels->type(), 1).MoveValueUnsafe(), labels })
+            arrow::Concatenate({ arrow::MakeArrayOfNull(labels->type(), 1, pd::GetMemoryPool()).MoveValueUnsafe(), labels },
+                               pd::GetMemoryPool())
                 .MoveValueUnsafe());
     }
 
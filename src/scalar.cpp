@@ -24,14 +24,14 @@ namespace pd {
     DataFrame BinaryImpl(DataFrame const & df, std::shared_ptr<arrow::Scalar> const& scalar, std::string const& name) {
         auto chunkedArray = std::make_shared<arrow::ChunkedArray>(df.array()->columns());
         return df.Make(ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction(name, {scalar, chunkedArray})).chunks());
+                pd::CallFunction(name, {scalar, chunkedArray})).chunks());
     }
 
     Series BinaryImpl(Series const & s, std::shared_ptr<arrow::Scalar> const& scalar, std::string const& name) {
 
         return Series{
                 ReturnOrThrowOnFailure(
-                        arrow::compute::CallFunction(name, {scalar, s.array()})).make_array(),
+                        pd::CallFunction(name, {scalar, s.array()})).make_array(),
                 s.indexArray()};
     }
 
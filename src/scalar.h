@@ -17,7 +17,7 @@ DataFrame operator op(DataFrame const& s) const; \
 Series operator op(Series const& s) const;  \
 inline Scalar operator op(Scalar const& s) const \
     { \
-        return Scalar{ReturnOrThrowOnFailure(arrow::compute::CallFunction(#name, { this->scalar, s.scalar })).scalar()}; \
+        return Scalar{ReturnOrThrowOnFailure(pd::CallFunction(#name, { this->scalar, s.scalar })).scalar()}; \
     } \
     template<typename T> \
     requires std::is_scalar_v<T> \
@@ -37,7 +37,7 @@ DataFrame operator op(DataFrame const& s) const; \
 Series operator op(Series const& s) const;  \
 inline bool operator op(Scalar const& s) const \
     { \
-        return ReturnOrThrowOnFailure(arrow::compute::CallFunction(#name, { this->scalar, s.scalar })).scalar_as<arrow::BooleanScalar>().value; \
+        return ReturnOrThrowOnFailure(pd::CallFunction(#name, { this->scalar, s.scalar })).scalar_as<arrow::BooleanScalar>().value; \
     } \
     template<typename T> \
     requires std::is_scalar_v<T> \
@@ -199,7 +199,7 @@ namespace pd {
         BINARY_BOOL_OPERATOR(<=, less_equal)
 
         inline bool operator==(Scalar const &s) const {
-            return ReturnOrThrowOnFailure(arrow::compute::CallFunction("equal", {this->scalar, s.scalar}))
+            return ReturnOrThrowOnFailure(pd::CallFunction("equal", {this->scalar, s.scalar}))
                     .scalar_as<arrow::BooleanScalar>()
                     .value;
         }
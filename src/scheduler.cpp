@@ -0,0 +1,94 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "scheduler.h"
+#include <algorithm>
+#include <arrow/util/thread_pool.h>
+#include <mutex>
+#include <tbb/global_control.h>
+#include <tbb/info.h>
+#include "core.h"
+
+
+namespace pd {
+
+    namespace {
+        struct Scheduler {
+            std::mutex mutex;
+            // as requested, 0 for the hardware concurrency
+            int threads{0};
+            std::shared_ptr<tbb::task_arena> arena;
+            // caps TBB's worker pool as well, so work outside our arena cannot oversubscribe either
+            std::unique_ptr<tbb::global_control> workers;
+
+            static Scheduler &Instance() {
+                static Scheduler instance;
+                return instance;
+            }
+        };
+
+        int hardwareThreads() {
+            return tbb::info::default_concurrency();
+        }
+    }
+
+    void set_parallelism(int threads) {
+        if (threads < 0) {
+            throw std::invalid_argument("set_parallelism: threads must be 0 (all cores) or positive");
+        }
+
+        auto &scheduler = Scheduler::Instance();
+        std::scoped_lock lock(scheduler.mutex);
+        const int concurrency = threads == 0 ? hardwareThreads() : threads;
+
+        scheduler.workers.reset();
+        if (threads > 0) {
+            scheduler.workers = std::make_unique<tbb::global_control>(
+                    tbb::global_control::max_allowed_parallelism, static_cast<size_t>(concurrency));
+        }
+        scheduler.arena = std::make_shared<tbb::task_arena>(concurrency);
+        scheduler.threads = threads;
+        ThrowOnFailure(arrow::SetCpuThreadPoolCapacity(concurrency));
+
+        auto ctx = GetDefaultExecContext();
+        ctx.use_threads = concurrency > 1;
+        SetDefaultExecContext(ctx);
+    }
+
+    int get_parallelism() {
+        auto &scheduler = Scheduler::Instance();
+        std::scoped_lock lock(scheduler.mutex);
+        return scheduler.threads > 0 ? scheduler.threads : hardwareThreads();
+    }
+
+    ParallelismGuard::ParallelismGuard(int threads) {
+        {
+            auto &scheduler = Scheduler::Instance();
+            std::scoped_lock lock(scheduler.mutex);
+            m_previous = scheduler.threads;
+        }
+        m_previousUseThreads = GetDefaultExecContext().use_threads;
+        set_parallelism(threads);
+    }
+
+    ParallelismGuard::~ParallelismGuard() {
+        set_parallelism(m_previous);
+        // set_parallelism derives use_threads from the thread count, which may not be what was set before
+        auto ctx = GetDefaultExecContext();
+        ctx.use_threads = m_previousUseThreads;
+        SetDefaultExecContext(ctx);
+    }
+
+    std::shared_ptr<tbb::task_arena> detail::currentArena() {
+        auto &scheduler = Scheduler::Instance();
+        std::scoped_lock lock(scheduler.mutex);
+        if (not scheduler.arena) {
+            scheduler.arena = std::make_shared<tbb::task_arena>(tbb::task_arena::automatic);
+        }
+        return scheduler.arena;
+    }
+
+    int64_t grainSize(int64_t length, int64_t minGrain) {
+        return std::max<int64_t>({minGrain, length / (4 * int64_t{get_parallelism()}), 1});
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include "exec_context.h"
+
+
+namespace pd {
+
+    /// Number of threads the library's parallel work runs on. Every pd::parallel_for executes inside one
+    /// tbb::task_arena of that size, and arrow's CPU thread pool (compute, parquet and csv decoding) is
+    /// resized to match, so TBB and arrow never compete for more than threads cores each.
+    /// 0 selects the hardware concurrency. 1 is the deterministic mode: loops run in order on the
+    /// calling thread and the default ExecContext turns use_threads off for arrow as well.
+    /// The setting is process wide.
+    void set_parallelism(int threads);
+
+    [[nodiscard]] int get_parallelism();
+
+    /// set_parallelism for the lifetime of the guard, the previous setting and the default
+    /// ExecContext's use_threads are restored on destruction.
+    /// Guards on different threads change the same process wide setting and must nest.
+    class ParallelismGuard {
+    public:
+        explicit ParallelismGuard(int threads);
+
+        ParallelismGuard(ParallelismGuard const &) = delete;
+
+        ParallelismGuard &operator=(ParallelismGuard const &) = delete;
+
+        ~ParallelismGuard();
+
+    private:
+        int m_previous{0};
+        bool m_previousUseThreads{true};
+    };
+
+    namespace detail {
+        std::shared_ptr<tbb::task_arena> currentArena();
+    }
+
+    /// rows per task for a loop over length rows: at least minGrain, and about four tasks per thread
+    [[nodiscard]] int64_t grainSize(int64_t length, int64_t minGrain = 1);
+
+    /// fn() inside the arena sized by set_parallelism, for TBB algorithms other than parallel_for
+    template<class Fn>
+    decltype(auto) inArena(Fn &&fn) {
+        return detail::currentArena()->execute(std::forward<Fn>(fn));
+    }
+
+    /// tbb::parallel_for run inside the arena sized by set_parallelism. The loop runs in order on the
+    /// calling thread when the active ExecContext has use_threads off.
+    template<std::integral Index, class Fn>
+    void parallel_for(Index first, Index last, Fn const &fn) {
+        if (not GetExecContext().use_threads or last - first < 2) {
+            for (Index i = first; i < last; ++i) {
+                fn(i);
+            }
+            return;
+        }
+        inArena([&] { tbb::parallel_for(first, last, fn); });
+    }
+
+    template<class Value, class Body>
+    void parallel_for(tbb::blocked_range<Value> const &range, Body const &body) {
+        if (not GetExecContext().use_threads or not range.is_divisible()) {
+            if (not range.empty()) {
+                body(range);
+            }
+            return;
+        }
+        inArena([&] { tbb::parallel_for(range, body); });
+    }
+}
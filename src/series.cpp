@@ -8,10 +8,14 @@
 #include <tabulate/table.hpp>
 #include <unordered_set>
 #include "boost/format.hpp"
+#include "categorical.h"
 #include "datetimelike.h"
+#include "elementwise.h"
+#include "ewm.h"
 #include "filesystem"
 #include "ranges"
 #include "resample.h"
+#include "scheduler.h"
 #include "stringlike.h"
 #include <DataFrame/DataFrameFinancialVisitors.h>
 
@@ -19,23 +23,52 @@
 #define BINARY_OPERATOR(sign, name) \
     Series Series::operator sign(const Series& a) const \
     { auto [x, y] = broadcast(a); \
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction(#name, {x.m_array, y.m_array}), x.indexArray()); \
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise(#name, {x.m_array, y.m_array}), x.labels()); \
     } \
 \
     Series Series::operator sign(const Scalar& a) const \
     { \
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction(#name, { m_array, a.scalar })); \
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise(#name, { m_array, a.scalar })); \
     } \
 \
     Series operator sign(Scalar const& a, Series const& b) \
     { \
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction(#name, { a.value(), b.m_array })); \
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise(#name, { a.value(), b.m_array })); \
+    }
+
+// equality of categoricals compares codes instead of decoding the labels
+#define CATEGORICAL_COMPARISON_OPERATOR(sign, name) \
+    Series Series::operator sign(const Series& a) const \
+    { auto [x, y] = broadcast(a); \
+        if (auto codes = pd::compareCodes(#name, x.m_array, y.m_array)) \
+        { \
+            return ReturnSeriesOrThrowOnError(std::move(*codes), x.labels()); \
+        } \
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise(#name, {x.m_array, y.m_array}), x.labels()); \
+    } \
+\
+    Series Series::operator sign(const Scalar& a) const \
+    { \
+        if (auto codes = pd::compareCodes(#name, m_array, a.value())) \
+        { \
+            return ReturnSeriesOrThrowOnError(std::move(*codes)); \
+        } \
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise(#name, { m_array, a.scalar })); \
+    } \
+\
+    Series operator sign(Scalar const& a, Series const& b) \
+    { \
+        if (auto codes = pd::compareCodes(#name, b.m_array, a.value())) \
+        { \
+            return ReturnSeriesOrThrowOnError(std::move(*codes)); \
+        } \
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise(#name, { a.value(), b.m_array })); \
     }
 
 #define GenericFunction(name, ReturnFilter, OutT, ClassT) \
     OutT ClassT::name() const \
     { \
-        auto result = arrow::compute::CallFunction(#name, { m_array }); \
+        auto result = pd::CallElementwise(#name, { m_array }); \
         if (result.ok()) \
         { \
             return OutT(ReturnFilter); \
@@ -49,7 +82,7 @@
 #define GenericFunctionSeriesReturnRename(name, f_name, ClassT) \
     Series ClassT ::name() const \
     { \
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction(#f_name, { m_array })); \
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise(#f_name, { m_array })); \
     }
 
 #define GenericFunctionSeriesReturn(name) \
@@ -76,30 +109,29 @@ namespace pd {
         if (isIndex) {
             setIndexer();
         } else if (!m_array) {
-            m_index = arrow::MakeArrayOfNull(arrow::uint64(), 0).MoveValueUnsafe();
-            m_array = arrow::MakeArrayOfNull(arrow::float64(), 0).MoveValueUnsafe();
+            m_index = arrow::MakeArrayOfNull(arrow::uint64(), 0, pd::GetMemoryPool()).MoveValueUnsafe();
+            m_array = arrow::MakeArrayOfNull(arrow::float64(), 0, pd::GetMemoryPool()).MoveValueUnsafe();
         } else {
-            m_index = uint_range(arr->length());
+            m_index = RangeIndex::positions(arr->length());
         }
     }
 
     Series::Series(
             std::shared_ptr<arrow::Array> const &arr,
-            std::shared_ptr<arrow::Array> const &index,
+            pd::Index const &index,
             std::string name,
             bool skipIndex)
             : NDFrame<arrow::Array>(arr, index, skipIndex), m_name(std::move(name)) {
         if (!m_array) {
-            m_index = arrow::MakeArrayOfNull(arrow::uint64(), 0).MoveValueUnsafe();
-            m_array = arrow::MakeArrayOfNull(arrow::float64(), 0).MoveValueUnsafe();
+            m_index = arrow::MakeArrayOfNull(arrow::uint64(), 0, pd::GetMemoryPool()).MoveValueUnsafe();
+            m_array = arrow::MakeArrayOfNull(arrow::float64(), 0, pd::GetMemoryPool()).MoveValueUnsafe();
         }
     }
     //</editor-fold>
 
     //<editor-fold desc="Indexing Functions">
     Scalar Series::operator[](Scalar const& _index) const {
-        auto indexArrayIndex = ReturnOrThrowOnFailure(arrow::compute::Index(m_index, arrow::compute::IndexOptions{
-                _index.value()})).scalar_as<arrow::Int64Scalar>().value;
+        auto indexArrayIndex = m_index.position(_index.value());
         if (indexArrayIndex == -1) {
             auto error = fmt::format("Index out of bounds: {}", _index.value()->ToString());
             throw std::runtime_error(error);;
@@ -123,7 +155,7 @@ namespace pd {
         }
         slice.normalize(size());
         return {slice.end == 0 ? m_array->Slice(slice.start) : m_array->Slice(slice.start, slice.end - slice.start),
-                slice.end == 0 ? m_index->Slice(slice.start) : m_index->Slice(slice.start, slice.end - slice.start),
+                slice.end == 0 ? m_index.slice(slice.start) : m_index.slice(slice.start, slice.end - slice.start),
                 m_name};
     }
 
@@ -137,9 +169,9 @@ namespace pd {
 
         arrow::compute::FilterOptions opt{arrow::compute::FilterOptions::NullSelectionBehavior::EMIT_NULL};
         auto arr = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("array_filter", {m_array, x.m_array}, &opt)).make_array();
+                pd::CallFunction("array_filter", {m_array, x.m_array}, &opt)).make_array();
         auto idx = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("array_filter", {m_index, x.m_array})).make_array();
+                pd::CallFunction("array_filter", {m_index, x.m_array})).make_array();
         return {arr, idx};
     }
 
@@ -152,23 +184,21 @@ namespace pd {
         }
 
         auto arr = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("array_take", {m_array, x.m_array})).make_array();
+                pd::CallFunction("array_take", {m_array, x.m_array})).make_array();
         auto idx = ReturnOrThrowOnFailure(
-                arrow::compute::CallFunction("array_take", {m_index, x.m_array})).make_array();
+                pd::CallFunction("array_take", {m_index, x.m_array})).make_array();
         return {arr, idx};
     }
 
     //</editor-fold>
 
     //<editor-fold desc="Indexing Operations">
-    Scalar Series::idxMin() const {
-        pd::Scalar minValue = ReturnScalarOrThrowOnError(arrow::compute::CallFunction("min", {m_array}));
-        return Scalar{m_index->GetScalar(index(minValue))};
+    Scalar Series::idxMin(bool skip_na) const {
+        return Scalar{m_index.label(argmin(skip_na))};
     }
 
-    Scalar Series::idxMax() const{
-        pd::Scalar maxIndex = ReturnScalarOrThrowOnError(arrow::compute::CallFunction("max", {m_array}));
-        return Scalar{m_index->GetScalar(index(maxIndex))};
+    Scalar Series::idxMax(bool skip_na) const {
+        return Scalar{m_index.label(argmax(skip_na))};
     }
     //</editor-fold>
 
@@ -210,15 +240,15 @@ namespace pd {
     }
 
     std::array<Series, 2> Series::broadcast(Series const &other) const {
-        auto otherIndex = other.indexArray();
-        if (otherIndex->Equals(m_index)) {
+        if (m_index.equals(other.labels())) {
             return {*this, other};
         }
-        auto mixedIndex = pd::ReturnOrThrowOnFailure(arrow::Concatenate({m_index, otherIndex}));
-        auto newIndex = pd::ReturnOrThrowOnFailure(arrow::compute::Unique(mixedIndex));
+        auto otherIndex = other.indexArray();
+        auto mixedIndex = pd::ReturnOrThrowOnFailure(arrow::Concatenate({m_index, otherIndex}, pd::GetMemoryPool()));
+        auto newIndex = pd::ReturnOrThrowOnFailure(pd::CallFunction("unique", {mixedIndex})).make_array();
         auto opt = arrow::compute::ArraySortOptions{arrow::compute::SortOrder::Ascending};
-        auto sortedIndices = ReturnOrThrowOnFailure(arrow::compute::CallFunction("array_sort_indices", {newIndex}, &opt)).make_array();
-        auto result = arrow::compute::Take(newIndex, sortedIndices)->make_array();
+        auto sortedIndices = ReturnOrThrowOnFailure(pd::CallFunction("array_sort_indices", {newIndex}, &opt)).make_array();
+        auto result = ReturnOrThrowOnFailure(pd::CallFunction("take", {newIndex, sortedIndices})).make_array();
 
         return {
                 reindex(result),
@@ -252,9 +282,9 @@ namespace pd {
 
     BINARY_OPERATOR(<=, less_equal)
 
-    BINARY_OPERATOR(==, equal)
+    CATEGORICAL_COMPARISON_OPERATOR(==, equal)
 
-    BINARY_OPERATOR(!=, not_equal)
+    CATEGORICAL_COMPARISON_OPERATOR(!=, not_equal)
 
     BINARY_OPERATOR(&&, and)
 
@@ -263,11 +293,12 @@ namespace pd {
     GenericFunctionSeriesReturn(abs)
 
     Series Series::operator-() const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::Negate(m_array, arrow::compute::ArithmeticOptions{false}));
+        arrow::compute::ArithmeticOptions opt{false};
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("negate", {m_array}, &opt));
     }
 
     Series Series::pow(double x) const {
-        auto result = arrow::compute::Power({m_array}, arrow::MakeScalar(x));
+        auto result = pd::CallElementwise("power", {m_array, arrow::MakeScalar(x)});
         if (result.ok()) {
             return {result->make_array(), false, m_name};
         } else {
@@ -276,7 +307,7 @@ namespace pd {
     }
 
     Series Series::exp() const {
-        return ReturnSeriesOrThrowOnError( arrow::compute::Exp({m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("exp", {m_array}));
     }
 
     GenericFunctionSeriesReturn(sqrt)
@@ -307,11 +338,11 @@ namespace pd {
 
     Series Series::round_to_multiple(double multiple, arrow::compute::RoundMode roundMode) const {
         arrow::compute::RoundToMultipleOptions opt{multiple, roundMode};
-        return ReturnSeriesOrThrowOnError(arrow::compute::RoundToMultiple({m_array}, opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("round_to_multiple", {m_array}, &opt));
     }
 
     Series Series::logb(int base) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::Logb({m_array}, arrow::MakeScalar(base)));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("logb", {m_array, arrow::MakeScalar(base)}));
     }
 
     GenericFunctionSeriesReturnRename(operator~, bit_wise_not, Series)
@@ -319,28 +350,28 @@ namespace pd {
     GenericFunctionSeriesReturnRename(operator!, invert, Series)
 
     Series Series::cumsum(double start, bool skip_nulls) const {
-        return ReturnSeriesOrThrowOnError(
-                arrow::compute::CumulativeSum(m_array, arrow::compute::CumulativeOptions{start, skip_nulls}));
+        arrow::compute::CumulativeOptions options{start, skip_nulls};
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("cumulative_sum", {m_array}, &options));
     }
 
     Series Series::cumprod(double start, bool skip_nulls) const {
-        return ReturnSeriesOrThrowOnError(
-                arrow::compute::CumulativeProd(m_array, arrow::compute::CumulativeOptions{start, skip_nulls}));
+        arrow::compute::CumulativeOptions options{start, skip_nulls};
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("cumulative_prod", {m_array}, &options));
     }
 
     Series Series::cummax(double start, bool skip_nulls) const {
-        return ReturnSeriesOrThrowOnError(
-                arrow::compute::CumulativeMax(m_array, arrow::compute::CumulativeOptions{start, skip_nulls}));
+        arrow::compute::CumulativeOptions options{start, skip_nulls};
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("cumulative_max", {m_array}, &options));
     }
 
     Series Series::cummin(double start, bool skip_nulls) const {
-        return ReturnSeriesOrThrowOnError(
-                arrow::compute::CumulativeMin(m_array, arrow::compute::CumulativeOptions{start, skip_nulls}));
+        arrow::compute::CumulativeOptions options{start, skip_nulls};
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("cumulative_min", {m_array}, &options));
     }
 
     std::shared_ptr<arrow::DictionaryArray> Series::dictionary_encode() const {
 
-        auto result = arrow::compute::DictionaryEncode(m_array);
+        auto result = pd::CallFunction("dictionary_encode", {m_array});
         if (result.ok()) {
             return result.MoveValueUnsafe().array_as<arrow::DictionaryArray>();
         } else {
@@ -348,6 +379,13 @@ namespace pd {
         }
     }
 
+    Series Series::categorize() const {
+        if (is_categorical()) {
+            return *this;
+        }
+        return {dictionary_encode(), m_index, m_name};
+    }
+
     Resampler Series::resample(
             std::string const &rule,
             bool closed_right,
@@ -467,7 +505,7 @@ namespace pd {
 
     Series StringLike::binary_replace_slice(int64_t start, int64_t stop, std::string const &replacement) const {
         arrow::compute::ReplaceSliceOptions opt(start, stop, replacement);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("binary_replace_slice", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("binary_replace_slice", {m_array}, &opt));
     }
 
     Series StringLike::replace_substring(
@@ -475,7 +513,7 @@ namespace pd {
             std::string const &replacement,
             int64_t const &max_replacements) const {
         arrow::compute::ReplaceSubstringOptions opt(pattern, replacement, max_replacements);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("replace_substring", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("replace_substring", {m_array}, &opt));
     }
 
     Series StringLike::replace_substring_regex(
@@ -483,160 +521,160 @@ namespace pd {
             std::string const &replacement,
             int64_t const &max_replacements) const {
         arrow::compute::ReplaceSubstringOptions opt(pattern, replacement, max_replacements);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("replace_substring_regex", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("replace_substring_regex", {m_array}, &opt));
     }
 
     Series StringLike::utf8_replace_slice(int64_t start, int64_t stop, std::string const &replacement) const {
         arrow::compute::ReplaceSliceOptions opt(start, stop, replacement);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_replace_slice", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_replace_slice", {m_array}, &opt));
     }
 
     Series StringLike::ascii_center(int64_t width, std::string const &padding) const {
         arrow::compute::PadOptions opt(width, padding);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ascii_center", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ascii_center", {m_array}, &opt));
     }
 
     Series StringLike::ascii_lpad(int64_t width, std::string const &padding) const {
         arrow::compute::PadOptions opt(width, padding);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ascii_lpad", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ascii_lpad", {m_array}, &opt));
     }
 
     Series StringLike::ascii_rpad(int64_t width, std::string const &padding) const {
         arrow::compute::PadOptions opt(width, padding);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ascii_rpad", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ascii_rpad", {m_array}, &opt));
     }
 
     Series StringLike::utf8_center(int64_t width, std::string const &padding) const {
         arrow::compute::PadOptions opt(width, padding);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_center", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_center", {m_array}, &opt));
     }
 
     Series StringLike::utf8_lpad(int64_t width, std::string const &padding) const {
         arrow::compute::PadOptions opt(width, padding);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_lpad", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_lpad", {m_array}, &opt));
     }
 
     Series StringLike::utf8_rpad(int64_t width, std::string const &padding) const {
         arrow::compute::PadOptions opt(width, padding);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_rpad", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_rpad", {m_array}, &opt));
     }
 
     Series StringLike::ascii_split_whitespace(int64_t max_splits, bool reverse) const {
         arrow::compute::SplitOptions opt(max_splits, reverse);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ascii_split_whitespace", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ascii_split_whitespace", {m_array}, &opt));
     }
 
     Series StringLike::utf8_split_whitespace(int64_t max_splits, bool reverse) const {
         arrow::compute::SplitOptions opt(max_splits, reverse);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_split_whitespace", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_split_whitespace", {m_array}, &opt));
     }
 
     Series StringLike::split_pattern(std::string const &pattern, int64_t max_splits, bool reverse) const {
         arrow::compute::SplitPatternOptions opt(pattern, max_splits, reverse);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("split_pattern", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("split_pattern", {m_array}, &opt));
     }
 
     Series StringLike::split_pattern_regex(std::string const &pattern, int64_t max_splits, bool reverse) const {
         arrow::compute::SplitPatternOptions opt(pattern, max_splits, reverse);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("split_pattern_regex", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("split_pattern_regex", {m_array}, &opt));
     }
 
     Series StringLike::ascii_ltrim(const std::string &characters) const {
         arrow::compute::TrimOptions opt(characters);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ascii_ltrim", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ascii_ltrim", {m_array}, &opt));
     }
 
     Series StringLike::ascii_rtrim(const std::string &characters) const {
         arrow::compute::TrimOptions opt(characters);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ascii_rtrim", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ascii_rtrim", {m_array}, &opt));
     }
 
     Series StringLike::ascii_trim(const std::string &characters) const {
         arrow::compute::TrimOptions opt(characters);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ascii_trim", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ascii_trim", {m_array}, &opt));
     }
 
     Series StringLike::utf8_ltrim(const std::string &characters) const {
         arrow::compute::TrimOptions opt(characters);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_ltrim", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_ltrim", {m_array}, &opt));
     }
 
     Series StringLike::utf8_rtrim(const std::string &characters) const {
         arrow::compute::TrimOptions opt(characters);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_rtrim", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_rtrim", {m_array}, &opt));
     }
 
     Series StringLike::utf8_trim(const std::string &characters) const {
         arrow::compute::TrimOptions opt(characters);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_trim", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_trim", {m_array}, &opt));
     }
 
     Series StringLike::extract_regex(const std::string &pattern) const {
         arrow::compute::ExtractRegexOptions opt(pattern);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("extract_regex", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("extract_regex", {m_array}, &opt));
     }
 
     Series StringLike::binary_join(const Series &joiner) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("binary_join", {m_array, joiner.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("binary_join", {m_array, joiner.m_array}));
     }
 
     Series StringLike::binary_join(const Scalar &joiner) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("binary_join", {m_array, joiner.scalar}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("binary_join", {m_array, joiner.scalar}));
     }
 
     Series StringLike::utf8_slice_codeunits(int64_t start, int64_t stop, int64_t step) const {
         arrow::compute::SliceOptions opt(start, stop, step);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("utf8_slice_codeunits", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("utf8_slice_codeunits", {m_array}, &opt));
     }
 
     Series StringLike::count_substring(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("count_substring", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("count_substring", {m_array}, &opt));
     }
 
     Series StringLike::count_substring_regex(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("count_substring_regex", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("count_substring_regex", {m_array}, &opt));
     }
 
     Series StringLike::ends_with(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ends_with", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ends_with", {m_array}, &opt));
     }
 
     Series StringLike::find_substring(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("find_substring", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("find_substring", {m_array}, &opt));
     }
 
     Series StringLike::match_like(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("match_like", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("match_like", {m_array}, &opt));
     }
 
     Series StringLike::match_substring_regex(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("match_substring_regex", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("match_substring_regex", {m_array}, &opt));
     }
 
     Series StringLike::match_substring(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("match_substring", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("match_substring", {m_array}, &opt));
     }
 
     Series StringLike::starts_with(const std::string &pattern, bool ignore_case) {
         arrow::compute::MatchSubstringOptions opt(pattern, ignore_case);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("starts_with", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("starts_with", {m_array}, &opt));
     }
 
     Series StringLike::index_in(const Series &value_set, bool skip_nulls) {
         arrow::compute::SetLookupOptions opt(value_set.array(), skip_nulls);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("index_in", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("index_in", {m_array}, &opt));
     }
 
     Series StringLike::is_in(const Series &value_set, bool skip_nulls) {
         arrow::compute::SetLookupOptions opt(value_set.array(), skip_nulls);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("is_in", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("is_in", {m_array}, &opt));
     }
 
     Series DateTimeLike::ceil(
@@ -651,7 +689,7 @@ namespace pd {
                 week_starts_monday,
                 ceil_is_strictly_greater,
                 calendar_based_origin);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("ceil_temporal", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("ceil_temporal", {m_array}, &opt));
     }
 
     Series DateTimeLike::floor(
@@ -666,7 +704,7 @@ namespace pd {
                 week_starts_monday,
                 ceil_is_strictly_greater,
                 calendar_based_origin);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("floor_temporal", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("floor_temporal", {m_array}, &opt));
     }
 
     Series DateTimeLike::round(
@@ -681,21 +719,21 @@ namespace pd {
                 week_starts_monday,
                 ceil_is_strictly_greater,
                 calendar_based_origin);
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("round_temporal", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("round_temporal", {m_array}, &opt));
     }
 
     Series Series::cast(const std::shared_ptr<arrow::DataType> &dt, bool safe) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::Cast(m_array, dt, arrow::compute::CastOptions{safe}));
+        return ReturnSeriesOrThrowOnError(pd::Cast(m_array, dt, safe));
     }
 
     Series Series::strftime(const std::string &format, std::string const &locale) const {
-        return ReturnSeriesOrThrowOnError(
-                arrow::compute::Strftime(m_array, arrow::compute::StrftimeOptions{format, locale}));
+        arrow::compute::StrftimeOptions opt{format, locale};
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("strftime", {m_array}, &opt));
     }
 
     Series Series::strptime(const std::string &format, arrow::TimeUnit::type unit, bool error_is_null) const {
-        return ReturnSeriesOrThrowOnError(
-                arrow::compute::Strptime(m_array, arrow::compute::StrptimeOptions{format, unit, error_is_null}));
+        arrow::compute::StrptimeOptions opt{format, unit, error_is_null};
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("strptime", {m_array}, &opt));
     }
 
 
@@ -704,7 +742,7 @@ namespace pd {
             return *this;
         }
 
-        auto scalarArrayBuilder = pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(m_array->type()));
+        auto scalarArrayBuilder = pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(m_array->type(), pd::GetMemoryPool()));
         pd::ThrowOnFailure(scalarArrayBuilder->Reserve(m_array->length()));
 
         bool shiftRight = periods > 0;
@@ -751,7 +789,7 @@ namespace pd {
 
     Series Series::replace_with_mask(Series const &cond, Series const &other) const {
         if ((cond.size() == other.size()) and (other.size() <= this->size())) {
-            return ReturnSeriesOrThrowOnError(arrow::compute::ReplaceWithMask(m_array, cond.m_array, other.m_array));
+            return ReturnSeriesOrThrowOnError(pd::CallFunction("replace_with_mask", {m_array, cond.m_array, other.m_array}));
         } else {
             throw std::runtime_error(
                     ""
@@ -765,19 +803,19 @@ namespace pd {
             throw std::runtime_error("Both Series must be indexes for intersection to be valid.");
         }
 
-        arrow::Int64Builder intersection_indices;
-        std::vector<int64_t> result;
-        result.reserve(indexer.size());
-        for (auto const &[index, value]: indexer) {
-            if (other.indexer.count(index) == 1) {
-                result.push_back(value);
+        // first occurrences of this index whose label is also in other, in this index's order
+        auto found = other.getIndexer().get_indexer(*m_array);
+        auto duplicated = getIndexer().duplicated();
+        arrow::Int64Builder intersection_indices(pd::GetMemoryPool());
+        ThrowOnFailure(intersection_indices.Reserve(size()));
+        for (int64_t i = 0; i < size(); i++) {
+            if (found->IsValid(i) and not duplicated->Value(i)) {
+                intersection_indices.UnsafeAppend(i);
             }
         }
-        std::sort(result.begin(), result.end());
-        ThrowOnFailure(intersection_indices.AppendValues(result));
 
         auto intersection_array =
-                ReturnOrThrowOnFailure(arrow::compute::Take(m_array, intersection_indices.Finish().MoveValueUnsafe()));
+                ReturnOrThrowOnFailure(pd::CallFunction("take", {m_array, intersection_indices.Finish().MoveValueUnsafe()}));
         return {intersection_array.make_array(), true};
     }
 
@@ -789,10 +827,10 @@ namespace pd {
         if (!isIndex || !other.isIndex) {
             throw std::runtime_error("Both Series must be indexes to perform union operation.");
         }
-        auto concatenated_arrays = pd::ReturnOrThrowOnFailure(arrow::Concatenate({m_array, other.m_array}));
+        auto concatenated_arrays = pd::ReturnOrThrowOnFailure(arrow::Concatenate({m_array, other.m_array}, pd::GetMemoryPool()));
 
         auto new_series =
-                Series(pd::ReturnOrThrowOnFailure(arrow::compute::Unique(concatenated_arrays)), nullptr, m_name, true);
+                Series(pd::ReturnOrThrowOnFailure(pd::CallFunction("unique", {concatenated_arrays})).make_array(), nullptr, m_name, true);
         new_series.setIndexer();
 
         return new_series;
@@ -811,8 +849,15 @@ namespace pd {
         if (!isIndex) {
             throw std::runtime_error("Cannot get indexed values from non-index series");
         }
-        auto key_view = indexer | std::views::keys;
-        return {key_view.begin(), key_view.end()};
+        auto duplicated = getIndexer().duplicated();
+        std::vector<std::shared_ptr<arrow::Scalar>> labels;
+        labels.reserve(getIndexer().size());
+        for (int64_t i = 0; i < size(); i++) {
+            if (m_array->IsValid(i) and not duplicated->Value(i)) {
+                labels.push_back(m_array->GetScalar(i).MoveValueUnsafe());
+            }
+        }
+        return labels;
     }
 
     Series Series::append(const Series &to_append, bool ignore_index) const {
@@ -835,28 +880,20 @@ namespace pd {
                 }
             }
 
-            auto concatenated_arrays = arrow::Concatenate({m_array, to_append.m_array}).MoveValueUnsafe();
+            auto concatenated_arrays = arrow::Concatenate({m_array, to_append.m_array}, pd::GetMemoryPool()).MoveValueUnsafe();
 
             if (isIndex) {
-                Indexer new_indexer;
-                int i = 0;
-                for (i = 0; i < concatenated_arrays->length(); i++) {
-                    new_indexer[concatenated_arrays->GetScalar(i).MoveValueUnsafe()] = i;
-                }
-
                 auto new_series = Series(concatenated_arrays, nullptr, m_name, true);
-                new_series.indexer = new_indexer;
-                new_series.isIndex = true;
-
+                new_series.setIndexer();
                 return new_series;
             } else {
                 return Series(
                         concatenated_arrays,
-                        arrow::Concatenate({m_index, to_append.m_index}).MoveValueUnsafe(),
+                        arrow::Concatenate({m_index, to_append.m_index}, pd::GetMemoryPool()).MoveValueUnsafe(),
                         m_name);
             }
         } else {
-            auto concatenated_arrays = arrow::Concatenate({m_array, to_append.m_array}).MoveValueUnsafe();
+            auto concatenated_arrays = arrow::Concatenate({m_array, to_append.m_array}, pd::GetMemoryPool()).MoveValueUnsafe();
             return Series(concatenated_arrays, nullptr, m_name);
         }
     }
@@ -864,7 +901,7 @@ namespace pd {
     Series Series::argsort(bool ascending) const {
         auto opt = arrow::compute::ArraySortOptions{ascending ? arrow::compute::SortOrder::Ascending :
                                                     arrow::compute::SortOrder::Descending};
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("array_sort_indices", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("array_sort_indices", {m_array}, &opt));
     }
 
     double Series::cov(const Series & /*s2*/) const {
@@ -873,10 +910,11 @@ namespace pd {
 
     Series Series::clip(Series const &x, pd::Scalar const &min, pd::Scalar const &max, bool skipNull) const {
         arrow::compute::ElementWiseAggregateOptions option{skipNull};
-        return {pd::ReturnOrThrowOnFailure(arrow::compute::MaxElementWise(
+        return {pd::ReturnOrThrowOnFailure(pd::CallFunction(
+                "max_element_wise",
                 {pd::ReturnOrThrowOnFailure(
-                        arrow::compute::MinElementWise({x.m_array, arrow::Datum(max.scalar)}, option)),
-                 arrow::Datum(min.scalar)}, option)).make_array(), x.indexArray()};
+                        pd::CallFunction("min_element_wise", {x.m_array, arrow::Datum(max.scalar)}, &option)),
+                 arrow::Datum(min.scalar)}, &option)).make_array(), x.indexArray()};
     }
 
     double Series::corr(const Series & /*ununsed*/, CorrelationType /*ununsed*/) const {
@@ -915,39 +953,9 @@ namespace pd {
     Series::ewm(EWMAgg agg, double value, EWMAlphaType type, bool adjust, bool ignore_na, int min_periods, bool bias)
     const {
         min_periods = std::max(min_periods, 1);
-        double comass{};
-        switch (type) {
-            case EWMAlphaType::CenterOfMass:
-                if (value >= 0) {
-                    comass = value;
-                } else {
-                    throw std::runtime_error("EWM with COM require Value >= 0");
-                }
-                break;
-            case EWMAlphaType::Span:
-                if (value >= 1) {
-                    comass = (value - 1) / 2;
-                } else {
-                    throw std::runtime_error("EWM with Span require Value >= 1");
-                }
-                break;
-            case EWMAlphaType::HalfLife:
-                if (value > 0) {
-                    double decay = 1 - std::exp(std::log(0.5) / value);
-                    comass = 1 / decay - 1;
-                }
-                throw std::runtime_error("EWM is not supported");
-                break;
-            case EWMAlphaType::Alpha:
-                if (value > 0 and value <= 1) {
-                    comass = (1 - value) / value;
-                } else {
-                    throw std::runtime_error("EWM with Alpha require 0 < value <= 1");
-                }
-                break;
-        };
+        const double comass = ewmCenterOfMass(value, type);
 
-        auto casted = ReturnOrThrowOnFailure(arrow::compute::Cast(m_array, DoubleTypePtr)).make_array();
+        auto casted = ReturnOrThrowOnFailure(pd::Cast(m_array, DoubleTypePtr)).make_array();
         auto doubleArray = arrow::internal::checked_pointer_cast<arrow::DoubleArray>(casted);
 
         std::vector<double> output;
@@ -970,9 +978,42 @@ namespace pd {
         return Series{output, m_name, m_index};
     }
 
+    Series Series::ewm(time_duration const &halflife, bool adjust, bool ignore_na, int min_periods) const {
+        if (m_index.type()->id() != arrow::Type::TIMESTAMP) {
+            throw std::runtime_error("EWM with a time halflife requires a timestamp index");
+        }
+        if (m_index->null_count() != 0) {
+            throw std::runtime_error("EWM with a time halflife requires an index without nulls");
+        }
+        const auto halfLifeNs = static_cast<double>(halflife.total_nanoseconds());
+        if (halfLifeNs <= 0) {
+            throw std::runtime_error("EWM with HalfLife require a positive duration");
+        }
+        if (not adjust) {
+            throw std::invalid_argument("EWM with a time halflife does not support adjust=false");
+        }
+
+        auto times = ReturnOrThrowOnFailure(
+                pd::Cast(m_index, arrow::timestamp(arrow::TimeUnit::NANO))).make_array();
+        auto nanos = std::static_pointer_cast<arrow::TimestampArray>(times)->raw_values();
+
+        std::vector<double> deltas(std::max<int64_t>(times->length() - 1, 0));
+        for (size_t i = 0; i < deltas.size(); i++) {
+            deltas[i] = static_cast<double>(nanos[i + 1] - nanos[i]) / halfLifeNs;
+        }
+
+        auto casted = ReturnOrThrowOnFailure(pd::Cast(m_array, DoubleTypePtr)).make_array();
+        auto doubleArray = arrow::internal::checked_pointer_cast<arrow::DoubleArray>(casted);
+
+        // a halflife on the time axis is a fixed com of 1 with per-row decay exponents
+        auto output = ewm(doubleArray, {0}, {doubleArray->length()}, std::max(min_periods, 1), 1.0, adjust, ignore_na,
+                          deltas);
+        return Series{output, m_name, m_index};
+    }
+
     Series Series::nth_element(int n) const {
         auto opt = arrow::compute::PartitionNthOptions{n};
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("partition_nth_indices", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("partition_nth_indices", {m_array}, &opt));
     }
 
     pd::Series Series::sort(bool ascending) const {
@@ -983,10 +1024,11 @@ namespace pd {
 
         auto opt = arrow::compute::ArraySortOptions{ascending ? arrow::compute::SortOrder::Ascending :
                                                               arrow::compute::SortOrder::Descending};
-        auto result = arrow::compute::CallFunction("array_sort_indices", {m_array}, &opt);
+        auto result = pd::CallFunction("array_sort_indices", {m_array}, &opt);
         if (result.ok()) {
             auto indices = result.MoveValueUnsafe();
-            return pd::Series{arrow::compute::Take(m_array, indices)->make_array(), arrow::compute::Take(m_index, indices)->make_array(), m_name};
+            return pd::Series{ReturnOrThrowOnFailure(pd::CallFunction("take", {m_array, indices})).make_array(),
+                              ReturnOrThrowOnFailure(pd::CallFunction("take", {m_index, indices})).make_array(), m_name};
         }
         throw std::runtime_error(result.status().ToString());
     }
@@ -1201,11 +1243,11 @@ namespace pd {
     }
 
     Series Series::if_else(const Series &truth_values, const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::IfElse(truth_values.m_array, m_array, other.m_array));
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("if_else", {truth_values.m_array, m_array, other.m_array}));
     }
 
     Series Series::if_else(const Series &truth_values, const Scalar &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::IfElse(truth_values.m_array, m_array, other.scalar));
+        return ReturnSeriesOrThrowOnError(pd::CallFunction("if_else", {truth_values.m_array, m_array, other.scalar}));
     }
 
     Series Series::n_largest(int n) const
@@ -1256,39 +1298,40 @@ namespace pd {
             const std::shared_ptr<arrow::Array> &newIndex,
             std::optional<std::unordered_map<int64_t, int64_t>> indexer,
             const std::optional<Scalar> &fillValue) const {
-        if (newIndex->type()->id() != m_index->type()->id()) {
+        if (newIndex->type()->id() != m_index.type()->id()) {
             std::stringstream ss;
             ss << "type(NewIndex) != type(CurrentIndex).\n";
-            ss << newIndex->type()->ToString() << " != " << m_index->type()->ToString() << "\nNewIndex:\n"
+            ss << newIndex->type()->ToString() << " != " << m_index.type()->ToString() << "\nNewIndex:\n"
                << newIndex->ToString() << "\nCurrentIndex:\n"
                << m_index->ToString();
 
             throw std::runtime_error(ss.str());
         }
 
+        if (not indexer) {
+            // one bulk probe of the shared label hash, then a typed take
+            auto positions = m_index.labelIndex().get_indexer(*newIndex);
+            auto values = ReturnOrThrowOnFailure(pd::CallFunction("array_take", {m_array, positions})).make_array();
+            if (fillValue and positions->null_count() != 0) {
+                auto found = ReturnOrThrowOnFailure(pd::CallFunction("is_valid", {positions}));
+                auto fill = ReturnOrThrowOnFailure(fillValue->value()->CastTo(m_array->type()));
+                values = ReturnOrThrowOnFailure(pd::CallFunction("if_else", {found, values, fill})).make_array();
+            }
+            return {values, newIndex, m_name};
+        }
+
         auto new_idx_int =
                 pd::ReturnOrThrowOnFailure(
-                        arrow::compute::Cast(newIndex, {arrow::int64()})).array_as<arrow::Int64Array>();
+                        pd::Cast(newIndex, arrow::int64())).array_as<arrow::Int64Array>();
         // Get the length of the new index
         int64_t newIndexLen = newIndex->length();
 
         // Create a new values array builder for the reindexed series
         // Build the new values array
-        auto newValuesBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(m_array->type()));
+        auto newValuesBuilder = ReturnOrThrowOnFailure(arrow::MakeBuilder(m_array->type(), pd::GetMemoryPool()));
 
         ThrowOnFailure(newValuesBuilder->Reserve(newIndexLen));
 
-        // Create a hashmap to store the index-value pairs of the current series
-        if (not indexer) {
-            indexer = std::unordered_map<int64_t, int64_t>{};
-            auto idx_int =
-                    pd::ReturnOrThrowOnFailure(
-                            arrow::compute::Cast(m_index, {arrow::int64()})).array_as<arrow::Int64Array>();
-            for (int i = 0; i < m_index->length(); i++) {
-                indexer->insert_or_assign(idx_int->Value(i), i);
-            }
-        }
-
         // Iterate through the new index and add the corresponding values to the new values array builder
         for (int64_t i = 0; i < newIndexLen; i++) {
             auto &&newIndexValue = new_idx_int->Value(i);
@@ -1312,45 +1355,37 @@ namespace pd {
             std::shared_ptr<arrow::Array> const &newIndex,
             std::optional<std::unordered_map<int64_t, int64_t>> indexer,
             const std::optional<Scalar> &fillValue) const {
-        if (newIndex->type()->id() != m_index->type()->id()) {
+        if (newIndex->type()->id() != m_index.type()->id()) {
             throw std::runtime_error(
                     "Index type of newIndex does not match "
                     "the index type of the current series.");
         }
+        if (not indexer) {
+            return reindex(newIndex, std::nullopt, fillValue);
+        }
 
         // Get the length of the new index
         int64_t newIndexLen = newIndex->length();
         auto new_idx_int =
                 pd::ReturnOrThrowOnFailure(
-                        arrow::compute::Cast(newIndex, {arrow::int64()})).array_as<arrow::Int64Array>();
+                        pd::Cast(newIndex, arrow::int64())).array_as<arrow::Int64Array>();
         // Create a new values array builder for the reindexed series
         // Use Intel TBB to parallelize the reindex operation
         auto null = arrow::MakeNullScalar(m_array->type());
         std::vector<ScalarPtr> scalars(newIndexLen, fillValue ? fillValue->scalar : null);
 
-        // Create a hashmap to store the index-value pairs of the current series
-        if (not indexer) {
-            indexer = std::unordered_map<int64_t, int64_t>{};
-            auto idx_int =
-                    pd::ReturnOrThrowOnFailure(
-                            arrow::compute::Cast(m_index, {arrow::int64()})).array_as<arrow::Int64Array>();
-            for (int i = 0; i < m_index->length(); i++) {
-                indexer->insert_or_assign(idx_int->Value(i), i);
-            }
-        }
-
-        tbb::parallel_for(
+        pd::parallel_for(
                 0L,
                 newIndexLen,
-                [&](int64_t i) {
+                pd::bindExecContext([&](int64_t i) {
                     auto &&newIndexValue = new_idx_int->Value(i);
                     if (indexer->count(newIndexValue) == 1) {
                         int64_t valueIndex = indexer->at(newIndexValue);
                         scalars[i] = m_array->GetScalar(valueIndex).MoveValueUnsafe();
                     }
-                });
+                }));
         // Build the new values array
-        auto newValuesBuilder = pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(m_array->type()));
+        auto newValuesBuilder = pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(m_array->type(), pd::GetMemoryPool()));
 
         ThrowOnFailure(newValuesBuilder->AppendScalars(scalars));
 
@@ -1361,18 +1396,18 @@ namespace pd {
         return {newValues, newIndex, m_name};
     }
 
-    Series Series::ReturnSeriesOrThrowOnError(arrow::Result<arrow::Datum> &&result, pd::ArrayPtr const& indexPtr) const {
+    Series Series::ReturnSeriesOrThrowOnError(arrow::Result<arrow::Datum> &&result, pd::Index const& indexPtr) const {
         if (result.ok()) {
-            auto idx = indexPtr ? indexPtr : m_index;
+            pd::Index idx = indexPtr ? indexPtr : m_index;
             auto arr = result->make_array();
             const int64_t arrayLength = arr->length();
-            const int64_t indexLength = idx ? idx->length() : 0;
+            const int64_t indexLength = idx ? idx.length() : 0;
             if (indexLength == 0 || arrayLength == 0) {
                 return pd::Series{arr, false, ""};
             } else if (arrayLength == indexLength) {
                 return pd::Series{arr, idx, ""};
             } else if (arrayLength < indexLength) {
-                return pd::Series{arr, idx->Slice(indexLength - arrayLength, arrayLength), ""};
+                return pd::Series{arr, idx.slice(indexLength - arrayLength, arrayLength), ""};
             }
             throw std::runtime_error(
                     (boost::format(
@@ -1425,65 +1460,65 @@ namespace pd {
     Series
     DateTimeLike::week(bool week_starts_monday, bool count_from_zero, bool first_week_is_fully_in_year) const {
         auto opt = arrow::compute::WeekOptions{week_starts_monday, count_from_zero, first_week_is_fully_in_year};
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("week", {m_array}, &opt));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("week", {m_array}, &opt));
     }
 
     Series DateTimeLike::day_time_interval_between(const Series &other) const {
         return ReturnSeriesOrThrowOnError(
-                arrow::compute::CallFunction("day_time_interval_between", {m_array, other.m_array}));
+                pd::CallElementwise("day_time_interval_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::days_between(const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("days_between", {m_array, other.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("days_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::hours_between(const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("hours_between", {m_array, other.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("hours_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::microseconds_between(const Series &other) const {
         return ReturnSeriesOrThrowOnError(
-                arrow::compute::CallFunction("microseconds_between", {m_array, other.m_array}));
+                pd::CallElementwise("microseconds_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::milliseconds_between(const Series &other) const {
         return ReturnSeriesOrThrowOnError(
-                arrow::compute::CallFunction("milliseconds_between", {m_array, other.m_array}));
+                pd::CallElementwise("milliseconds_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::minutes_between(const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("minutes_between", {m_array, other.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("minutes_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::month_day_nano_interval_between(const Series &other) const {
         return ReturnSeriesOrThrowOnError(
-                arrow::compute::CallFunction("month_day_nano_interval_between", {m_array, other.m_array}));
+                pd::CallElementwise("month_day_nano_interval_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::month_interval_between(const Series &other) const {
         return ReturnSeriesOrThrowOnError(
-                arrow::compute::CallFunction("month_interval_between", {m_array, other.m_array}));
+                pd::CallElementwise("month_interval_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::nanoseconds_between(const Series &other) const {
         return ReturnSeriesOrThrowOnError(
-                arrow::compute::CallFunction("nanoseconds_between", {m_array, other.m_array}));
+                pd::CallElementwise("nanoseconds_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::quarters_between(const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("quarters_between", {m_array, other.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("quarters_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::seconds_between(const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("seconds_between", {m_array, other.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("seconds_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::weeks_between(const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("weeks_between", {m_array, other.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("weeks_between", {m_array, other.m_array}));
     }
 
     Series DateTimeLike::years_between(const Series &other) const {
-        return ReturnSeriesOrThrowOnError(arrow::compute::CallFunction("years_between", {m_array, other.m_array}));
+        return ReturnSeriesOrThrowOnError(pd::CallElementwise("years_between", {m_array, other.m_array}));
     }
 
 } // namespace pd
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include <vector>
 #include "ndframe.h"
 #include "scalar.h"
+#include "transform.h"
+#include "visit.h"
 
 
 #define PANDAS_SCALAR_OVERRIDES(op, V) \
@@ -27,7 +29,7 @@ namespace pd {
 
         Series(
                 std::shared_ptr<arrow::Array> const &arr,
-                std::shared_ptr<arrow::Array> const &index,
+                pd::Index const &index,
                 std::string name = "",
                 bool skipIndex = false);
 
@@ -42,7 +44,7 @@ namespace pd {
                 std::string const &name = "",
                 std::shared_ptr<arrow::Array> const &index = nullptr)
                 : NDFrame<arrow::Array>(index), m_name(name) {
-            auto builder = pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(dataType));
+            auto builder = pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(dataType, pd::GetMemoryPool()));
             ThrowOnFailure(builder->AppendScalars(arr));
             m_array = pd::ReturnOrThrowOnFailure(builder->Finish());
         }
@@ -81,8 +83,9 @@ namespace pd {
         //</editor-fold>
 
         //<editor-fold desc="Indexing Operations">
-        Scalar idxMin() const;
-        Scalar idxMax() const;
+        /// label of the first smallest / largest value, null when there is none
+        Scalar idxMin(bool skip_na = true) const;
+        Scalar idxMax(bool skip_na = true) const;
         //</editor-fold>
 
         //<editor-fold desc="Arithmetric Operation">
@@ -210,16 +213,38 @@ namespace pd {
         //</editor-fold>
 
         //<editor-fold desc="Iterator Functions">
+        /// fn inlined over the raw values, see pd::transform; nulls stay null
+        template<class In, class Out = void, class F>
+        Series transform(F &&fn, TransformOptions const &options = {}) const {
+            return {pd::transform<In, Out>(*m_array, std::forward<F>(fn), options), m_index, m_name};
+        }
+
+        /// fn(this[i], other[i]) by position, the result keeps this series' index
+        template<class Lhs, class Rhs = Lhs, class Out = void, class F>
+        Series transform2(Series const &other, F &&fn, TransformOptions const &options = {}) const {
+            return {pd::transform2<Lhs, Rhs, Out>(*m_array, *other.m_array, std::forward<F>(fn), options), m_index, m_name};
+        }
+
+        /// fn over every non-null value, null rows stay null and fn is not called on them.
+        /// Arithmetic columns are mapped with pd::transform, which calls fn concurrently from several
+        /// threads; install an ExecContext with use_threads off to call it serially and in order.
         template<class OutType, class InType>
         Series map(std::function<OutType(InType &&)> const& fn) const
         {
-            typename arrow::CTypeTraits<OutType>::BuilderType builder;
-            ThrowOnFailure(builder.Reserve(size()));
-            for (auto const& element: view<InType>())
-            {
-                builder.UnsafeAppend(fn(*element));
+            if constexpr (std::is_arithmetic_v<InType> and not std::is_same_v<InType, bool> and
+                          std::is_arithmetic_v<OutType>) {
+                return transform<InType, OutType>([&fn](InType x) { return fn(std::move(x)); },
+                                                  {.skipNulls = true});
+            } else {
+                typename arrow::CTypeTraits<OutType>::BuilderType builder(pd::GetMemoryPool());
+                ThrowOnFailure(builder.Reserve(size()));
+                for (auto const& element: *view<InType>())
+                {
+                    // checked appends, Reserve does not cover the value data of string builders
+                    ThrowOnFailure(element ? builder.Append(fn(InType(*element))) : builder.AppendNull());
+                }
+                return {ReturnOrThrowOnFailure(builder.Finish()), m_index};
             }
-            return {ReturnOrThrowOnFailure(builder.Finish()), m_index};
         }
 
         template<class InType>
@@ -227,6 +252,8 @@ namespace pd {
             return where(map<bool, InType>(fn));
         }
 
+        /// func(value, args...) over every non-null value, with the same null handling and
+        /// concurrency as map
         template<typename DataT, typename OutputT = DataT, typename... Args>
         [[nodiscard]] Series apply(auto &&func, Args &&... args) const;
 
@@ -277,9 +304,10 @@ namespace pd {
             return isIndex;
         }
 
-        // Get the indexer for the Series object.
-        inline auto getIndexer() const noexcept {
-            return indexer;
+        // Get the label -> position table of an index Series, empty for other Series.
+        inline LabelIndex const &getIndexer() const {
+            static const LabelIndex empty;
+            return isIndex ? indexer.labelIndex() : empty;
         }
 
         template<typename T>
@@ -357,6 +385,13 @@ namespace pd {
 
         [[nodiscard]] std::shared_ptr<arrow::DictionaryArray> dictionary_encode() const;
 
+        /// dictionary encoded copy keeping the index and name, a no-op on categoricals
+        [[nodiscard]] Series categorize() const;
+
+        [[nodiscard]] bool is_categorical() const {
+            return m_array->type_id() == arrow::Type::DICTIONARY;
+        }
+
         pd::Series reindex(
                 std::shared_ptr<arrow::Array> const &newIndex,
                 std::optional<std::unordered_map<int64_t, int64_t>> indexer = std::nullopt,
@@ -434,12 +469,20 @@ namespace pd {
                 int min_periods = 0,
                 bool bias = false) const;
 
+        /// halflife measured on the timestamp index, only the mean is defined for irregular times.
+        /// adjust=false throws, as in pandas: the recursive form has no meaning with irregular spacing.
+        [[nodiscard]] Series ewm(
+                time_duration const &halflife,
+                bool adjust = true,
+                bool ignore_na = false,
+                int min_periods = 0) const;
+
         [[nodiscard]] Series strftime(std::string const &format, std::string const &locale = "C") const;
 
         [[nodiscard]] Series strptime(std::string const &format, arrow::TimeUnit::type unit, bool error_is_null = false)
         const;
 
-        Series ReturnSeriesOrThrowOnError(arrow::Result<arrow::Datum> &&result, pd::ArrayPtr const& indexPtr=nullptr) const;
+        Series ReturnSeriesOrThrowOnError(arrow::Result<arrow::Datum> &&result, pd::Index const& indexPtr=nullptr) const;
 
         bool approx_equals_(pd::Series const &a, double eps) const {
             return m_array->ApproxEquals(*a.m_array, arrow::EqualOptions::Defaults().atol(eps));
@@ -451,7 +494,7 @@ namespace pd {
 
         template<typename V, bool in_reverse = false, typename ColumnType=double>
         V& hmVisit(V&& visitor) const {
-            if ((m_index->type()->id() != arrow::Type::INT64 && m_index->type()->id() != arrow::Type::TIMESTAMP))
+            if ((m_index.type()->id() != arrow::Type::INT64 && m_index.type()->id() != arrow::Type::TIMESTAMP))
             {
                 throw std::runtime_error("invalid index for hwdf Visitor only int64 are allowed.");
             }
@@ -473,6 +516,12 @@ namespace pd {
             return visitor;
         }
 
+        /// streams the values to visitor(firstRow, ColumnView<T>) chunk by chunk, see pd::visitColumns
+        template<typename T, typename V>
+        V visit(V visitor, VisitOptions const &options = {}) const {
+            return visitColumns<T>(std::move(visitor), {m_array}, options);
+        }
+
         template<typename ReturnT, typename FunctionSignature>
         Series rolling(FunctionSignature && fn, int64_t window) const{
             return rollingT<false, ReturnT, pd::Series, Series>(std::forward<FunctionSignature>(fn), window, m_array, m_index);
@@ -532,7 +581,7 @@ namespace pd {
             std::string _name,
             std::shared_ptr<arrow::Array> const &index,
             bool skipIndex) {
-        BuilderT builder;
+        BuilderT builder(pd::GetMemoryPool());
 
         auto status = builder.Reserve(arr.size());
         if (status.ok()) {
@@ -573,19 +622,23 @@ namespace pd {
 
     template<typename DataT, typename OutputT, typename... Args>
     Series Series::apply(auto &&func, Args &&... args) const {
-
-        typename arrow::CTypeTraits<OutputT>::BuilderType builder;
-        auto realArray = std::static_pointer_cast<typename arrow::CTypeTraits<DataT>::ArrayType>(m_array);
-
-        if (realArray) {
-            int64_t N = realArray->length();
-            ThrowOnFailure(builder.Reserve(N));
-            for (auto const &element: *realArray) {
-                OutputT res = func(*element, std::forward<Args>(args)...);
-                builder.UnsafeAppend(res);
+        if constexpr (std::is_arithmetic_v<DataT> and not std::is_same_v<DataT, bool> and
+                      std::is_arithmetic_v<OutputT>) {
+            return transform<DataT, OutputT>([&](DataT x) -> OutputT { return func(x, args...); },
+                                             {.skipNulls = true});
+        } else {
+            typename arrow::CTypeTraits<OutputT>::BuilderType builder(pd::GetMemoryPool());
+            auto realArray = std::static_pointer_cast<typename arrow::CTypeTraits<DataT>::ArrayType>(m_array);
+
+            if (realArray) {
+                int64_t N = realArray->length();
+                ThrowOnFailure(builder.Reserve(N));
+                for (auto const &element: *realArray) {
+                    ThrowOnFailure(element ? builder.Append(func(*element, args...)) : builder.AppendNull());
+                }
+                return {ReturnOrThrowOnFailure(builder.Finish()), m_index, m_name};
             }
-            return {ReturnOrThrowOnFailure(builder.Finish()), m_index, m_name};
+            throw RawArrayCastException{arrow::CTypeTraits<DataT>::type_singleton(), m_array->type()};
         }
-        throw RawArrayCastException{arrow::CTypeTraits<DataT>::type_singleton(), m_array->type()};
     }
 } // namespace pd
@@ -0,0 +1,216 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+
+namespace pd {
+
+    /// 64 bit finalizer of murmur3, spreads fixed width values before they are sketched
+    inline uint64_t mixHash(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    /// Cardinality sketch with 2^14 registers, the relative standard error is ~0.8%.
+    /// Small cardinalities fall back to linear counting which is near exact.
+    class HyperLogLog {
+    public:
+        static constexpr int PRECISION = 14;
+        static constexpr size_t REGISTERS = size_t{1} << PRECISION;
+
+        void add(uint64_t hash) {
+            const auto index = hash >> (64 - PRECISION);
+            const auto rank = static_cast<uint8_t>(
+                    std::countl_zero((hash << PRECISION) | (uint64_t{1} << (PRECISION - 1))) + 1);
+            m_registers[index] = std::max(m_registers[index], rank);
+        }
+
+        void merge(HyperLogLog const &other) {
+            for (size_t i = 0; i < REGISTERS; i++) {
+                m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+            }
+        }
+
+        [[nodiscard]] int64_t estimate() const {
+            constexpr double m = REGISTERS;
+            double sum = 0;
+            size_t zeros = 0;
+            for (auto r: m_registers) {
+                sum += std::ldexp(1.0, -r);
+                zeros += (r == 0);
+            }
+            const double alpha = 0.7213 / (1 + 1.079 / m);
+            double estimate = alpha * m * m / sum;
+            if (estimate <= 2.5 * m and zeros > 0) {
+                estimate = m * std::log(m / static_cast<double>(zeros));
+            }
+            return std::llround(estimate);
+        }
+
+    private:
+        std::array<uint8_t, REGISTERS> m_registers{};
+    };
+
+    /// Mergeable quantile sketch (merging t-digest with the arcsine scale function).
+    /// Tails are kept at a much finer resolution than the median, which suits percentiles.
+    class TDigest {
+    public:
+        explicit TDigest(double compression = 100) : m_compression(compression) {
+            m_buffer.reserve(bufferSize());
+        }
+
+        void add(double x) {
+            m_buffer.push_back({x, 1});
+            m_min = std::min(m_min, x);
+            m_max = std::max(m_max, x);
+            if (m_buffer.size() >= bufferSize()) {
+                compress();
+            }
+        }
+
+        void merge(TDigest const &other) {
+            m_buffer.insert(m_buffer.end(), other.m_centroids.begin(), other.m_centroids.end());
+            m_buffer.insert(m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+            compress();
+        }
+
+        [[nodiscard]] double count() const {
+            double total = m_total;
+            for (auto const &c: m_buffer) {
+                total += c.weight;
+            }
+            return total;
+        }
+
+        /// interpolated quantile, NaN for an empty digest
+        double quantile(double q) {
+            compress();
+            if (m_centroids.empty()) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (m_centroids.size() == 1) {
+                return m_centroids[0].mean;
+            }
+
+            const double index = std::clamp(q, 0.0, 1.0) * m_total;
+            auto const &first = m_centroids.front();
+            auto const &last = m_centroids.back();
+            if (index < 1) {
+                return m_min;
+            }
+            if (first.weight > 1 and index < first.weight / 2) {
+                return m_min + (index - 1) / (first.weight / 2 - 1) * (first.mean - m_min);
+            }
+            if (index > m_total - 1) {
+                return m_max;
+            }
+            if (last.weight > 1 and m_total - index <= last.weight / 2) {
+                return m_max - (m_total - index - 1) / (last.weight / 2 - 1) * (m_max - last.mean);
+            }
+
+            double weightSoFar = first.weight / 2;
+            for (size_t i = 0; i + 1 < m_centroids.size(); i++) {
+                auto const &left = m_centroids[i];
+                auto const &right = m_centroids[i + 1];
+                const double dw = (left.weight + right.weight) / 2;
+                if (weightSoFar + dw > index) {
+                    double leftUnit = 0;
+                    if (left.weight == 1) {
+                        if (index - weightSoFar < 0.5) {
+                            return left.mean;
+                        }
+                        leftUnit = 0.5;
+                    }
+                    double rightUnit = 0;
+                    if (right.weight == 1) {
+                        if (weightSoFar + dw - index <= 0.5) {
+                            return right.mean;
+                        }
+                        rightUnit = 0.5;
+                    }
+                    const double z1 = index - weightSoFar - leftUnit;
+                    const double z2 = weightSoFar + dw - index - rightUnit;
+                    return (left.mean * z2 + right.mean * z1) / (z1 + z2);
+                }
+                weightSoFar += dw;
+            }
+            const double z1 = index - m_total - last.weight / 2;
+            const double z2 = last.weight / 2 - z1;
+            return (last.mean * z1 + m_max * z2) / (z1 + z2);
+        }
+
+    private:
+        struct Centroid {
+            double mean;
+            double weight;
+        };
+
+        double m_compression;
+        std::vector<Centroid> m_centroids, m_buffer;
+        double m_total{0};
+        double m_min{std::numeric_limits<double>::infinity()};
+        double m_max{-std::numeric_limits<double>::infinity()};
+
+        [[nodiscard]] size_t bufferSize() const {
+            return static_cast<size_t>(m_compression) * 5;
+        }
+
+        [[nodiscard]] double scale(double q) const {
+            return m_compression / (2 * std::numbers::pi) * std::asin(2 * q - 1);
+        }
+
+        [[nodiscard]] double inverseScale(double k) const {
+            return (std::sin(std::clamp(k * 2 * std::numbers::pi / m_compression,
+                                        -std::numbers::pi / 2,
+                                        std::numbers::pi / 2)) + 1) / 2;
+        }
+
+        void compress() {
+            if (m_buffer.empty()) {
+                return;
+            }
+            m_buffer.insert(m_buffer.end(), m_centroids.begin(), m_centroids.end());
+            std::ranges::sort(m_buffer, {}, &Centroid::mean);
+
+            double total = 0;
+            for (auto const &c: m_buffer) {
+                total += c.weight;
+            }
+
+            m_centroids.clear();
+            Centroid current = m_buffer.front();
+            double weightSoFar = 0;
+            double limit = total * inverseScale(scale(0) + 1);
+            for (size_t i = 1; i < m_buffer.size(); i++) {
+                auto const &next = m_buffer[i];
+                if (weightSoFar + current.weight + next.weight <= limit) {
+                    current.weight += next.weight;
+                    current.mean += (next.mean - current.mean) * next.weight / current.weight;
+                } else {
+                    weightSoFar += current.weight;
+                    m_centroids.push_back(current);
+                    limit = total * inverseScale(scale(weightSoFar / total) + 1);
+                    current = next;
+                }
+            }
+            m_centroids.push_back(current);
+            m_total = total;
+            m_buffer.clear();
+        }
+    };
+}
@@ -0,0 +1,365 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "sort.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include "exec_context.h"
+#include "scheduler.h"
+
+
+namespace pd {
+
+    namespace {
+        constexpr size_t RADIX_BITS = 8;
+        constexpr size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+        // below this a comparison sort beats eight histogram passes
+        constexpr size_t SMALL_SORT = 1024;
+        constexpr size_t MIN_BLOCK_SIZE = 1 << 16;
+
+        constexpr uint64_t SIGN_BIT = uint64_t{1} << 63;
+
+        template<class CType>
+        constexpr uint64_t keyMask() {
+            if constexpr (std::is_floating_point_v<CType> || sizeof(CType) == 8) {
+                return ~uint64_t{0};
+            } else {
+                return (uint64_t{1} << (sizeof(CType) * 8)) - 1;
+            }
+        }
+
+        /// maps a value to an unsigned key with the same ordering
+        template<class CType>
+        uint64_t encodeKey(CType value) {
+            if constexpr (std::is_floating_point_v<CType>) {
+                // -0.0 == 0.0, keep them in their original order
+                const auto bits = std::bit_cast<uint64_t>(value == 0 ? 0.0 : static_cast<double>(value));
+                return (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+            } else if constexpr (std::is_signed_v<CType>) {
+                using U = std::make_unsigned_t<CType>;
+                return static_cast<U>(static_cast<U>(value) ^ (U{1} << (sizeof(CType) * 8 - 1)));
+            } else {
+                return static_cast<uint64_t>(value);
+            }
+        }
+
+        template<class CType>
+        bool isMissing(arrow::ArrayData const &data, int64_t row, CType const *values) {
+            if (data.MayHaveNulls() && !arrow::bit_util::GetBit(data.buffers[0]->data(), data.offset + row)) {
+                return true;
+            }
+            if constexpr (std::is_floating_point_v<CType>) {
+                return std::isnan(values[row]);
+            }
+            return false;
+        }
+
+        template<class Fn>
+        void visitRadixType(arrow::DataType const &type, Fn &&fn) {
+            switch (type.id()) {
+                case arrow::Type::INT8:
+                    return fn(int8_t{});
+                case arrow::Type::INT16:
+                    return fn(int16_t{});
+                case arrow::Type::INT32:
+                case arrow::Type::DATE32:
+                case arrow::Type::TIME32:
+                    return fn(int32_t{});
+                case arrow::Type::INT64:
+                case arrow::Type::DATE64:
+                case arrow::Type::TIME64:
+                case arrow::Type::TIMESTAMP:
+                case arrow::Type::DURATION:
+                    return fn(int64_t{});
+                case arrow::Type::UINT8:
+                    return fn(uint8_t{});
+                case arrow::Type::UINT16:
+                    return fn(uint16_t{});
+                case arrow::Type::UINT32:
+                    return fn(uint32_t{});
+                case arrow::Type::UINT64:
+                    return fn(uint64_t{});
+                case arrow::Type::FLOAT:
+                    return fn(float{});
+                case arrow::Type::DOUBLE:
+                    return fn(double{});
+                default:
+                    throw std::runtime_error("radix sort does not support " + type.ToString());
+            }
+        }
+
+        /// stable LSD radix sort of (keys, rows) pairs, blocks are histogrammed and
+        /// scattered in parallel, passes where every key shares the digit are skipped
+        void radixSort(std::vector<uint64_t> &keys, std::vector<uint64_t> &rows) {
+            const size_t n = keys.size();
+            if (n < SMALL_SORT) {
+                std::vector<size_t> order(n);
+                std::iota(order.begin(), order.end(), 0);
+                std::ranges::stable_sort(order, {}, [&keys](size_t i) { return keys[i]; });
+
+                std::vector<uint64_t> sortedKeys(n), sortedRows(n);
+                for (size_t i = 0; i < n; i++) {
+                    sortedKeys[i] = keys[order[i]];
+                    sortedRows[i] = rows[order[i]];
+                }
+                keys.swap(sortedKeys);
+                rows.swap(sortedRows);
+                return;
+            }
+
+            const size_t maxBlocks = static_cast<size_t>(pd::get_parallelism()) * 4;
+            const size_t numBlocks = std::clamp<size_t>(n / MIN_BLOCK_SIZE, 1, maxBlocks);
+            const size_t blockSize = (n + numBlocks - 1) / numBlocks;
+
+            std::vector<uint64_t> keysOut(n), rowsOut(n);
+            std::vector<std::array<size_t, RADIX_BUCKETS>> offsets(numBlocks);
+
+            for (size_t shift = 0; shift < 64; shift += RADIX_BITS) {
+                pd::parallel_for(size_t{0}, numBlocks, pd::bindExecContext([&](size_t b) {
+                    auto &count = offsets[b];
+                    count.fill(0);
+                    const size_t end = std::min(n, (b + 1) * blockSize);
+                    for (size_t i = b * blockSize; i < end; i++) {
+                        count[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+                    }
+                }));
+
+                bool skip = false;
+                size_t offset = 0;
+                for (size_t digit = 0; digit < RADIX_BUCKETS && !skip; digit++) {
+                    size_t total = 0;
+                    for (auto &count: offsets) {
+                        const size_t c = count[digit];
+                        count[digit] = offset + total;
+                        total += c;
+                    }
+                    skip = total == n;
+                    offset += total;
+                }
+                if (skip) {
+                    continue;
+                }
+
+                pd::parallel_for(size_t{0}, numBlocks, pd::bindExecContext([&](size_t b) {
+                    auto &position = offsets[b];
+                    const size_t end = std::min(n, (b + 1) * blockSize);
+                    for (size_t i = b * blockSize; i < end; i++) {
+                        const size_t target = position[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+                        keysOut[target] = keys[i];
+                        rowsOut[target] = rows[i];
+                    }
+                }));
+                keys.swap(keysOut);
+                rows.swap(rowsOut);
+            }
+        }
+
+        /// one stable pass over `perm` by a single radix key
+        void radixPass(arrow::Array const &column, SortKey const &key, std::vector<uint64_t> &perm) {
+            const auto &data = *column.data();
+            const size_t n = perm.size();
+
+            std::vector<uint64_t> keys, rows, missing;
+            keys.reserve(n);
+            rows.reserve(n);
+
+            visitRadixType(*column.type(), [&]<class CType>(CType) {
+                const auto *values = data.GetValues<CType>(1);
+                const uint64_t flip = key.ascending ? 0 : keyMask<CType>();
+                for (auto row: perm) {
+                    if (isMissing(data, static_cast<int64_t>(row), values)) {
+                        missing.push_back(row);
+                    } else {
+                        keys.push_back(encodeKey(values[row]) ^ flip);
+                        rows.push_back(row);
+                    }
+                }
+            });
+
+            radixSort(keys, rows);
+
+            auto out = perm.begin();
+            if (key.null_placement == arrow::compute::NullPlacement::AtStart) {
+                out = std::ranges::copy(missing, out).out;
+            }
+            out = std::ranges::copy(rows, out).out;
+            if (key.null_placement == arrow::compute::NullPlacement::AtEnd) {
+                std::ranges::copy(missing, out);
+            }
+        }
+
+        std::shared_ptr<arrow::UInt64Array> toArray(std::vector<uint64_t> const &values) {
+            const auto n = static_cast<int64_t>(values.size());
+            auto buffer = ReturnOrThrowOnFailure(
+                    arrow::AllocateBuffer(n * static_cast<int64_t>(sizeof(uint64_t)), GetMemoryPool()));
+            if (n > 0) {
+                std::memcpy(buffer->mutable_data(), values.data(), values.size() * sizeof(uint64_t));
+            }
+            return std::make_shared<arrow::UInt64Array>(n, std::move(buffer));
+        }
+
+        /// one stable pass over `perm` for key types without a radix encoding
+        void arrowPass(ArrayPtr const &column, SortKey const &key, std::vector<uint64_t> &perm) {
+            auto permuted = ReturnOrThrowOnFailure(pd::CallFunction("take", {column, toArray(perm)})).make_array();
+
+            arrow::compute::ArraySortOptions options{
+                    key.ascending ? arrow::compute::SortOrder::Ascending : arrow::compute::SortOrder::Descending,
+                    key.null_placement};
+            auto order = ReturnOrThrowOnFailure(pd::CallFunction("array_sort_indices", {permuted}, &options))
+                    .array_as<arrow::UInt64Array>();
+
+            std::vector<uint64_t> sorted(perm.size());
+            for (size_t i = 0; i < sorted.size(); i++) {
+                sorted[i] = perm[order->Value(static_cast<int64_t>(i))];
+            }
+            perm.swap(sorted);
+        }
+
+        ArrayPtr keyColumn(arrow::RecordBatch const &batch, SortKey const &key) {
+            auto column = batch.GetColumnByName(key.column);
+            if (!column) {
+                throw std::runtime_error(key.column + " not in schema");
+            }
+            return column;
+        }
+
+        std::vector<uint64_t> sortPermutation(std::vector<ArrayPtr> const &columns,
+                                              std::vector<SortKey> const &keys,
+                                              int64_t numRows) {
+            std::vector<uint64_t> perm(numRows);
+            std::iota(perm.begin(), perm.end(), 0);
+
+            // least significant key first, every pass is stable
+            for (size_t i = keys.size(); i-- > 0;) {
+                if (isRadixSortable(*columns[i]->type())) {
+                    radixPass(*columns[i], keys[i], perm);
+                } else {
+                    arrowPass(columns[i], keys[i], perm);
+                }
+            }
+            return perm;
+        }
+    }
+
+    bool isRadixSortable(arrow::DataType const &type) {
+        switch (type.id()) {
+            case arrow::Type::INT8:
+            case arrow::Type::INT16:
+            case arrow::Type::INT32:
+            case arrow::Type::INT64:
+            case arrow::Type::UINT8:
+            case arrow::Type::UINT16:
+            case arrow::Type::UINT32:
+            case arrow::Type::UINT64:
+            case arrow::Type::FLOAT:
+            case arrow::Type::DOUBLE:
+            case arrow::Type::DATE32:
+            case arrow::Type::DATE64:
+            case arrow::Type::TIME32:
+            case arrow::Type::TIME64:
+            case arrow::Type::TIMESTAMP:
+            case arrow::Type::DURATION:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::shared_ptr<arrow::UInt64Array> sort_indices(arrow::RecordBatch const &batch, std::vector<SortKey> const &keys) {
+        std::vector<ArrayPtr> columns;
+        columns.reserve(keys.size());
+        for (auto const &key: keys) {
+            columns.emplace_back(keyColumn(batch, key));
+        }
+        return toArray(sortPermutation(columns, keys, batch.num_rows()));
+    }
+
+    std::shared_ptr<arrow::UInt64Array> sort_indices(ArrayPtr const &array,
+                                                     bool ascending,
+                                                     arrow::compute::NullPlacement null_placement) {
+        return toArray(sortPermutation({array}, {SortKey{"", ascending, null_placement}}, array->length()));
+    }
+
+    std::shared_ptr<arrow::UInt64Array> select_k(arrow::RecordBatch const &batch,
+                                                 std::vector<SortKey> const &keys,
+                                                 int64_t k) {
+        std::vector<ArrayPtr> columns;
+        columns.reserve(keys.size());
+        for (auto const &key: keys) {
+            columns.emplace_back(keyColumn(batch, key));
+        }
+        k = std::max<int64_t>(k, 0);
+
+        if (!std::ranges::all_of(columns, [](auto const &column) { return isRadixSortable(*column->type()); })) {
+            // the full sort keeps rows with a missing key, they are dropped while taking the first k
+            const auto missingKey = [&](int64_t row) {
+                return std::ranges::any_of(columns, [row](ArrayPtr const &column) {
+                    switch (column->type_id()) {
+                        case arrow::Type::FLOAT:
+                            return column->IsNull(row) || std::isnan(static_cast<arrow::FloatArray const &>(*column).Value(row));
+                        case arrow::Type::DOUBLE:
+                            return column->IsNull(row) || std::isnan(static_cast<arrow::DoubleArray const &>(*column).Value(row));
+                        default:
+                            return column->IsNull(row);
+                    }
+                });
+            };
+            auto sorted = sort_indices(batch, keys);
+            const auto *order = sorted->raw_values();
+            std::vector<uint64_t> rows;
+            rows.reserve(std::min(k, sorted->length()));
+            for (int64_t i = 0; i < sorted->length() && static_cast<int64_t>(rows.size()) < k; i++) {
+                if (!missingKey(static_cast<int64_t>(order[i]))) {
+                    rows.push_back(order[i]);
+                }
+            }
+            return toArray(rows);
+        }
+
+        const int64_t n = batch.num_rows();
+        std::vector<std::vector<uint64_t>> encoded(keys.size(), std::vector<uint64_t>(n));
+        std::vector<bool> missing(n, false);
+        for (size_t j = 0; j < keys.size(); j++) {
+            const auto &data = *columns[j]->data();
+            visitRadixType(*columns[j]->type(), [&]<class CType>(CType) {
+                const auto *values = data.GetValues<CType>(1);
+                const uint64_t flip = keys[j].ascending ? 0 : keyMask<CType>();
+                for (int64_t row = 0; row < n; row++) {
+                    if (isMissing(data, row, values)) {
+                        missing[row] = true;
+                    } else {
+                        encoded[j][row] = encodeKey(values[row]) ^ flip;
+                    }
+                }
+            });
+        }
+
+        std::vector<uint64_t> rows;
+        rows.reserve(n);
+        for (int64_t row = 0; row < n; row++) {
+            if (!missing[row]) {
+                rows.push_back(row);
+            }
+        }
+
+        auto less = [&encoded](uint64_t a, uint64_t b) {
+            for (auto const &key: encoded) {
+                if (key[a] != key[b]) {
+                    return key[a] < key[b];
+                }
+            }
+            return a < b;
+        };
+
+        if (static_cast<size_t>(k) < rows.size()) {
+            std::ranges::nth_element(rows, rows.begin() + k, less);
+            rows.resize(k);
+        }
+        std::ranges::sort(rows, less);
+        return toArray(rows);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/compute/api_vector.h>
+#include <string>
+#include <vector>
+#include "core.h"
+
+
+namespace pd {
+
+    struct SortKey {
+        std::string column;
+        bool ascending{true};
+        arrow::compute::NullPlacement null_placement{arrow::compute::NullPlacement::AtEnd};
+    };
+
+    /// integer, floating point and temporal keys take the parallel LSD radix path,
+    /// every other type is sorted with arrow's stable array_sort_indices
+    bool isRadixSortable(arrow::DataType const &type);
+
+    /// Stable permutation sorting the rows of `batch` lexicographically by `keys`.
+    /// NaN is treated as missing and placed with the nulls, like pandas.
+    std::shared_ptr<arrow::UInt64Array> sort_indices(arrow::RecordBatch const &batch, std::vector<SortKey> const &keys);
+
+    std::shared_ptr<arrow::UInt64Array> sort_indices(ArrayPtr const &array,
+                                                     bool ascending = true,
+                                                     arrow::compute::NullPlacement null_placement =
+                                                     arrow::compute::NullPlacement::AtEnd);
+
+    /// Positions of the first `k` rows in `keys` order without sorting the whole batch.
+    /// Rows with a missing key are skipped and ties keep their original order.
+    std::shared_ptr<arrow::UInt64Array> select_k(arrow::RecordBatch const &batch,
+                                                 std::vector<SortKey> const &keys,
+                                                 int64_t k);
+}
@@ -0,0 +1,242 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "streaming_frame.h"
+#include "tracing.h"
+
+
+namespace pd {
+
+    StreamingFrame::StreamingFrame(std::shared_ptr<arrow::Schema> schema,
+                                   std::shared_ptr<arrow::DataType> indexType,
+                                   int64_t chunkSize,
+                                   std::optional<int64_t> capacity)
+            : m_schema(std::move(schema)),
+              m_indexType(std::move(indexType)),
+              m_chunkSize(chunkSize),
+              m_capacity(capacity) {
+        if (m_chunkSize <= 0) {
+            throw std::invalid_argument("StreamingFrame: chunkSize must be positive");
+        }
+        if (m_capacity && *m_capacity <= 0) {
+            throw std::invalid_argument("StreamingFrame: capacity must be positive");
+        }
+
+        auto *pool = pd::GetMemoryPool();
+        m_builders.reserve(m_schema->num_fields());
+        for (auto const &field: m_schema->fields()) {
+            m_builders.emplace_back(pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(field->type(), pool)));
+            pd::ThrowOnFailure(m_builders.back()->Reserve(m_chunkSize));
+        }
+        m_indexBuilder = pd::ReturnOrThrowOnFailure(arrow::MakeBuilder(m_indexType ? m_indexType : arrow::uint64(), pool));
+        pd::ThrowOnFailure(m_indexBuilder->Reserve(m_chunkSize));
+    }
+
+    static std::shared_ptr<arrow::Scalar> castScalar(std::shared_ptr<arrow::Scalar> const &scalar,
+                                                     std::shared_ptr<arrow::DataType> const &type) {
+        if (scalar->type->Equals(*type)) {
+            return scalar;
+        }
+        return pd::ReturnOrThrowOnFailure(scalar->CastTo(type));
+    }
+
+    void StreamingFrame::appendValues(std::vector<Scalar> const &values) {
+        if (static_cast<int>(values.size()) != m_schema->num_fields()) {
+            throw std::invalid_argument(fmt::format("StreamingFrame: expected {} values per row, got {}",
+                                                    m_schema->num_fields(), values.size()));
+        }
+
+        // cast every value before touching the builders so a bad row leaves the frame unchanged
+        std::vector<std::shared_ptr<arrow::Scalar>> row(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            row[i] = castScalar(values[i].value(), m_schema->field(static_cast<int>(i))->type());
+        }
+
+        for (size_t i = 0; i < row.size(); i++) {
+            pd::ThrowOnFailure(m_builders[i]->AppendScalar(*row[i]));
+        }
+    }
+
+    void StreamingFrame::append_row(Scalar const &index, std::vector<Scalar> const &values) {
+        if (!m_indexType) {
+            throw std::invalid_argument("StreamingFrame: frame uses a position index, append without an index");
+        }
+        auto indexValue = castScalar(index.value(), m_indexType);
+        appendValues(values);
+        pd::ThrowOnFailure(m_indexBuilder->AppendScalar(*indexValue));
+
+        m_tailRows++;
+        m_totalRows++;
+        if (m_tailRows == m_chunkSize) {
+            seal();
+        } else {
+            evict();
+        }
+    }
+
+    void StreamingFrame::append_row(std::vector<Scalar> const &values) {
+        if (m_indexType) {
+            throw std::invalid_argument("StreamingFrame: frame has an index of type " + m_indexType->ToString());
+        }
+        appendValues(values);
+        pd::ThrowOnFailure(static_cast<arrow::UInt64Builder &>(*m_indexBuilder).Append(m_totalRows));
+
+        m_tailRows++;
+        m_totalRows++;
+        if (m_tailRows == m_chunkSize) {
+            seal();
+        } else {
+            evict();
+        }
+    }
+
+    void StreamingFrame::append_batch(DataFrame const &df) {
+        PD_TRACE_SCOPE("StreamingFrame::append_batch");
+        auto batch = df.array();
+        if (!batch->schema()->Equals(*m_schema, false)) {
+            throw std::invalid_argument(fmt::format("StreamingFrame: batch schema {} does not match {}",
+                                                    batch->schema()->ToString(), m_schema->ToString()));
+        }
+
+        const int64_t n = batch->num_rows();
+        if (n == 0) {
+            return;
+        }
+
+        // rows that would be evicted right away are never retained
+        const int64_t skip = m_capacity ? std::max<int64_t>(n - *m_capacity, 0) : 0;
+        const int64_t kept = n - skip;
+
+        ArrayPtr index;
+        if (m_indexType) {
+            index = df.indexArray()->Slice(skip);
+            if (!index->type()->Equals(*m_indexType)) {
+                index = pd::ReturnOrThrowOnFailure(pd::Cast(index, m_indexType)).make_array();
+            }
+        } else {
+            arrow::UInt64Builder builder(pd::GetMemoryPool());
+            pd::ThrowOnFailure(builder.Reserve(kept));
+            for (int64_t i = skip; i < n; i++) {
+                builder.UnsafeAppend(static_cast<uint64_t>(m_totalRows + i));
+            }
+            index = pd::ReturnOrThrowOnFailure(builder.Finish());
+        }
+
+        // rows appended before the batch must stay in front of it
+        seal();
+        m_chunks.push_back(Chunk{skip > 0 ? batch->Slice(skip) : batch, index});
+        m_sealedRows += kept;
+        m_totalRows += n;
+        evict();
+    }
+
+    void StreamingFrame::seal() {
+        if (m_tailRows == 0) {
+            return;
+        }
+
+        arrow::ArrayVector columns(m_builders.size());
+        for (size_t i = 0; i < m_builders.size(); i++) {
+            columns[i] = pd::ReturnOrThrowOnFailure(m_builders[i]->Finish());
+            pd::ThrowOnFailure(m_builders[i]->Reserve(m_chunkSize));
+        }
+        auto index = pd::ReturnOrThrowOnFailure(m_indexBuilder->Finish());
+        pd::ThrowOnFailure(m_indexBuilder->Reserve(m_chunkSize));
+
+        m_chunks.push_back(Chunk{arrow::RecordBatch::Make(m_schema, m_tailRows, columns), index});
+        m_sealedRows += m_tailRows;
+        m_tailRows = 0;
+        evict();
+    }
+
+    void StreamingFrame::evict() {
+        if (!m_capacity) {
+            return;
+        }
+        // only drop a chunk when the rows after it still fill the capacity
+        while (!m_chunks.empty() &&
+               m_sealedRows - m_chunks.front().data->num_rows() + m_tailRows >= *m_capacity) {
+            m_sealedRows -= m_chunks.front().data->num_rows();
+            m_chunks.pop_front();
+        }
+    }
+
+    StreamingFrame::Chunk StreamingFrame::copyTail() {
+        auto copyBuilder = [this](arrow::ArrayBuilder &builder) {
+            auto array = pd::ReturnOrThrowOnFailure(builder.Finish());
+            pd::ThrowOnFailure(builder.Reserve(std::max(m_chunkSize, array->length())));
+            pd::ThrowOnFailure(builder.AppendArraySlice(arrow::ArraySpan(*array->data()), 0, array->length()));
+            return array;
+        };
+
+        arrow::ArrayVector columns(m_builders.size());
+        for (size_t i = 0; i < m_builders.size(); i++) {
+            columns[i] = copyBuilder(*m_builders[i]);
+        }
+        auto index = copyBuilder(*m_indexBuilder);
+        return Chunk{arrow::RecordBatch::Make(m_schema, m_tailRows, columns), index};
+    }
+
+    std::vector<StreamingFrame::Chunk> StreamingFrame::retainedChunks() {
+        std::vector<Chunk> chunks(m_chunks.begin(), m_chunks.end());
+        if (m_tailRows > 0) {
+            chunks.emplace_back(copyTail());
+        }
+        return chunks;
+    }
+
+    int64_t StreamingFrame::num_rows() const {
+        const int64_t retained = m_sealedRows + m_tailRows;
+        return m_capacity ? std::min(retained, *m_capacity) : retained;
+    }
+
+    std::shared_ptr<arrow::Table> StreamingFrame::toTable(std::string const &indexName) {
+        PD_TRACE_SCOPE("StreamingFrame::toTable");
+        auto chunks = retainedChunks();
+
+        auto fields = m_schema->fields();
+        fields.push_back(arrow::field(indexName, m_indexType ? m_indexType : arrow::uint64()));
+        auto schema = arrow::schema(fields);
+
+        arrow::RecordBatchVector batches;
+        batches.reserve(chunks.size());
+        for (auto const &chunk: chunks) {
+            batches.emplace_back(pd::concatenateArraysToRecordBatch(chunk.data, chunk.index, indexName));
+        }
+
+        auto table = pd::ReturnOrThrowOnFailure(arrow::Table::FromRecordBatches(schema, batches));
+        return table->Slice(table->num_rows() - num_rows());
+    }
+
+    DataFrame StreamingFrame::snapshot() {
+        PD_TRACE_SCOPE("StreamingFrame::snapshot");
+        auto chunks = retainedChunks();
+        const auto indexType = m_indexType ? m_indexType : arrow::uint64();
+        if (chunks.empty()) {
+            return DataFrame{pd::ReturnOrThrowOnFailure(arrow::RecordBatch::MakeEmpty(m_schema)),
+                             pd::ReturnOrThrowOnFailure(arrow::MakeEmptyArray(indexType, pd::GetMemoryPool()))};
+        }
+
+        // DataFrame holds a single RecordBatch, so several chunks are combined here
+        std::shared_ptr<arrow::RecordBatch> batch;
+        ArrayPtr index;
+        if (chunks.size() == 1) {
+            batch = chunks.front().data;
+            index = chunks.front().index;
+        } else {
+            auto *pool = pd::GetMemoryPool();
+            arrow::ArrayVector columns(m_schema->num_fields());
+            arrow::ArrayVector pieces(chunks.size());
+            for (int i = 0; i < m_schema->num_fields(); i++) {
+                std::ranges::transform(chunks, pieces.begin(), [i](Chunk const &chunk) { return chunk.data->column(i); });
+                columns[i] = pd::ReturnOrThrowOnFailure(arrow::Concatenate(pieces, pool));
+            }
+            std::ranges::transform(chunks, pieces.begin(), [](Chunk const &chunk) { return chunk.index; });
+            index = pd::ReturnOrThrowOnFailure(arrow::Concatenate(pieces, pool));
+            batch = arrow::RecordBatch::Make(m_schema, index->length(), columns);
+        }
+
+        const int64_t offset = batch->num_rows() - num_rows();
+        return DataFrame{batch->Slice(offset), index->Slice(offset)};
+    }
+}
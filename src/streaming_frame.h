@@ -0,0 +1,89 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <deque>
+#include <optional>
+#include "dataframe.h"
+
+
+namespace pd {
+
+    /// Append-only frame with a fixed schema for live data.
+    /// Rows are appended into per-column builders that are sealed into immutable
+    /// chunks every `chunkSize` rows, so appends are amortized O(1).
+    /// With a capacity only the most recent `capacity` rows are kept. Whole chunks are
+    /// evicted after every append once the rows behind them fill the capacity, so fewer than
+    /// capacity + chunkSize rows stay resident; batches are kept as their own chunks and ones
+    /// longer than the capacity are sliced to their last `capacity` rows, so up to
+    /// 2 * capacity rows can be resident while such a chunk is at the front.
+    class StreamingFrame {
+    public:
+        /// a null indexType keeps a uint64 position index, like DataFrame's default index
+        explicit StreamingFrame(std::shared_ptr<arrow::Schema> schema,
+                                std::shared_ptr<arrow::DataType> indexType = arrow::timestamp(arrow::TimeUnit::NANO),
+                                int64_t chunkSize = 4096,
+                                std::optional<int64_t> capacity = std::nullopt);
+
+        void append_row(Scalar const &index, std::vector<Scalar> const &values);
+
+        void append_row(std::vector<Scalar> const &values);
+
+        template<class IndexT, class... Ts>
+        void append(IndexT const &index, Ts const &... values) {
+            append_row(Scalar(index), std::vector<Scalar>{Scalar(values)...});
+        }
+
+        /// batches with the frame's schema are kept as sealed chunks without copying
+        void append_batch(DataFrame const &df);
+
+        /// sealed chunks are shared and the tail is copied, the returned table stays
+        /// valid while more rows are appended
+        [[nodiscard]] std::shared_ptr<arrow::Table> toTable(std::string const &indexName = "index");
+
+        [[nodiscard]] DataFrame snapshot();
+
+        [[nodiscard]] int64_t num_rows() const;
+
+        [[nodiscard]] int64_t total_rows() const { return m_totalRows; }
+
+        /// rows held in chunks and builders, including ones past the capacity not evicted yet
+        [[nodiscard]] int64_t resident_rows() const { return m_sealedRows + m_tailRows; }
+
+        [[nodiscard]] int64_t num_chunks() const { return static_cast<int64_t>(m_chunks.size()); }
+
+        [[nodiscard]] std::optional<int64_t> capacity() const { return m_capacity; }
+
+        [[nodiscard]] std::shared_ptr<arrow::Schema> schema() const { return m_schema; }
+
+    private:
+        struct Chunk {
+            std::shared_ptr<arrow::RecordBatch> data;
+            ArrayPtr index;
+        };
+
+        std::shared_ptr<arrow::Schema> m_schema;
+        std::shared_ptr<arrow::DataType> m_indexType;
+        int64_t m_chunkSize;
+        std::optional<int64_t> m_capacity;
+
+        std::vector<std::unique_ptr<arrow::ArrayBuilder>> m_builders;
+        std::unique_ptr<arrow::ArrayBuilder> m_indexBuilder;
+        int64_t m_tailRows{0};
+
+        std::deque<Chunk> m_chunks;
+        int64_t m_sealedRows{0};
+        int64_t m_totalRows{0};
+
+        void appendValues(std::vector<Scalar> const &values);
+
+        void seal();
+
+        void evict();
+
+        Chunk copyTail();
+
+        std::vector<Chunk> retainedChunks();
+    };
+}
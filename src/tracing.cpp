@@ -0,0 +1,276 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "tracing.h"
+#include <arrow/io/file.h>
+#include <arrow/util/byte_size.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <map>
+#include <mutex>
+#include <thread>
+
+
+namespace pd::tracing {
+
+    namespace {
+        std::atomic<bool> &enabledFlag() {
+            static std::atomic<bool> flag = [] {
+                const char *env = std::getenv("PANDAS_ARROW_TRACE");
+                return env != nullptr && std::string_view{env} != "0" && std::string_view{env} != "";
+            }();
+            return flag;
+        }
+
+        std::string escape(std::string_view s) {
+            std::string out;
+            out.reserve(s.size());
+            for (char c: s) {
+                switch (c) {
+                    case '"':
+                        out += "\\\"";
+                        break;
+                    case '\\':
+                        out += "\\\\";
+                        break;
+                    case '\n':
+                        out += "\\n";
+                        break;
+                    default:
+                        out += c;
+                }
+            }
+            return out;
+        }
+
+        arrow::Status writeFile(std::filesystem::path const &path, std::string const &content) {
+            ARROW_ASSIGN_OR_RAISE(auto file, arrow::io::FileOutputStream::Open(path.string()));
+            ARROW_RETURN_NOT_OK(file->Write(content.data(), static_cast<int64_t>(content.size())));
+            return file->Close();
+        }
+    }
+
+    void enable(bool on) {
+        enabledFlag().store(on, std::memory_order_relaxed);
+    }
+
+    bool enabled() {
+        return enabledFlag().load(std::memory_order_relaxed);
+    }
+
+    //<editor-fold desc="FunctionStats">
+    void FunctionStats::add(TraceEvent const &event) {
+        count++;
+        total_ns += event.duration_ns;
+        min_ns = std::min(min_ns, event.duration_ns);
+        max_ns = std::max(max_ns, event.duration_ns);
+        input_rows += event.input_rows;
+        input_bytes += event.input_bytes;
+        output_bytes += event.output_bytes;
+
+        auto bucket = event.duration_ns > 0 ? std::bit_width(static_cast<uint64_t>(event.duration_ns)) - 1 : 0;
+        histogram[std::min<size_t>(bucket, NUM_BUCKETS - 1)]++;
+    }
+
+    int64_t FunctionStats::percentile(double p) const {
+        if (count == 0) {
+            return 0;
+        }
+        const auto target = static_cast<int64_t>(std::ceil(p / 100.0 * static_cast<double>(count)));
+        int64_t seen = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            seen += histogram[i];
+            if (seen >= std::max<int64_t>(target, 1)) {
+                return std::clamp<int64_t>(int64_t{1} << (i + 1), min_ns, max_ns);
+            }
+        }
+        return max_ns;
+    }
+    //</editor-fold>
+
+    //<editor-fold desc="Registry">
+    struct Registry::Impl {
+        mutable std::mutex mutex;
+        std::map<std::string, FunctionStats> stats;
+        std::vector<TraceEvent> events;
+        size_t maxEvents{1'000'000};
+        std::chrono::steady_clock::time_point origin{std::chrono::steady_clock::now()};
+    };
+
+    Registry::Registry() : m_impl(std::make_unique<Impl>()) {}
+
+    Registry &Registry::Instance() {
+        static Registry instance;
+        return instance;
+    }
+
+    int64_t Registry::nowNs() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_impl->origin).count();
+    }
+
+    void Registry::record(TraceEvent &&event) {
+        std::scoped_lock lock(m_impl->mutex);
+        auto &entry = m_impl->stats[event.name];
+        if (entry.name.empty()) {
+            entry.name = event.name;
+        }
+        entry.add(event);
+        if (m_impl->events.size() < m_impl->maxEvents) {
+            m_impl->events.emplace_back(std::move(event));
+        }
+    }
+
+    std::vector<FunctionStats> Registry::stats() const {
+        std::vector<FunctionStats> result;
+        {
+            std::scoped_lock lock(m_impl->mutex);
+            result.reserve(m_impl->stats.size());
+            for (auto const &[_, entry]: m_impl->stats) {
+                result.push_back(entry);
+            }
+        }
+        std::ranges::sort(result, std::greater{}, &FunctionStats::total_ns);
+        return result;
+    }
+
+    std::vector<TraceEvent> Registry::events() const {
+        std::scoped_lock lock(m_impl->mutex);
+        return m_impl->events;
+    }
+
+    void Registry::reset() {
+        std::scoped_lock lock(m_impl->mutex);
+        m_impl->stats.clear();
+        m_impl->events.clear();
+    }
+
+    void Registry::setMaxEvents(size_t maxEvents) {
+        std::scoped_lock lock(m_impl->mutex);
+        m_impl->maxEvents = maxEvents;
+    }
+
+    std::string Registry::toJSON() const {
+        std::string out = "{\"functions\":[";
+        bool first = true;
+        for (auto const &entry: stats()) {
+            out += fmt::format(
+                    R"({}{{"name":"{}","count":{},"total_ns":{},"mean_ns":{},"min_ns":{},"max_ns":{},)"
+                    R"("p50_ns":{},"p99_ns":{},"input_rows":{},"input_bytes":{},"output_bytes":{},"histogram_log2_ns":[{}]}})",
+                    first ? "" : ",",
+                    escape(entry.name),
+                    entry.count,
+                    entry.total_ns,
+                    entry.count ? entry.total_ns / entry.count : 0,
+                    entry.count ? entry.min_ns : 0,
+                    entry.max_ns,
+                    entry.percentile(50),
+                    entry.percentile(99),
+                    entry.input_rows,
+                    entry.input_bytes,
+                    entry.output_bytes,
+                    fmt::join(entry.histogram, ","));
+            first = false;
+        }
+        out += "]}";
+        return out;
+    }
+
+    std::string Registry::toChromeTrace() const {
+        std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (auto const &event: events()) {
+            out += fmt::format(
+                    R"({}{{"name":"{}","cat":"pandas_arrow","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},)"
+                    R"("args":{{"input_rows":{},"input_bytes":{},"output_rows":{},"output_bytes":{}}}}})",
+                    first ? "" : ",",
+                    escape(event.name),
+                    event.thread_id,
+                    static_cast<double>(event.start_ns) / 1e3,
+                    static_cast<double>(event.duration_ns) / 1e3,
+                    event.input_rows,
+                    event.input_bytes,
+                    event.output_rows,
+                    event.output_bytes);
+            first = false;
+        }
+        out += "]}";
+        return out;
+    }
+
+    arrow::Status Registry::dumpJSON(std::filesystem::path const &path) const {
+        return writeFile(path, toJSON());
+    }
+
+    arrow::Status Registry::dumpChromeTrace(std::filesystem::path const &path) const {
+        return writeFile(path, toChromeTrace());
+    }
+    //</editor-fold>
+
+    //<editor-fold desc="Span">
+    int64_t datumRows(arrow::Datum const &datum) {
+        switch (datum.kind()) {
+            case arrow::Datum::SCALAR:
+                return 1;
+            case arrow::Datum::ARRAY:
+            case arrow::Datum::CHUNKED_ARRAY:
+            case arrow::Datum::RECORD_BATCH:
+            case arrow::Datum::TABLE:
+                return datum.length();
+            default:
+                return 0;
+        }
+    }
+
+    int64_t datumBytes(arrow::Datum const &datum) {
+        switch (datum.kind()) {
+            case arrow::Datum::ARRAY:
+                return arrow::util::TotalBufferSize(*datum.array());
+            case arrow::Datum::CHUNKED_ARRAY:
+                return arrow::util::TotalBufferSize(*datum.chunked_array());
+            case arrow::Datum::RECORD_BATCH:
+                return arrow::util::TotalBufferSize(*datum.record_batch());
+            case arrow::Datum::TABLE:
+                return arrow::util::TotalBufferSize(*datum.table());
+            default:
+                return 0;
+        }
+    }
+
+    Span::Span(std::string_view name) : m_active(enabled()) {
+        if (m_active) {
+            m_event.name = name;
+            m_event.thread_id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+            m_event.start_ns = Registry::Instance().nowNs();
+        }
+    }
+
+    Span::Span(std::string_view name, std::vector<arrow::Datum> const &inputs) : Span(name) {
+        if (m_active) {
+            for (auto const &input: inputs) {
+                m_event.input_rows = std::max(m_event.input_rows, datumRows(input));
+                m_event.input_bytes += datumBytes(input);
+            }
+        }
+    }
+
+    void Span::setOutput(arrow::Datum const &output) {
+        if (m_active) {
+            m_event.output_rows = datumRows(output);
+            m_event.output_bytes = datumBytes(output);
+        }
+    }
+
+    Span::~Span() {
+        if (m_active) {
+            auto &registry = Registry::Instance();
+            m_event.duration_ns = registry.nowNs() - m_event.start_ns;
+            registry.record(std::move(m_event));
+        }
+    }
+    //</editor-fold>
+}
@@ -0,0 +1,123 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/datum.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace pd::tracing {
+
+    /// Tracing is off by default; it can be switched on with enable() or by setting
+    /// PANDAS_ARROW_TRACE=1 in the environment before the first traced call.
+    void enable(bool on = true);
+
+    bool enabled();
+
+    struct TraceEvent {
+        std::string name;
+        int64_t start_ns{0}; // since the registry was created
+        int64_t duration_ns{0};
+        uint64_t thread_id{0};
+        int64_t input_rows{0};
+        int64_t input_bytes{0};
+        int64_t output_rows{0};
+        int64_t output_bytes{0};
+    };
+
+    struct FunctionStats {
+        static constexpr size_t NUM_BUCKETS = 40;
+
+        std::string name;
+        int64_t count{0};
+        int64_t total_ns{0};
+        int64_t min_ns{std::numeric_limits<int64_t>::max()};
+        int64_t max_ns{0};
+        int64_t input_rows{0};
+        int64_t input_bytes{0};
+        int64_t output_bytes{0};
+        /// bucket i counts calls with duration in [2^i, 2^(i+1)) ns
+        std::array<int64_t, NUM_BUCKETS> histogram{};
+
+        void add(TraceEvent const &event);
+
+        /// approximate percentile (0-100) from the log2 histogram, in ns
+        [[nodiscard]] int64_t percentile(double p) const;
+    };
+
+    /// Process wide store of per-function histograms and the raw event timeline.
+    class Registry {
+    public:
+        static Registry &Instance();
+
+        void record(TraceEvent &&event);
+
+        /// per-function stats, slowest total time first
+        [[nodiscard]] std::vector<FunctionStats> stats() const;
+
+        [[nodiscard]] std::vector<TraceEvent> events() const;
+
+        [[nodiscard]] std::string toJSON() const;
+
+        /// chrome://tracing / Perfetto "Trace Event Format"
+        [[nodiscard]] std::string toChromeTrace() const;
+
+        arrow::Status dumpJSON(std::filesystem::path const &path) const;
+
+        arrow::Status dumpChromeTrace(std::filesystem::path const &path) const;
+
+        void reset();
+
+        /// bounds the event timeline, histograms keep accumulating once it is full
+        void setMaxEvents(size_t maxEvents);
+
+        [[nodiscard]] int64_t nowNs() const;
+
+    private:
+        Registry();
+
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+
+    int64_t datumRows(arrow::Datum const &datum);
+
+    int64_t datumBytes(arrow::Datum const &datum);
+
+    /// RAII timer recording one TraceEvent when tracing is enabled.
+    class Span {
+    public:
+        explicit Span(std::string_view name);
+
+        Span(std::string_view name, std::vector<arrow::Datum> const &inputs);
+
+        Span(Span const &) = delete;
+
+        Span &operator=(Span const &) = delete;
+
+        ~Span();
+
+        void setOutput(arrow::Datum const &output);
+
+        void setInputRows(int64_t rows) {
+            if (m_active) m_event.input_rows = rows;
+        }
+
+    private:
+        bool m_active;
+        TraceEvent m_event;
+    };
+}
+
+#define PD_TRACE_CONCAT_IMPL(a, b) a##b
+#define PD_TRACE_CONCAT(a, b) PD_TRACE_CONCAT_IMPL(a, b)
+#define PD_TRACE_SCOPE(name) pd::tracing::Span PD_TRACE_CONCAT(pd_trace_span_, __LINE__)(name)
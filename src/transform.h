@@ -0,0 +1,169 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/util/bitmap_generate.h>
+#include <arrow/util/bitmap_ops.h>
+#include <type_traits>
+#include "core.h"
+#include "exec_context.h"
+#include "scheduler.h"
+#include "visit.h"
+
+
+namespace pd {
+
+    struct TransformOptions {
+        /// rows per task, rounded up to a multiple of 64 so that no two tasks write to one bitmap byte
+        int64_t morselSize{1 << 16};
+        /// morsels run concurrently, fn must be safe to call from several threads. Loops also run
+        /// serially when the active ExecContext has use_threads off.
+        bool parallel{true};
+        /// fn is not called on null slots, they hold a value-initialized Out. Off by default since
+        /// the per row check keeps the loop from vectorizing.
+        bool skipNulls{false};
+        /// arrow type of the result, of the same width as Out; Out's own type when not set
+        std::shared_ptr<arrow::DataType> type{nullptr};
+    };
+
+    namespace detail {
+        template<class In, class Out, class F>
+        using TransformResult = std::conditional_t<std::is_void_v<Out>, std::invoke_result_t<F &, In>, Out>;
+
+        /// body(begin, end) over [0, length) one morsel at a time, morsels run in parallel when there are several
+        template<class Body>
+        void forEachMorsel(int64_t length, TransformOptions const &options, Body &&body) {
+            const int64_t morsel = std::max<int64_t>(64, (options.morselSize + 63) / 64 * 64);
+            const int64_t count = (length + morsel - 1) / morsel;
+            auto run = [&](int64_t i) {
+                body(i * morsel, std::min(length, (i + 1) * morsel));
+            };
+            if (options.parallel and count > 1) {
+                pd::parallel_for(int64_t{0}, count, pd::bindExecContext(run));
+            } else {
+                for (int64_t i = 0; i < count; i++) {
+                    run(i);
+                }
+            }
+        }
+
+        /// writes value(i) for rows [begin, end): a plain loop the compiler can vectorize, bits for bool
+        template<class Out, class Value>
+        void storeValues(uint8_t *values, int64_t begin, int64_t end, Value &&value) {
+            if constexpr (std::is_same_v<Out, bool>) {
+                int64_t i = begin;
+                arrow::internal::GenerateBitsUnrolled(values, begin, end - begin, [&] { return static_cast<bool>(value(i++)); });
+            } else {
+                auto *out = reinterpret_cast<Out *>(values);
+                for (int64_t i = begin; i < end; i++) {
+                    out[i] = static_cast<Out>(value(i));
+                }
+            }
+        }
+
+        inline std::shared_ptr<arrow::Buffer> copyValidity(arrow::ArrayData const &data) {
+            if (data.null_count == 0 or not data.buffers[0]) {
+                return nullptr;
+            }
+            if (data.offset == 0) {
+                return data.buffers[0];
+            }
+            return ReturnOrThrowOnFailure(
+                    arrow::internal::CopyBitmap(pd::GetMemoryPool(), data.buffers[0]->data(), data.offset, data.length));
+        }
+
+        inline std::shared_ptr<arrow::Buffer> andValidity(arrow::ArrayData const &lhs, arrow::ArrayData const &rhs) {
+            const bool lhsNulls = lhs.null_count != 0 and lhs.buffers[0];
+            const bool rhsNulls = rhs.null_count != 0 and rhs.buffers[0];
+            if (not(lhsNulls and rhsNulls)) {
+                return lhsNulls ? copyValidity(lhs) : copyValidity(rhs);
+            }
+            return ReturnOrThrowOnFailure(arrow::internal::BitmapAnd(
+                    pd::GetMemoryPool(), lhs.buffers[0]->data(), lhs.offset, rhs.buffers[0]->data(), rhs.offset,
+                    lhs.length, 0));
+        }
+
+        template<class Out>
+        std::shared_ptr<arrow::Array> makeTransformed(
+                TransformOptions const &options,
+                int64_t length,
+                std::shared_ptr<arrow::Buffer> values,
+                std::shared_ptr<arrow::Buffer> validity,
+                int64_t nullCount) {
+            auto type = options.type;
+            if (not type) {
+                type = std::is_same_v<Out, bool> ? arrow::boolean() : arrow::CTypeTraits<Out>::type_singleton();
+            } else if (arrow::bit_width(type->id()) != (std::is_same_v<Out, bool> ? 1 : int(sizeof(Out) * 8))) {
+                throw std::runtime_error("transform: " + type->ToString() + " does not have the width of the result");
+            }
+            return arrow::MakeArray(arrow::ArrayData::Make(type, length, {std::move(validity), std::move(values)},
+                                                           nullCount));
+        }
+
+        template<class Out>
+        std::shared_ptr<arrow::Buffer> allocateTransformed(int64_t length) {
+            if constexpr (std::is_same_v<Out, bool>) {
+                return ReturnOrThrowOnFailure(arrow::AllocateEmptyBitmap(length, pd::GetMemoryPool()));
+            } else {
+                return ReturnOrThrowOnFailure(arrow::AllocateBuffer(length * sizeof(Out), pd::GetMemoryPool()));
+            }
+        }
+    }
+
+    /// Element-wise fn over a fixed width column into a new one of type Out (fn's result type by default).
+    /// fn is inlined over the raw values, nulls are carried by copying the validity bitmap, so unless
+    /// options.skipNulls is set fn also runs on the slots under a null and must not trap on whatever
+    /// value they hold.
+    template<class In, class Out = void, class F>
+    std::shared_ptr<arrow::Array> transform(arrow::Array const &array, F &&fn, TransformOptions const &options = {}) {
+        using Result = detail::TransformResult<In, Out, F>;
+        detail::checkColumn<In>(array);
+
+        auto const &data = *array.data();
+        auto const *in = data.GetValues<In>(1);
+        auto values = detail::allocateTransformed<Result>(data.length);
+        auto *out = values->mutable_data();
+        if (options.skipNulls and data.null_count != 0 and data.buffers[0]) {
+            auto const *validity = data.buffers[0]->data();
+            detail::forEachMorsel(data.length, options, [&](int64_t begin, int64_t end) {
+                detail::storeValues<Result>(out, begin, end, [&](int64_t i) {
+                    return arrow::bit_util::GetBit(validity, data.offset + i) ? fn(in[i]) : Result{};
+                });
+            });
+        } else {
+            detail::forEachMorsel(data.length, options, [&](int64_t begin, int64_t end) {
+                detail::storeValues<Result>(out, begin, end, [&](int64_t i) { return fn(in[i]); });
+            });
+        }
+        return detail::makeTransformed<Result>(options, data.length, std::move(values), detail::copyValidity(data),
+                                               data.null_count);
+    }
+
+    /// Binary version over two columns of the same length, row i of one paired with row i of the other.
+    /// A row of the result is null when it is null on either side.
+    template<class Lhs, class Rhs = Lhs, class Out = void, class F>
+    std::shared_ptr<arrow::Array> transform2(arrow::Array const &lhs, arrow::Array const &rhs, F &&fn,
+                                             TransformOptions const &options = {}) {
+        using Result = std::conditional_t<std::is_void_v<Out>, std::invoke_result_t<F &, Lhs, Rhs>, Out>;
+        detail::checkColumn<Lhs>(lhs);
+        detail::checkColumn<Rhs>(rhs);
+        if (lhs.length() != rhs.length()) {
+            throw std::runtime_error("transform2: columns have different lengths");
+        }
+
+        auto const &left = *lhs.data();
+        auto const &right = *rhs.data();
+        auto const *a = left.GetValues<Lhs>(1);
+        auto const *b = right.GetValues<Rhs>(1);
+        auto values = detail::allocateTransformed<Result>(left.length);
+        auto *out = values->mutable_data();
+        detail::forEachMorsel(left.length, options, [&](int64_t begin, int64_t end) {
+            detail::storeValues<Result>(out, begin, end, [&](int64_t i) { return fn(a[i], b[i]); });
+        });
+
+        auto validity = detail::andValidity(left, right);
+        return detail::makeTransformed<Result>(options, left.length, std::move(values), validity,
+                                               validity ? arrow::kUnknownNullCount : 0);
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/util/bit_util.h>
+#include <array>
+#include <span>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <tuple>
+#include "exec_context.h"
+#include "scheduler.h"
+
+
+namespace pd {
+
+    /// Values of one column over a chunk of rows, with the validity bitmap when the column has nulls
+    template<class T>
+    struct ColumnView {
+        std::span<const T> values;
+        uint8_t const *validity{nullptr};
+        int64_t bitOffset{0};
+
+        [[nodiscard]] size_t size() const { return values.size(); }
+
+        [[nodiscard]] bool hasNulls() const { return validity != nullptr; }
+
+        [[nodiscard]] bool isValid(size_t i) const {
+            return validity == nullptr or arrow::bit_util::GetBit(validity, bitOffset + static_cast<int64_t>(i));
+        }
+
+        T operator[](size_t i) const { return values[i]; }
+
+        auto begin() const { return values.begin(); }
+
+        auto end() const { return values.end(); }
+    };
+
+    struct VisitOptions {
+        /// rows handed to the visitor per call, 0 sizes chunks to stay in L2
+        int64_t chunkSize{0};
+        /// splittable visitors are run with a parallel reduction unless this is false
+        bool parallel{true};
+    };
+
+    /// A visitor that can run on disjoint row ranges and merge the partial states:
+    /// Visitor(Visitor &, tbb::split) starts an empty state, join(rhs) folds in the rows after it.
+    template<class V>
+    concept SplittableVisitor = requires(V &v, tbb::split s) {
+        V(v, s);
+        v.join(v);
+    };
+
+    namespace detail {
+        template<class T>
+        ColumnView<T> columnView(arrow::ArrayData const &data, int64_t start, int64_t length) {
+            auto const *values = data.GetValues<T>(1) + start;
+            auto const *validity = data.null_count != 0 and data.buffers[0] ? data.buffers[0]->data() : nullptr;
+            return {{values, static_cast<size_t>(length)}, validity, data.offset + start};
+        }
+
+        template<class T>
+        void checkColumn(arrow::Array const &array) {
+            static_assert(std::is_arithmetic_v<T> and not std::is_same_v<T, bool>,
+                          "visit works on fixed width numeric columns");
+            auto expected = arrow::CTypeTraits<T>::type_singleton();
+            bool const matches = array.type_id() == expected->id() or
+                                 (std::is_same_v<T, int64_t> and arrow::is_temporal(array.type_id()) and
+                                  arrow::bit_width(array.type_id()) == 64);
+            if (not matches) {
+                throw std::runtime_error("visit: expected a column of type " + expected->ToString() + ", got " +
+                                         array.type()->ToString());
+            }
+        }
+
+        template<class... ColumnTypes, class Visitor, size_t N, size_t... I>
+        void visitChunks(Visitor &visitor,
+                         std::array<std::shared_ptr<arrow::ArrayData>, N> const &columns,
+                         int64_t begin, int64_t end, int64_t chunkSize,
+                         std::index_sequence<I...>) {
+            for (int64_t start = begin; start < end; start += chunkSize) {
+                auto length = std::min(chunkSize, end - start);
+                visitor(start, columnView<ColumnTypes>(*columns[I], start, length)...);
+            }
+        }
+
+        template<class Visitor, size_t N, class... ColumnTypes>
+        struct ReduceBody {
+            Visitor visitor;
+            std::array<std::shared_ptr<arrow::ArrayData>, N> const &columns;
+            int64_t chunkSize;
+            ExecContext context;
+
+            ReduceBody(Visitor v, std::array<std::shared_ptr<arrow::ArrayData>, N> const &columns, int64_t chunkSize)
+                    : visitor(std::move(v)), columns(columns), chunkSize(chunkSize), context(GetExecContext()) {}
+
+            ReduceBody(ReduceBody &other, tbb::split s)
+                    : visitor(other.visitor, s), columns(other.columns), chunkSize(other.chunkSize),
+                      context(other.context) {}
+
+            void operator()(tbb::blocked_range<int64_t> const &range) {
+                ScopedExecContext scope(context);
+                visitChunks<ColumnTypes...>(visitor, columns, range.begin(), range.end(), chunkSize,
+                                            std::make_index_sequence<N>{});
+            }
+
+            void join(ReduceBody &rhs) { visitor.join(rhs.visitor); }
+        };
+    }
+
+    /// Streams columns to visitor(int64_t firstRow, ColumnView<ColumnTypes>...) in row order,
+    /// one cache sized chunk per call. Splittable visitors are reduced over the chunks in parallel;
+    /// the split points do not depend on the thread count so floating point results are reproducible.
+    /// pre() and post() are called around the pass when the visitor has them.
+    template<class... ColumnTypes, class Visitor>
+    Visitor visitColumns(Visitor visitor,
+                         std::array<std::shared_ptr<arrow::Array>, sizeof...(ColumnTypes)> const &arrays,
+                         VisitOptions const &options = {}) {
+        constexpr size_t N = sizeof...(ColumnTypes);
+        static_assert(N > 0, "visit needs at least one column");
+
+        std::array<std::shared_ptr<arrow::ArrayData>, N> columns;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (detail::checkColumn<ColumnTypes>(*arrays[I]), ...);
+        }(std::make_index_sequence<N>{});
+
+        const int64_t length = arrays[0]->length();
+        for (size_t i = 0; i < N; i++) {
+            if (arrays[i]->length() != length) {
+                throw std::runtime_error("visit: columns have different lengths");
+            }
+            columns[i] = arrays[i]->data();
+        }
+
+        constexpr int64_t rowBytes = (static_cast<int64_t>(sizeof(ColumnTypes)) + ...);
+        const int64_t chunkSize = options.chunkSize > 0 ? options.chunkSize : std::max<int64_t>(1024, (256 << 10) / rowBytes);
+
+        if constexpr (requires { visitor.pre(); }) {
+            visitor.pre();
+        }
+        if constexpr (SplittableVisitor<Visitor>) {
+            if (options.parallel and length > chunkSize) {
+                detail::ReduceBody<Visitor, N, ColumnTypes...> body(std::move(visitor), columns, chunkSize);
+                // the split does not depend on the thread count, so results match in every parallelism setting
+                pd::inArena([&] {
+                    tbb::parallel_deterministic_reduce(tbb::blocked_range<int64_t>(0, length, chunkSize), body);
+                });
+                visitor = std::move(body.visitor);
+            } else {
+                detail::visitChunks<ColumnTypes...>(visitor, columns, 0, length, chunkSize, std::make_index_sequence<N>{});
+            }
+        } else {
+            detail::visitChunks<ColumnTypes...>(visitor, columns, 0, length, chunkSize, std::make_index_sequence<N>{});
+        }
+        if constexpr (requires { visitor.post(); }) {
+            visitor.post();
+        }
+        return visitor;
+    }
+}
@@ -0,0 +1,102 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "argminmax.h"
+#include "pandas_arrow.h"
+
+
+TEST_CASE("argmin / argmax take the first extremum in one pass", "[argminmax]")
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    pd::Series ints(std::vector<int32_t>{ 3, 1, 7, 1, 7, 2 });
+    REQUIRE(ints.argmin() == 1);
+    REQUIRE(ints.argmax() == 2);
+
+    pd::Series withNaN(std::vector<double>{ nan, 2.0, -1.0, nan, 5.0, 5.0 });
+    REQUIRE(withNaN.argmin() == 2);
+    REQUIRE(withNaN.argmax() == 4);
+    REQUIRE(withNaN.argmax(false) == -1);
+
+    auto nulls = arrow::ArrayT<double>::Make({ 9.0, 1.0, 4.0 }, { false, true, true });
+    REQUIRE(pd::argmax(*nulls) == 2);
+    REQUIRE(pd::argmax(*nulls, false) == -1);
+    REQUIRE(pd::argmin(*arrow::ArrayT<double>::Make({ nan, nan })) == -1);
+
+    auto when = pd::date_range(date(2024, Jan, 1), 10);
+    REQUIRE(pd::argmax(*when) == 9);
+
+    // types without a native kernel fall back to the min / max aggregate
+    pd::Series names(std::vector<std::string>{ "b", "c", "a" });
+    REQUIRE(names.argmin() == 2);
+    REQUIRE(names.argmax() == 1);
+
+    REQUIRE(withNaN.idxMax().as<uint64_t>() == 4);
+    REQUIRE_FALSE(pd::Series(std::vector<double>{ nan }).idxMin().isValid());
+}
+
+TEST_CASE("argmin / argmax are parallel over long columns", "[argminmax]")
+{
+    const int64_t n = 1 << 22;
+    arrow::Int64Builder builder;
+    REQUIRE(builder.Reserve(n).ok());
+    for (int64_t i = 0; i < n; i++) {
+        builder.UnsafeAppend((i * 7919) % 100003);
+    }
+    auto values = builder.Finish().MoveValueUnsafe();
+
+    // both extremes repeat in many chunks, the first occurrence is reported
+    REQUIRE(pd::argmin(*values) == 0);
+    auto const *raw = std::static_pointer_cast<arrow::Int64Array>(values)->raw_values();
+    REQUIRE(pd::argmax(*values) == std::distance(raw, std::max_element(raw, raw + n)));
+
+    auto sliced = values->Slice(1);
+    REQUIRE(pd::argmin(*sliced) == 100003 - 1);
+}
+
+TEST_CASE("DataFrame idxMax along either axis", "[argminmax]")
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    pd::DataFrame prices(std::map<std::string, std::vector<double>>{
+        { "aapl", { 1, 5, nan, 2 } },
+        { "msft", { 3, 5, nan, 1 } },
+        { "goog", { 2, 6, nan, 2 } } });
+
+    auto perColumn = prices.idxMax();
+    REQUIRE(perColumn.at("aapl").as<uint64_t>() == 1);
+    REQUIRE(perColumn.at("msft").as<uint64_t>() == 1);
+    REQUIRE(perColumn.at("goog").as<uint64_t>() == 1);
+    REQUIRE(prices.argmin(pd::AxisType::Index).equals(std::vector<int64_t>{ 0, 0, 3 }));
+
+    auto leader = prices.idxMax(pd::AxisType::Columns);
+    REQUIRE(leader.size() == 4);
+    REQUIRE(leader[0].as<std::string>() == "msft");
+    REQUIRE(leader[1].as<std::string>() == "goog");
+    REQUIRE_FALSE(leader[2].isValid());
+
+    auto positions = prices.argmax(pd::AxisType::Columns);
+    REQUIRE(positions.array()->null_count() == 1);
+    // ties go to the leftmost column
+    REQUIRE(prices.columnNames() == std::vector<std::string>{ "aapl", "goog", "msft" });
+    REQUIRE(positions[3].as<int64_t>() == 0);
+}
+
+TEST_CASE("row-wise argmax keeps integer precision", "[argminmax]")
+{
+    // distinct above 2^53, equal once cast to double
+    const int64_t big = (int64_t{ 1 } << 53) + 1;
+    auto a = arrow::ArrayT<int64_t>::Make({ big - 1, 1 });
+    auto b = arrow::ArrayT<int64_t>::Make({ big, 2 });
+    REQUIRE(pd::argmaxRows({ a, b })->Equals(*arrow::ArrayT<int64_t>::Make({ 1, 1 })));
+    REQUIRE(pd::argminRows({ b, a })->Equals(*arrow::ArrayT<int64_t>::Make({ 1, 1 })));
+
+    // mixed integer widths are compared as int64
+    auto narrow = arrow::ArrayT<int32_t>::Make({ 0, 3 });
+    REQUIRE(pd::argmaxRows({ narrow, b })->Equals(*arrow::ArrayT<int64_t>::Make({ 1, 0 })));
+
+    // next to a float column they would lose precision, which is refused
+    auto floats = arrow::ArrayT<double>::Make({ 0.5, 0.5 });
+    REQUIRE_THROWS(pd::argmaxRows({ floats, b }));
+    REQUIRE(pd::argmaxRows({ floats, narrow })->Equals(*arrow::ArrayT<int64_t>::Make({ 0, 1 })));
+}
@@ -2,31 +2,351 @@
 // Created by dewe on 1/18/23.
 //
 
+#include <benchmark/benchmark.h>
+#include <filesystem>
 #include "pandas_arrow.h"
 
+// Google Benchmark suite for the hot paths of the library.
+// Results can be exported with
+//   pandas_arrow_bench --benchmark_out=results.json --benchmark_out_format=json
+// and two runs compared with tests/compare_benchmarks.py.
+// PANDAS_ARROW_BENCH_MAX_ROWS caps the largest size (default 100M rows).
 
-int main()
+namespace {
+
+using namespace std::string_literals;
+
+constexpr int64_t kMinRows = 1'000;
+constexpr int64_t kDefaultMaxRows = 100'000'000;
+constexpr int kNumColumns = 8;
+constexpr int kNumGroups = 100;
+
+int64_t maxRows()
+{
+    static const int64_t value = []
+    {
+        const char* env = std::getenv("PANDAS_ARROW_BENCH_MAX_ROWS");
+        return env ? std::stoll(env) : kDefaultMaxRows;
+    }();
+    return value;
+}
+
+void RowSizes(benchmark::internal::Benchmark* b)
 {
-    using namespace std::string_literals;
-    using namespace pd;
+    b->RangeMultiplier(10)->Range(kMinRows, maxRows())->Unit(benchmark::kMillisecond);
+}
+
+void RowSizesUpTo(benchmark::internal::Benchmark* b, int64_t limit)
+{
+    b->RangeMultiplier(10)->Range(kMinRows, std::min(limit, maxRows()))->Unit(benchmark::kMillisecond);
+}
+
+// the frame of the size being benchmarked is cached across the cases of that size and replaced
+// when another size is requested, so at most one generated frame is alive at a time. The
+// generator is seeded, every case still runs on identical data. The reference stays valid
+// until numericFrame is called with a different size.
+pd::DataFrame const& numericFrame(int64_t rows)
+{
+    static std::optional<std::pair<int64_t, pd::DataFrame>> cache;
+    static std::mutex mutex;
+
+    std::scoped_lock lock(mutex);
+    if (cache and cache->first == rows)
+    {
+        return cache->second;
+    }
+    // release the previous frame before generating the next one
+    cache.reset();
+
+    pd::random::RandomState random(1);
+    pd::TableLike<double> data;
+    for (int i = 0; i < kNumColumns; i++)
+    {
+        data["c"s + std::to_string(i)] = random.randn(rows);
+    }
+
+    auto index = pd::date_range(ptime(date(2000, 1, 1)), static_cast<int>(rows), time_duration(0, 0, 1));
+    auto df = pd::DataFrame(data, index);
+
+    auto keys = random.randint(rows, 0, kNumGroups);
+    df.add_column("key", arrow::ArrayT<int64_t>::Make(keys));
 
-    TableLike<int64_t> data;
+    return cache.emplace(rows, std::move(df)).second;
+}
 
-    auto random = pd::random::RandomState(1);
-    for (int i = 0; i < 400; i++)
+std::vector<std::string> valueColumns()
+{
+    std::vector<std::string> columns(kNumColumns);
+    for (int i = 0; i < kNumColumns; i++)
     {
-        data[std::to_string(i)] = random.randint(1e6, 10, 20);
+        columns[i] = "c"s + std::to_string(i);
     }
+    return columns;
+}
 
-    auto df = pd::DataFrame(data, range(0l, 1e6l));
+std::filesystem::path scratchFile(std::string const& name)
+{
+    return std::filesystem::temp_directory_path() / ("pandas_arrow_bench_"s + name);
+}
 
-    auto start = std::chrono::high_resolution_clock::now();
+void setRowCounters(benchmark::State& state, int64_t rows)
+{
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.counters["rows"] = static_cast<double>(rows);
+}
 
-    auto result = (((df + df) * df) / df).sum();
+} // namespace
 
-    auto end = std::chrono::high_resolution_clock::now();
+//<editor-fold desc="Arithmetic">
+static void BM_Arithmetic(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0))[valueColumns()];
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize((((df + df) * df) / df).sum());
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_Arithmetic)->Apply(RowSizes);
+//</editor-fold>
 
-    std::cout << "elapsed time(s): " << std::chrono::duration<double>(end - start).count() << " s.\n";
+//<editor-fold desc="GroupBy">
+static void BM_GroupBySum(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    auto columns = valueColumns();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::ReturnOrThrowOnFailure(df.group_by("key"s).sum(columns)));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_GroupBySum)->Apply(RowSizes);
+
+static void BM_GroupByMean(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    auto columns = valueColumns();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::ReturnOrThrowOnFailure(df.group_by("key"s).mean(columns)));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_GroupByMean)->Apply(RowSizes);
+
+static void BM_GroupByStdDev(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    auto columns = valueColumns();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::ReturnOrThrowOnFailure(df.group_by("key"s).stddev(columns)));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_GroupByStdDev)->Apply(RowSizes);
+//</editor-fold>
+
+//<editor-fold desc="Resample / Rolling">
+static void BM_ResampleMean(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0))[valueColumns()];
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::ReturnOrThrowOnFailure(df.resample("1T").mean()));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ResampleMean)->Apply(RowSizes);
+
+static void BM_RollingMean(benchmark::State& state)
+{
+    auto series = numericFrame(state.range(0))["c0"];
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(series.rolling<double>([](pd::Series const& window)
+                                                        { return window.mean().as<double>(); },
+                                                        state.range(1)));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_RollingMean)->Apply([](benchmark::internal::Benchmark* b)
+                                 {
+                                     for (int64_t rows = kMinRows; rows <= std::min(10'000'000L, maxRows()); rows *= 10)
+                                     {
+                                         b->Args({ rows, 10 })->Args({ rows, 100 });
+                                     }
+                                     b->Unit(benchmark::kMillisecond);
+                                 });
+//</editor-fold>
+
+//<editor-fold desc="Reindex / Broadcast">
+static void BM_Reindex(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    // shift by half a second so that roughly every other label misses
+    auto newIndex = pd::date_range(ptime(date(2000, 1, 1)) + milliseconds(500),
+                                   static_cast<int>(state.range(0)),
+                                   milliseconds(500));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(df.reindex(newIndex));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_Reindex)->Apply(RowSizes);
+
+static void BM_ReindexAsync(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    auto newIndex = pd::date_range(ptime(date(2000, 1, 1)) + milliseconds(500),
+                                   static_cast<int>(state.range(0)),
+                                   milliseconds(500));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(df.reindexAsync(newIndex));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ReindexAsync)->Apply(RowSizes);
+
+static void BM_Broadcast(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    auto lhs = df["c0"];
+    auto rhs = pd::Series(df["c1"].m_array,
+                          pd::date_range(ptime(date(2000, 1, 1)) + milliseconds(500),
+                                         static_cast<int>(state.range(0)),
+                                         time_duration(0, 0, 1)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(lhs.broadcast(rhs));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_Broadcast)->Apply(RowSizes);
+//</editor-fold>
+
+//<editor-fold desc="Concat">
+static void BM_ConcatRows(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    std::vector<pd::DataFrame> objs{ df, df, df, df };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::concat(objs, pd::AxisType::Index, pd::JoinType::Outer, true));
+    }
+    setRowCounters(state, 4 * state.range(0));
+}
+BENCHMARK(BM_ConcatRows)->Apply(RowSizes);
+
+static void BM_ConcatColumns(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    std::vector<pd::DataFrame> objs;
+    for (auto const& column : valueColumns())
+    {
+        objs.emplace_back(df[std::vector{ column }]);
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::concat(objs, pd::AxisType::Columns));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ConcatColumns)->Apply(RowSizes);
+//</editor-fold>
+
+//<editor-fold desc="IO">
+static void BM_ToParquet(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    auto path = scratchFile("write.parquet");
+    for (auto _ : state)
+    {
+        pd::ThrowOnFailure(df.toParquet(path));
+    }
+    std::filesystem::remove(path);
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ToParquet)->Apply(RowSizes);
+
+static void BM_ReadParquet(benchmark::State& state)
+{
+    auto path = scratchFile("read.parquet");
+    pd::ThrowOnFailure(numericFrame(state.range(0)).toParquet(path));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::DataFrame::readParquet(path));
+    }
+    std::filesystem::remove(path);
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ReadParquet)->Apply(RowSizes);
+
+static void BM_ReadCSV(benchmark::State& state)
+{
+    auto path = scratchFile("read.csv");
+    pd::ThrowOnFailure(numericFrame(state.range(0)).toCSV(path));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pd::DataFrame::readCSV(path));
+    }
+    std::filesystem::remove(path);
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ReadCSV)->Apply([](benchmark::internal::Benchmark* b) { RowSizesUpTo(b, 10'000'000); });
+//</editor-fold>
+
+//<editor-fold desc="Sort">
+static void BM_SortValuesSingleKey(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(df.sort_values({ "c0" }));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_SortValuesSingleKey)->Apply(RowSizes);
+
+static void BM_SortValuesMultiKey(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(df.sort_values({ "key", "c0" }));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_SortValuesMultiKey)->Apply(RowSizes);
+//</editor-fold>
+
+//<editor-fold desc="Row Reductions">
+static void BM_ForAxisColumns(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0))[valueColumns()];
+    arrow::compute::ScalarAggregateOptions options;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(df.forAxis("sum", pd::AxisType::Columns, options));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ForAxisColumns)->Apply([](benchmark::internal::Benchmark* b) { RowSizesUpTo(b, 10'000'000); });
+
+static void BM_ForAxisIndex(benchmark::State& state)
+{
+    auto const& df = numericFrame(state.range(0))[valueColumns()];
+    arrow::compute::ScalarAggregateOptions options;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(df.forAxis("sum", pd::AxisType::Index, options));
+    }
+    setRowCounters(state, state.range(0));
+}
+BENCHMARK(BM_ForAxisIndex)->Apply(RowSizes);
+//</editor-fold>
 
-    return 0;
-}
\ No newline at end of file
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "calendar.h"
+#include "pandas_arrow.h"
+
+
+using namespace pd;
+
+
+TEST_CASE("civil date arithmetic matches boost", "[calendar]")
+{
+    for (auto day = date(1899, Dec, 25); day < date(2101, Jan, 7); day += days(17)) {
+        auto z = toDays(day);
+        REQUIRE(z * NANOS_PER_DAY == fromDate(day));
+        auto civil = civilFromDays(z);
+        REQUIRE(date(civil.year, civil.month, civil.day) == day);
+        REQUIRE(weekdayFromDays(z) == day.day_of_week().as_number());
+    }
+
+    // month ends stay month ends, other days are clamped
+    REQUIRE(addMonths({ 2024, 1, 31 }, 1) == toDays(date(2024, Feb, 29)));
+    REQUIRE(addMonths({ 2024, 1, 30 }, 1) == toDays(date(2024, Feb, 29)));
+    REQUIRE(addMonths({ 2024, 2, 29 }, 1) == toDays(date(2024, Mar, 31)));
+    REQUIRE(addMonths({ 2024, 1, 15 }, -13) == toDays(date(2022, Dec, 15)));
+}
+
+TEST_CASE("calendar ranges agree with the boost iterators", "[calendar]")
+{
+    auto start = date(2023, Jan, 31);
+    auto monthly = date_range(start, 30, "MS");
+    auto it = month_iterator(start, 1);
+    for (int64_t i = 0; i < monthly->length(); i++, ++it) {
+        REQUIRE(monthly->Value(i) == fromDate(*it));
+    }
+
+    auto yearly = date_range(date(2020, Feb, 29), date(2030, Mar, 1), "YS");
+    REQUIRE(yearly->length() == 11);
+    REQUIRE(yearly->Value(1) == fromDate(date(2021, Feb, 28)));
+
+    auto weekly = date_range(date(2024, Jan, 1), date(2024, Mar, 31), "2WS", "UTC");
+    REQUIRE(weekly->length() == 7);
+    REQUIRE(std::static_pointer_cast<arrow::TimestampType>(weekly->type())->timezone() == "UTC");
+
+    // the period overloads keep the time zone
+    auto minutes = date_range(ptime(date(2024, Jan, 2), hours(9)), 10, "1min", "America/New_York");
+    REQUIRE(std::static_pointer_cast<arrow::TimestampType>(minutes->type())->timezone() == "America/New_York");
+
+    // long grids are filled in parallel, a low threshold exercises that on a small one
+    auto ctx = pd::GetExecContext();
+    ctx.serial_threshold = 1 << 10;
+    ctx.morsel_size = 1 << 8;
+    pd::ScopedExecContext scope(ctx);
+    auto grid = date_range(ptime(date(2020, Jan, 1)), ptime(date(2020, Jan, 3)), time_duration(0, 0, 1));
+    REQUIRE(grid->length() == 2 * 86400 + 1);
+    REQUIRE(grid->Value(grid->length() - 1) == fromDate(date(2020, Jan, 3)));
+    REQUIRE(grid->Value(123456) == fromPTime(ptime(date(2020, Jan, 1)) + seconds(123456)));
+}
+
+TEST_CASE("BusinessCalendar produces trading session grids", "[calendar]")
+{
+    BusinessCalendar calendar({ date(2024, Jan, 1), date(2024, Jan, 15) });
+
+    REQUIRE_FALSE(calendar.isSession(date(2024, Jan, 1)));
+    REQUIRE_FALSE(calendar.isSession(date(2024, Jan, 6)));
+    REQUIRE(calendar.rollForward(date(2024, Jan, 13)) == date(2024, Jan, 16));
+    REQUIRE(calendar.add(date(2024, Jan, 12), 1) == date(2024, Jan, 16));
+    REQUIRE(calendar.add(date(2024, Jan, 16), -1) == date(2024, Jan, 12));
+
+    auto sessions = calendar.sessions(date(2024, Jan, 1), date(2024, Jan, 31));
+    REQUIRE(sessions->length() == 21);
+    REQUIRE(sessions->Value(0) == fromDate(date(2024, Jan, 2)));
+
+    auto bars = calendar.sessionGrid(date(2024, Jan, 1), date(2024, Jan, 5), hours(9) + minutes(30), hours(16), minutes(1));
+    REQUIRE(bars->length() == 4 * 390);
+    REQUIRE(bars->Value(0) == fromPTime(ptime(date(2024, Jan, 2), hours(9) + minutes(30))));
+    REQUIRE(bars->Value(390) == fromPTime(ptime(date(2024, Jan, 3), hours(9) + minutes(30))));
+    REQUIRE(bars->Value(389) == fromPTime(ptime(date(2024, Jan, 2), hours(15) + minutes(59))));
+
+    // "B" ranges use the weekday calendar
+    auto business = date_range(date(2024, Jan, 5), date(2024, Jan, 12), "B");
+    REQUIRE(business->length() == 6);
+    REQUIRE(business->Value(1) == fromDate(date(2024, Jan, 8)));
+    REQUIRE(date(2024, Jan, 5) + DateOffset{ DateOffset::BusinessDay, 1 } == date(2024, Jan, 8));
+}
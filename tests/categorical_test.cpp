@@ -0,0 +1,155 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+using namespace std::string_literals;
+
+
+static pd::DataFrame tradeFrame(std::vector<std::string> const &symbols, std::vector<double> const &prices)
+{
+    auto rb = arrow::RecordBatch::Make(
+        arrow::schema({ arrow::field("symbol", arrow::utf8()), arrow::field("price", arrow::float64()) }),
+        int64_t(symbols.size()),
+        { arrow::ArrayT<std::string>::Make(symbols), pd::Series(prices).array() });
+    return pd::DataFrame(rb).categorize({ "symbol" });
+}
+
+static std::string label(pd::Series const &categorical, int64_t i)
+{
+    auto code = std::static_pointer_cast<arrow::DictionaryScalar>(categorical.at(i).scalar);
+    return pd::ReturnOrThrowOnFailure(code->GetEncodedValue())->ToString();
+}
+
+TEST_CASE("categorical columns survive where, take and concat", "[categorical]")
+{
+    auto df = tradeFrame({ "AAPL", "MSFT", "AAPL", "IBM" }, { 1, 2, 3, 4 });
+    REQUIRE(df["symbol"].is_categorical());
+    REQUIRE(df["price"].categorize().is_categorical());
+
+    auto filtered = df.where(df["price"] > pd::Scalar(1.5));
+    REQUIRE(filtered["symbol"].is_categorical());
+    REQUIRE(filtered.num_rows() == 3);
+
+    auto taken = df.take(pd::Series(std::vector<int64_t>{ 3, 0 }));
+    REQUIRE(taken["symbol"].is_categorical());
+    REQUIRE(label(taken["symbol"], 0) == "IBM");
+
+    // each frame was encoded on its own, the dictionaries are unified
+    auto other = tradeFrame({ "TSLA", "IBM" }, { 5, 6 });
+    auto joined = pd::concat({ df, other }, pd::AxisType::Index, pd::JoinType::Outer, true);
+    auto symbol = joined["symbol"];
+    REQUIRE(symbol.is_categorical());
+    REQUIRE(symbol.size() == 6);
+    auto const &categorical = static_cast<arrow::DictionaryArray const &>(*symbol.array());
+    REQUIRE(categorical.dictionary()->length() == 4);
+    REQUIRE(label(symbol, 4) == "TSLA");
+    REQUIRE(label(symbol, 5) == "IBM");
+}
+
+TEST_CASE("equality with a label compares the codes", "[categorical]")
+{
+    auto df = tradeFrame({ "AAPL", "MSFT", "AAPL", "IBM" }, { 1, 2, 3, 4 });
+    auto symbol = df["symbol"];
+
+    REQUIRE((symbol == pd::Scalar("AAPL"s)).equals(std::vector<bool>{ true, false, true, false }));
+    REQUIRE((symbol != pd::Scalar("AAPL"s)).equals(std::vector<bool>{ false, true, false, true }));
+    REQUIRE((symbol == pd::Scalar("GOOG"s)).equals(std::vector<bool>{ false, false, false, false }));
+    REQUIRE((symbol == symbol).equals(std::vector<bool>{ true, true, true, true }));
+
+    // the decoded comparison agrees
+    auto decoded = pd::Series(arrow::ArrayT<std::string>::Make({ "AAPL", "MSFT", "AAPL", "IBM" }), false);
+    REQUIRE((decoded == pd::Scalar("AAPL"s)).array()->Equals(*(symbol == pd::Scalar("AAPL"s)).array()));
+}
+
+TEST_CASE("group_by and value_counts on a categorical use its codes", "[categorical]")
+{
+    auto df = tradeFrame({ "MSFT", "AAPL", "MSFT", "IBM", "MSFT" }, { 1, 2, 3, 4, 5 });
+
+    auto groupby = df.group_by("symbol"s);
+    auto keys = groupby.unique();
+    REQUIRE(keys->Equals(*arrow::ArrayT<std::string>::Make({ "MSFT", "AAPL", "IBM" })));
+
+    auto sum = pd::ReturnOrThrowOnFailure(groupby.sum("price"));
+    REQUIRE(sum.values<double>() == std::vector<double>{ 9, 2, 4 });
+
+    // matches grouping the plain strings
+    auto plain = pd::DataFrame(arrow::RecordBatch::Make(
+        arrow::schema({ arrow::field("symbol", arrow::utf8()), arrow::field("price", arrow::float64()) }),
+        5,
+        { arrow::ArrayT<std::string>::Make({ "MSFT", "AAPL", "MSFT", "IBM", "MSFT" }), df["price"].array() }));
+    REQUIRE(pd::ReturnOrThrowOnFailure(plain.group_by("symbol"s).sum("price")).array()->Equals(*sum.array()));
+
+    auto counts = df["symbol"].value_counts();
+    REQUIRE(counts["values"].is_categorical());
+    REQUIRE(counts["counts"].values<int64_t>() == std::vector<int64_t>{ 3, 1, 1 });
+    REQUIRE(label(counts["values"], 0) == "MSFT");
+}
+
+TEST_CASE("categoricals round trip through parquet", "[categorical]")
+{
+    auto df = tradeFrame({ "AAPL", "MSFT", "AAPL" }, { 1, 2, 3 });
+    auto path = std::filesystem::temp_directory_path() / "categorical_test.parquet";
+    pd::ThrowOnFailure(df.toParquet(path));
+
+    auto stored = pd::DataFrame::readParquet(path);
+    REQUIRE(stored["symbol"].is_categorical());
+
+    auto plain = tradeFrame({ "AAPL", "MSFT", "AAPL" }, { 1, 2, 3 });
+    plain.add_column("symbol", plain["symbol"].cast<std::string>());
+    pd::ThrowOnFailure(plain.toParquet(path));
+    REQUIRE_FALSE(pd::DataFrame::readParquet(path)["symbol"].is_categorical());
+    auto encoded = pd::DataFrame::readParquet(path, { "symbol" });
+    REQUIRE(encoded["symbol"].is_categorical());
+    REQUIRE(label(encoded["symbol"], 1) == "MSFT");
+
+    REQUIRE_THROWS(pd::DataFrame::readParquet(path, { "missing" }));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("categoricals with unsigned codes", "[categorical]")
+{
+    auto dictionary = arrow::ArrayT<std::string>::Make({ "AAPL", "IBM", "MSFT" });
+    for (auto const &indexType: { arrow::uint8(), arrow::uint16(), arrow::uint32(), arrow::uint64() })
+    {
+        auto codes = pd::ReturnOrThrowOnFailure(
+            arrow::compute::Cast(*arrow::ArrayT<int64_t>::Make({ 2, 0, 2, 1, 2 }), indexType));
+        auto symbols = pd::ReturnOrThrowOnFailure(
+            arrow::DictionaryArray::FromArrays(arrow::dictionary(indexType, arrow::utf8()), codes, dictionary));
+        auto df = pd::DataFrame(arrow::RecordBatch::Make(
+            arrow::schema({ arrow::field("symbol", symbols->type()), arrow::field("price", arrow::float64()) }),
+            5,
+            { symbols, pd::Series(std::vector<double>{ 1, 2, 3, 4, 5 }).array() }));
+
+        auto sum = pd::ReturnOrThrowOnFailure(df.group_by("symbol"s).sum("price"));
+        REQUIRE(sum.values<double>() == std::vector<double>{ 9, 2, 4 });
+
+        auto counts = df["symbol"].value_counts();
+        REQUIRE(counts["counts"].values<int64_t>() == std::vector<int64_t>{ 1, 1, 3 });
+    }
+
+    SECTION("a label outside a full uint8 dictionary matches no row")
+    {
+        std::vector<std::string> labels(256);
+        for (int i = 0; i < 256; i++)
+        {
+            labels[i] = "s" + std::to_string(i);
+        }
+        arrow::UInt8Builder codeBuilder;
+        pd::ThrowOnFailure(codeBuilder.AppendValues(std::vector<uint8_t>{ 255, 0, 255 }));
+        pd::ThrowOnFailure(codeBuilder.AppendNull());
+        auto symbols = pd::ReturnOrThrowOnFailure(arrow::DictionaryArray::FromArrays(
+            arrow::dictionary(arrow::uint8(), arrow::utf8()),
+            pd::ReturnOrThrowOnFailure(codeBuilder.Finish()),
+            arrow::ArrayT<std::string>::Make(labels)));
+        pd::Series s{ symbols, false, "symbol" };
+
+        auto equal = s == pd::Scalar("absent"s);
+        REQUIRE(equal.array()->Equals(*arrow::ArrayT<bool>::Make({ false, false, false, false }, { true, true, true, false })));
+        auto notEqual = s != pd::Scalar("absent"s);
+        REQUIRE(notEqual.array()->Equals(*arrow::ArrayT<bool>::Make({ true, true, true, false }, { true, true, true, false })));
+        REQUIRE((s == pd::Scalar("s255"s)).array()->Equals(*arrow::ArrayT<bool>::Make({ true, false, true, false }, { true, true, true, false })));
+    }
+}
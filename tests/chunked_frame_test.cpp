@@ -0,0 +1,119 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <filesystem>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include "pandas_arrow.h"
+
+
+namespace {
+    pd::DataFrame part(std::vector<std::string> const &symbols, std::vector<int64_t> const &qty, std::vector<double> const &px,
+                       int64_t firstLabel) {
+        auto index = pd::range(firstLabel, firstLabel + int64_t(qty.size()));
+        return pd::DataFrame{arrow::RecordBatch::Make(
+                                 arrow::schema({ arrow::field("sym", arrow::utf8()), arrow::field("qty", arrow::int64()), arrow::field("px", arrow::float64()) }),
+                                 int64_t(qty.size()),
+                                 { arrow::ArrayT<std::string>::Make(symbols), arrow::ArrayT<int64_t>::Make(qty), arrow::ArrayT<double>::Make(px) }),
+            index};
+    }
+
+    std::vector<pd::DataFrame> parts() {
+        return { part({ "a", "b", "a" }, { 1, 2, 3 }, { 10, 20, 30 }, 0),
+            part({ "b", "c" }, { 4, 5 }, { 40, 50 }, 3),
+            part({ "a", "c", "c", "b" }, { 6, 7, 8, 9 }, { 60, 70, 80, 90 }, 5) };
+    }
+}
+
+TEST_CASE("ChunkedFrame keeps frames as chunks", "[chunked_frame]")
+{
+    auto frames = parts();
+    auto chunked = pd::ChunkedFrame::fromFrames(frames);
+    REQUIRE(chunked.num_rows() == 9);
+    REQUIRE(chunked.table()->column(1)->num_chunks() == 3);
+    REQUIRE(chunked.table()->column(1)->chunk(0)->data()->buffers[1] == frames[0].array()->column(1)->data()->buffers[1]);
+    REQUIRE(chunked.combine().equals_(pd::concat(frames)));
+
+    auto batches = chunked.batches();
+    REQUIRE(batches.size() == 3);
+    REQUIRE(batches[2].indexArray()->Equals(*pd::range(5L, 9L)));
+
+    auto qty = chunked["qty"];
+    REQUIRE(qty.sum().as<int64_t>() == 45);
+    REQUIRE(qty.max().as<int64_t>() == 9);
+    REQUIRE(chunked["px"].mean().as<double>() == 50);
+    REQUIRE(chunked["px"].var().as<double>() == Approx(750.0));
+
+    SECTION("elementwise operations run chunk by chunk")
+    {
+        auto notional = chunked["px"] * chunked["qty"];
+        REQUIRE(notional.num_chunks() == 3);
+        REQUIRE(notional.sum().as<double>() == 2850);
+
+        // a differently chunked operand is walked by arrow without combining either side
+        auto flat = pd::ChunkedSeries{ chunked["qty"].combine() };
+        REQUIRE((chunked["qty"] + flat).sum().as<int64_t>() == 90);
+        REQUIRE((chunked["qty"] - pd::Scalar(int64_t{ 1 })).chunk(1).array()->Equals(*arrow::ArrayT<int64_t>::Make({ 3, 4 })));
+        REQUIRE_THROWS((chunked["qty"] + chunked["qty"].slice(1)));
+    }
+
+    SECTION("filtering and slicing keep the index")
+    {
+        auto large = chunked.filter(chunked["qty"] > pd::Scalar(int64_t{ 5 }));
+        REQUIRE(large.num_rows() == 4);
+        REQUIRE(large.combine().indexArray()->Equals(*pd::range(5L, 9L)));
+
+        auto middle = chunked.slice(2, 4);
+        REQUIRE(middle["qty"].combine().array()->Equals(*arrow::ArrayT<int64_t>::Make({ 3, 4, 5, 6 })));
+        REQUIRE(middle["qty"].chunk(0).indexArray()->Equals(*pd::range(2L, 3L)));
+
+        auto more = chunked.append(part({ "d" }, { 10 }, { 100 }, 9));
+        REQUIRE(more.num_rows() == 10);
+        REQUIRE(more["qty"].values()->num_chunks() == 4);
+        REQUIRE_THROWS(chunked.append(chunked[std::vector<std::string>{ "qty" }]));
+    }
+
+    SECTION("aggregations per column")
+    {
+        auto sums = chunked.sum();
+        REQUIRE(sums.size() == 2);
+        REQUIRE(sums.at(0).as<double>() == 45);
+        REQUIRE(sums.at(1).as<double>() == 450);
+        REQUIRE(chunked.count().size() == 3);
+    }
+}
+
+TEST_CASE("ChunkedGroupBy reduces every chunk without gathering groups", "[chunked_frame]")
+{
+    auto chunked = pd::ChunkedFrame::fromFrames(parts());
+    auto groups = chunked.group_by("sym");
+    REQUIRE(groups.groupSize() == 3);
+    REQUIRE(groups.unique()->Equals(*arrow::ArrayT<std::string>::Make({ "a", "b", "c" })));
+
+    auto sum = groups.sum();
+    REQUIRE(sum.columnNames() == std::vector<std::string>{ "qty", "px" });
+    REQUIRE(sum["qty"].array()->Equals(*arrow::ArrayT<int64_t>::Make({ 10, 15, 20 })));
+    REQUIRE(groups.mean()["px"].array()->Equals(*arrow::ArrayT<double>::Make({ 100.0 / 3, 50, 200.0 / 3 })));
+    REQUIRE(groups.min()["qty"].array()->Equals(*arrow::ArrayT<int64_t>::Make({ 1, 2, 5 })));
+    REQUIRE(groups.max()["px"].array()->Equals(*arrow::ArrayT<double>::Make({ 60, 90, 80 })));
+    REQUIRE(groups.count()["qty"].array()->Equals(*arrow::ArrayT<int64_t>::Make({ 3, 3, 3 })));
+}
+
+TEST_CASE("parquet files read as chunked or combined frames", "[chunked_frame]")
+{
+    auto path = std::filesystem::temp_directory_path() / "chunked_frame_test.parquet";
+    auto table = pd::ChunkedFrame::fromFrames(parts()).table();
+    auto outfile = pd::ReturnOrThrowOnFailure(arrow::io::FileOutputStream::Open(path.string()));
+    pd::ThrowOnFailure(parquet::arrow::WriteTable(*table, pd::GetMemoryPool(), outfile, 4));
+    pd::ThrowOnFailure(outfile->Close());
+
+    auto chunked = pd::ChunkedFrame::readParquet(path);
+    REQUIRE(chunked.num_rows() == 9);
+    REQUIRE(chunked["qty"].sum().as<int64_t>() == 45);
+
+    auto df = pd::DataFrame::readParquet(path);
+    REQUIRE(df.num_rows() == 9);
+    REQUIRE(df["px"].array()->Equals(*chunked["px"].combine().array()));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""
+Compare two Google Benchmark JSON reports produced by pandas_arrow_bench.
+
+    pandas_arrow_bench --benchmark_out=base.json --benchmark_out_format=json
+    pandas_arrow_bench --benchmark_out=head.json --benchmark_out_format=json
+    python3 compare_benchmarks.py base.json head.json --threshold 0.10
+
+Exits with status 1 when any case regressed by more than the threshold.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path, metric):
+    with open(path) as f:
+        report = json.load(f)
+
+    results = {}
+    for bench in report["benchmarks"]:
+        # skip mean/median/stddev rows when --benchmark_repetitions is used
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "median":
+            continue
+        name = bench.get("run_name", bench["name"])
+        results[name] = (bench[metric], bench.get("time_unit", "ns"))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--metric", default="real_time", choices=["real_time", "cpu_time"])
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown reported as a regression (default: 0.10)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    regressions = []
+    width = max((len(name) for name in baseline), default=4)
+    print(f"{'name':<{width}}  {'baseline':>12}  {'contender':>12}  {'change':>8}")
+    for name, (base, unit) in baseline.items():
+        if name not in contender:
+            print(f"{name:<{width}}  {base:>10.3f}{unit:>2}  {'missing':>12}")
+            continue
+        head, _ = contender[name]
+        change = (head - base) / base if base else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        print(f"{name:<{width}}  {base:>10.3f}{unit:>2}  {head:>10.3f}{unit:>2}  {change:>+7.1%}{flag}")
+
+    for name in contender.keys() - baseline.keys():
+        print(f"{name:<{width}}  {'new':>12}")
+
+    if regressions:
+        print(f"\n{len(regressions)} case(s) regressed by more than {args.threshold:.0%}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
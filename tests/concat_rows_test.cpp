@@ -0,0 +1,86 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+namespace {
+    pd::DataFrame frame(arrow::FieldVector const &fields, arrow::ArrayVector const &columns,
+                        std::shared_ptr<arrow::Array> const &index) {
+        return pd::DataFrame{arrow::RecordBatch::Make(arrow::schema(fields), index->length(), columns), index};
+    }
+
+    std::shared_ptr<arrow::Array> symbols(std::vector<std::string> const &values, int64_t nulls) {
+        arrow::StringBuilder builder;
+        pd::ThrowOnFailure(builder.AppendValues(values));
+        pd::ThrowOnFailure(builder.AppendNulls(nulls));
+        return pd::ReturnOrThrowOnFailure(builder.Finish());
+    }
+}
+
+TEST_CASE("concat copies rows into preallocated columns", "[concat]")
+{
+    // odd row counts put the second input mid byte in the output bitmaps
+    auto df1 = frame({ arrow::field("px", arrow::float64()), arrow::field("up", arrow::boolean()), arrow::field("sym", arrow::utf8()) },
+        { arrow::ArrayT<double>::Make({ 1.5, 0, 3.5 }, { true, false, true }),
+            arrow::ArrayT<bool>::Make({ true, false, true }),
+            symbols({ "a", "b" }, 1) },
+        arrow::ArrayT<int64_t>::Make({ 10, 11, 12 }));
+    auto df2 = frame({ arrow::field("px", arrow::int64()), arrow::field("up", arrow::boolean()) },
+        { arrow::ArrayT<int64_t>::Make({ 4, 5, 6, 7, 8 }),
+            arrow::ArrayT<bool>::Make({ false, false, true, true, false }, { true, false, true, true, true }) },
+        arrow::ArrayT<int64_t>::Make({ 20, 21, 22, 23, 24 }));
+
+    auto result = pd::concat({ df1, df2 });
+    REQUIRE(result.columnNames() == std::vector<std::string>{ "px", "up", "sym" });
+    REQUIRE(result.indexArray()->Equals(*arrow::ArrayT<int64_t>::Make({ 10, 11, 12, 20, 21, 22, 23, 24 })));
+    REQUIRE(result["px"].array()->Equals(
+        *arrow::ArrayT<double>::Make({ 1.5, 0, 3.5, 4, 5, 6, 7, 8 }, { true, false, true, true, true, true, true, true })));
+    REQUIRE(result["up"].array()->Equals(*arrow::ArrayT<bool>::Make({ true, false, true, false, false, true, true, false },
+        { true, true, true, true, false, true, true, true })));
+    REQUIRE(result["sym"].array()->null_count() == 6);
+    REQUIRE(result["sym"].array()->Equals(*symbols({ "a", "b" }, 6)));
+
+    auto inner = pd::concat({ df1, df2 }, pd::AxisType::Index, pd::JoinType::Inner, true);
+    REQUIRE(inner.columnNames() == std::vector<std::string>{ "px", "up" });
+    REQUIRE(inner.num_rows() == 8);
+
+    SECTION("chunked rows reuse the input buffers")
+    {
+        auto table = pd::Concatenator({ df1, df2 }).concatenateRowChunks();
+        REQUIRE(table->num_rows() == 8);
+        auto up = table->GetColumnByName("up");
+        REQUIRE(up->num_chunks() == 2);
+        REQUIRE(up->chunk(0)->data()->buffers[1] == df1.array()->column(1)->data()->buffers[1]);
+        // the int64 px of df2 is cast to the unified double type, sym is missing from df2
+        REQUIRE(table->GetColumnByName("px")->type()->Equals(arrow::float64()));
+        REQUIRE(table->GetColumnByName("sym")->chunk(1)->null_count() == 5);
+    }
+
+    SECTION("concatColumnsUnsafe builds the schema once")
+    {
+        auto df3 = frame({ arrow::field("qty", arrow::int64()) }, { arrow::ArrayT<int64_t>::Make({ 1, 2, 3 }) },
+            arrow::ArrayT<int64_t>::Make({ 10, 11, 12 }));
+        auto wide = pd::concatColumnsUnsafe({ df1, df3 });
+        REQUIRE(wide.num_columns() == 4);
+        REQUIRE(wide["qty"].array()->Equals(*df3["qty"].array()));
+        REQUIRE_THROWS(pd::concatColumnsUnsafe({ df1, df2 }));
+    }
+}
+
+TEST_CASE("concat keeps long columns intact across many inputs", "[concat]")
+{
+    std::vector<pd::DataFrame> parts;
+    std::vector<int64_t> all;
+    for (int64_t p = 0; p < 7; p++) {
+        std::vector<int64_t> values(1000 + p * 13);
+        std::iota(values.begin(), values.end(), int64_t(all.size()));
+        all.insert(all.end(), values.begin(), values.end());
+        parts.push_back(frame({ arrow::field("v", arrow::int64()) }, { arrow::ArrayT<int64_t>::Make(values) },
+            pd::range(0L, int64_t(values.size()))));
+    }
+    auto result = pd::concat(parts, pd::AxisType::Index, pd::JoinType::Outer, true);
+    REQUIRE(result["v"].array()->Equals(*arrow::ArrayT<int64_t>::Make(all)));
+    REQUIRE(result["v"].array()->null_count() == 0);
+}
@@ -290,14 +290,16 @@ TEST_CASE("Test describe with non-numeric columns", "[describe]")
                      { "x", "y", "z" });
     df.setIndex(arrow::ArrayT<std::string>::Make({ "a"s, "b"s, "c"s }));
 
-    REQUIRE_THROWS(df.describe());
-    //    REQUIRE(desc.shape() == pd::DataFrame::Shape{ 3, 4 });
-    //    REQUIRE(
-    //        desc.columns() ==
-    //        std::vector<std::string>{ "count", "nunique", "top", "freq" });
-    //    REQUIRE(desc.index().equals(std::vector<std::string>{ "x", "y", "z" })); REQUIRE(desc.at("count", "x") == 3);
-    //    REQUIRE(desc.at("nunique", "x") == 3); REQUIRE(desc.at("top", "x") == "a"); REQUIRE(desc.at("freq", "x") ==
-    //    1);
+    auto desc = df.describe(true, true);
+    INFO(desc);
+    REQUIRE(desc.shape() == pd::DataFrame::Shape{ 3, 9 });
+    REQUIRE(desc.index().equals(std::vector<std::string>{ "x", "y", "z" }));
+    REQUIRE(desc.at("x", "count").as<int64_t>() == 3L);
+    REQUIRE(desc.at("x", "nunique").as<int64_t>() == 3L);
+    REQUIRE(desc.at("x", "min").as<std::string>() == "a");
+    REQUIRE(desc.at("z", "max").as<std::string>() == "i");
+    REQUIRE_FALSE(desc.at("x", "mean").isValid());
+    REQUIRE_FALSE(desc.at("x", "50%").isValid());
 }
 
 TEST_CASE("Test argsort", "[argsort]")
@@ -408,8 +410,11 @@ TEST_CASE("Test sort_values with by and ascending=false", "[sort_values]")
     REQUIRE(sorted.at(1, "b") == 5);
     REQUIRE(sorted.at(2, "b") == 4);
 
-    // check index is ignored
-    REQUIRE(sorted.index().equals(std::vector<::uint64_t>{ 0, 1, 2 }));
+    // check index follows the rows
+    REQUIRE(sorted.index().equals(std::vector<std::string>{ "z", "y", "x" }));
+
+    auto ignored = df.sort_values({ "a", "b" }, false, arrow::compute::NullPlacement::AtEnd, true);
+    REQUIRE(ignored.index().equals(std::vector<::uint64_t>{ 0, 1, 2 }));
 }
 
 //  Each row of the output will be the corresponding value of the
@@ -460,4 +465,47 @@ TEST_CASE("Test Transpose function", "[transpose]")
                                                                         { "1", { "Bob", "8", "true", "0" } } },
                        arrow::ArrayT<std::string>::Make({ "name", "score", "employed", "kids" }) }));
     }
+
+    SECTION("Large DataFrame with nulls is transposed in tiles", "[transpose]")
+    {
+        const int64_t rows = 150, cols = 70;
+        arrow::ArrayVector columns;
+        arrow::FieldVector fields;
+        for (int64_t j = 0; j < cols; j++)
+        {
+            arrow::Int32Builder builder;
+            for (int64_t i = 0; i < rows; i++)
+            {
+                ThrowOnFailure((i + j) % 7 == 0 ? builder.AppendNull() : builder.Append(int32_t(i * 1000 + j)));
+            }
+            columns.push_back(ReturnOrThrowOnFailure(builder.Finish()));
+            fields.push_back(arrow::field(std::to_string(j), j % 2 ? arrow::float64() : arrow::int32()));
+            if (j % 2)
+            {
+                columns.back() = ReturnOrThrowOnFailure(arrow::compute::Cast(columns.back(), arrow::float64())).make_array();
+            }
+        }
+        DataFrame df(arrow::schema(fields), rows, columns);
+        auto sliced = df.slice(3, rows - 3);
+
+        auto transposed = sliced.transpose();
+        INFO(transposed.head(3));
+        REQUIRE(transposed.shape() == DataFrame::Shape{ cols, rows - 3 });
+        REQUIRE(transposed.dtypes().front()->type()->Equals(arrow::float64()));
+        for (int64_t i = 0; i < rows - 3; i++)
+        {
+            for (int64_t j = 0; j < cols; j++)
+            {
+                auto cell = transposed.at(j, i);
+                if ((i + 3 + j) % 7 == 0)
+                {
+                    REQUIRE_FALSE(cell.isValid());
+                }
+                else
+                {
+                    REQUIRE(cell.as<double>() == double((i + 3) * 1000 + j));
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
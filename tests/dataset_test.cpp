@@ -0,0 +1,85 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <filesystem>
+#include "pandas_arrow.h"
+
+
+using namespace std::string_literals;
+
+
+// root/date=YYYY-MM-DD/symbol=S/part.parquet with one minute bar per row
+static std::filesystem::path writeBars()
+{
+    auto root = std::filesystem::temp_directory_path() / "dataset_test";
+    std::filesystem::remove_all(root);
+
+    for (int day = 1; day <= 3; day++) {
+        auto start = ptime(date(2026, 1, day), hours(9));
+        for (auto const &symbol : { "AAPL"s, "MSFT"s }) {
+            auto directory = root / ("date=2026-01-0" + std::to_string(day)) / ("symbol=" + symbol);
+            std::filesystem::create_directories(directory);
+
+            std::vector<double> close(10);
+            std::iota(close.begin(), close.end(), day * 100.0);
+            auto bars = pd::DataFrame(arrow::RecordBatch::Make(arrow::schema({ arrow::field("close", arrow::float64()) }),
+                                          10,
+                                          { pd::Series(close).array() }),
+                pd::date_range(start, 10, "1min"));
+            pd::ThrowOnFailure(bars.toParquet(directory / "part.parquet"));
+        }
+    }
+    return root;
+}
+
+TEST_CASE("Dataset discovers hive partitions and prunes them", "[dataset]")
+{
+    auto root = writeBars();
+    auto dataset = pd::Dataset::open(root.string());
+
+    REQUIRE(dataset.schema()->GetFieldByName("date"));
+    REQUIRE(dataset.schema()->GetFieldByName("symbol"));
+    REQUIRE(dataset.files().size() == 6);
+
+    auto all = dataset.read();
+    REQUIRE(all.num_rows() == 60);
+    REQUIRE(all.indexArray()->type()->id() == arrow::Type::TIMESTAMP);
+
+    auto msft = dataset.where("symbol", pd::Scalar("MSFT"s));
+    REQUIRE(msft.files().size() == 3);
+    REQUIRE(msft.read().num_rows() == 30);
+
+    auto days = dataset.isin("date", { pd::Scalar("2026-01-01"s), pd::Scalar("2026-01-03"s) });
+    REQUIRE(days.files().size() == 4);
+
+    // the time range prunes the date partitions before the index filters the rows
+    auto window = dataset.between(ptime(date(2026, 1, 2), hours(9) + minutes(5)), ptime(date(2026, 1, 3), hours(0)));
+    REQUIRE(window.files().size() == 2);
+    auto rows = window.where("symbol", pd::Scalar("AAPL"s)).select({ "close" }).read();
+    REQUIRE(rows.num_rows() == 5);
+    REQUIRE(rows.columnNames() == std::vector<std::string>{ "close" });
+    REQUIRE(rows["close"].values<double>() == std::vector<double>{ 205, 206, 207, 208, 209 });
+
+    REQUIRE_THROWS(dataset.where("missing", pd::Scalar(1.0)));
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Dataset streams frames batch by batch", "[dataset]")
+{
+    auto root = writeBars();
+    pd::DatasetOptions options;
+    options.batchSize = 4;
+    auto stream = pd::Dataset::open(root.string(), options).where("symbol", pd::Scalar("AAPL"s)).stream();
+
+    int64_t rows = 0, batches = 0;
+    while (auto frame = stream.next()) {
+        REQUIRE(frame->num_rows() <= 4);
+        REQUIRE(frame->indexArray()->type()->id() == arrow::Type::TIMESTAMP);
+        rows += frame->num_rows();
+        batches++;
+    }
+    REQUIRE(rows == 30);
+    REQUIRE(batches >= 8);
+    std::filesystem::remove_all(root);
+}
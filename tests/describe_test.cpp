@@ -0,0 +1,125 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <random>
+#include "pandas_arrow.h"
+#include "sketch.h"
+
+
+TEST_CASE("HyperLogLog and TDigest stay close to the exact statistics", "[describe]")
+{
+    std::mt19937_64 gen(7);
+    std::normal_distribution<double> normal(100, 15);
+
+    pd::HyperLogLog hll, left, right;
+    pd::TDigest digest, first, second;
+    std::vector<double> values(200000);
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = normal(gen);
+        auto hash = pd::mixHash(i % 50000);
+        hll.add(hash);
+        (i % 2 ? left : right).add(hash);
+        digest.add(values[i]);
+        (i < values.size() / 2 ? first : second).add(values[i]);
+    }
+    left.merge(right);
+    first.merge(second);
+
+    REQUIRE(hll.estimate() == Catch::Approx(50000).epsilon(0.03));
+    REQUIRE(left.estimate() == hll.estimate());
+
+    std::ranges::sort(values);
+    for (double q : { 0.01, 0.25, 0.5, 0.75, 0.99 })
+    {
+        INFO("q=" << q);
+        auto exact = values[static_cast<size_t>(q * (values.size() - 1))];
+        REQUIRE(digest.quantile(q) == Catch::Approx(exact).epsilon(0.005));
+        REQUIRE(first.quantile(q) == Catch::Approx(exact).epsilon(0.005));
+    }
+    REQUIRE(digest.quantile(0) == values.front());
+    REQUIRE(digest.quantile(1) == values.back());
+
+    pd::HyperLogLog small;
+    for (uint64_t i = 0; i < 10; i++)
+    {
+        small.add(pd::mixHash(i));
+    }
+    REQUIRE(small.estimate() == 10);
+}
+
+TEST_CASE("describe summarises mixed numeric, string and timestamp columns", "[describe]")
+{
+    arrow::StringBuilder names;
+    pd::ThrowOnFailure(names.AppendValues({ "b", "", "a", "b" }, std::vector<uint8_t>{ 1, 0, 1, 1 }.data()));
+
+    pd::DataFrame df(std::map<std::string, pd::ArrayPtr>{
+        { "price", pd::Series(std::vector<double>{ 1.0, NAN, 3.0, 5.0 }).array() },
+        { "size", pd::Series(std::vector<int32_t>{ 4, 3, 2, 1 }).array() },
+        { "name", pd::ReturnOrThrowOnFailure(names.Finish()) },
+        { "time", pd::date_range(date(2024, 1, 1), 4, "D") } });
+
+    pd::DescribeOptions options;
+    options.percentiles = { 0.5 };
+    auto desc = df.describe(options);
+    INFO(desc);
+    REQUIRE(desc.columns() == std::vector<std::string>{ "count", "mean", "std", "min", "nunique", "50%", "max" });
+    REQUIRE(desc.dtypes()[3]->type()->Equals(arrow::utf8()));
+
+    REQUIRE(desc.at("price", "count").as<int64_t>() == 3);
+    REQUIRE(desc.at("price", "mean").as<double>() == 3.0);
+    REQUIRE(desc.at("price", "std").as<double>() == 2.0);
+    REQUIRE(desc.at("size", "max").as<std::string>() == "4");
+
+    REQUIRE(desc.at("name", "count").as<int64_t>() == 3);
+    REQUIRE(desc.at("name", "nunique").as<int64_t>() == 2);
+    REQUIRE(desc.at("name", "min").as<std::string>() == "a");
+    REQUIRE_FALSE(desc.at("name", "mean").isValid());
+
+    REQUIRE(desc.at("time", "nunique").as<int64_t>() == 4);
+    REQUIRE_FALSE(desc.at("time", "std").isValid());
+
+    auto times = df[std::vector<std::string>{ "time" }].describe(options);
+    REQUIRE(times.dtypes()[3]->type()->id() == arrow::Type::TIMESTAMP);
+    REQUIRE(times.at("time", "min").as<ptime>() == ptime(date(2024, 1, 1)));
+    REQUIRE(times.at("time", "50%").as<ptime>() == ptime(date(2024, 1, 2), hours(12)));
+}
+
+TEST_CASE("describe sketches large columns unless exact is requested", "[describe]")
+{
+    std::mt19937_64 gen(11);
+    std::uniform_int_distribution<int64_t> keys(0, 19999);
+    std::normal_distribution<double> normal;
+
+    const size_t N = 300000;
+    std::vector<int64_t> ids(N);
+    std::vector<double> noise(N);
+    for (size_t i = 0; i < N; i++)
+    {
+        ids[i] = keys(gen);
+        noise[i] = normal(gen);
+    }
+    pd::DataFrame df(std::map<std::string, pd::ArrayPtr>{ { "id", pd::Series(ids).array() },
+                                                          { "noise", pd::Series(noise).array() } });
+
+    pd::DescribeOptions options;
+    options.percentiles = { 0.1, 0.5, 0.9 };
+    auto sketched = df.describe(options);
+    options.exact = true;
+    auto exact = df.describe(options);
+    INFO(sketched << "\n" << exact);
+
+    REQUIRE(exact.at("id", "nunique").as<int64_t>() == pd::Series(ids).nunique());
+    REQUIRE(static_cast<double>(sketched.at("id", "nunique").as<int64_t>()) ==
+            Catch::Approx(exact.at("id", "nunique").as<int64_t>()).epsilon(0.03));
+    REQUIRE(sketched.at("noise", "mean").as<double>() == Catch::Approx(pd::Series(noise).mean().as<double>()));
+    REQUIRE(sketched.at("noise", "std").as<double>() == Catch::Approx(pd::Series(noise).std().as<double>()));
+    REQUIRE(sketched.at("noise", "max").as<double>() == pd::Series(noise).max().as<double>());
+    for (auto q : { "10%", "50%", "90%" })
+    {
+        REQUIRE(sketched.at("noise", q).as<double>() ==
+                Catch::Approx(exact.at("noise", q).as<double>()).margin(0.01));
+    }
+    REQUIRE(exact.at("noise", "50%").as<double>() == Catch::Approx(pd::Series(noise).quantile(0.5).as<double>()));
+}
@@ -0,0 +1,92 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+namespace {
+    pd::ExecContext morsels(int64_t size) {
+        auto ctx = pd::GetExecContext();
+        ctx.morsel_size = size;
+        ctx.serial_threshold = 2 * size;
+        return ctx;
+    }
+
+    std::shared_ptr<arrow::Array> words(int64_t n) {
+        arrow::StringBuilder builder;
+        for (int64_t i = 0; i < n; i++) {
+            pd::ThrowOnFailure(i % 7 == 3 ? builder.AppendNull() : builder.Append("w" + std::to_string(i)));
+        }
+        return pd::ReturnOrThrowOnFailure(builder.Finish());
+    }
+}
+
+TEST_CASE("elementwise functions split long inputs into morsels", "[elementwise]")
+{
+    const int64_t n = 1003;
+    auto values = pd::range(0L, n);
+    std::vector<bool> validity(n);
+    for (int64_t i = 0; i < n; i++) {
+        validity[i] = i % 5 != 2;
+    }
+    auto withNulls = arrow::ArrayT<int64_t>::Make(std::vector<int64_t>(n, 1), validity);
+    auto text = words(n);
+
+    auto serialSum = pd::ReturnOrThrowOnFailure(pd::CallFunction("add", {values, withNulls})).make_array();
+    auto serialUpper = pd::ReturnOrThrowOnFailure(pd::CallFunction("utf8_upper", {text})).make_array();
+    auto serialMask = pd::ReturnOrThrowOnFailure(pd::CallFunction("greater", {withNulls, arrow::MakeScalar(int64_t{0})})).make_array();
+
+    pd::ScopedExecContext scope(morsels(16));
+
+    auto sum = pd::ReturnOrThrowOnFailure(pd::CallElementwise("add", {values, withNulls})).make_array();
+    REQUIRE(sum->Equals(*serialSum));
+    REQUIRE(sum->null_count() == serialSum->null_count());
+
+    auto upper = pd::ReturnOrThrowOnFailure(pd::CallElementwise("utf8_upper", {text})).make_array();
+    REQUIRE(upper->Equals(*serialUpper));
+
+    auto mask = pd::ReturnOrThrowOnFailure(pd::CallElementwise("greater", {withNulls, arrow::MakeScalar(int64_t{0})})).make_array();
+    REQUIRE(mask->Equals(*serialMask));
+
+    SECTION("Series operators go through the morsel path")
+    {
+        pd::Series series{values, false, "x"};
+        REQUIRE((series * pd::Scalar(int64_t{2})).array()->Equals(
+                *pd::ReturnOrThrowOnFailure(pd::CallFunction("multiply", {values, arrow::MakeScalar(int64_t{2})})).make_array()));
+        REQUIRE(pd::Series{text, false, "s"}.str().utf8_upper().array()->Equals(*serialUpper));
+    }
+
+    SECTION("functions that are not elementwise and serial contexts fall back")
+    {
+        auto sorted = pd::ReturnOrThrowOnFailure(pd::CallElementwise("array_sort_indices", {values})).make_array();
+        REQUIRE(sorted->length() == n);
+
+        auto serial = morsels(16);
+        serial.use_threads = false;
+        pd::ScopedExecContext noThreads(serial);
+        REQUIRE(pd::ReturnOrThrowOnFailure(pd::CallElementwise("add", {values, withNulls})).make_array()->Equals(*serialSum));
+    }
+
+    SECTION("errors in a morsel are reported")
+    {
+        auto zeros = arrow::ArrayT<int64_t>::Make(std::vector<int64_t>(n, 0));
+        REQUIRE_FALSE(pd::CallElementwise("divide", {values, zeros}).ok());
+    }
+}
+
+TEST_CASE("Stitch copies pieces that split bitmap bytes", "[elementwise]")
+{
+    auto text = words(23);
+    arrow::ArrayVector pieces{ text->Slice(0, 3), text->Slice(3, 5), text->Slice(8, 15) };
+    auto stitched = pd::ReturnOrThrowOnFailure(pd::Stitch(pieces));
+    REQUIRE(stitched->Equals(*text));
+    REQUIRE(stitched->null_count() == text->null_count());
+
+    auto flags = arrow::ArrayT<bool>::Make({ true, false, true, true, false, false, true, false, true, true, false });
+    auto stitchedFlags = pd::ReturnOrThrowOnFailure(pd::Stitch({ flags->Slice(0, 5), flags->Slice(5, 1), flags->Slice(6, 5) }));
+    REQUIRE(stitchedFlags->Equals(*flags));
+
+    REQUIRE(pd::ReturnOrThrowOnFailure(pd::Stitch({ flags })) == flags);
+    REQUIRE_FALSE(pd::Stitch({}).ok());
+}
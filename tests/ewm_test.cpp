@@ -0,0 +1,86 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+TEST_CASE("EWMState matches Series::ewm incrementally", "[EWM]")
+{
+    std::vector<double> values{ 2.0, 3.0, NAN, 5.0, 6.0, 1.0, NAN, 4.0 };
+    pd::Series s(values);
+
+    for (bool adjust : { true, false })
+    {
+        for (bool ignore_na : { true, false })
+        {
+            auto mean = s.ewm(pd::EWMAgg::Mean, 3.0, pd::EWMAlphaType::Span, adjust, ignore_na);
+            pd::EWMState state(3.0, pd::EWMAlphaType::Span, adjust, ignore_na);
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                state.update(values[i]);
+                INFO("adjust=" << adjust << " ignore_na=" << ignore_na << " row=" << i);
+                REQUIRE(state.mean() == Catch::Approx(mean.at(i).as<double>()));
+            }
+        }
+    }
+}
+
+TEST_CASE("EWMState variance matches Series::ewm", "[EWM]")
+{
+    std::vector<double> values{ 1.0, 4.0, 2.0, 8.0, 5.0, 7.0 };
+    pd::Series s(values);
+
+    for (bool bias : { true, false })
+    {
+        auto var = s.ewm(pd::EWMAgg::Var, 0.5, pd::EWMAlphaType::CenterOfMass, true, false, 0, bias);
+        auto stddev = s.ewm(pd::EWMAgg::StdDev, 0.5, pd::EWMAlphaType::CenterOfMass, true, false, 0, bias);
+        pd::EWMState state(0.5, pd::EWMAlphaType::CenterOfMass, true, false, 0, bias);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            state.update(values[i]);
+            if (std::isnan(var.at(i).as<double>()))
+            {
+                REQUIRE(std::isnan(state.var()));
+                continue;
+            }
+            REQUIRE(state.var() == Catch::Approx(var.at(i).as<double>()));
+            REQUIRE(state.std() == Catch::Approx(stddev.at(i).as<double>()));
+        }
+    }
+}
+
+TEST_CASE("EWMState with a time halflife", "[EWM]")
+{
+    pd::EWMState state(hours(4 * 24));
+    REQUIRE_THROWS(state.update(1.0));
+    REQUIRE_THROWS_AS(pd::EWMState(hours(4 * 24), false), std::invalid_argument);
+
+    state.update(0, ptime(date(2020, 1, 1)));
+    state.update(1, ptime(date(2020, 1, 3)));
+    state.update(2, ptime(date(2020, 1, 10)));
+    state.update(NAN, ptime(date(2020, 1, 15)));
+    REQUIRE(state.mean() == Catch::Approx(1.523889).epsilon(0.0001));
+    state.update(4, ptime(date(2020, 1, 17)));
+    REQUIRE(state.mean() == Catch::Approx(3.233686).epsilon(0.0001));
+    REQUIRE(state.nobs() == 4);
+
+    state.reset();
+    REQUIRE(std::isnan(state.mean()));
+}
+
+TEST_CASE("DataFrame::ewm smooths every column", "[EWM]")
+{
+    pd::DataFrame df(std::map<std::string, std::vector<double>>{ { "a", { 1, 2, 3, 4, 5 } }, { "b", { 5, 4, 3, 2, 1 } } },
+                     pd::date_range(date(2020, 1, 1), 5, "D"));
+
+    auto result = df.ewm(pd::EWMAgg::Mean, 0.5, pd::EWMAlphaType::CenterOfMass);
+    REQUIRE(result.shape() == std::array<int64_t, 2>{ 5, 2 });
+    REQUIRE(result.indexArray()->Equals(df.indexArray()));
+    REQUIRE(result["a"].equals_(df["a"].ewm(pd::EWMAgg::Mean, 0.5, pd::EWMAlphaType::CenterOfMass)));
+    REQUIRE(result["b"].equals_(df["b"].ewm(pd::EWMAgg::Mean, 0.5, pd::EWMAlphaType::CenterOfMass)));
+
+    auto timed = df.ewm(hours(2 * 24));
+    REQUIRE(timed["a"].equals_(df["a"].ewm(hours(2 * 24))));
+    REQUIRE(timed["a"].approx_equals_(df["a"].ewm(pd::EWMAgg::Mean, 2.0, pd::EWMAlphaType::HalfLife), 1e-9));
+}
@@ -0,0 +1,95 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+TEST_CASE("ScopedExecContext installs and restores the memory pool", "[ExecContext]")
+{
+    pd::TrackingMemoryPool pool;
+    auto previous = pd::GetMemoryPool();
+    {
+        pd::ScopedExecContext scope(&pool);
+        REQUIRE(pd::GetMemoryPool() == &pool);
+    }
+    REQUIRE(pd::GetMemoryPool() == previous);
+}
+
+TEST_CASE("TrackingMemoryPool accounts for allocations made by operations", "[ExecContext]")
+{
+    pd::TrackingMemoryPool pool;
+    {
+        pd::ScopedExecContext scope(&pool);
+
+        pd::Series s(std::vector<double>{ 1, 2, 3, 4, 5 }, "a");
+        auto result = (s + s).cumsum();
+        REQUIRE(pool.num_allocations() > 0);
+        REQUIRE(pool.bytes_allocated() > 0);
+        REQUIRE(pool.max_memory() >= pool.bytes_allocated());
+        REQUIRE(pool.total_bytes_allocated() >= pool.bytes_allocated());
+    }
+    REQUIRE(pool.bytes_allocated() == 0);
+}
+
+TEST_CASE("Concatenation, masking and resampling allocate from the active pool", "[ExecContext]")
+{
+    auto index = pd::date_range(ptime(date(2000, 1, 1)), 9);
+    pd::Series s(pd::range(0L, 9L), index);
+    pd::DataFrame df{ arrow::RecordBatch::Make(arrow::schema({ arrow::field("a", arrow::int64()) }), 9, { s.array() }),
+        index };
+    auto mask = s > pd::Scalar(4L);
+
+    auto allocations = [](auto &&op) {
+        pd::TrackingMemoryPool pool;
+        pd::ScopedExecContext scope(&pool);
+        auto result = op();
+        return pool.num_allocations();
+    };
+
+    REQUIRE(allocations([&] { return s.append(s); }) > 0);
+    REQUIRE(allocations([&] { return s.where(mask, pd::Scalar(0L)); }) > 0);
+    REQUIRE(allocations([&] { return pd::ReturnOrThrowOnFailure(df.resample("3T").sum()); }) > 0);
+}
+
+TEST_CASE("TrackingMemoryPool enforces its limit", "[ExecContext]")
+{
+    pd::TrackingMemoryPool pool(arrow::default_memory_pool(), 1024);
+    pd::ScopedExecContext scope(&pool);
+
+    REQUIRE_NOTHROW(pd::Series(std::vector<int64_t>{ 1, 2, 3 }, "small"));
+    REQUIRE_THROWS(pd::Series(std::vector<int64_t>(10000, 1), "large"));
+}
+
+TEST_CASE("Parallel regions inherit the caller's context", "[ExecContext]")
+{
+    pd::TrackingMemoryPool pool;
+    pd::ScopedExecContext scope(&pool);
+
+    pd::DataFrame df(std::map<std::string, std::vector<double>>{ { "a", { 1, 2, 3 } }, { "b", { 4, 5, 6 } } });
+    auto before = pool.num_allocations();
+    auto result = df.sum(pd::AxisType::Columns);
+    REQUIRE(pool.num_allocations() > before);
+}
+
+TEST_CASE("ScopedAllocationTracker reports per scope stats", "[ExecContext]")
+{
+    pd::AllocationStats stats;
+    {
+        pd::ScopedAllocationTracker tracker("exec_context_test");
+        pd::Series s(std::vector<double>(1000, 1.0), "a");
+        stats = tracker.stats();
+    }
+    REQUIRE(stats.name == "exec_context_test");
+    REQUIRE(stats.num_allocations > 0);
+    REQUIRE(stats.total_bytes_allocated >= 8000);
+
+    auto report = pd::AllocationReport();
+    REQUIRE(std::ranges::any_of(report, [](auto const& entry) { return entry.name == "exec_context_test"; }));
+}
+
+TEST_CASE("MakeMemoryPool selects a backend", "[ExecContext]")
+{
+    REQUIRE(pd::ReturnOrThrowOnFailure(pd::MakeMemoryPool("system")) == arrow::system_memory_pool());
+    REQUIRE_FALSE(pd::MakeMemoryPool("unknown").ok());
+}
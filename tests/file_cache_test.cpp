@@ -0,0 +1,110 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <arrow/api.h>
+#include <arrow/filesystem/localfs.h>
+#include <catch.hpp>
+#include <fstream>
+#include <thread>
+#include "file_cache.h"
+
+
+static void writeObject(std::filesystem::path const &path, std::string const &content)
+{
+    std::ofstream(path, std::ios::binary) << content;
+}
+
+static std::string readAll(std::shared_ptr<arrow::io::RandomAccessFile> const &file)
+{
+    auto size = file->GetSize().ValueOrDie();
+    return file->ReadAt(0, size).ValueOrDie()->ToString();
+}
+
+TEST_CASE("FileCache serves repeated opens from local disk", "[file_cache]")
+{
+    auto root = std::filesystem::temp_directory_path() / "file_cache_test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "remote");
+
+    // a local filesystem stands in for the object store
+    arrow::fs::LocalFileSystem remote;
+    // every open checks the object's version
+    pd::FileCache cache(root / "cache", 64, std::chrono::seconds{ 0 });
+
+    auto a = (root / "remote" / "a.parquet").string();
+    writeObject(a, std::string(20, 'a'));
+
+    REQUIRE(readAll(cache.open(remote, a).ValueOrDie()) == std::string(20, 'a'));
+    REQUIRE(cache.misses() == 1);
+    REQUIRE(readAll(cache.open(remote, a).ValueOrDie()) == std::string(20, 'a'));
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.size() == 20);
+
+    SECTION("a rewritten object is fetched again")
+    {
+        writeObject(a, std::string(30, 'b'));
+        REQUIRE(readAll(cache.open(remote, a).ValueOrDie()) == std::string(30, 'b'));
+        REQUIRE(cache.misses() == 2);
+    }
+
+    SECTION("least recently used entries are evicted past the capacity")
+    {
+        auto b = (root / "remote" / "b.parquet").string();
+        auto c = (root / "remote" / "c.parquet").string();
+        writeObject(b, std::string(20, 'b'));
+        writeObject(c, std::string(30, 'c'));
+
+        REQUIRE(cache.open(remote, b).ok());
+        REQUIRE(cache.size() == 40);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(cache.open(remote, a).ok());
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        // b is the oldest entry once a was touched again
+        REQUIRE(cache.open(remote, c).ok());
+        REQUIRE(cache.size() == 50);
+        REQUIRE(cache.open(remote, a).ok());
+        REQUIRE(cache.hits() == 3);
+        REQUIRE(cache.open(remote, b).ok());
+        REQUIRE(cache.misses() == 4);
+        REQUIRE(cache.size() <= 64);
+    }
+
+    SECTION("objects larger than the cache are read directly")
+    {
+        auto big = (root / "remote" / "big.parquet").string();
+        writeObject(big, std::string(100, 'x'));
+        REQUIRE(readAll(cache.open(remote, big).ValueOrDie()) == std::string(100, 'x'));
+        REQUIRE(cache.size() == 20);
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("FileCache skips the version check of recently validated paths", "[file_cache]")
+{
+    auto root = std::filesystem::temp_directory_path() / "file_cache_ttl_test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "remote");
+
+    arrow::fs::LocalFileSystem remote;
+    pd::FileCache cache(root / "cache", 64, std::chrono::hours{ 1 });
+
+    auto a = (root / "remote" / "a.parquet").string();
+    writeObject(a, std::string(20, 'a'));
+    REQUIRE(cache.open(remote, a).ok());
+
+    // the remote is not consulted, even a deleted object is still served
+    writeObject(a, std::string(30, 'b'));
+    REQUIRE(readAll(cache.open(remote, a).ValueOrDie()) == std::string(20, 'a'));
+    std::filesystem::remove(a);
+    REQUIRE(readAll(cache.open(remote, a).ValueOrDie()) == std::string(20, 'a'));
+    REQUIRE(cache.hits() == 2);
+    REQUIRE(cache.misses() == 1);
+
+    for (auto const &file: std::filesystem::directory_iterator(root / "cache"))
+    {
+        REQUIRE(file.path().extension() != ".part");
+    }
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,117 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include "pandas_arrow.h"
+#include "catch.hpp"
+
+
+using namespace std::string_literals;
+
+
+static pd::DataFrame symbolFrame()
+{
+    return pd::DataFrame(std::map<std::string, std::vector<double>>{ { "symbol", { 1, 2, 1, 2, 1, 2 } },
+                                                                    { "price", { 10, 20, 11, 18, 12, 27 } },
+                                                                    { "volume", { 1, 5, 2, 5, 3, 5 } } },
+        arrow::ArrayT<std::string>::Make({ "t0", "t1", "t2", "t3", "t4", "t5" }));
+}
+
+TEST_CASE("GroupBy::transform broadcasts aggregates to the original rows", "[GroupBy]")
+{
+    auto df = symbolFrame();
+    auto groupby = df.group_by("symbol"s);
+
+    auto result = pd::ReturnOrThrowOnFailure(groupby.transform("mean", std::vector{ "price"s, "volume"s }));
+    INFO(result);
+    REQUIRE(result.num_rows() == 6);
+    REQUIRE(result.indexArray()->Equals(df.indexArray()));
+    REQUIRE(result["price"].values<double>() == std::vector<double>{ 11, 65.0 / 3, 11, 65.0 / 3, 11, 65.0 / 3 });
+    REQUIRE(result["volume"].values<double>() == std::vector<double>{ 2, 5, 2, 5, 2, 5 });
+
+    auto count = pd::ReturnOrThrowOnFailure(groupby.transform("count", "price"));
+    REQUIRE(count.values<int64_t>() == std::vector<int64_t>{ 3, 3, 3, 3, 3, 3 });
+
+    REQUIRE_FALSE(groupby.transform("sum", "missing").ok());
+}
+
+TEST_CASE("GroupBy cumulative functions keep the row order", "[GroupBy]")
+{
+    auto df = symbolFrame();
+    auto groupby = df.group_by("symbol"s);
+
+    REQUIRE(pd::ReturnOrThrowOnFailure(groupby.cumsum("volume")).values<double>() ==
+            std::vector<double>{ 1, 5, 3, 10, 6, 15 });
+    REQUIRE(pd::ReturnOrThrowOnFailure(groupby.cumprod("volume")).values<double>() ==
+            std::vector<double>{ 1, 5, 2, 25, 6, 125 });
+    REQUIRE(pd::ReturnOrThrowOnFailure(groupby.cummax("price")).values<double>() ==
+            std::vector<double>{ 10, 20, 11, 20, 12, 27 });
+    REQUIRE(pd::ReturnOrThrowOnFailure(groupby.cummin("price")).values<double>() ==
+            std::vector<double>{ 10, 20, 10, 18, 10, 18 });
+
+    auto ints = pd::DataFrame(std::map<std::string, std::vector<int32_t>>{ { "k", { 0, 1, 0, 1 } },
+                                                                          { "v", { 1, 2, 3, 4 } } });
+    auto summed = pd::ReturnOrThrowOnFailure(ints.group_by("k"s).cumsum("v"));
+    REQUIRE(summed.dtype()->id() == arrow::Type::INT64);
+    REQUIRE(summed.values<int64_t>() == std::vector<int64_t>{ 1, 2, 4, 6 });
+}
+
+TEST_CASE("GroupBy shift, diff and pct_change look back within each group", "[GroupBy]")
+{
+    auto df = symbolFrame();
+    auto groupby = df.group_by("symbol"s);
+
+    auto shifted = pd::ReturnOrThrowOnFailure(groupby.shift("price"));
+    INFO(shifted);
+    REQUIRE(shifted.array()->null_count() == 2);
+    REQUIRE(shifted.at(2).as<double>() == 10);
+    REQUIRE(shifted.at(5).as<double>() == 18);
+    REQUIRE(shifted.indexArray()->Equals(df.indexArray()));
+
+    auto lead = pd::ReturnOrThrowOnFailure(groupby.shift("price", -1));
+    REQUIRE(lead.at(0).as<double>() == 11);
+    REQUIRE_FALSE(lead.array()->IsValid(4));
+
+    auto diff = pd::ReturnOrThrowOnFailure(groupby.diff("price"));
+    REQUIRE(std::isnan(diff.at(0).as<double>()));
+    REQUIRE(diff.array()->null_count() == 2);
+    REQUIRE(diff.at(3).as<double>() == -2);
+    REQUIRE(diff.at(5).as<double>() == 9);
+
+    auto returns = pd::ReturnOrThrowOnFailure(groupby.pct_change("price", 2));
+    REQUIRE(std::isnan(returns.at(2).as<double>()));
+    REQUIRE(returns.array()->null_count() == 4);
+    REQUIRE(returns.at(4).as<double>() == Catch::Approx(0.2));
+    REQUIRE(returns.at(5).as<double>() == Catch::Approx(0.35));
+}
+
+TEST_CASE("GroupBy rank and ffill", "[GroupBy]")
+{
+    auto df = pd::DataFrame(std::map<std::string, std::vector<double>>{ { "k", { 0, 0, 1, 0, 1, 1 } },
+                                                                       { "v", { 3, 1, 5, 3, NAN, 2 } } });
+    auto groupby = df.group_by("k"s);
+
+    auto ranked = pd::ReturnOrThrowOnFailure(groupby.rank("v"));
+    INFO(ranked);
+    REQUIRE(ranked.at(0).as<double>() == 2.5);
+    REQUIRE(ranked.at(1).as<double>() == 1);
+    REQUIRE(ranked.at(3).as<double>() == 2.5);
+    REQUIRE(ranked.at(2).as<double>() == 2);
+    REQUIRE(std::isnan(ranked.at(4).as<double>()));
+    REQUIRE_FALSE(ranked.array()->IsValid(4));
+    REQUIRE(ranked.array()->null_count() == 1);
+    REQUIRE(ranked.at(5).as<double>() == 1);
+
+    auto descending = pd::ReturnOrThrowOnFailure(groupby.rank("v", false));
+    REQUIRE(descending.at(1).as<double>() == 3);
+
+    arrow::DoubleBuilder builder;
+    pd::ThrowOnFailure(builder.AppendValues({ 1.0, 0.0, 0.0, 4.0 }, { true, true, false, false }));
+    auto sparse = pd::DataFrame(arrow::RecordBatch::Make(
+        arrow::schema({ arrow::field("k", arrow::int64()), arrow::field("v", arrow::float64()) }),
+        4,
+        { pd::Series(std::vector<int64_t>{ 0, 1, 0, 1 }).array(), pd::ReturnOrThrowOnFailure(builder.Finish()) }));
+
+    auto filled = pd::ReturnOrThrowOnFailure(sparse.group_by("k"s).ffill("v"));
+    REQUIRE(filled.at(2).as<double>() == 1.0);
+    REQUIRE(filled.at(3).as<double>() == 0.0);
+}
@@ -0,0 +1,134 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include "json_io.h"
+#include "pandas_arrow.h"
+
+
+namespace {
+    std::string text(std::shared_ptr<arrow::Buffer> const &buffer) {
+        return buffer->ToString();
+    }
+
+    pd::DataFrame sampleFrame() {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        auto schema = arrow::schema({ arrow::field("id", arrow::int64()),
+                                      arrow::field("price", arrow::float64()),
+                                      arrow::field("name", arrow::utf8()),
+                                      arrow::field("active", arrow::boolean()) });
+        return pd::DataFrame{ arrow::RecordBatch::Make(schema, 3, { arrow::ArrayT<int64_t>::Make({ 1, 2, 3 }),
+                                                                    arrow::ArrayT<double>::Make({ 1.5, nan, 2.0 }),
+                                                                    arrow::ArrayT<std::string>::Make({ "a", "say \"hi\"\n", "c" }),
+                                                                    arrow::ArrayT<bool>::Make({ true, false, true }) }),
+            pd::date_range(date(2024, Jan, 1), 3) };
+    }
+}
+
+TEST_CASE("toJSON writes records and columns without a DOM", "[json]")
+{
+    auto df = sampleFrame();
+
+    REQUIRE(text(pd::ReturnOrThrowOnFailure(df.toJSON())) ==
+            "{\"id\":1,\"price\":1.5,\"name\":\"a\",\"active\":true}\n"
+            "{\"id\":2,\"price\":null,\"name\":\"say \\\"hi\\\"\\n\",\"active\":false}\n"
+            "{\"id\":3,\"price\":2.0,\"name\":\"c\",\"active\":true}\n");
+
+    REQUIRE(text(pd::ReturnOrThrowOnFailure(df.toJSON(pd::JSONOrient::Columns, { "id", "active" }))) ==
+            "{\"id\":[1,2,3],\"active\":[true,false,true]}\n");
+
+    auto withIndex = text(pd::ReturnOrThrowOnFailure(df.toJSON(pd::JSONOrient::Records, { "id" }, "time")));
+    REQUIRE(withIndex.starts_with("{\"id\":1,\"time\":1704067200000000000}\n"));
+
+    REQUIRE_FALSE(df.toJSON(pd::JSONOrient::Records, { "missing" }).ok());
+}
+
+TEST_CASE("toJSON writes binary columns as base64", "[json]")
+{
+    arrow::BinaryBuilder builder;
+    pd::ThrowOnFailure(builder.Append(std::string("\xff\x00", 2)));
+    pd::ThrowOnFailure(builder.AppendNull());
+    pd::ThrowOnFailure(builder.Append(std::string("abc")));
+    pd::DataFrame df{ arrow::RecordBatch::Make(arrow::schema({ arrow::field("raw", arrow::binary()) }), 3,
+                                               { pd::ReturnOrThrowOnFailure(builder.Finish()) }),
+        pd::range(0L, 3L) };
+
+    REQUIRE(text(pd::ReturnOrThrowOnFailure(df.toJSON(pd::JSONOrient::Columns))) ==
+            "{\"raw\":[\"/wA=\",null,\"YWJj\"]}\n");
+}
+
+TEST_CASE("readJSON round trips both orients with the index", "[json]")
+{
+    auto df = sampleFrame();
+    for (auto orient: { pd::JSONOrient::Records, pd::JSONOrient::Columns })
+    {
+        auto buffer = pd::ReturnOrThrowOnFailure(df.toJSON(orient, {}, "time"));
+        auto read = pd::DataFrame::readJSON(buffer, orient, nullptr, "time");
+        REQUIRE(read.columnNames() == df.columnNames());
+        REQUIRE(read.equals_(df));
+        REQUIRE(read.indexArray()->Equals(*df.indexArray()));
+    }
+
+    auto pretty = std::make_shared<arrow::Buffer>("{\n  \"a\": [1, 2, 3],\n  \"b\": [\"x\", null, \"z\"]\n}\n");
+    auto columns = pd::DataFrame::readJSON(pretty, pd::JSONOrient::Columns);
+    REQUIRE(columns.num_rows() == 3);
+    REQUIRE(columns["a"].sum().as<int64_t>() == 6);
+    REQUIRE(columns["b"].array()->null_count() == 1);
+
+    auto ragged = std::make_shared<arrow::Buffer>(R"({"a": [1, 2], "b": [1]})");
+    REQUIRE_THROWS(pd::DataFrame::readJSON(ragged, pd::JSONOrient::Columns));
+}
+
+TEST_CASE("readJSON applies an explicit schema", "[json]")
+{
+    auto buffer = std::make_shared<arrow::Buffer>("{\"a\": 1, \"b\": \"x\", \"extra\": true}\n"
+                                                  "{\"a\": 2, \"b\": \"y\"}\n");
+    auto inferred = pd::DataFrame::readJSON(buffer);
+    REQUIRE(inferred.columnNames() == std::vector<std::string>{ "a", "b", "extra" });
+    REQUIRE(inferred["a"].dtype()->id() == arrow::Type::INT64);
+
+    auto schema = arrow::schema({ arrow::field("a", arrow::float64()), arrow::field("b", arrow::utf8()) });
+    auto typed = pd::DataFrame::readJSON(buffer, pd::JSONOrient::Records, schema);
+    REQUIRE(typed.columnNames() == std::vector<std::string>{ "a", "b" });
+    REQUIRE(typed["a"].dtype()->id() == arrow::Type::DOUBLE);
+
+    auto columns = std::make_shared<arrow::Buffer>(R"({"a": [1, 2], "b": ["x", "y"]})");
+    auto typedColumns = pd::DataFrame::readJSON(columns, pd::JSONOrient::Columns, schema);
+    REQUIRE(typedColumns["a"].dtype()->id() == arrow::Type::DOUBLE);
+    REQUIRE(typedColumns["a"].sum().as<double>() == 3.0);
+}
+
+TEST_CASE("JSONBatchReader streams a log block by block", "[json]")
+{
+    constexpr int64_t rows = 20000;
+    auto ids = pd::range(0L, rows);
+    pd::DataFrame df{ arrow::RecordBatch::Make(arrow::schema({ arrow::field("id", arrow::int64()) }), rows, { ids }), ids };
+
+    auto path = std::filesystem::temp_directory_path() / "pandas_arrow_json_stream.ndjson";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text(pd::ReturnOrThrowOnFailure(df.toJSON(pd::JSONOrient::Records, {}, "ts")));
+    }
+
+    auto whole = pd::DataFrame::readJSON(path, pd::JSONOrient::Records, nullptr, "ts");
+    REQUIRE(whole.num_rows() == rows);
+    REQUIRE(whole["id"].sum().as<int64_t>() == rows * (rows - 1) / 2);
+
+    pd::JSONBatchReader reader(path, nullptr, "ts", 1 << 14);
+    int64_t total = 0, sum = 0, batches = 0;
+    while (auto batch = reader.next())
+    {
+        REQUIRE(batch->columnNames() == std::vector<std::string>{ "id" });
+        REQUIRE(batch->indexArray()->type_id() == arrow::Type::TIMESTAMP);
+        total += batch->num_rows();
+        sum += (*batch)["id"].sum().as<int64_t>();
+        batches++;
+    }
+    REQUIRE(batches > 1);
+    REQUIRE(total == rows);
+    REQUIRE(sum == rows * (rows - 1) / 2);
+    REQUIRE(reader.bytes_processed() == static_cast<int64_t>(std::filesystem::file_size(path)));
+    std::filesystem::remove(path);
+}
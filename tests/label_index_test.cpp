@@ -0,0 +1,73 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+TEST_CASE("LabelIndex finds integer, temporal and string labels", "[label_index]")
+{
+    pd::LabelIndex ints(arrow::ArrayT<int32_t>::Make({ 40, 10, 30, 20 }));
+    REQUIRE(ints.size() == 4);
+    REQUIRE_FALSE(ints.has_duplicates());
+    REQUIRE(ints.find(arrow::Int32Scalar(30)) == 2);
+    REQUIRE(ints.find(arrow::Int64Scalar(10)) == 1);
+    REQUIRE(ints.find(arrow::Int32Scalar(11)) == -1);
+    REQUIRE_THROWS_AS(ints.at(arrow::MakeScalar(11)), std::out_of_range);
+
+    auto stamps = pd::date_range(date(2024, Jan, 1), 5);
+    pd::LabelIndex dates(stamps);
+    REQUIRE(dates.find(*pd::fromDateTime(ptime(date(2024, Jan, 3)))) == 2);
+
+    pd::LabelIndex names(arrow::ArrayT<std::string>::Make({ "msft", "aapl", "goog" }));
+    REQUIRE(names.find(arrow::StringScalar("goog")) == 2);
+    REQUIRE(names.find(arrow::LargeStringScalar("aapl")) == 1);
+    REQUIRE(names.find(arrow::StringScalar("tsla")) == -1);
+
+    auto positions = names.get_indexer(*arrow::ArrayT<std::string>::Make({ "goog", "tsla", "msft" }));
+    REQUIRE(positions->Equals(*arrow::ArrayT<int64_t>::Make({ 2, 0, 0 }, { true, false, true })));
+    auto taken = pd::ReturnOrThrowOnFailure(pd::CallFunction("array_take", { arrow::ArrayT<double>::Make({ 1, 2, 3 }), positions }));
+    REQUIRE(taken.make_array()->Equals(*arrow::ArrayT<double>::Make({ 3, 0, 1 }, { true, false, true })));
+}
+
+TEST_CASE("LabelIndex detects duplicates and keeps first positions", "[label_index]")
+{
+    pd::LabelIndex labels(arrow::ArrayT<std::string>::Make({ "a", "b", "a", "c", "b" }));
+    REQUIRE(labels.has_duplicates());
+    REQUIRE(labels.size() == 3);
+    REQUIRE(labels.find(arrow::StringScalar("b")) == 1);
+    REQUIRE(labels.duplicated()->Equals(*arrow::ArrayT<bool>::Make({ false, false, true, false, true })));
+
+    // large tables go through the parallel bulk probe
+    const int64_t n = 200000;
+    std::vector<int64_t> values(n);
+    for (int64_t i = 0; i < n; i++) {
+        values[i] = (i * 7919) % n;
+    }
+    pd::LabelIndex shuffled(arrow::ArrayT<int64_t>::Make(values));
+    REQUIRE_FALSE(shuffled.has_duplicates());
+    auto lookup = shuffled.get_indexer(*pd::range(0L, n));
+    bool same = true;
+    for (int64_t i = 0; i < n; i++) {
+        same &= values[lookup->Value(i)] == i;
+    }
+    REQUIRE(same);
+}
+
+TEST_CASE("frames share the label index of their index", "[label_index]")
+{
+    auto index = arrow::ArrayT<std::string>::Make({ "x", "y", "z" });
+    pd::DataFrame df(arrow::RecordBatch::Make(arrow::schema({ arrow::field("v", arrow::int64()) }), 3,
+                         { arrow::ArrayT<int64_t>::Make({ 1, 2, 3 }) }),
+        index);
+    auto copy = df;
+    REQUIRE(&df.labels().labelIndex() == &copy.labels().labelIndex());
+    REQUIRE(df.labels().position(arrow::MakeScalar(std::string("z"))) == 2);
+
+    auto reindexed = df.reindex(arrow::ArrayT<std::string>::Make({ "z", "w", "x" }), pd::Scalar(int64_t{ -1 }));
+    REQUIRE(reindexed["v"].equals(std::vector<int64_t>{ 3, -1, 1 }));
+
+    pd::Series labels(index, true);
+    REQUIRE(labels.index(pd::Scalar(std::string("y"))) == 1);
+    REQUIRE(labels.append(pd::Series(arrow::ArrayT<std::string>::Make({ "w" }), true)).getIndexer().size() == 4);
+}
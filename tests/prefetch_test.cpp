@@ -0,0 +1,103 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <filesystem>
+#include "pandas_arrow.h"
+#include "prefetch.h"
+
+
+namespace {
+    pd::DataFrame makeFrame(int64_t rows, int64_t start = 0) {
+        auto values = pd::range(start, start + rows);
+        return pd::DataFrame{ arrow::RecordBatch::Make(arrow::schema({ arrow::field("v", arrow::int64()) }), rows, { values }),
+            pd::range(0L, rows) };
+    }
+
+    struct TempDirectory {
+        std::filesystem::path path{ std::filesystem::temp_directory_path() / "pandas_arrow_prefetch_test" };
+
+        TempDirectory() { std::filesystem::create_directories(path); }
+
+        ~TempDirectory() { std::filesystem::remove_all(path); }
+    };
+}
+
+TEST_CASE("async reads and writes match the blocking ones", "[prefetch]")
+{
+    TempDirectory dir;
+    auto df = makeFrame(5000);
+    auto parquet = (dir.path / "frame.parquet").string();
+    auto csv = (dir.path / "frame.csv").string();
+
+    auto written = df.toParquetAsync(parquet);
+    pd::ThrowOnFailure(df.toCSV(csv));
+    REQUIRE(written.status().ok());
+
+    auto read = pd::DataFrame::readParquetAsync(parquet);
+    auto readCSV = pd::DataFrame::readCSVAsync(csv);
+    REQUIRE(pd::ReturnOrThrowOnFailure(read.MoveResult()).equals_(pd::DataFrame::readParquet(parquet)));
+    REQUIRE(pd::ReturnOrThrowOnFailure(readCSV.MoveResult()).equals_(pd::DataFrame::readCSV(csv)));
+
+    // failures surface through the future instead of throwing on a worker thread
+    auto missing = pd::DataFrame::readParquetAsync((dir.path / "missing.parquet").string());
+    REQUIRE_FALSE(missing.status().ok());
+}
+
+TEST_CASE("Prefetcher yields files in order while reading ahead", "[prefetch]")
+{
+    TempDirectory dir;
+    std::vector<std::string> paths;
+    std::vector<arrow::Future<>> writes;
+    for (int64_t i = 0; i < 6; i++)
+    {
+        paths.push_back((dir.path / fmt::format("day{}.{}", i, i == 3 ? "csv" : "parquet")).string());
+        auto df = makeFrame(1000 * (i + 1), i);
+        if (i == 3)
+        {
+            pd::ThrowOnFailure(df.toCSV(paths.back()));
+        }
+        else
+        {
+            writes.push_back(df.toParquetAsync(paths.back()));
+        }
+    }
+    for (auto &write: writes)
+    {
+        REQUIRE(write.status().ok());
+    }
+
+    SECTION("depth bounds the files in flight")
+    {
+        pd::Prefetcher prefetcher(paths, { .depth = 3 });
+        REQUIRE(prefetcher.ahead() == 3);
+        for (int64_t i = 0; i < 6; i++)
+        {
+            auto df = prefetcher.next();
+            REQUIRE(df);
+            REQUIRE(df->num_rows() == 1000 * (i + 1));
+            REQUIRE((*df)["v"].min().as<int64_t>() == i);
+            REQUIRE(prefetcher.ahead() <= 3);
+            REQUIRE(prefetcher.remaining() == static_cast<size_t>(5 - i));
+        }
+        REQUIRE_FALSE(prefetcher.next());
+    }
+
+    SECTION("the memory budget holds back reads once frame sizes are known")
+    {
+        pd::Prefetcher prefetcher(paths, { .depth = 4, .memoryBudget = 1 });
+        REQUIRE(prefetcher.ahead() == 1);
+        int64_t files = 0;
+        while (auto df = prefetcher.next())
+        {
+            REQUIRE(prefetcher.ahead() <= 1);
+            files++;
+        }
+        REQUIRE(files == 6);
+
+        pd::Prefetcher roomy(paths, { .depth = 4, .memoryBudget = int64_t{ 1 } << 30 });
+        REQUIRE(roomy.ahead() == 1);
+        REQUIRE(roomy.next()->num_rows() == 1000);
+        REQUIRE(roomy.ahead() == 4);
+    }
+}
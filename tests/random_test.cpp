@@ -0,0 +1,120 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <numeric>
+#include <set>
+#include "pandas_arrow.h"
+
+
+TEST_CASE("Philox4x32-10 matches the Random123 known answers", "[random]")
+{
+    using pd::random::Philox4x32;
+    REQUIRE(Philox4x32::apply({ 0, 0, 0, 0 }, { 0, 0 }) == Philox4x32::Counter{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+    REQUIRE(Philox4x32::apply({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }) ==
+            Philox4x32::Counter{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd });
+}
+
+TEST_CASE("RandomState draws depend on position, not on threads", "[random]")
+{
+    constexpr int64_t n = 200000;
+    std::shared_ptr<arrow::DoubleArray> serial;
+    {
+        pd::ParallelismGuard guard(1);
+        serial = pd::random::RandomState(7).normal(n);
+    }
+    auto parallel = pd::random::RandomState(7).normal(n);
+    REQUIRE(parallel->Equals(*serial));
+
+    pd::random::RandomState state(7);
+    auto first = state.normal(n / 2);
+    auto second = state.normal(n / 2);
+    REQUIRE(state.position() == n);
+    REQUIRE(first->Equals(*serial->Slice(0, n / 2)));
+    REQUIRE(second->Equals(*serial->Slice(n / 2)));
+
+    pd::random::RandomState skipped(7);
+    skipped.jump(n - 10);
+    REQUIRE(skipped.normal(10)->Equals(*serial->Slice(n - 10)));
+
+    auto stream = pd::random::RandomState(7).substream(3);
+    REQUIRE(stream.normal(10)->Equals(*pd::random::RandomState(7).substream(3).normal(10)));
+    REQUIRE_FALSE(pd::random::RandomState(7).substream(4).normal(10)->Equals(*pd::random::RandomState(7).substream(3).normal(10)));
+    REQUIRE_FALSE(pd::random::RandomState(8).normal(10)->Equals(*serial->Slice(0, 10)));
+}
+
+TEST_CASE("RandomState distributions", "[random]")
+{
+    pd::random::RandomState state(42);
+    constexpr int64_t n = 1000000;
+
+    pd::Series normal{ state.normal(n, 1.5, 2.0), false };
+    REQUIRE(normal.mean().as<double>() == Approx(1.5).margin(0.01));
+    REQUIRE(normal.std().as<double>() == Approx(2.0).margin(0.01));
+
+    pd::Series uniform{ state.uniform(n, -1, 3), false };
+    REQUIRE(uniform.min().as<double>() >= -1);
+    REQUIRE(uniform.max().as<double>() < 3);
+    REQUIRE(uniform.mean().as<double>() == Approx(1.0).margin(0.01));
+
+    auto dice = state.integers(6000, 1, 7);
+    std::set<int64_t> faces(dice->raw_values(), dice->raw_values() + dice->length());
+    REQUIRE(faces == std::set<int64_t>{ 1, 2, 3, 4, 5, 6 });
+    REQUIRE_THROWS_AS(state.integers(1, 3, 3), std::invalid_argument);
+
+    auto ints = state.randint(100, 0, 1);
+    REQUIRE(std::ranges::all_of(ints, [](int64_t v) { return v == 0 or v == 1; }));
+}
+
+TEST_CASE("RandomState sampling", "[random]")
+{
+    pd::random::RandomState state(11);
+
+    auto permutation = state.permutation(1000);
+    std::vector<int64_t> sorted(permutation->raw_values(), permutation->raw_values() + 1000);
+    REQUIRE_FALSE(std::ranges::is_sorted(sorted));
+    std::ranges::sort(sorted);
+    std::vector<int64_t> expected(1000);
+    std::iota(expected.begin(), expected.end(), 0);
+    REQUIRE(sorted == expected);
+
+    auto picked = state.sampleIndices(1000, 100);
+    REQUIRE(std::set<int64_t>(picked->raw_values(), picked->raw_values() + 100).size() == 100);
+    REQUIRE(state.sampleIndices(3, 10, true)->length() == 10);
+
+    // a few rows of a huge population need memory for the sample only
+    pd::random::RandomState sparse(7);
+    auto few = sparse.sampleIndices(int64_t{ 1 } << 40, 1000);
+    std::set<int64_t> distinct(few->raw_values(), few->raw_values() + 1000);
+    REQUIRE(distinct.size() == 1000);
+    REQUIRE(*distinct.begin() >= 0);
+    REQUIRE(*distinct.rbegin() < int64_t{ 1 } << 40);
+    REQUIRE(few->Equals(*pd::random::RandomState(7).sampleIndices(int64_t{ 1 } << 40, 1000)));
+    auto small = sparse.sampleIndices(1000, 10);
+    REQUIRE(std::set<int64_t>(small->raw_values(), small->raw_values() + 10).size() == 10);
+    REQUIRE_THROWS_AS(state.sampleIndices(3, 10), std::invalid_argument);
+
+    pd::Series values{ pd::range(0L, 100L), pd::range(100L, 200L), "v" };
+    auto sample = state.sample(values, 10);
+    REQUIRE(sample.size() == 10);
+    for (int64_t i = 0; i < 10; i++)
+    {
+        REQUIRE(sample.indexArray()->GetScalar(i).MoveValueUnsafe()->Equals(*arrow::MakeScalar(sample.at(i).as<int64_t>() + 100)));
+    }
+
+    pd::DataFrame df{ arrow::RecordBatch::Make(arrow::schema({ arrow::field("a", arrow::int64()) }), 100, { pd::range(0L, 100L) }),
+        pd::range(0L, 100L) };
+    auto shuffled = state.permutation(df);
+    REQUIRE(shuffled.num_rows() == 100);
+    REQUIRE(shuffled["a"].sum().as<int64_t>() == 4950);
+    REQUIRE(shuffled.indexArray()->Equals(*shuffled["a"].array()));
+
+    SECTION("bootstrap replicates are reproducible")
+    {
+        auto means = state.bootstrap(values, 200, [](pd::Series const &replicate) { return replicate.mean().as<double>(); });
+        REQUIRE(means.size() == 200);
+        REQUIRE(std::accumulate(means.begin(), means.end(), 0.0) / 200 == Approx(49.5).margin(1.0));
+        REQUIRE(means == state.bootstrap(values, 200, [](pd::Series const &replicate) { return replicate.mean().as<double>(); }));
+        REQUIRE(state.resample(df, 5).equals_(state.resample(df, 5)));
+    }
+}
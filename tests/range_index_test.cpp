@@ -0,0 +1,62 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+TEST_CASE("frames without an index get a lazy RangeIndex", "[range_index]")
+{
+    pd::DataFrame df(std::map<std::string, std::vector<double>>{ { "a", { 1, 2, 3, 4, 5 } } });
+    REQUIRE(df.rangeIndex());
+    REQUIRE_FALSE(df.labels().isMaterialized());
+
+    auto tail = df.slice(2, 3);
+    REQUIRE(tail.rangeIndex() == pd::RangeIndex{ 2, 1, 3, arrow::uint64() });
+    REQUIRE(tail.labels().position(arrow::MakeScalar(uint64_t{ 3 })) == 1);
+    REQUIRE(tail.labels().position(arrow::MakeScalar(uint64_t{ 1 })) == -1);
+    REQUIRE(tail[pd::Scalar(uint64_t{ 4 })]["a"].at(0).as<double>() == 5);
+    REQUIRE(df.equals_(df.slice(0, 5)));
+    REQUIRE_FALSE(df.labels().isMaterialized());
+
+    auto reset = df.sort_values({ "a" }, false).reset_index("old", false);
+    REQUIRE(reset.rangeIndex() == pd::RangeIndex::positions(5));
+    REQUIRE(reset["old"].equals(std::vector<uint64_t>{ 4, 3, 2, 1, 0 }));
+
+    // the array is only built when asked for, and equals the eager uint_range
+    REQUIRE(tail.indexArray()->Equals(*pd::uint_range(5)->Slice(2)));
+    REQUIRE(tail.labels().isMaterialized());
+}
+
+TEST_CASE("regular DatetimeIndex supports O(1) lookups and slicing", "[range_index]")
+{
+    auto start = ptime(date(2024, 3, 1), hours(9));
+    auto grid = pd::RangeIndex::datetime(start, minutes(1), 390);
+
+    auto bars = pd::DataFrame(arrow::RecordBatch::Make(arrow::schema({ arrow::field("close", arrow::float64()) }),
+                                  390,
+                                  { pd::Series(std::vector<double>(390, 1.0)).array() }),
+        grid);
+    REQUIRE(bars.labels().type()->id() == arrow::Type::TIMESTAMP);
+    REQUIRE(bars.labels().position(pd::fromDateTime(start + minutes(30))) == 30);
+    REQUIRE(bars.labels().position(pd::fromDateTime(start + seconds(30))) == -1);
+
+    auto window = bars.slice(pd::DateTimeSlice{ start + minutes(10), start + minutes(19) }, { "close" });
+    REQUIRE(window.num_rows() == 9);
+    REQUIRE(window.rangeIndex()->start == pd::fromPTime(start + minutes(10)));
+    REQUIRE_FALSE(bars.labels().isMaterialized());
+
+    REQUIRE(grid.materialize()->Equals(*pd::date_range(start, 390, "1min")));
+
+    // same grid on both sides aligns without looking at the labels
+    auto close = bars["close"];
+    auto sum = close + close;
+    REQUIRE(sum.rangeIndex() == grid);
+    REQUIRE_FALSE(sum.labels().isMaterialized());
+}
+
+TEST_CASE("range() honours its start", "[range_index]")
+{
+    REQUIRE(pd::Series(pd::range(3L, 6L), false).equals(std::vector<int64_t>{ 3, 4, 5 }));
+    REQUIRE(pd::Series(pd::range(2UL, 4UL), false).equals(std::vector<uint64_t>{ 2, 3 }));
+}
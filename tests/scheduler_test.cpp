@@ -0,0 +1,94 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <arrow/util/thread_pool.h>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include "pandas_arrow.h"
+
+
+TEST_CASE("ParallelismGuard bounds TBB and arrow together", "[scheduler]")
+{
+    const int hardware = pd::get_parallelism();
+    {
+        pd::ParallelismGuard guard(2);
+        REQUIRE(pd::get_parallelism() == 2);
+        REQUIRE(arrow::GetCpuThreadPoolCapacity() == 2);
+        REQUIRE(pd::GetExecContext().use_threads);
+
+        std::atomic<int> widest{0};
+        pd::parallel_for(0, 64, [&](int) {
+            widest = std::max(widest.load(), tbb::this_task_arena::max_concurrency());
+        });
+        REQUIRE(widest == 2);
+    }
+    REQUIRE(pd::get_parallelism() == hardware);
+    REQUIRE_THROWS_AS(pd::set_parallelism(-1), std::invalid_argument);
+}
+
+TEST_CASE("a single thread runs loops in order on the caller", "[scheduler]")
+{
+    pd::ParallelismGuard guard(1);
+    REQUIRE_FALSE(pd::GetExecContext().use_threads);
+
+    std::vector<int64_t> order;
+    std::mutex mutex;
+    bool sameThread = true;
+    const auto caller = std::this_thread::get_id();
+    pd::parallel_for(int64_t{0}, int64_t{100}, pd::bindExecContext([&](int64_t i) {
+        std::scoped_lock lock(mutex);
+        sameThread = sameThread and std::this_thread::get_id() == caller;
+        order.push_back(i);
+    }));
+    REQUIRE(sameThread);
+    std::vector<int64_t> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    REQUIRE(order == expected);
+
+    std::vector<std::pair<size_t, size_t>> ranges;
+    pd::parallel_for(tbb::blocked_range<size_t>(0, 1000, 10), [&](tbb::blocked_range<size_t> const &r) {
+        ranges.emplace_back(r.begin(), r.end());
+    });
+    REQUIRE(ranges == std::vector<std::pair<size_t, size_t>>{ { 0, 1000 } });
+
+    SECTION("results match the parallel run")
+    {
+        auto values = arrow::ArrayT<double>::Make(std::vector<double>(100000, 0.1));
+        pd::DataFrame df{ arrow::RecordBatch::Make(arrow::schema({ arrow::field("a", arrow::float64()), arrow::field("b", arrow::float64()) }),
+                                                   values->length(), { values, values }),
+            pd::range(0L, values->length()) };
+        auto serial = df * pd::Scalar(2.0);
+        auto serialSum = serial.sum().as<double>();
+        pd::ParallelismGuard parallel(0);
+        auto result = df * pd::Scalar(2.0);
+        REQUIRE(result.equals_(serial));
+        REQUIRE(result.sum().as<double>() == Catch::Approx(serialSum));
+    }
+}
+
+TEST_CASE("ParallelismGuard restores the previous use_threads", "[scheduler]")
+{
+    auto ctx = pd::GetDefaultExecContext();
+    const bool original = ctx.use_threads;
+    ctx.use_threads = false;
+    pd::SetDefaultExecContext(ctx);
+    {
+        pd::ParallelismGuard guard(4);
+        REQUIRE(pd::GetDefaultExecContext().use_threads);
+    }
+    REQUIRE_FALSE(pd::GetDefaultExecContext().use_threads);
+
+    ctx.use_threads = original;
+    pd::SetDefaultExecContext(ctx);
+}
+
+TEST_CASE("grain sizes follow the data size", "[scheduler]")
+{
+    pd::ParallelismGuard guard(4);
+    REQUIRE(pd::grainSize(0) == 1);
+    REQUIRE(pd::grainSize(1600) == 100);
+    REQUIRE(pd::grainSize(1600, 512) == 512);
+}
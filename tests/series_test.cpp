@@ -1208,6 +1208,39 @@ TEST_CASE("Test Series::ewm with mean")
     REQUIRE(result.at(4).as<double>() == Catch::Approx(5.450000).epsilon(0.01));
 }
 
+TEST_CASE("Test Series::ewm with halflife")
+{
+    Series s(std::vector{ 1.0, 2.0, 3.0, 4.0, 5.0 });
+    auto halflife = s.ewm(pd::EWMAgg::Mean, 2.0, pd::EWMAlphaType::HalfLife);
+    auto alpha = s.ewm(pd::EWMAgg::Mean, 1 - std::exp(std::log(0.5) / 2.0), pd::EWMAlphaType::Alpha);
+    INFO(halflife);
+    for (int i = 0; i < 5; i++)
+    {
+        REQUIRE(halflife.at(i).as<double>() == Catch::Approx(alpha.at(i).as<double>()));
+    }
+    REQUIRE_THROWS(s.ewm(pd::EWMAgg::Mean, 0.0, pd::EWMAlphaType::HalfLife));
+}
+
+TEST_CASE("Test Series::ewm with halflife on a timestamp index")
+{
+    auto index = pd::ReturnOrThrowOnFailure(arrow::compute::Cast(
+        arrow::ArrayT<std::string>::Make({ "2020-01-01", "2020-01-03", "2020-01-10", "2020-01-15", "2020-01-17" }),
+        arrow::timestamp(arrow::TimeUnit::NANO))).make_array();
+    Series s(std::vector<double>{ 0, 1, 2, NAN, 4 }, "B", index);
+
+    auto result = s.ewm(hours(4 * 24));
+    INFO(result);
+    REQUIRE(result.size() == 5);
+    REQUIRE(result.at(0).as<double>() == Catch::Approx(0.0));
+    REQUIRE(result.at(1).as<double>() == Catch::Approx(0.585786).epsilon(0.0001));
+    REQUIRE(result.at(2).as<double>() == Catch::Approx(1.523889).epsilon(0.0001));
+    REQUIRE(result.at(3).as<double>() == Catch::Approx(1.523889).epsilon(0.0001));
+    REQUIRE(result.at(4).as<double>() == Catch::Approx(3.233686).epsilon(0.0001));
+
+    REQUIRE_THROWS(Series(std::vector{ 1.0, 2.0 }).ewm(hours(24)));
+    REQUIRE_THROWS_AS(s.ewm(hours(4 * 24), false), std::invalid_argument);
+}
+
 TEST_CASE("Test reindex vs reindex_async benchmark small data", "[.reindex]")
 {
     // Create a test input Series
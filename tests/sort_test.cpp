@@ -0,0 +1,119 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include <random>
+#include "pandas_arrow.h"
+
+
+static std::shared_ptr<arrow::UInt64Array> arrowSortIndices(std::shared_ptr<arrow::RecordBatch> const& batch,
+    std::vector<arrow::compute::SortKey> const& keys)
+{
+    arrow::compute::SortOptions options{ keys };
+    return std::static_pointer_cast<arrow::UInt64Array>(
+        pd::ReturnOrThrowOnFailure(arrow::compute::SortIndices(arrow::Datum(batch), options)));
+}
+
+TEST_CASE("radix sort_indices matches arrow on numeric keys", "[sort]")
+{
+    std::mt19937_64 gen(42);
+    for (int64_t n : { 10, 5000, 200000 })
+    {
+        std::uniform_int_distribution<int64_t> small(-20, 20);
+        std::normal_distribution<double> normal;
+
+        std::vector<int64_t> key(n);
+        std::vector<double> value(n);
+        std::vector<int32_t> tiebreak(n);
+        for (int64_t i = 0; i < n; i++)
+        {
+            key[i] = small(gen);
+            value[i] = normal(gen);
+            tiebreak[i] = static_cast<int32_t>(small(gen));
+        }
+        auto batch = pd::DataFrame(std::map<std::string, pd::ArrayPtr>{
+                                       { "key", pd::Series(key).array() },
+                                       { "value", pd::Series(value).array() },
+                                       { "tiebreak", pd::Series(tiebreak).array() } })
+                         .array();
+
+        INFO("rows=" << n);
+        auto ours = pd::sort_indices(*batch, { { "key", false }, { "tiebreak" }, { "value" } });
+        auto expected = arrowSortIndices(batch,
+            { arrow::compute::SortKey("key", arrow::compute::SortOrder::Descending),
+                arrow::compute::SortKey("tiebreak"),
+                arrow::compute::SortKey("value") });
+        REQUIRE(ours->Equals(*expected));
+
+        auto single = pd::sort_indices(batch->GetColumnByName("value"));
+        REQUIRE(single->Equals(*arrowSortIndices(batch, { arrow::compute::SortKey("value") })));
+    }
+}
+
+TEST_CASE("sort_indices is stable and places missing values", "[sort]")
+{
+    arrow::DoubleBuilder builder;
+    for (std::optional<double> v : std::vector<std::optional<double>>{ 3.0, std::nullopt, 1.0, NAN, 1.0, -0.0, 0.0, std::nullopt })
+    {
+        pd::ThrowOnFailure(v ? builder.Append(*v) : builder.AppendNull());
+    }
+    auto values = pd::ReturnOrThrowOnFailure(builder.Finish());
+
+    auto atEnd = pd::Series(pd::sort_indices(values), false);
+    REQUIRE(atEnd.equals(std::vector<uint64_t>{ 5, 6, 2, 4, 0, 1, 3, 7 }));
+
+    auto atStart = pd::Series(pd::sort_indices(values, false, arrow::compute::NullPlacement::AtStart), false);
+    REQUIRE(atStart.equals(std::vector<uint64_t>{ 1, 3, 7, 0, 2, 4, 5, 6 }));
+
+    arrow::StringBuilder strings;
+    pd::ThrowOnFailure(strings.AppendValues({ "b", "", "a", "b" }, std::vector<uint8_t>{ 1, 0, 1, 1 }.data()));
+    auto sortedStrings = pd::Series(pd::sort_indices(pd::ReturnOrThrowOnFailure(strings.Finish())), false);
+    REQUIRE(sortedStrings.equals(std::vector<uint64_t>{ 2, 0, 3, 1 }));
+}
+
+TEST_CASE("sort_values sorts all columns and the index by one permutation", "[sort]")
+{
+    pd::DataFrame df(std::map<std::string, std::vector<int64_t>>{
+                         { "a", { 2, 1, 2, 1, 3 } },
+                         { "b", { 5, 6, 7, 8, 9 } } },
+        arrow::ArrayT<std::string>::Make({ "v", "w", "x", "y", "z" }));
+
+    auto sorted = df.sort_values({ "a", "b" }, { true, false });
+    INFO(sorted);
+    REQUIRE(sorted["a"].equals(std::vector<int64_t>{ 1, 1, 2, 2, 3 }));
+    REQUIRE(sorted["b"].equals(std::vector<int64_t>{ 8, 6, 7, 5, 9 }));
+    REQUIRE(sorted.index().equals(std::vector<std::string>{ "y", "w", "x", "v", "z" }));
+
+    REQUIRE(df.argsort({ "a", "b" }, true).equals(std::vector<uint64_t>{ 1, 3, 0, 2, 4 }));
+    REQUIRE_THROWS(df.sort_values({ "missing" }));
+    REQUIRE_THROWS(df.sort_values({ "a", "b" }, std::vector<bool>{ true }));
+}
+
+TEST_CASE("nlargest and nsmallest select the top rows", "[sort]")
+{
+    pd::DataFrame df(std::map<std::string, std::vector<double>>{
+        { "price", { 3.0, NAN, 9.0, 1.0, 9.0, 4.0 } },
+        { "size", { 1, 2, 3, 4, 5, 6 } } });
+
+    auto top = df.nlargest(3, { "price" });
+    INFO(top);
+    REQUIRE(top["price"].equals(std::vector<double>{ 9.0, 9.0, 4.0 }));
+    REQUIRE(top.index().equals(std::vector<uint64_t>{ 2, 4, 5 }));
+
+    auto bottom = df.nsmallest(2, { "price", "size" });
+    REQUIRE(bottom["size"].equals(std::vector<double>{ 4, 1 }));
+
+    REQUIRE(df.nlargest(10, { "price" }).num_rows() == 5);
+
+    // string keys take the full sort, rows without a key are still skipped
+    arrow::StringBuilder names;
+    pd::ThrowOnFailure(names.AppendValues({ "b", "", "a", "" }, std::vector<uint8_t>{ 1, 0, 1, 0 }.data()));
+    pd::DataFrame named{ arrow::RecordBatch::Make(arrow::schema({ arrow::field("name", arrow::utf8()) }), 4,
+                                                  { pd::ReturnOrThrowOnFailure(names.Finish()) }),
+        pd::range(0L, 4L) };
+    auto first = named.nsmallest(3, { "name" });
+    REQUIRE(first.num_rows() == 2);
+    REQUIRE(first["name"].array()->null_count() == 0);
+    REQUIRE(first.index().equals(std::vector<int64_t>{ 2, 0 }));
+    REQUIRE(named.nlargest(3, { "name" }).index().equals(std::vector<int64_t>{ 0, 2 }));
+}
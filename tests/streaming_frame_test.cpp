@@ -0,0 +1,121 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+static std::shared_ptr<arrow::Schema> quoteSchema()
+{
+    return arrow::schema({ arrow::field("price", arrow::float64()), arrow::field("size", arrow::int64()) });
+}
+
+TEST_CASE("StreamingFrame appends rows and seals chunks", "[StreamingFrame]")
+{
+    pd::StreamingFrame frame(quoteSchema(), arrow::uint64(), 3);
+
+    for (uint64_t i = 0; i < 7; i++)
+    {
+        frame.append(i, 1.5 * static_cast<double>(i), static_cast<int64_t>(i * 10));
+    }
+    REQUIRE(frame.num_rows() == 7);
+    REQUIRE(frame.total_rows() == 7);
+    REQUIRE(frame.num_chunks() == 2);
+
+    auto df = frame.snapshot();
+    REQUIRE(df.num_rows() == 7);
+    REQUIRE(df.indexArray()->type()->Equals(arrow::uint64()));
+    REQUIRE(df["price"][6].as<double>() == 9.0);
+    REQUIRE(df["size"][3].as<int64_t>() == 30);
+    REQUIRE(df.index()[4].as<uint64_t>() == 4);
+}
+
+TEST_CASE("StreamingFrame casts values and rejects bad rows", "[StreamingFrame]")
+{
+    pd::StreamingFrame frame(quoteSchema(), nullptr);
+
+    frame.append_row({ pd::Scalar(int64_t{ 2 }), pd::Scalar(int32_t{ 5 }) });
+    REQUIRE_THROWS(frame.append_row({ pd::Scalar(1.0) }));
+    REQUIRE_THROWS(frame.append_row(pd::Scalar(uint64_t{ 1 }), { pd::Scalar(1.0), pd::Scalar(int64_t{ 1 }) }));
+    frame.append_row({ pd::Scalar(3.0), pd::Scalar(int64_t{ 6 }) });
+
+    auto df = frame.snapshot();
+    REQUIRE(df.num_rows() == 2);
+    REQUIRE(df["price"][0].as<double>() == 2.0);
+    REQUIRE(df["size"][0].as<int64_t>() == 5);
+    REQUIRE(df.index()[1].as<uint64_t>() == 1);
+}
+
+TEST_CASE("StreamingFrame snapshots are unaffected by later appends", "[StreamingFrame]")
+{
+    pd::StreamingFrame frame(quoteSchema(), arrow::timestamp(arrow::TimeUnit::NANO), 4);
+    auto index = pd::date_range(ptime(date(2026, 1, 1)), 6, "1min");
+
+    for (int64_t i = 0; i < 5; i++)
+    {
+        frame.append_row(pd::Scalar(index->GetScalar(i)), { pd::Scalar(double(i)), pd::Scalar(i) });
+    }
+    auto table = frame.toTable();
+    auto before = frame.snapshot();
+
+    frame.append_row(pd::Scalar(index->GetScalar(5)), { pd::Scalar(5.0), pd::Scalar(int64_t{ 5 }) });
+
+    REQUIRE(table->num_rows() == 5);
+    REQUIRE(table->num_columns() == 3);
+    REQUIRE(table->schema()->field(2)->name() == "index");
+    REQUIRE(before.num_rows() == 5);
+    REQUIRE(frame.snapshot().num_rows() == 6);
+    REQUIRE(frame.snapshot().index()[5].as<ptime>() == ptime(date(2026, 1, 1), time_duration(0, 5, 0)));
+}
+
+TEST_CASE("StreamingFrame keeps only the most recent rows with a capacity", "[StreamingFrame]")
+{
+    pd::StreamingFrame frame(quoteSchema(), nullptr, 4, 5);
+
+    for (int64_t i = 0; i < 23; i++)
+    {
+        frame.append_row({ pd::Scalar(double(i)), pd::Scalar(i) });
+        REQUIRE(frame.resident_rows() < 5 + 4);
+    }
+    REQUIRE(frame.num_rows() == 5);
+    REQUIRE(frame.total_rows() == 23);
+    REQUIRE(frame.num_chunks() <= 2);
+
+    auto df = frame.snapshot();
+    REQUIRE(df.num_rows() == 5);
+    REQUIRE(df["size"][0].as<int64_t>() == 18);
+    REQUIRE(df["size"][4].as<int64_t>() == 22);
+    REQUIRE(df.index()[0].as<uint64_t>() == 18);
+
+    auto table = frame.toTable();
+    REQUIRE(table->num_rows() == 5);
+}
+
+TEST_CASE("StreamingFrame appends whole batches", "[StreamingFrame]")
+{
+    pd::StreamingFrame frame(quoteSchema(), nullptr, 8);
+    frame.append_row({ pd::Scalar(0.0), pd::Scalar(int64_t{ 0 }) });
+
+    auto price = pd::Series(std::vector<double>{ 1, 2, 3 }, "price");
+    auto size = pd::Series(std::vector<int64_t>{ 1, 2, 3 }, "size");
+    pd::DataFrame batch(arrow::RecordBatch::Make(quoteSchema(), 3, { price.array(), size.array() }));
+
+    frame.append_batch(batch);
+    frame.append_row({ pd::Scalar(4.0), pd::Scalar(int64_t{ 4 }) });
+
+    auto df = frame.snapshot();
+    REQUIRE(df.num_rows() == 5);
+    REQUIRE(df["size"][4].as<int64_t>() == 4);
+    REQUIRE(df.index()[3].as<uint64_t>() == 3);
+
+    pd::StreamingFrame bounded(quoteSchema(), nullptr, 8, 2);
+    bounded.append_batch(batch);
+    REQUIRE(bounded.resident_rows() == 2);
+    REQUIRE(bounded.total_rows() == 3);
+    auto tail = bounded.snapshot();
+    REQUIRE(tail["size"][0].as<int64_t>() == 2);
+    REQUIRE(tail.index()[1].as<uint64_t>() == 2);
+
+    auto wrongSchema = pd::DataFrame(std::map<std::string, std::vector<double>>{ { "other", { 1.0 } } });
+    REQUIRE_THROWS(frame.append_batch(wrongSchema));
+}
@@ -0,0 +1,96 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+namespace {
+    struct TracingGuard {
+        TracingGuard() {
+            pd::tracing::Registry::Instance().reset();
+            pd::tracing::enable();
+        }
+
+        ~TracingGuard() {
+            pd::tracing::enable(false);
+            pd::tracing::Registry::Instance().reset();
+        }
+    };
+
+    std::optional<pd::tracing::FunctionStats> findStats(std::string const &name) {
+        for (auto const &entry: pd::tracing::Registry::Instance().stats()) {
+            if (entry.name == name) {
+                return entry;
+            }
+        }
+        return std::nullopt;
+    }
+}
+
+TEST_CASE("Tracing is opt-in", "[tracing]")
+{
+    pd::tracing::enable(false);
+    pd::tracing::Registry::Instance().reset();
+
+    pd::Series s(std::vector<double>{ 1, 2, 3 }, "a");
+    auto result = s + s;
+
+    REQUIRE(pd::tracing::Registry::Instance().stats().empty());
+}
+
+TEST_CASE("Compute calls are recorded with their sizes", "[tracing]")
+{
+    TracingGuard guard;
+
+    pd::Series s(std::vector<double>{ 1, 2, 3, 4 }, "a");
+    auto result = s + s;
+    result = result + s;
+
+    auto add = findStats("add");
+    REQUIRE(add.has_value());
+    REQUIRE(add->count == 2);
+    REQUIRE(add->input_rows == 8);
+    REQUIRE(add->input_bytes > 0);
+    REQUIRE(add->output_bytes > 0);
+    REQUIRE(add->max_ns >= add->min_ns);
+    REQUIRE(add->percentile(50) <= add->max_ns);
+
+    int64_t histogramCount = 0;
+    for (auto bucket: add->histogram) {
+        histogramCount += bucket;
+    }
+    REQUIRE(histogramCount == add->count);
+}
+
+TEST_CASE("Scoped operations are recorded", "[tracing]")
+{
+    TracingGuard guard;
+
+    pd::DataFrame df(std::map<std::string, std::vector<double>>{ { "a", { 3, 1, 2 } }, { "b", { 4, 5, 6 } } });
+    auto sorted = df.sort_values({ "a" });
+
+    REQUIRE(findStats("DataFrame::sort_values").has_value());
+    REQUIRE_FALSE(pd::tracing::Registry::Instance().events().empty());
+}
+
+TEST_CASE("Registry dumps JSON and Chrome trace format", "[tracing]")
+{
+    TracingGuard guard;
+
+    pd::Series s(std::vector<double>{ 1, 2, 3 }, "a");
+    auto result = s * s;
+
+    auto json = pd::tracing::Registry::Instance().toJSON();
+    REQUIRE(json.find("\"name\":\"multiply\"") != std::string::npos);
+    REQUIRE(json.find("\"histogram_log2_ns\"") != std::string::npos);
+
+    auto trace = pd::tracing::Registry::Instance().toChromeTrace();
+    REQUIRE(trace.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    REQUIRE(trace.find("\"ph\":\"X\"") != std::string::npos);
+
+    auto path = std::filesystem::temp_directory_path() / "pandas_arrow_trace.json";
+    REQUIRE(pd::tracing::Registry::Instance().dumpChromeTrace(path).ok());
+    REQUIRE(std::filesystem::file_size(path) == trace.size());
+    std::filesystem::remove(path);
+}
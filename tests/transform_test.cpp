@@ -0,0 +1,105 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+TEST_CASE("transform inlines the functor and carries nulls", "[transform]")
+{
+    auto values = arrow::ArrayT<double>::Make({ 1, 2, 3, 4, 5 }, { true, false, true, true, true });
+    pd::Series s(values, true);
+
+    auto doubled = s.transform<double>([](double x) { return x * 2; });
+    REQUIRE(doubled.array()->null_count() == 1);
+    REQUIRE(doubled.at(0).as<double>() == 2);
+    REQUIRE_FALSE(doubled.at(1).isValid());
+    REQUIRE(doubled.at(4).as<double>() == 10);
+
+    // the bitmap of a slice starts mid byte
+    auto tail = pd::transform<double, int64_t>(*values->Slice(1), [](double x) { return int64_t(x) + 1; });
+    REQUIRE(tail->Equals(*arrow::ArrayT<int64_t>::Make({ 0, 4, 5, 6 }, { false, true, true, true })));
+
+    auto positive = s.transform<double>([](double x) { return x > 2; });
+    REQUIRE(positive.dtype()->id() == arrow::Type::BOOL);
+    REQUIRE(positive.array()->Equals(*arrow::ArrayT<bool>::Make({ false, false, true, true, true }, { true, false, true, true, true })));
+
+    auto stamps = pd::transform<int64_t>(*pd::date_range(date(2024, Jan, 1), 3),
+        [](int64_t t) { return t + 3600'000'000'000L; },
+        { .type = arrow::timestamp(arrow::TimeUnit::NANO) });
+    REQUIRE(stamps->type()->id() == arrow::Type::TIMESTAMP);
+    REQUIRE(std::static_pointer_cast<arrow::TimestampArray>(stamps)->Value(0) == pd::fromPTime(ptime(date(2024, Jan, 1), hours(1))));
+    REQUIRE_THROWS(pd::transform<int64_t>(*stamps, [](int64_t t) { return t; }, { .type = arrow::int32() }));
+
+    // map and apply now go through transform
+    auto mapped = s.map<double, double>([](double &&x) { return x + 1; });
+    REQUIRE_FALSE(mapped.at(1).isValid());
+    REQUIRE(s.apply<double, double>([](double x, double y) { return x * y; }, 3.0).at(2).as<double>() == 9);
+}
+
+TEST_CASE("map and apply skip nulls and run serially without threads", "[transform]")
+{
+    auto values = arrow::ArrayT<double>::Make({ 1, 2, 3, 4, 5 }, { true, false, true, true, true });
+    pd::Series s(values, true);
+
+    auto ctx = pd::GetExecContext();
+    ctx.use_threads = false;
+    pd::ScopedExecContext scope(ctx);
+
+    std::vector<double> seen;
+    auto mapped = s.map<double, double>([&](double &&x) {
+        seen.push_back(x);
+        return x + 1;
+    });
+    REQUIRE(seen == std::vector<double>{ 1, 3, 4, 5 });
+    REQUIRE(mapped.array()->null_count() == 1);
+
+    seen.clear();
+    auto applied = s.apply<double, double>([&](double x, double y) {
+        seen.push_back(x);
+        return x * y;
+    }, 2.0);
+    REQUIRE(seen == std::vector<double>{ 1, 3, 4, 5 });
+    REQUIRE(applied.at(4).as<double>() == 10);
+
+    arrow::StringBuilder builder;
+    pd::ThrowOnFailure(builder.AppendValues({ "a", "", "c" }, std::vector<uint8_t>{ 1, 0, 1 }.data()));
+    pd::Series names{ pd::ReturnOrThrowOnFailure(builder.Finish()), false, "names" };
+    auto upper = names.map<std::string, std::string>([](std::string &&x) { return x + x; });
+    REQUIRE(upper.at(2).as<std::string>() == "cc");
+    REQUIRE_FALSE(upper.at(1).isValid());
+}
+
+TEST_CASE("transform splits long columns into morsels", "[transform]")
+{
+    const int64_t n = (1 << 20) + 3;
+    std::vector<int32_t> values(n);
+    std::iota(values.begin(), values.end(), 0);
+    pd::Series s(values);
+
+    auto odd = s.transform<int32_t>([](int32_t x) { return (x & 1) == 1; }, { .morselSize = 1000 });
+    REQUIRE(odd.size() == n);
+    REQUIRE(odd.sum().as<uint64_t>() == n / 2);
+
+    auto squares = pd::transform<int32_t, int64_t>(*s.array(), [](int32_t x) { return int64_t(x) * x; });
+    auto const *raw = std::static_pointer_cast<arrow::Int64Array>(squares)->raw_values();
+    bool same = true;
+    for (int64_t i = 0; i < n; i++) {
+        same &= raw[i] == i * i;
+    }
+    REQUIRE(same);
+}
+
+TEST_CASE("transform2 pairs two columns and ANDs their validity", "[transform]")
+{
+    pd::Series close(arrow::ArrayT<double>::Make({ 10, 11, 12, 13 }, { true, true, false, true }), true);
+    pd::Series volume(arrow::ArrayT<int64_t>::Make({ 100, 200, 300, 400 }, { true, false, true, true }), true);
+
+    auto notional = close.transform2<double, int64_t>(volume, [](double c, int64_t v) { return c * double(v); });
+    REQUIRE(notional.array()->Equals(*arrow::ArrayT<double>::Make({ 1000, 0, 0, 5200 }, { true, false, false, true })));
+
+    auto dense = pd::transform2<double>(*close.array()->Slice(0, 2), *close.array()->Slice(0, 2), [](double a, double b) { return a - b; });
+    REQUIRE(dense->null_count() == 0);
+
+    REQUIRE_THROWS(close.transform2<double>(pd::Series(close.array()->Slice(1), true), [](double a, double b) { return a + b; }));
+}
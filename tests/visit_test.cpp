@@ -0,0 +1,111 @@
+//
+// Created by dewe on 10/19/26.
+//
+#include <catch.hpp>
+#include "pandas_arrow.h"
+
+
+using namespace std::string_literals;
+
+
+namespace {
+    // volume weighted price, rows with a missing volume are skipped
+    struct VWAP {
+        double notional{0}, volume{0};
+        int64_t rows{0}, chunks{0};
+
+        VWAP() = default;
+
+        VWAP(VWAP &, tbb::split) {}
+
+        void operator()(int64_t, pd::ColumnView<double> const &price, pd::ColumnView<int64_t> const &size)
+        {
+            chunks++;
+            for (size_t i = 0; i < price.size(); i++) {
+                if (size.isValid(i)) {
+                    notional += price[i] * static_cast<double>(size[i]);
+                    volume += static_cast<double>(size[i]);
+                    rows++;
+                }
+            }
+        }
+
+        void join(VWAP const &rhs)
+        {
+            notional += rhs.notional;
+            volume += rhs.volume;
+            rows += rhs.rows;
+            chunks += rhs.chunks;
+        }
+    };
+
+    // order dependent, so it can only run sequentially
+    struct LastChange {
+        std::vector<int64_t> firstRows;
+        double last{ std::nan("") };
+        int64_t changes{ 0 };
+        bool pre_called{ false }, post_called{ false };
+
+        void pre() { pre_called = true; }
+
+        void post() { post_called = true; }
+
+        void operator()(int64_t firstRow, pd::ColumnView<double> const &price)
+        {
+            firstRows.push_back(firstRow);
+            for (auto value : price) {
+                changes += (value != last);
+                last = value;
+            }
+        }
+    };
+}
+
+TEST_CASE("visit streams mixed typed columns with their validity", "[visit]")
+{
+    constexpr int64_t N = 1 << 20;
+    std::vector<double> price(N);
+    arrow::Int64Builder size;
+    REQUIRE(size.Reserve(N).ok());
+    for (int64_t i = 0; i < N; i++) {
+        price[i] = 100 + static_cast<double>(i % 7);
+        if (i % 10 == 0) {
+            size.UnsafeAppendNull();
+        } else {
+            size.UnsafeAppend(i % 5 + 1);
+        }
+    }
+    auto df = pd::DataFrame(arrow::RecordBatch::Make(
+        arrow::schema({ arrow::field("price", arrow::float64()), arrow::field("size", arrow::int64()) }),
+        N,
+        { pd::Series(price).array(), size.Finish().ValueOrDie() }));
+
+    auto parallel = df.visit<double, int64_t>(VWAP{}, { "price"s, "size"s }, { .chunkSize = 4096 });
+    auto serial = df.visit<double, int64_t>(VWAP{}, { "price"s, "size"s }, { .chunkSize = 4096, .parallel = false });
+
+    REQUIRE(parallel.rows == N - N / 10 - 1);
+    REQUIRE(parallel.chunks == N / 4096);
+    REQUIRE(parallel.rows == serial.rows);
+    REQUIRE(parallel.notional / parallel.volume == Approx(serial.notional / serial.volume));
+    // the split points are fixed so repeated runs agree to the bit
+    auto again = df.visit<double, int64_t>(VWAP{}, { "price"s, "size"s }, { .chunkSize = 4096 });
+    REQUIRE(again.notional == parallel.notional);
+
+    auto tail = df.slice(N - 100, 100);
+    auto sliced = tail.visit<double, int64_t>(VWAP{}, { "price"s, "size"s });
+    REQUIRE(sliced.rows == 90);
+
+    REQUIRE_THROWS(df.visit<double>(LastChange{}, { "size"s }));
+    REQUIRE_THROWS(df.visit<double, int64_t>(VWAP{}, { "price"s, "missing"s }));
+}
+
+TEST_CASE("visit runs non splittable visitors in row order", "[visit]")
+{
+    auto series = pd::Series(std::vector<double>{ 1, 1, 2, 2, 3, 1, 1, 4, 4, 5 });
+    auto result = series.visit<double>(LastChange{}, { .chunkSize = 3 });
+
+    REQUIRE(result.pre_called);
+    REQUIRE(result.post_called);
+    REQUIRE(result.firstRows == std::vector<int64_t>{ 0, 3, 6, 9 });
+    REQUIRE(result.changes == 6);
+}